@@ -17,6 +17,7 @@ MxxRu::Cpp::composite_target {
 	example[ 'hello_periodic' ]
 	example[ 'chstate' ]
 	example[ 'chstate_msg_tracing' ]
+	example[ 'flight_recorder_decoder' ]
 	example[ 'disp' ]
 	example[ 'coop_listener' ]
 	example[ 'exception_logger' ]
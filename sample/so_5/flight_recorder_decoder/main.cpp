@@ -0,0 +1,46 @@
+/*
+ * A decoder for dumps of message tracing flight recorder.
+ *
+ * Dumps are made by so_5::msg_tracing::flight_recorder_t. Every dump
+ * from the command line is converted to a timeline where records from
+ * all threads are merged by timestamps. The timeline goes to std::cout.
+ *
+ * Dump can be decoded only on the same platform where it was made.
+ */
+
+#include <fstream>
+#include <iostream>
+
+// Main SObjectizer header file.
+#include <so_5/all.hpp>
+
+int
+main( int argc, char ** argv )
+{
+	if( argc < 2 )
+	{
+		std::cerr << "Usage: " << argv[ 0 ] << " <dump_file>..." << std::endl;
+		return 2;
+	}
+
+	int result = 0;
+	for( int i = 1; i != argc; ++i )
+	{
+		try
+		{
+			std::ifstream from( argv[ i ], std::ios::binary );
+			if( !from )
+				throw std::runtime_error( "unable to open file" );
+
+			std::cout << "=== " << argv[ i ] << std::endl;
+			so_5::msg_tracing::decode_flight_recorder_dump( from, std::cout );
+		}
+		catch( const std::exception & ex )
+		{
+			std::cerr << argv[ i ] << ": error: " << ex.what() << std::endl;
+			result = 1;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,9 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'so_5/prj_s.rb'
+	target 'sample.so_5.flight_recorder_decoder_s'
+
+	cpp_source 'main.cpp'
+}
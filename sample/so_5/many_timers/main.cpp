@@ -23,7 +23,8 @@ struct cfg_t
 	enum class timer_type_t {
 		wheel,
 		list,
-		heap
+		heap,
+		hwheel
 	} m_timer_type = { timer_type_t::wheel };
 };
 
@@ -60,7 +61,7 @@ cfg_t parse_args( int argc, char ** argv )
 				"Where options are:\n"
 				"-m <count>       count of delayed messages to be sent\n"
 				"-d <millisecons> pause for delayed messages\n"
-				"-t <type>        timer type (wheel, list, heap)\n"
+				"-t <type>        timer type (wheel, list, heap, hwheel)\n"
 				"-h               show this help\n"
 				<< std::flush;
 			std::exit( 1 );
@@ -93,6 +94,8 @@ cfg_t parse_args( int argc, char ** argv )
 				result.m_timer_type = cfg_t::timer_type_t::list;
 			else if( 0 == std::strcmp( *current, "heap" ) )
 				result.m_timer_type = cfg_t::timer_type_t::heap;
+			else if( 0 == std::strcmp( *current, "hwheel" ) )
+				result.m_timer_type = cfg_t::timer_type_t::hwheel;
 			else
 				throw std::invalid_argument( "unknown type of timer" );
 		}
@@ -111,6 +114,8 @@ void show_cfg( const cfg_t & cfg )
 		timer_type = "list";
 	else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
 		timer_type = "heap";
+	else if( cfg.m_timer_type == cfg_t::timer_type_t::hwheel )
+		timer_type = "hwheel";
 
 	std::cout << "timer: " << timer_type
 			<< ", messages: " << cfg.m_messages
@@ -203,6 +208,8 @@ void run_sobjectizer( const cfg_t & cfg )
 				timer = so_5::timer_list_factory();
 			else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
 				timer = so_5::timer_heap_factory();
+			else if( cfg.m_timer_type == cfg_t::timer_type_t::hwheel )
+				timer = so_5::timer_hwheel_factory();
 
 			params.timer_thread( timer );
 		} );
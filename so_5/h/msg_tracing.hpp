@@ -14,9 +14,22 @@
 
 #include <so_5/h/declspec.hpp>
 #include <so_5/h/compiler_features.hpp>
+#include <so_5/h/current_thread_id.hpp>
+#include <so_5/h/spinlocks.hpp>
+#include <so_5/h/types.hpp>
 
+#include <so_5/rt/h/fwd.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 #include <string>
 #include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
 
 namespace so_5 {
 
@@ -36,6 +49,323 @@ enum class status_t
 		enabled
 	};
 
+//
+// action_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Kind of message delivery action described by a trace record.
+ */
+enum class action_t : std::uint8_t
+	{
+		//! There is no subscribers for a message sent to mbox.
+		no_subscribers,
+		//! A message is pushed to the event queue of a subscriber.
+		push_to_queue,
+		//! A message is rejected by subscriber's delivery filter.
+		message_rejected,
+		//! Overlimit reaction: the application is aborted.
+		overlimit_abort,
+		//! Overlimit reaction: a message is dropped.
+		overlimit_drop,
+		//! Overlimit reaction: a message is redirected to another mbox.
+		overlimit_redirect,
+		//! Overlimit reaction: a message is transformed to another one.
+		overlimit_transform,
+		//! The result of search of event handler for a message.
+		find_handler,
+		//! An agent leaves a state.
+		state_leaving,
+		//! An agent enters into a state.
+		state_entering,
+		//! A message is stored into a mchain.
+		mchain_stored,
+		//! A message is extracted from a mchain.
+		mchain_extracted,
+		//! A message is dropped when a mchain is closed.
+		mchain_dropped_on_close,
+		//! A new message is dropped because of mchain's overflow.
+		mchain_overflow_drop_newest,
+		//! The oldest message is removed because of mchain's overflow.
+		mchain_overflow_remove_oldest,
+		//! A message is replaced by a new one in a mchain with conflation.
+		mchain_conflated,
+		//! An exception is thrown because of mchain's overflow.
+		mchain_overflow_throw_exception,
+		//! The application is aborted because of mchain's overflow.
+		mchain_overflow_abort_app
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Name of the action for textual description.
+ *
+ * \return A pointer to string literal.
+ */
+SO_5_FUNC const char *
+action_name( action_t action );
+
+//
+// message_info_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Description of a message in a trace record.
+ */
+struct message_info_t
+	{
+		//! Type of the message.
+		/*!
+		 * It is typeid(void) if there is no message in the record.
+		 */
+		std::type_index m_type = typeid(void);
+
+		//! Pointer to the envelope if the message is inside an envelope.
+		const void * m_envelope = nullptr;
+
+		//! Pointer to the payload of the message.
+		/*!
+		 * It is nullptr for signals.
+		 */
+		const void * m_payload = nullptr;
+
+		//! Is the message mutable?
+		bool m_mutable = false;
+
+		//! Is there a message?
+		bool
+		empty() const SO_5_NOEXCEPT
+			{
+				return std::type_index{ typeid(void) } == m_type;
+			}
+	};
+
+//
+// trace_record_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Structured description of one message delivery action.
+ *
+ * It is a trivially copyable object without any dynamically allocated
+ * content. It is filled up by SObjectizer and passed to
+ * tracer_t::trace_record(). Fields which are not applicable for
+ * the action are zeros (message_info_t::m_type is typeid(void)).
+ *
+ * \note Pointers are valid only during tracer_t::trace_record() call.
+ * They can be stored only as identifiers.
+ */
+struct trace_record_t
+	{
+		//! Time of the action.
+		/*!
+		 * It is set only if tracer_t::needs_timestamps() returns true.
+		 * Otherwise it is zero.
+		 */
+		std::chrono::steady_clock::time_point m_timestamp;
+
+		//! ID of the thread on which the action is performed.
+		current_thread_id_t m_thread_id;
+
+		//! The action.
+		action_t m_action;
+
+		//! Name of the operation during which the action is performed.
+		/*!
+		 * It is "deliver_message", "deliver_service_request" or
+		 * "replay_last_value" for mboxes, a name of the context of event
+		 * handler search for action_t::find_handler, "state" for changes
+		 * of agent's state and "message" or "service_request" for mchains.
+		 *
+		 * It is always a pointer to a string literal.
+		 */
+		const char * m_operation;
+
+		//! ID of mbox or mchain.
+		mbox_id_t m_mbox_id;
+
+		//! The message.
+		message_info_t m_message;
+
+		//! The subscriber or the owner of the state.
+		const agent_t * m_agent;
+
+		//! The current state of the agent (for action_t::find_handler)
+		//! or the state which the agent leaves/enters.
+		const state_t * m_state;
+
+		//! Event handler found by action_t::find_handler.
+		/*!
+		 * It is nullptr if there is no handler.
+		 */
+		const void * m_event_handler;
+
+		//! Deep of overlimit reactions (for actions of mboxes).
+		unsigned int m_overlimit_deep;
+
+		//! ID of the target mbox for action_t::overlimit_redirect and
+		//! action_t::overlimit_transform.
+		mbox_id_t m_target_mbox_id;
+
+		//! The second message.
+		/*!
+		 * It is the result of action_t::overlimit_transform or a message
+		 * removed (replaced) by action_t::mchain_overflow_remove_oldest
+		 * (action_t::mchain_conflated).
+		 */
+		message_info_t m_second_message;
+
+		//! Size of mchain for action_t::mchain_stored.
+		std::size_t m_chain_size;
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Make textual description of a trace record.
+ *
+ * This is the same description which was passed to tracer_t::trace()
+ * in previous versions.
+ */
+SO_5_FUNC std::string
+to_text( const trace_record_t & record );
+
+//
+// sampling_t
+//
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Rules for selection of messages to be traced.
+ *
+ * By default all messages are traced. Message can be selected by
+ * its type, by mbox (mchain) where it was sent and one of every N
+ * messages can be selected. All specified rules must be satisfied.
+ *
+ * Decision about a message is made anew for every delivery of it:
+ * for every send of the message instance and for every shot of
+ * a delayed or periodic message. This decision is kept inside the message
+ * instance and reused at all other points of the same delivery:
+ * redirection of the message, its extraction from a mchain, search of
+ * event handler for it. The result of transformation of a selected message
+ * is selected too.
+ *
+ * One of every N messages is counted separately on every thread.
+ * Because of that one of every N deliveries is selected for every
+ * sender thread.
+ *
+ * Selection by agent is applied to every record separately. Records
+ * which are related to an agent are traced only if it is one of specified
+ * agents. Records which are not related to any agent (storing of
+ * messages to mchains and extraction from them, absence of subscribers)
+ * are not checked by agents. Records about changes of agent's states are
+ * selected only by agents.
+ *
+ * IDs of mboxes and pointers to agents are known only after their
+ * creation. Rules with them can be set at run-time by
+ * so_5::environment_t::change_message_delivery_sampling().
+ *
+ * \note Signals have no instances. Because of that the decision about
+ * a signal is made anew at every point.
+ *
+ * \note If the same message instance takes part in several deliveries
+ * at the same time (e.g. a periodic message with very small period)
+ * then records of an earlier delivery can use the decision made for
+ * a later one.
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( &init, []( so_5::environment_params_t & params ) {
+		params.message_delivery_tracer(
+			so_5::msg_tracing::make_sampled_tracer(
+				so_5::msg_tracing::sampling_t{}
+					.message_type< request >()
+					.one_of( 100 ),
+				so_5::msg_tracing::std_cout_tracer() ) );
+	} );
+	\endcode
+ */
+class SO_5_TYPE sampling_t
+	{
+	public :
+		//! Default constructor makes rules which select everything.
+		sampling_t();
+
+		//! Select one of every \a n messages.
+		/*!
+		 * Values 0 and 1 mean every message.
+		 */
+		sampling_t &
+		one_of( unsigned int n );
+
+		//! Select messages of specified type.
+		/*!
+		 * Can be called several times for several types.
+		 */
+		sampling_t &
+		message_type( const std::type_index & type );
+
+		//! Select messages of specified type.
+		template< typename MSG >
+		sampling_t &
+		message_type()
+			{
+				return message_type( typeid(MSG) );
+			}
+
+		//! Select messages sent to mbox or mchain with specified ID.
+		/*!
+		 * Can be called several times for several mboxes.
+		 */
+		sampling_t &
+		mbox_id( mbox_id_t id );
+
+		//! Select records related to specified agent.
+		/*!
+		 * Can be called several times for several agents.
+		 */
+		sampling_t &
+		agent( const agent_t & agent );
+
+		//! Make the decision about a message.
+		bool
+		select_message(
+			const std::type_index & msg_type,
+			mbox_id_t mbox_id ) const SO_5_NOEXCEPT;
+
+		//! Make the decision about a record related to an agent.
+		/*!
+		 * \a agent can be nullptr for records without agents. Such records
+		 * are always selected.
+		 */
+		bool
+		select_agent( const agent_t * agent ) const SO_5_NOEXCEPT;
+
+	private :
+		//! Only one of every m_one_of messages is selected.
+		unsigned int m_one_of;
+
+		//! Types of selected messages.
+		std::vector< std::type_index > m_types;
+
+		//! IDs of mboxes for selected messages.
+		std::vector< mbox_id_t > m_mboxes;
+
+		//! Selected agents.
+		std::vector< const agent_t * > m_agents;
+	};
+
 //
 // tracer_t
 //
@@ -61,6 +391,114 @@ class SO_5_TYPE tracer_t
 		//! appropriate storage/stream.
 		virtual void
 		trace( const std::string & what ) SO_5_NOEXCEPT = 0;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Handle structured description of message delivery action.
+		 *
+		 * This method is called by SObjectizer for every traced action.
+		 * Default implementation makes textual description by to_text()
+		 * and passes it to trace(). A tracer which doesn't need text
+		 * can redefine this method and avoid the cost of formatting.
+		 */
+		virtual void
+		trace_record( const trace_record_t & record ) SO_5_NOEXCEPT;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Does the tracer use trace_record_t::m_timestamp?
+		 *
+		 * Reading of the clock isn't free. So SObjectizer sets
+		 * the timestamp of a record only if this method returns true.
+		 * Default implementation returns false because to_text() doesn't
+		 * show timestamps.
+		 */
+		virtual bool
+		needs_timestamps() const SO_5_NOEXCEPT;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Are there rules for selection of traced messages?
+		 *
+		 * SObjectizer checks these rules before making a trace record.
+		 * If there are no rules then all messages are traced.
+		 */
+		bool
+		has_sampling() const SO_5_NOEXCEPT
+			{
+				return m_has_sampling.load( std::memory_order_acquire );
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Make the decision about a message by the actual rules.
+		 *
+		 * \see sampling_t::select_message().
+		 */
+		bool
+		select_message(
+			const std::type_index & msg_type,
+			mbox_id_t mbox_id ) const SO_5_NOEXCEPT;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Make the decision about a record related to an agent
+		 * by the actual rules.
+		 *
+		 * \see sampling_t::select_agent().
+		 */
+		bool
+		select_agent( const agent_t * agent ) const SO_5_NOEXCEPT;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Get a copy of the actual rules.
+		 *
+		 * \return rules which select everything if there are no rules.
+		 */
+		sampling_t
+		current_sampling() const;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Replace rules for selection of traced messages.
+		 *
+		 * Can be called while messages are being traced. Previous rules
+		 * are destroyed when there are no more threads which use them.
+		 */
+		void
+		change_sampling( sampling_t rules );
+
+	private :
+		//! Are there rules for selection of traced messages?
+		/*!
+		 * Allows to check the rules without acquiring m_sampling_lock
+		 * if there are no rules.
+		 */
+		std::atomic< bool > m_has_sampling;
+
+		//! Lock for the rules.
+		/*!
+		 * Rules are checked under read lock and replaced under write lock.
+		 */
+		mutable default_rw_spinlock_t m_sampling_lock;
+
+		//! The actual rules for selection of traced messages.
+		std::unique_ptr< sampling_t > m_sampling;
 	};
 
 //
@@ -75,6 +513,75 @@ class SO_5_TYPE tracer_t
  */
 using tracer_unique_ptr_t = std::unique_ptr< tracer_t >;
 
+//
+// filter_t
+//
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of filter for trace records.
+ *
+ * Filter returns true if the record must be passed to the tracer.
+ *
+ * \attention Filter must not throw exceptions.
+ */
+using filter_t = std::function< bool( const trace_record_t & ) >;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Make a tracer which passes to \a actual_tracer only records
+ * accepted by \a filter.
+ *
+ * Filter is applied to the structured record before any formatting.
+ * So only accepted records are formatted (if \a actual_tracer formats
+ * them at all).
+ *
+ * \note Filter receives records without timestamps. If \a actual_tracer
+ * needs timestamps then they are set only for accepted records.
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( &init, []( so_5::environment_params_t & params ) {
+		params.message_delivery_tracer(
+			so_5::msg_tracing::make_filtered_tracer(
+				[]( const so_5::msg_tracing::trace_record_t & r ) {
+					// Only results of event handler search are interesting.
+					return so_5::msg_tracing::action_t::find_handler == r.m_action;
+				},
+				so_5::msg_tracing::std_cout_tracer() ) );
+	} );
+	\endcode
+ */
+SO_5_FUNC tracer_unique_ptr_t
+make_filtered_tracer(
+	//! Filter to be applied.
+	filter_t filter,
+	//! Tracer for accepted records.
+	tracer_unique_ptr_t actual_tracer );
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Set rules for selection of messages to \a actual_tracer.
+ *
+ * Unlike make_filtered_tracer() the decision is made before any trace
+ * record is built. And it is consistent for all records about the
+ * same message.
+ *
+ * \return \a actual_tracer.
+ */
+SO_5_FUNC tracer_unique_ptr_t
+make_sampled_tracer(
+	//! Rules for selection of messages.
+	sampling_t sampling,
+	//! Tracer for records about selected messages.
+	tracer_unique_ptr_t actual_tracer );
+
 //
 // Standard stream tracers.
 //
@@ -106,6 +613,146 @@ std_cerr_tracer();
 SO_5_FUNC tracer_unique_ptr_t
 std_clog_tracer();
 
+//
+// flight_recorder_t
+//
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Storage of the last trace records for every working thread.
+ *
+ * Every thread which produces trace records gets its own ring buffer
+ * at the first record. Records are stored into that buffer without
+ * any locks and without formatting. When the buffer is full the oldest
+ * records are overwritten. So flight recorder can be always on.
+ *
+ * The content of buffers can be dumped at any time in binary form.
+ * Dump can be converted to readable timeline by
+ * decode_flight_recorder_dump().
+ *
+ * \note Count of threads is limited by \a max_threads constructor's
+ * argument. Records from additional threads are lost (but counted).
+ * A buffer is released when its thread finishes. Records of the finished
+ * thread are kept in the buffer until a new thread takes it and
+ * overwrites them.
+ *
+ * \note Binary dump contains values of pointers and can be decoded
+ * only on the same platform.
+ *
+ * \par Usage example:
+	\code
+	auto recorder = std::make_shared< so_5::msg_tracing::flight_recorder_t >();
+	so_5::launch( &init, [&]( so_5::environment_params_t & params ) {
+		params.message_delivery_tracer(
+			so_5::msg_tracing::flight_recorder_tracer(
+				recorder, "so5_trace.bin" ) );
+	} );
+	\endcode
+ */
+class SO_5_TYPE flight_recorder_t
+	{
+		flight_recorder_t( const flight_recorder_t & ) = delete;
+		flight_recorder_t & operator=( const flight_recorder_t & ) = delete;
+
+	public :
+		//! Default capacity of buffer for one thread.
+		static const std::size_t default_records_per_thread = 4096;
+		//! Default max count of threads.
+		static const std::size_t default_max_threads = 64;
+
+		flight_recorder_t(
+			//! Capacity of buffer for one thread.
+			std::size_t records_per_thread = default_records_per_thread,
+			//! Max count of threads with own buffers.
+			std::size_t max_threads = default_max_threads );
+		~flight_recorder_t();
+
+		//! Store a record to the buffer of the current thread.
+		void
+		store( const trace_record_t & record ) SO_5_NOEXCEPT;
+
+		//! Write the binary dump of all buffers.
+		/*!
+		 * Can be called while records are being stored. Records which
+		 * are overwritten during dumping are not included.
+		 *
+		 * \throw so_5::exception_t with rc_msg_tracing_dump_failure
+		 * if the dump can't be written.
+		 */
+		void
+		dump( std::ostream & to ) const;
+
+		//! Write the binary dump of all buffers to a file.
+		void
+		dump_to_file( const std::string & file_name ) const;
+
+		//! Count of records lost because of limit of threads.
+		std::size_t
+		lost_records() const;
+
+	private :
+		struct internals_t;
+
+		//! Internals of the recorder.
+		/*!
+		 * They are shared with finished threads which release
+		 * their buffers.
+		 */
+		std::shared_ptr< internals_t > m_impl;
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A short alias for shared_ptr to flight recorder.
+ */
+using flight_recorder_shptr_t = std::shared_ptr< flight_recorder_t >;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Factory for tracer which stores records to a flight recorder.
+ */
+SO_5_FUNC tracer_unique_ptr_t
+flight_recorder_tracer( flight_recorder_shptr_t recorder );
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Factory for tracer which stores records to a flight recorder
+ * and dumps them to the file at shutdown.
+ *
+ * Dump is made when the tracer is destroyed (at the end of
+ * SObjectizer Environment's work). Errors of dumping are ignored.
+ */
+SO_5_FUNC tracer_unique_ptr_t
+flight_recorder_tracer(
+	flight_recorder_shptr_t recorder,
+	std::string dump_file_name );
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Convert binary dump of flight recorder into readable timeline.
+ *
+ * Records from all threads are merged and sorted by timestamps.
+ *
+ * \throw so_5::exception_t with rc_msg_tracing_dump_failure
+ * if dump has an invalid format.
+ */
+SO_5_FUNC void
+decode_flight_recorder_dump(
+	//! Binary dump.
+	std::istream & from,
+	//! Stream for the timeline.
+	std::ostream & to );
+
 } /* namespace msg_tracing */
 
 } /* namespace so_5 */
@@ -316,6 +316,30 @@ const int rc_delivery_filter_cannot_be_used_on_mpsc_mbox = 89;
 
 //! Unable to schedule a timer event.
 const int rc_unable_to_schedule_timer_act = 90;
+
+/*!
+ * \brief Invalid count of shards for sharded timer thread.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_invalid_timer_shards_count = 91;
+
+/*!
+ * \brief Invalid slack for coalescing timer thread.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_invalid_timer_slack = 92;
+
+/*!
+ * \brief timerfd-based timer thread is not supported on this platform.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_timerfd_not_supported = 93;
 //! \}
 
 //! \name Error codes for layers.
@@ -354,6 +378,16 @@ const int rc_priority_quote_illegal_value = 120;
 //! Message delivery tracing is disabled and cannot be used.
 const int rc_msg_tracing_disabled = 140;
 
+/*!
+ * \brief Dump of message tracing flight recorder can't be written or read.
+ *
+ * For example, dump file can't be created or it has an invalid format.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_msg_tracing_dump_failure = 141;
+
 //! \}
 
 //! \name Error codes for message chains.
@@ -428,6 +462,60 @@ const int rc_mutable_msg_cannot_be_periodic = 173;
  */
 const int rc_subscription_to_mutable_msg_from_mpmc_mbox = 174;
 
+/*!
+ * \brief An attempt to set key filter on routing mbox for message type
+ * without key extractor.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_routing_key_extractor_not_found = 175;
+
+/*!
+ * \brief Invalid range for key filter of routing mbox.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_invalid_routing_key_range = 176;
+
+/*!
+ * \brief Invalid name of topic or topic pattern.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_invalid_topic_name = 177;
+
+/*!
+ * \brief An attempt to send a message or service request to mbox
+ * of topic pattern.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_topic_pattern_cannot_be_published = 178;
+
+/*!
+ * \brief An error in spill-to-disk storage of mchain.
+ *
+ * For example, spill file can't be created or mapped into memory.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_mchain_spill_failure = 179;
+
+/*!
+ * \brief An attempt to create mchain with incompatible parameters.
+ *
+ * For example, spill-to-disk can't be used with conflation of messages.
+ *
+ * \since
+ * v.5.5.20
+ */
+const int rc_incompatible_mchain_params = 180;
+
 //! \name Common error codes.
 //! \{
 
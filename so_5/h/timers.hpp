@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 
 #include <so_5/h/declspec.hpp>
@@ -57,6 +59,27 @@ class SO_5_TYPE timer_t
 		//! Release the timer event.
 		virtual void
 		release() = 0;
+
+		//! Schedule the timer event again with new pause and period.
+		/*!
+		 * The same message is delivered to the same mbox. If the timer
+		 * event is active it is canceled first.
+		 *
+		 * \retval false if the timer event is already released.
+		 *
+		 * \note The default implementation throws an exception with
+		 * rc_not_implemented error code.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual bool
+		reschedule(
+			//! Pause before the next message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period );
 	};
 
 //
@@ -103,6 +126,40 @@ class SO_5_TYPE timer_id_t
 		void
 		release();
 
+		//! Schedule the timer event again with new pause and period.
+		/*!
+		 * The same message is delivered to the same mbox. Objects for
+		 * the timer are reused, so there is no need for memory allocation.
+		 * It makes this method cheap for retransmission timers:
+		 * \code
+			void on_request_sent() {
+				if( !m_retransmit.reschedule( m_timeout ) )
+					m_retransmit = so_5::send_periodic< retransmit >(
+							*this, m_timeout, std::chrono::seconds::zero() );
+			}
+		 * \endcode
+		 *
+		 * If the timer event is active it is canceled first.
+		 *
+		 * \retval false if there is no timer event (timer_id is empty
+		 * or the timer event is already released).
+		 *
+		 * \throw so_5::exception_t with rc_mutable_msg_cannot_be_periodic
+		 * error code if the message is mutable because a mutable message
+		 * can't be delivered several times.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		bool
+		reschedule(
+			//! Pause before the next message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period =
+					std::chrono::steady_clock::duration::zero() );
+
 	private :
 		//! Actual timer.
 		so_5::intrusive_ptr_t< timer_t > m_timer;
@@ -120,6 +177,58 @@ namespace timer_thread
 
 } /* namespace timer_thread */
 
+//
+// timer_lateness_histogram_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Histogram of lateness of expired timers.
+ *
+ * Lateness is the difference between the time when a timer is detected
+ * as expired by timer thread and the time when it had to expire.
+ *
+ * Buckets have exponential widths: bucket 0 is for lateness less than
+ * 1us, bucket N is for lateness in [2^(N-1)us, 2^N us). The last bucket
+ * is for all greater values.
+ *
+ * \note Timers of timer_wheel and timer_hwheel are processed by time
+ * steps. Their lateness is calculated for the start of the time step,
+ * so it is always less than the granularity of the wheel for idle
+ * timer thread.
+ */
+struct SO_5_TYPE timer_lateness_histogram_t
+{
+	//! Count of buckets.
+	static const std::size_t bucket_count = 24;
+
+	//! Counts of values in every bucket.
+	std::array< std::uint64_t, bucket_count > m_buckets;
+
+	//! Upper border (exclusive) of values in a bucket.
+	/*!
+	 * \note It is std::chrono::steady_clock::duration::max() for the
+	 * last bucket.
+	 */
+	static std::chrono::steady_clock::duration
+	upper_border( std::size_t index );
+
+	//! Total count of values in the histogram.
+	std::uint64_t
+	total() const;
+
+	//! Get an estimation for a percentile.
+	/*!
+	 * \return Upper border of the bucket in which the percentile is.
+	 * Zero if the histogram is empty.
+	 */
+	std::chrono::steady_clock::duration
+	percentile(
+		//! Percentile in range [0.0, 1.0].
+		double p ) const;
+};
+
 //
 // timer_thread_stats_t
 //
@@ -128,6 +237,11 @@ namespace timer_thread
  * v.5.5.4
  *
  * \brief Statistics for run-time monitoring.
+ *
+ * \note Since v.5.5.20 there is information about work of timer thread.
+ * Histogram and counters are accumulated since the start of timer thread.
+ * Maximums are accumulated since the previous call to
+ * timer_thread_t::query_stats() and are reset by that call.
  */
 struct timer_thread_stats_t
 {
@@ -136,6 +250,75 @@ struct timer_thread_stats_t
 
 	//! Quantity of periodic timers.
 	std::size_t m_periodic_count;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Lateness of expired timers.
+	 */
+	timer_lateness_histogram_t m_lateness;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Count of time steps with at least one expired timer.
+	 *
+	 * A time step is a tick of timer_wheel and timer_hwheel or a round
+	 * of processing of expired timers for timer_list and timer_heap.
+	 * The average count of timers expired at one time step is
+	 * m_lateness.total() divided by this value.
+	 */
+	std::uint64_t m_ticks_with_expired_timers;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Max count of timers expired at one time step.
+	 */
+	std::size_t m_max_expired_per_tick;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Total time of holding the lock by timer thread.
+	 *
+	 * \note The lock is not held during execution of timers' actions.
+	 */
+	std::chrono::steady_clock::duration m_lock_hold_time;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Max time of one holding of the lock by timer thread.
+	 */
+	std::chrono::steady_clock::duration m_max_lock_hold_time;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Count of slots of timer_wheel (timer_hwheel) with at least
+	 * one timer.
+	 *
+	 * \note It is always 0 for timer_list and timer_heap.
+	 */
+	std::size_t m_occupied_slots;
+
+	/*!
+	 * \since
+	 * v.5.5.20
+	 *
+	 * \brief Max count of timers in one slot of timer_wheel
+	 * (timer_hwheel).
+	 *
+	 * \note It is always 0 for timer_list and timer_heap.
+	 */
+	std::size_t m_max_slot_occupancy;
 };
 
 //
@@ -302,6 +485,163 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer thread.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hwheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hwheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Size of the wheel at every level.
+	unsigned int wheel_size,
+	//! Count of levels.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity );
+
+/*!
+ * \brief Type of timer mechanism.
+ *
+ * \since
+ * v.5.5.20
+ */
+enum class timer_engine_t
+	{
+		//! timer_wheel mechanism.
+		wheel,
+		//! timer_list mechanism.
+		list,
+		//! timer_heap mechanism.
+		heap,
+		//! hierarchical timer_wheel mechanism.
+		hwheel
+	};
+
+/*!
+ * \brief Create timer thread which receives new timers via lock-free inbox.
+ *
+ * Scheduling of a timer is just a push to the lock-free inbox. Timer
+ * thread handles the content of the inbox before processing of expired
+ * timers. The lock of timer thread is acquired by the caller only if
+ * timer thread must be woken up earlier because of the new timer.
+ *
+ * Cancellation of a timer is performed under the lock because
+ * timer_id_t::release() must destroy the timer's message on return.
+ *
+ * \note Default parameters will be used for the timer mechanism.
+ *
+ * \note A timer is not counted in query_stats() until timer thread handles
+ * the content of the inbox.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_thread_with_inbox(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Timer mechanism to be used.
+	timer_engine_t engine );
+
+/*!
+ * \brief Create timer thread which coalesces wakeups for close timers.
+ *
+ * Timer thread wakes up only at time points which are multiples of
+ * \a slack. All timers with deadlines between two such points are
+ * processed at one wakeup, one after another. A timer can be fired later
+ * than its deadline, but not more than \a slack.
+ *
+ * This reduces the count of wakeups and context switches of timer thread
+ * if there are many timers with close but different deadlines.
+ *
+ * Messages from all timers processed at one wakeup are delivered
+ * together: all messages for the same mbox are passed to it by one
+ * operation (e.g. a message chain is locked only once for them).
+ * The order of messages for every mbox is kept.
+ *
+ * \note Default parameters will be used for the timer mechanism.
+ *
+ * \throw so_5::exception_t if \a slack is negative.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_coalescing_timer_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Timer mechanism to be used.
+	timer_engine_t engine,
+	//! Max allowed delay for timers.
+	//! Zero means that timers are fired exactly at their deadlines.
+	std::chrono::steady_clock::duration slack );
+
+/*!
+ * \brief Create timer thread which waits on Linux timerfd.
+ *
+ * Timer thread sleeps in epoll_wait() on timerfd which is armed with
+ * absolute CLOCK_MONOTONIC deadline of the nearest timer. Timer thread
+ * is woken up for earlier timers via eventfd.
+ *
+ * This gives less wakeup jitter under high load than waiting on
+ * std::condition_variable.
+ *
+ * \note Default parameters will be used for the timer mechanism.
+ *
+ * \throw so_5::exception_t with rc_timerfd_not_supported error code
+ * on platforms other than Linux.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timerfd_timer_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Timer mechanism to be used.
+	timer_engine_t engine );
+
+/*!
+ * \brief Create timer thread which distributes timers between several
+ * independent timer threads.
+ *
+ * Every shard is created by \a shard_factory and has its own lock.
+ * A shard for a new timer is selected by the ID of the caller's thread.
+ * It reduces contention when many worker threads schedule and cancel
+ * timers at the same time.
+ *
+ * Statistics for run-time monitoring are aggregated from all shards.
+ *
+ * \throw so_5::exception_t if \a shards is zero.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of shards.
+	std::size_t shards,
+	//! Factory for creation of every shard.
+	const timer_thread_factory_t & shard_factory );
 /*!
  * \}
  */
@@ -396,6 +736,158 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with default
+ * parameters.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+timer_hwheel_factory()
+	{
+		// Use this trick because create_timer_hwheel_thread is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hwheel_thread;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+timer_hwheel_factory(
+	//! Size of the wheel at every level.
+	unsigned int wheel_size,
+	//! Count of levels.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hwheel_thread is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hwheel_thread;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, wheel_size, levels, granularity );
+	}
+
+/*!
+ * \brief Factory for timer thread with lock-free inbox.
+ *
+ * Usage example:
+ * \code
+	so_5::launch( ...,
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timer_with_inbox_factory() );
+		} );
+ * \endcode
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+timer_with_inbox_factory(
+	//! Timer mechanism to be used.
+	timer_engine_t engine = timer_engine_t::heap )
+	{
+		using namespace std::placeholders;
+
+		return std::bind( &create_timer_thread_with_inbox, _1, engine );
+	}
+
+/*!
+ * \brief Factory for timer thread with coalescing of wakeups.
+ *
+ * Usage example:
+ * \code
+	so_5::launch( ...,
+		[]( so_5::environment_params_t & params ) {
+			// Timers can be fired up to 1ms later than their deadlines.
+			params.timer_thread( so_5::coalescing_timer_factory(
+					std::chrono::milliseconds(1) ) );
+		} );
+ * \endcode
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+coalescing_timer_factory(
+	//! Max allowed delay for timers.
+	std::chrono::steady_clock::duration slack,
+	//! Timer mechanism to be used.
+	timer_engine_t engine = timer_engine_t::heap )
+	{
+		using namespace std::placeholders;
+
+		return std::bind( &create_coalescing_timer_thread, _1, engine, slack );
+	}
+
+/*!
+ * \brief Factory for timer thread which waits on Linux timerfd.
+ *
+ * Usage example:
+ * \code
+	so_5::launch( ...,
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timerfd_timer_factory() );
+		} );
+ * \endcode
+ *
+ * \note Available on Linux only. Creation of timer thread fails
+ * on other platforms.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+timerfd_timer_factory(
+	//! Timer mechanism to be used.
+	timer_engine_t engine = timer_engine_t::heap )
+	{
+		using namespace std::placeholders;
+
+		return std::bind( &create_timerfd_timer_thread, _1, engine );
+	}
+
+/*!
+ * \brief Factory for sharded timer thread.
+ *
+ * Usage example:
+ * \code
+	so_5::launch( ...,
+		[]( so_5::environment_params_t & params ) {
+			// Four timer_heap threads will be used.
+			params.timer_thread( so_5::sharded_timer_factory( 4 ) );
+		} );
+ * \endcode
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_factory_t
+sharded_timer_factory(
+	//! Count of shards.
+	std::size_t shards,
+	//! Factory for creation of every shard.
+	timer_thread_factory_t shard_factory = timer_heap_factory() )
+	{
+		return [shards, shard_factory]( error_logger_shptr_t logger ) {
+				return create_sharded_timer_thread(
+						std::move( logger ), shards, shard_factory );
+			};
+	}
 /*!
  * \}
  */
@@ -636,6 +1128,42 @@ create_timer_list_manager(
 	//! A collector for elapsed timers.
 	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
 		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hwheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.20
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hwheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector,
+	//! Size of the wheel at every level.
+	unsigned int wheel_size,
+	//! Count of levels.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -743,6 +1271,56 @@ timer_list_manager_factory()
 	{
 		return &create_timer_list_manager;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with default
+ * parameters.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_manager_factory_t
+timer_hwheel_manager_factory()
+	{
+		// Use this trick because create_timer_hwheel_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t > ) =
+				create_timer_hwheel_manager;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_manager_factory_t
+timer_hwheel_manager_factory(
+	//! Size of the wheel at every level.
+	unsigned int wheel_size,
+	//! Count of levels.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hwheel_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t >,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hwheel_manager;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, _2, wheel_size, levels, granularity );
+	}
 /*!
  * \}
  */
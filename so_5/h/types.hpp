@@ -76,5 +76,21 @@ enum class work_thread_activity_tracking_t
 		on
 	};
 
+/*!
+ * \brief Values for collecting statistics of event handlers.
+ *
+ * \since
+ * v.5.5.20
+ */
+enum class event_handler_stats_t
+	{
+		//! Statistics are not collected.
+		off,
+		//! Statistics are collected for every agent separately.
+		per_agent,
+		//! Statistics are collected for all agents of a cooperation.
+		per_coop
+	};
+
 } /* namespace so_5 */
 
@@ -4,8 +4,14 @@
 
 #include <so_5/h/msg_tracing.hpp>
 
+#include <so_5/rt/h/state.hpp>
+
+#include <so_5/details/h/ios_helpers.hpp>
+
+#include <algorithm>
 #include <mutex>
 #include <iostream>
+#include <sstream>
 
 namespace so_5 {
 
@@ -16,13 +22,360 @@ namespace msg_tracing {
 //
 
 tracer_t::tracer_t()
+	:	m_has_sampling( false )
 	{}
 
 tracer_t::~tracer_t()
 	{}
 
+void
+tracer_t::trace_record( const trace_record_t & record ) SO_5_NOEXCEPT
+	{
+		trace( to_text( record ) );
+	}
+
+bool
+tracer_t::needs_timestamps() const SO_5_NOEXCEPT
+	{
+		return false;
+	}
+
+//
+// sampling_t
+//
+sampling_t::sampling_t()
+	:	m_one_of( 1u )
+	{}
+
+sampling_t &
+sampling_t::one_of( unsigned int n )
+	{
+		m_one_of = n ? n : 1u;
+		return *this;
+	}
+
+sampling_t &
+sampling_t::message_type( const std::type_index & type )
+	{
+		m_types.push_back( type );
+		return *this;
+	}
+
+sampling_t &
+sampling_t::mbox_id( mbox_id_t id )
+	{
+		m_mboxes.push_back( id );
+		return *this;
+	}
+
+sampling_t &
+sampling_t::agent( const agent_t & agent )
+	{
+		m_agents.push_back( &agent );
+		return *this;
+	}
+
+bool
+sampling_t::select_message(
+	const std::type_index & msg_type,
+	mbox_id_t mbox_id ) const SO_5_NOEXCEPT
+	{
+		if( !m_types.empty() && m_types.end() ==
+				std::find( m_types.begin(), m_types.end(), msg_type ) )
+			return false;
+
+		if( !m_mboxes.empty() && m_mboxes.end() ==
+				std::find( m_mboxes.begin(), m_mboxes.end(), mbox_id ) )
+			return false;
+
+		if( 1u != m_one_of )
+			{
+				// The counter is not shared between threads. It allows to
+				// avoid contention between senders.
+				static thread_local unsigned int counter = 0u;
+				return 0u == counter++ % m_one_of;
+			}
+
+		return true;
+	}
+
+bool
+sampling_t::select_agent( const agent_t * agent ) const SO_5_NOEXCEPT
+	{
+		return !agent || m_agents.empty() || m_agents.end() !=
+				std::find( m_agents.begin(), m_agents.end(), agent );
+	}
+
+bool
+tracer_t::select_message(
+	const std::type_index & msg_type,
+	mbox_id_t mbox_id ) const SO_5_NOEXCEPT
+	{
+		read_lock_guard_t< default_rw_spinlock_t > lock{ m_sampling_lock };
+		return !m_sampling || m_sampling->select_message( msg_type, mbox_id );
+	}
+
+bool
+tracer_t::select_agent( const agent_t * agent ) const SO_5_NOEXCEPT
+	{
+		read_lock_guard_t< default_rw_spinlock_t > lock{ m_sampling_lock };
+		return !m_sampling || m_sampling->select_agent( agent );
+	}
+
+sampling_t
+tracer_t::current_sampling() const
+	{
+		read_lock_guard_t< default_rw_spinlock_t > lock{ m_sampling_lock };
+		return m_sampling ? *m_sampling : sampling_t{};
+	}
+
+void
+tracer_t::change_sampling( sampling_t rules )
+	{
+		std::unique_ptr< sampling_t > actual{
+				new sampling_t( std::move( rules ) ) };
+
+		{
+			std::lock_guard< default_rw_spinlock_t > lock{ m_sampling_lock };
+			m_sampling.swap( actual );
+		}
+		m_has_sampling.store( true, std::memory_order_release );
+
+		// Previous rules are destroyed here outside of the lock.
+	}
+
+//
+// action_name
+//
+SO_5_FUNC const char *
+action_name( action_t action )
+	{
+		switch( action )
+			{
+			case action_t::no_subscribers: return "no_subscribers";
+			case action_t::push_to_queue: return "push_to_queue";
+			case action_t::message_rejected: return "message_rejected";
+			case action_t::overlimit_abort: return "overlimit.abort";
+			case action_t::overlimit_drop: return "overlimit.drop";
+			case action_t::overlimit_redirect: return "overlimit.redirect";
+			case action_t::overlimit_transform: return "overlimit.transform";
+			case action_t::find_handler: return "find_handler";
+			case action_t::state_leaving: return "leaving";
+			case action_t::state_entering: return "entering";
+			case action_t::mchain_stored: return "stored";
+			case action_t::mchain_extracted: return "extracted";
+			case action_t::mchain_dropped_on_close: return "dropped_on_close";
+			case action_t::mchain_overflow_drop_newest:
+				return "overflow.drop_newest";
+			case action_t::mchain_overflow_remove_oldest:
+				return "overflow.remove_oldest";
+			case action_t::mchain_conflated: return "conflated";
+			case action_t::mchain_overflow_throw_exception:
+				return "overflow.throw_exception";
+			case action_t::mchain_overflow_abort_app:
+				return "overflow.abort_app";
+			}
+
+		return "unknown";
+	}
+
+//
+// to_text
+//
+
+namespace impl {
+
+using namespace so_5::details::ios_helpers;
+
+void
+message_to_text( std::ostream & s, const message_info_t & msg )
+	{
+		s << "[msg_type=" << msg.m_type.name() << "]";
+
+		if( msg.m_envelope )
+			s << "[envelope_ptr=" << pointer{ msg.m_envelope } << "]";
+		if( msg.m_payload )
+			s << "[payload_ptr=" << pointer{ msg.m_payload } << "]";
+		else
+			s << "[signal]";
+		if( msg.m_mutable )
+			s << "[mutable]";
+	}
+
+void
+agent_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		s << "[agent_ptr=" << pointer{ r.m_agent } << "]";
+	}
+
+void
+action_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		s << " " << r.m_operation << "." << action_name( r.m_action ) << " ";
+	}
+
+//! Description of actions of mboxes.
+void
+mbox_action_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		s << "[mbox_id=" << r.m_mbox_id << "]";
+		action_to_text( s, r );
+		message_to_text( s, r.m_message );
+		s << "[overlimit_deep=" << r.m_overlimit_deep << "]";
+
+		if( action_t::no_subscribers != r.m_action )
+			agent_to_text( s, r );
+
+		if( action_t::overlimit_redirect == r.m_action ||
+				action_t::overlimit_transform == r.m_action )
+			{
+				s << " ==> [mbox_id=" << r.m_target_mbox_id << "]";
+				if( action_t::overlimit_transform == r.m_action )
+					message_to_text( s, r.m_second_message );
+			}
+	}
+
+//! Description of the result of event handler search.
+void
+find_handler_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		agent_to_text( s, r );
+		action_to_text( s, r );
+		s << "[mbox_id=" << r.m_mbox_id << "]";
+		message_to_text( s, r.m_message );
+		s << "[state=" << r.m_state->query_name() << "]";
+
+		s << "[evt_handler=";
+		if( r.m_event_handler )
+			s << pointer{ r.m_event_handler };
+		else
+			s << "NONE";
+		s << "]";
+	}
+
+//! Description of changes of agent's state.
+void
+state_change_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		agent_to_text( s, r );
+		action_to_text( s, r );
+		s << "[state=" << r.m_state->query_name() << "]";
+	}
+
+//! Description of actions of mchains.
+void
+mchain_action_to_text( std::ostream & s, const trace_record_t & r )
+	{
+		s << "[mchain_id=" << r.m_mbox_id << "]";
+		action_to_text( s, r );
+		message_to_text( s, r.m_message );
+
+		if( action_t::mchain_stored == r.m_action )
+			s << "[chain_size=" << r.m_chain_size << "]";
+		else if( action_t::mchain_overflow_remove_oldest == r.m_action )
+			{
+				s << " removed: ";
+				message_to_text( s, r.m_second_message );
+			}
+		else if( action_t::mchain_conflated == r.m_action )
+			{
+				s << " replaced: ";
+				message_to_text( s, r.m_second_message );
+			}
+	}
+
+} /* namespace impl */
+
+SO_5_FUNC std::string
+to_text( const trace_record_t & record )
+	{
+		std::ostringstream s;
+
+		s << "[tid=" << record.m_thread_id << "]";
+
+		switch( record.m_action )
+			{
+			case action_t::no_subscribers:
+			case action_t::push_to_queue:
+			case action_t::message_rejected:
+			case action_t::overlimit_abort:
+			case action_t::overlimit_drop:
+			case action_t::overlimit_redirect:
+			case action_t::overlimit_transform:
+				impl::mbox_action_to_text( s, record );
+			break;
+
+			case action_t::find_handler:
+				impl::find_handler_to_text( s, record );
+			break;
+
+			case action_t::state_leaving:
+			case action_t::state_entering:
+				impl::state_change_to_text( s, record );
+			break;
+
+			default:
+				impl::mchain_action_to_text( s, record );
+			}
+
+		return s.str();
+	}
+
 namespace impl {
 
+//
+// filtered_tracer_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A tracer which passes only accepted records to the actual tracer.
+ */
+class filtered_tracer_t : public tracer_t
+	{
+	public :
+		filtered_tracer_t(
+			filter_t filter,
+			tracer_unique_ptr_t actual_tracer )
+			:	m_filter( std::move( filter ) )
+			,	m_actual_tracer( std::move( actual_tracer ) )
+			{
+				if( m_actual_tracer->has_sampling() )
+					change_sampling( m_actual_tracer->current_sampling() );
+			}
+
+		virtual void
+		trace( const std::string & what ) SO_5_NOEXCEPT override
+			{
+				m_actual_tracer->trace( what );
+			}
+
+		virtual void
+		trace_record( const trace_record_t & record ) SO_5_NOEXCEPT override
+			{
+				if( m_filter( record ) )
+					{
+						if( m_actual_tracer->needs_timestamps() )
+							{
+								// The timestamp is set only for accepted records.
+								trace_record_t stamped = record;
+								stamped.m_timestamp = std::chrono::steady_clock::now();
+								m_actual_tracer->trace_record( stamped );
+							}
+						else
+							m_actual_tracer->trace_record( record );
+					}
+			}
+
+	private :
+		//! Filter for records.
+		const filter_t m_filter;
+
+		//! Tracer for accepted records.
+		const tracer_unique_ptr_t m_actual_tracer;
+	};
+
 //
 // std_stream_tracer_t
 //
@@ -65,6 +418,33 @@ class std_stream_tracer_t : public tracer_t
 
 } /* namespace impl */
 
+//
+// make_filtered_tracer
+//
+
+SO_5_FUNC tracer_unique_ptr_t
+make_filtered_tracer(
+	filter_t filter,
+	tracer_unique_ptr_t actual_tracer )
+	{
+		return tracer_unique_ptr_t{
+				new impl::filtered_tracer_t{
+						std::move( filter ), std::move( actual_tracer ) } };
+	}
+
+//
+// make_sampled_tracer
+//
+
+SO_5_FUNC tracer_unique_ptr_t
+make_sampled_tracer(
+	sampling_t sampling,
+	tracer_unique_ptr_t actual_tracer )
+	{
+		actual_tracer->change_sampling( std::move( sampling ) );
+		return actual_tracer;
+	}
+
 //
 // Standard stream tracers.
 //
@@ -0,0 +1,818 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Flight recorder for message delivery tracing.
+ */
+
+#include <so_5/h/msg_tracing.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace so_5 {
+
+namespace msg_tracing {
+
+namespace flight_recorder_details {
+
+//! Signature at the beginning of a dump.
+const char dump_signature[] = { 'S', 'O', '5', 'F', 'R', 'E', 'C', '1' };
+
+static_assert( std::is_trivially_copyable< trace_record_t >::value,
+		"trace_record_t is stored by memcpy" );
+
+//! Count of words in a stored record.
+const std::size_t record_words =
+		( sizeof( trace_record_t ) + sizeof( std::uint64_t ) - 1u ) /
+		sizeof( std::uint64_t );
+
+//! Type of storage for one word of a record.
+/*!
+ * Records are stored and read by words with relaxed atomic operations.
+ * It allows to read a record while it is being overwritten by the owner
+ * thread without data race. The result of such reading is dropped.
+ */
+using record_word_t = std::atomic< std::uint64_t >;
+
+//! Store a record into words.
+inline void
+store_record( record_word_t * to, const trace_record_t & record ) SO_5_NOEXCEPT
+	{
+		std::uint64_t words[ record_words ] = {};
+		std::memcpy( words, &record, sizeof( record ) );
+
+		for( std::size_t i = 0; i != record_words; ++i )
+			to[ i ].store( words[ i ], std::memory_order_relaxed );
+	}
+
+//! Read a record from words.
+inline trace_record_t
+load_record( const record_word_t * from ) SO_5_NOEXCEPT
+	{
+		std::uint64_t words[ record_words ];
+		for( std::size_t i = 0; i != record_words; ++i )
+			words[ i ] = from[ i ].load( std::memory_order_relaxed );
+
+		trace_record_t record{};
+		std::memcpy( &record, words, sizeof( record ) );
+
+		return record;
+	}
+
+//
+// thread_buffer_t
+//
+/*!
+ * \brief Ring buffer of one thread.
+ *
+ * Only the owner thread writes records. Dumping thread reads them
+ * and checks the counter of written records after reading. Records
+ * which could be overwritten during reading are dropped.
+ *
+ * The buffer is released when the owner thread finishes. A released
+ * buffer keeps its records and can be taken by a new thread.
+ */
+struct thread_buffer_t
+	{
+		//! Slot is not used yet.
+		static const int free_slot = 0;
+		//! Slot is being taken by a thread.
+		static const int taking = 1;
+		//! Slot has the owner and the buffer.
+		static const int owned = 2;
+		//! The owner of slot is finished.
+		static const int released = 3;
+
+		std::atomic< int > m_state{ free_slot };
+
+		//! Words of records.
+		/*!
+		 * It is nullptr if the buffer can't be allocated.
+		 *
+		 * It is set only once when the slot is taken from free state.
+		 */
+		std::unique_ptr< record_word_t[] > m_words;
+
+		//! Total count of records which writing was started.
+		std::atomic< std::uint64_t > m_started{ 0 };
+
+		//! Total count of records written.
+		std::atomic< std::uint64_t > m_written{ 0 };
+
+		//! Release the slot of a finished thread.
+		void
+		release() SO_5_NOEXCEPT
+			{
+				m_state.store( released, std::memory_order_release );
+			}
+	};
+
+//
+// thread_buffers_t
+//
+/*!
+ * \brief Buffers of the current thread in all flight recorders.
+ *
+ * It is a thread local object. It allows to find the buffer without
+ * scanning of slots of a recorder. Buffers are released when the
+ * thread finishes.
+ */
+class thread_buffers_t
+	{
+		struct item_t
+			{
+				std::uint64_t m_recorder_id;
+				//! Internals of the recorder which own the buffer.
+				std::weak_ptr< void > m_recorder;
+				thread_buffer_t * m_buffer;
+			};
+
+	public :
+		~thread_buffers_t()
+			{
+				for( auto & item : m_items )
+					// The recorder can be destroyed already.
+					if( auto recorder = item.m_recorder.lock() )
+						item.m_buffer->release();
+			}
+
+		//! Find the buffer of the current thread in the recorder.
+		/*!
+		 * \return nullptr if the thread has no buffer in the recorder.
+		 */
+		thread_buffer_t *
+		find( std::uint64_t recorder_id ) const SO_5_NOEXCEPT
+			{
+				// The last used recorder is checked first.
+				if( m_last && m_last->m_recorder_id == recorder_id )
+					return m_last->m_buffer;
+
+				for( const auto & item : m_items )
+					if( item.m_recorder_id == recorder_id )
+						{
+							m_last = &item;
+							return item.m_buffer;
+						}
+
+				return nullptr;
+			}
+
+		//! Remember the buffer of the current thread in the recorder.
+		/*!
+		 * Items for destroyed recorders are removed.
+		 */
+		void
+		add(
+			std::uint64_t recorder_id,
+			std::weak_ptr< void > recorder,
+			thread_buffer_t & buffer )
+			{
+				m_last = nullptr;
+				m_items.erase(
+						std::remove_if( m_items.begin(), m_items.end(),
+								[]( const item_t & item ) {
+									return item.m_recorder.expired();
+								} ),
+						m_items.end() );
+
+				m_items.push_back( item_t{
+						recorder_id, std::move( recorder ), &buffer } );
+			}
+
+	private :
+		std::vector< item_t > m_items;
+
+		//! The last found item.
+		mutable const item_t * m_last = nullptr;
+	};
+
+//! Buffers of the current thread.
+thread_buffers_t &
+current_thread_buffers()
+	{
+		static thread_local thread_buffers_t buffers;
+		return buffers;
+	}
+
+//
+// write_value
+//
+template< typename T >
+void
+write_value( std::ostream & to, const T & v )
+	{
+		to.write( reinterpret_cast< const char * >( &v ), sizeof( v ) );
+	}
+
+//
+// read_value
+//
+template< typename T >
+T
+read_value( std::istream & from )
+	{
+		T v{};
+		from.read( reinterpret_cast< char * >( &v ), sizeof( v ) );
+		if( !from )
+			SO_5_THROW_EXCEPTION( rc_msg_tracing_dump_failure,
+					"unexpected end of flight recorder dump" );
+
+		return v;
+	}
+
+inline std::uint64_t
+pointer_value( const void * p )
+	{
+		return static_cast< std::uint64_t >(
+				reinterpret_cast< std::uintptr_t >( p ) );
+	}
+
+//
+// dumped_message_t
+//
+//! Description of a message read from a dump.
+struct dumped_message_t
+	{
+		std::uint64_t m_type_name;
+		std::uint64_t m_envelope;
+		std::uint64_t m_payload;
+		std::uint8_t m_mutable;
+	};
+
+//
+// dumped_record_t
+//
+//! Trace record read from a dump.
+struct dumped_record_t
+	{
+		std::uint64_t m_thread;
+		std::int64_t m_timestamp;
+		std::uint8_t m_action;
+		std::uint64_t m_operation;
+		std::uint64_t m_mbox_id;
+		dumped_message_t m_message;
+		std::uint64_t m_agent;
+		std::uint64_t m_state;
+		std::uint64_t m_event_handler;
+		std::uint32_t m_overlimit_deep;
+		std::uint64_t m_target_mbox_id;
+		dumped_message_t m_second_message;
+		std::uint64_t m_chain_size;
+	};
+
+//! Name of the message type or nullptr if there is no message.
+/*!
+ * The name has static storage duration. So its pointer is used as
+ * a key in the table of strings.
+ */
+inline const char *
+type_name( const message_info_t & msg )
+	{
+		return msg.empty() ? nullptr : msg.m_type.name();
+	}
+
+void
+write_message( std::ostream & to, const message_info_t & msg )
+	{
+		write_value( to, pointer_value( type_name( msg ) ) );
+		write_value( to, pointer_value( msg.m_envelope ) );
+		write_value( to, pointer_value( msg.m_payload ) );
+		write_value( to, static_cast< std::uint8_t >( msg.m_mutable ) );
+	}
+
+dumped_message_t
+read_message( std::istream & from )
+	{
+		dumped_message_t msg;
+		msg.m_type_name = read_value< std::uint64_t >( from );
+		msg.m_envelope = read_value< std::uint64_t >( from );
+		msg.m_payload = read_value< std::uint64_t >( from );
+		msg.m_mutable = read_value< std::uint8_t >( from );
+
+		return msg;
+	}
+
+void
+write_record( std::ostream & to, const trace_record_t & r )
+	{
+		write_value( to, static_cast< std::int64_t >(
+				std::chrono::duration_cast< std::chrono::nanoseconds >(
+						r.m_timestamp.time_since_epoch() ).count() ) );
+		write_value( to, static_cast< std::uint8_t >( r.m_action ) );
+		write_value( to, pointer_value( r.m_operation ) );
+		write_value( to, static_cast< std::uint64_t >( r.m_mbox_id ) );
+		write_message( to, r.m_message );
+		write_value( to, pointer_value( r.m_agent ) );
+		write_value( to, pointer_value( r.m_state ) );
+		write_value( to, pointer_value( r.m_event_handler ) );
+		write_value( to, static_cast< std::uint32_t >( r.m_overlimit_deep ) );
+		write_value( to, static_cast< std::uint64_t >( r.m_target_mbox_id ) );
+		write_message( to, r.m_second_message );
+		write_value( to, static_cast< std::uint64_t >( r.m_chain_size ) );
+	}
+
+dumped_record_t
+read_record( std::istream & from, std::uint64_t thread )
+	{
+		dumped_record_t r;
+		r.m_thread = thread;
+		r.m_timestamp = read_value< std::int64_t >( from );
+		r.m_action = read_value< std::uint8_t >( from );
+		r.m_operation = read_value< std::uint64_t >( from );
+		r.m_mbox_id = read_value< std::uint64_t >( from );
+		r.m_message = read_message( from );
+		r.m_agent = read_value< std::uint64_t >( from );
+		r.m_state = read_value< std::uint64_t >( from );
+		r.m_event_handler = read_value< std::uint64_t >( from );
+		r.m_overlimit_deep = read_value< std::uint32_t >( from );
+		r.m_target_mbox_id = read_value< std::uint64_t >( from );
+		r.m_second_message = read_message( from );
+		r.m_chain_size = read_value< std::uint64_t >( from );
+
+		return r;
+	}
+
+//! Helper for printing of pointer values from a dump.
+struct hex_value
+	{
+		std::uint64_t m_value;
+	};
+
+inline std::ostream &
+operator<<( std::ostream & to, hex_value v )
+	{
+		return to << "0x" << std::hex << v.m_value << std::dec;
+	}
+
+//! Type of table of strings from a dump.
+using strings_t = std::map< std::uint64_t, std::string >;
+
+const char *
+find_string( const strings_t & strings, std::uint64_t key )
+	{
+		auto it = strings.find( key );
+		return strings.end() != it ? it->second.c_str() : "?";
+	}
+
+void
+print_message(
+	std::ostream & to,
+	const strings_t & strings,
+	const dumped_message_t & msg )
+	{
+		to << "[msg_type=" << find_string( strings, msg.m_type_name ) << "]";
+
+		if( msg.m_envelope )
+			to << "[envelope_ptr=" << hex_value{ msg.m_envelope } << "]";
+		if( msg.m_payload )
+			to << "[payload_ptr=" << hex_value{ msg.m_payload } << "]";
+		else
+			to << "[signal]";
+		if( msg.m_mutable )
+			to << "[mutable]";
+	}
+
+void
+print_record(
+	std::ostream & to,
+	const strings_t & strings,
+	std::int64_t first_timestamp,
+	const dumped_record_t & r )
+	{
+		const auto action = static_cast< action_t >( r.m_action );
+
+		to << "[time=+" << ( r.m_timestamp - first_timestamp ) << "ns]"
+			<< "[thread=" << r.m_thread << "] "
+			<< find_string( strings, r.m_operation ) << "."
+			<< action_name( action ) << " ";
+
+		if( action_t::state_leaving != action &&
+				action_t::state_entering != action )
+			to << "[mbox_id=" << r.m_mbox_id << "]";
+		if( r.m_agent )
+			to << "[agent_ptr=" << hex_value{ r.m_agent } << "]";
+		if( r.m_message.m_type_name )
+			print_message( to, strings, r.m_message );
+		if( r.m_state )
+			to << "[state_ptr=" << hex_value{ r.m_state } << "]";
+		if( action_t::find_handler == action )
+			{
+				to << "[evt_handler=";
+				if( r.m_event_handler )
+					to << hex_value{ r.m_event_handler };
+				else
+					to << "NONE";
+				to << "]";
+			}
+		if( r.m_overlimit_deep )
+			to << "[overlimit_deep=" << r.m_overlimit_deep << "]";
+		if( action_t::mchain_stored == action )
+			to << "[chain_size=" << r.m_chain_size << "]";
+		if( r.m_target_mbox_id )
+			to << " ==> [mbox_id=" << r.m_target_mbox_id << "]";
+		if( r.m_second_message.m_type_name )
+			{
+				to << " second: ";
+				print_message( to, strings, r.m_second_message );
+			}
+
+		to << "\n";
+	}
+
+} /* namespace flight_recorder_details */
+
+using namespace flight_recorder_details;
+
+//
+// flight_recorder_t::internals_t
+//
+struct flight_recorder_t::internals_t
+	: public std::enable_shared_from_this< internals_t >
+	{
+		internals_t(
+			std::size_t records_per_thread,
+			std::size_t max_threads )
+			:	m_id( next_id() )
+			,	m_records_per_thread( records_per_thread )
+			,	m_max_threads( max_threads )
+			,	m_buffers( new thread_buffer_t[ max_threads ] )
+			{}
+
+		//! Unique ID of the recorder.
+		/*!
+		 * IDs are never reused. Unlike the address of the recorder it
+		 * can't point to a new recorder after the destruction of the old one.
+		 */
+		const std::uint64_t m_id;
+
+		const std::size_t m_records_per_thread;
+		const std::size_t m_max_threads;
+
+		std::unique_ptr< thread_buffer_t[] > m_buffers;
+
+		std::atomic< std::size_t > m_lost{ 0 };
+
+		static std::uint64_t
+		next_id() SO_5_NOEXCEPT
+			{
+				static std::atomic< std::uint64_t > counter{ 0 };
+				return ++counter;
+			}
+
+		//! Find or take the buffer of the current thread.
+		/*!
+		 * \return nullptr if there is no buffer for the current thread.
+		 */
+		thread_buffer_t *
+		buffer_for_current_thread() SO_5_NOEXCEPT;
+
+		//! Take a free slot or a slot of a finished thread.
+		thread_buffer_t *
+		take_buffer() SO_5_NOEXCEPT
+			{
+				for( std::size_t i = 0; i != m_max_threads; ++i )
+					{
+						auto & b = m_buffers[ i ];
+						int state = thread_buffer_t::free_slot;
+						if( b.m_state.compare_exchange_strong(
+								state, thread_buffer_t::taking,
+								std::memory_order_acq_rel ) )
+							{
+								b.m_words.reset( new(std::nothrow)
+										record_word_t[
+												m_records_per_thread * record_words ] );
+								b.m_state.store(
+										thread_buffer_t::owned,
+										std::memory_order_release );
+
+								return &b;
+							}
+					}
+
+				// There are no free slots. A slot of a finished thread
+				// is reused. Its counters are not reset because the slot
+				// can be dumped at the same time.
+				for( std::size_t i = 0; i != m_max_threads; ++i )
+					{
+						auto & b = m_buffers[ i ];
+						int state = thread_buffer_t::released;
+						if( b.m_state.compare_exchange_strong(
+								state, thread_buffer_t::owned,
+								std::memory_order_acq_rel ) )
+							return &b;
+					}
+
+				return nullptr;
+			}
+
+	};
+
+thread_buffer_t *
+flight_recorder_t::internals_t::buffer_for_current_thread() SO_5_NOEXCEPT
+	{
+		auto & buffers = current_thread_buffers();
+		if( auto b = buffers.find( m_id ) )
+			return b;
+
+		auto b = take_buffer();
+		if( b )
+			try
+				{
+					buffers.add( m_id, shared_from_this(), *b );
+				}
+			catch( ... )
+				{
+					// The buffer can't be released at the end of the thread.
+					// So it is released right now.
+					b->release();
+					b = nullptr;
+				}
+
+		return b;
+	}
+
+//
+// flight_recorder_t
+//
+flight_recorder_t::flight_recorder_t(
+	std::size_t records_per_thread,
+	std::size_t max_threads )
+	:	m_impl( std::make_shared< internals_t >(
+				std::max< std::size_t >( 1u, records_per_thread ),
+				max_threads ) )
+	{}
+
+flight_recorder_t::~flight_recorder_t()
+	{}
+
+void
+flight_recorder_t::store( const trace_record_t & record ) SO_5_NOEXCEPT
+	{
+		auto b = m_impl->buffer_for_current_thread();
+		if( !b || !b->m_words )
+			{
+				m_impl->m_lost.fetch_add( 1u, std::memory_order_relaxed );
+				return;
+			}
+
+		// Only the current thread modifies the counters.
+		const auto n = b->m_written.load( std::memory_order_relaxed );
+		b->m_started.store( n + 1u, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+
+		store_record(
+				&b->m_words[ ( n % m_impl->m_records_per_thread ) * record_words ],
+				record );
+
+		b->m_written.store( n + 1u, std::memory_order_release );
+	}
+
+void
+flight_recorder_t::dump( std::ostream & to ) const
+	{
+		const std::uint64_t capacity = m_impl->m_records_per_thread;
+
+		// Copies of records of every thread.
+		std::vector< std::vector< trace_record_t > > threads;
+		for( std::size_t i = 0; i != m_impl->m_max_threads; ++i )
+			{
+				const auto & b = m_impl->m_buffers[ i ];
+				const auto state = b.m_state.load( std::memory_order_acquire );
+				// Slots which are free or being taken right now are skipped.
+				if( thread_buffer_t::owned != state &&
+						thread_buffer_t::released != state )
+					continue;
+
+				threads.emplace_back();
+				if( !b.m_words )
+					continue;
+
+				const auto written = b.m_written.load( std::memory_order_acquire );
+				const auto first = written > capacity ? written - capacity : 0u;
+
+				auto & records = threads.back();
+				records.reserve( static_cast< std::size_t >( written - first ) );
+				for( auto n = first; n != written; ++n )
+					records.push_back( load_record(
+							&b.m_words[ ( n % capacity ) * record_words ] ) );
+
+				// Records which could be overwritten during copying
+				// must be dropped.
+				std::atomic_thread_fence( std::memory_order_acquire );
+				const auto started = b.m_started.load( std::memory_order_relaxed );
+				if( started > first + capacity )
+					{
+						const auto valid_from = started - capacity;
+						records.erase( records.begin(),
+								records.begin() + static_cast< std::ptrdiff_t >(
+									std::min( valid_from, written ) - first ) );
+					}
+			}
+
+		// Names of operations and message types have static storage
+		// duration. They are stored into the dump as a table.
+		strings_t strings;
+		auto add_string = [&strings]( const char * s ) {
+			if( s )
+				strings.emplace( pointer_value( s ), std::string{ s } );
+		};
+		for( const auto & records : threads )
+			for( const auto & r : records )
+				{
+					add_string( r.m_operation );
+					add_string( type_name( r.m_message ) );
+					add_string( type_name( r.m_second_message ) );
+				}
+
+		to.write( dump_signature, sizeof( dump_signature ) );
+		write_value( to, static_cast< std::uint64_t >( lost_records() ) );
+
+		write_value( to, static_cast< std::uint64_t >( strings.size() ) );
+		for( const auto & s : strings )
+			{
+				write_value( to, s.first );
+				write_value( to, static_cast< std::uint64_t >( s.second.size() ) );
+				to.write( s.second.data(),
+						static_cast< std::streamsize >( s.second.size() ) );
+			}
+
+		write_value( to, static_cast< std::uint64_t >( threads.size() ) );
+		for( const auto & records : threads )
+			{
+				write_value( to, static_cast< std::uint64_t >( records.size() ) );
+				for( const auto & r : records )
+					write_record( to, r );
+			}
+
+		if( !to )
+			SO_5_THROW_EXCEPTION( rc_msg_tracing_dump_failure,
+					"unable to write flight recorder dump" );
+	}
+
+void
+flight_recorder_t::dump_to_file( const std::string & file_name ) const
+	{
+		std::ofstream to( file_name, std::ios::binary | std::ios::trunc );
+		if( !to )
+			SO_5_THROW_EXCEPTION( rc_msg_tracing_dump_failure,
+					"unable to create flight recorder dump file: " + file_name );
+
+		dump( to );
+	}
+
+std::size_t
+flight_recorder_t::lost_records() const
+	{
+		return m_impl->m_lost.load( std::memory_order_relaxed );
+	}
+
+namespace impl {
+
+//
+// flight_recorder_tracer_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Tracer which stores records to a flight recorder.
+ */
+class flight_recorder_tracer_t : public tracer_t
+	{
+	public :
+		flight_recorder_tracer_t(
+			flight_recorder_shptr_t recorder,
+			std::string dump_file_name )
+			:	m_recorder( std::move( recorder ) )
+			,	m_dump_file_name( std::move( dump_file_name ) )
+			{}
+
+		~flight_recorder_tracer_t()
+			{
+				if( !m_dump_file_name.empty() )
+					try
+						{
+							m_recorder->dump_to_file( m_dump_file_name );
+						}
+					catch( ... )
+						{}
+			}
+
+		virtual void
+		trace( const std::string & ) SO_5_NOEXCEPT override
+			{
+				// Textual descriptions are not stored.
+			}
+
+		virtual void
+		trace_record( const trace_record_t & record ) SO_5_NOEXCEPT override
+			{
+				m_recorder->store( record );
+			}
+
+		virtual bool
+		needs_timestamps() const SO_5_NOEXCEPT override
+			{
+				// Records from all threads are merged by timestamps.
+				return true;
+			}
+
+	private :
+		const flight_recorder_shptr_t m_recorder;
+		const std::string m_dump_file_name;
+	};
+
+} /* namespace impl */
+
+//
+// flight_recorder_tracer
+//
+SO_5_FUNC tracer_unique_ptr_t
+flight_recorder_tracer( flight_recorder_shptr_t recorder )
+	{
+		return flight_recorder_tracer( std::move( recorder ), std::string{} );
+	}
+
+SO_5_FUNC tracer_unique_ptr_t
+flight_recorder_tracer(
+	flight_recorder_shptr_t recorder,
+	std::string dump_file_name )
+	{
+		return tracer_unique_ptr_t{
+				new impl::flight_recorder_tracer_t{
+						std::move( recorder ), std::move( dump_file_name ) } };
+	}
+
+//
+// decode_flight_recorder_dump
+//
+SO_5_FUNC void
+decode_flight_recorder_dump(
+	std::istream & from,
+	std::ostream & to )
+	{
+		char signature[ sizeof( dump_signature ) ];
+		from.read( signature, sizeof( signature ) );
+		if( !from || !std::equal( std::begin( signature ), std::end( signature ),
+				std::begin( dump_signature ) ) )
+			SO_5_THROW_EXCEPTION( rc_msg_tracing_dump_failure,
+					"it is not a flight recorder dump" );
+
+		const auto lost = read_value< std::uint64_t >( from );
+
+		strings_t strings;
+		for( auto n = read_value< std::uint64_t >( from ); n; --n )
+			{
+				const auto key = read_value< std::uint64_t >( from );
+				std::string value(
+						static_cast< std::size_t >(
+								read_value< std::uint64_t >( from ) ),
+						'\0' );
+				from.read( &value[ 0 ], static_cast< std::streamsize >(
+						value.size() ) );
+				if( !from )
+					SO_5_THROW_EXCEPTION( rc_msg_tracing_dump_failure,
+							"unexpected end of flight recorder dump" );
+
+				strings.emplace( key, std::move( value ) );
+			}
+
+		std::vector< dumped_record_t > records;
+		const auto threads = read_value< std::uint64_t >( from );
+		for( std::uint64_t thread = 0; thread != threads; ++thread )
+			for( auto n = read_value< std::uint64_t >( from ); n; --n )
+				records.push_back( read_record( from, thread ) );
+
+		std::stable_sort( records.begin(), records.end(),
+				[]( const dumped_record_t & a, const dumped_record_t & b ) {
+					return a.m_timestamp < b.m_timestamp;
+				} );
+
+		to << "threads: " << threads << ", records: " << records.size()
+			<< ", lost: " << lost << "\n";
+
+		const auto first_timestamp =
+				records.empty() ? 0 : records.front().m_timestamp;
+		for( const auto & r : records )
+			print_record( to, strings, first_timestamp, r );
+	}
+
+} /* namespace msg_tracing */
+
+} /* namespace so_5 */
@@ -39,6 +39,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		cpp_source 'timers.cpp'
 
 		cpp_source 'msg_tracing.cpp'
+		cpp_source 'msg_tracing_flight_recorder.cpp'
 
 		cpp_source 'wrapped_env.cpp'
 
@@ -50,7 +51,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 			cpp_source 'message_limit.cpp'
 
 			cpp_source 'mbox.cpp'
+			cpp_source 'routing_mbox.cpp'
+			cpp_source 'topic_mbox.cpp'
 			cpp_source 'mchain.cpp'
+			cpp_source 'mchain_consumer.cpp'
 
 			cpp_source 'event_queue.cpp'
 
@@ -84,7 +88,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'process_unhandled_exception.cpp'
 
 				cpp_source 'named_local_mbox.cpp'
+				cpp_source 'topic_space.cpp'
 				cpp_source 'mbox_core.cpp'
+				cpp_source 'mchain_spill.cpp'
+				cpp_source 'mchain_stats.cpp'
 
 				cpp_source 'coop_repository_basis.cpp'
 
@@ -101,6 +108,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'controller.cpp'
 				cpp_source 'repository.cpp'
 				cpp_source 'std_names.cpp'
+				cpp_source 'duration_histogram.cpp'
 
 				sources_root( 'impl' ) {
 					cpp_source 'std_controller.cpp'
@@ -108,6 +116,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 					cpp_source 'ds_agent_core_stats.cpp'
 					cpp_source 'ds_mbox_core_stats.cpp'
 					cpp_source 'ds_timer_thread_stats.cpp'
+					cpp_source 'ds_event_handler_stats.cpp'
 				}
 			}
 		}
@@ -10,11 +10,15 @@
 
 #include <so_5/rt/impl/h/state_listener_controller.hpp>
 #include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+#include <so_5/rt/impl/h/nested_state_handlers_table.hpp>
+#include <so_5/rt/impl/h/state_time_limits.hpp>
 #include <so_5/rt/impl/h/process_unhandled_exception.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/delivery_filter_storage.hpp>
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
 
+#include <so_5/rt/stats/impl/h/ds_event_handler_stats.hpp>
+
 #include <so_5/details/h/abort_on_fatal_error.hpp>
 
 #include <so_5/h/spinlocks.hpp>
@@ -60,6 +64,71 @@ struct working_thread_id_sentinel_t
 			}
 	};
 
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A helper class for measuring time of an event handler.
+ *
+ * Does nothing if there is no storage for statistics.
+ */
+class event_handler_meter_t
+	{
+		using clock_t = std::chrono::steady_clock;
+
+		stats::impl::event_handler_stats_storage_t * const m_stats;
+		const execution_demand_t & m_demand;
+		const clock_t::time_point m_enqueued_at;
+		const clock_t::time_point m_started_at;
+
+	public :
+		event_handler_meter_t(
+			stats::impl::event_handler_stats_storage_t * stats,
+			const execution_demand_t & demand,
+			clock_t::time_point enqueued_at )
+			:	m_stats( stats )
+			,	m_demand( demand )
+			,	m_enqueued_at( enqueued_at )
+			,	m_started_at( stats ? clock_t::now() : clock_t::time_point{} )
+			{}
+		event_handler_meter_t( const event_handler_meter_t & ) = delete;
+		event_handler_meter_t &
+		operator=( const event_handler_meter_t & ) = delete;
+
+		~event_handler_meter_t()
+			{
+				if( m_stats )
+					m_stats->register_event(
+							m_demand.m_msg_type,
+							m_enqueued_at,
+							m_started_at,
+							clock_t::now() );
+			}
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A wrapper for a message which holds time of pushing
+ * the message to event queue.
+ *
+ * It is used only if statistics of event handlers are collected
+ * for the receiver. The original message is restored before the
+ * search of an event handler.
+ */
+struct stamped_message_t final : public message_t
+	{
+		//! The original message. Can be nullptr for signals.
+		message_ref_t m_original;
+		//! Time of pushing to event queue.
+		const std::chrono::steady_clock::time_point m_enqueued_at;
+
+		stamped_message_t( std::chrono::steady_clock::time_point enqueued_at )
+			:	m_enqueued_at( enqueued_at )
+			{}
+	};
+
 /*!
  * \since
  * v.5.4.0
@@ -80,15 +149,28 @@ create_anonymous_state_name( const agent_t * agent, const state_t * st )
 //
 // state_t::time_limit_t
 //
+/*!
+ * \note Since v.5.5.20 there is no own mbox and timer for every entering
+ * into the state. The common impl::state_time_limits_t object of
+ * the agent is used instead. See the description of
+ * impl::state_time_limits_t for the details.
+ */
 struct state_t::time_limit_t
 {
-	struct timeout : public signal_t {};
+	using clock = impl::state_time_limits_t::clock;
+	using timeout = impl::state_time_limits_t::timeout;
 
 	duration_t m_limit;
 	const state_t & m_state_to_switch;
 
-	mbox_t m_unique_mbox;
-	timer_id_t m_timer;
+	//! Deadline for the current stay in the state.
+	/*!
+	 * Has sense only when the state is active.
+	 */
+	clock::time_point m_deadline;
+
+	//! Is event handler for timeout signal subscribed for the state?
+	bool m_subscribed = false;
 
 	time_limit_t(
 		duration_t limit,
@@ -100,6 +182,7 @@ struct state_t::time_limit_t
 	void
 	set_up_limit_for_agent(
 		agent_t & agent,
+		std::unique_ptr< impl::state_time_limits_t > & limits,
 		const state_t & current_state ) SO_5_NOEXCEPT
 	{
 		// Because this method is called from on_enter handler it can't
@@ -107,49 +190,132 @@ struct state_t::time_limit_t
 		// So we don't care about exception safety.
 		so_5::details::invoke_noexcept_code( [&] {
 
-			// New unique mbox is necessary for time limit.
-			m_unique_mbox = impl::internal_env_iface_t{ agent.so_environment() }
-					// A new MPSC mbox will be used for that.
-					.create_mpsc_mbox(
-							// New MPSC mbox will be directly connected to target agent.
-							&agent,
-							// Message limits will not be used.
-							nullptr );
-
-			// A subscription must be created for timeout signal.
-			agent.so_subscribe( m_unique_mbox )
-					.in( current_state )
-					.event< timeout >( [&agent, this] {
-						agent.so_change_state( m_state_to_switch );
-					} );
-
-			// Delayed timeout signal must be sent.
-			m_timer = agent.so_environment().schedule_timer< timeout >(
-					m_unique_mbox,
-					m_limit,
-					duration_t::zero() );
+			if( !limits )
+			{
+				limits.reset( new impl::state_time_limits_t() );
+
+				// One unique mbox is used for all time limits of the agent.
+				limits->m_mbox = impl::internal_env_iface_t{
+							agent.so_environment() }
+						// A new MPSC mbox will be used for that.
+						.create_mpsc_mbox(
+								// New MPSC mbox will be directly connected to
+								// target agent.
+								&agent,
+								// Message limits will not be used.
+								nullptr );
+			}
+
+			// A subscription is created only once and is kept until
+			// the time limit is dropped.
+			if( !m_subscribed )
+			{
+				auto & l = *limits;
+				agent.so_subscribe( l.m_mbox )
+						.in( current_state )
+						.event< timeout >( [&agent, &l] {
+							handle_timeout( agent, l );
+						} );
+				m_subscribed = true;
+			}
+
+			m_deadline = clock::now() + m_limit;
+			arm_timer_if_necessary( agent, *limits, m_deadline );
 		} );
 	}
 
 	void
-	drop_limit_for_agent(
+	drop_subscription(
 		agent_t & agent,
-		const state_t & current_state ) SO_5_NOEXCEPT
+		impl::state_time_limits_t * limits,
+		const state_t & current_state )
 	{
-		// Because this method is called from on_exit handler it can't
-		// throw exceptions. Any exception will lead to abort of the application.
-		// So we don't care about exception safety.
-		so_5::details::invoke_noexcept_code( [&] {
-			m_timer.release();
+		if( m_subscribed && limits )
+		{
+			agent.so_drop_subscription< timeout >(
+					limits->m_mbox, current_state );
+			m_subscribed = false;
+		}
+	}
 
-			if( m_unique_mbox )
-			{
-				// Old subscription must be removed.
-				agent.so_drop_subscription< timeout >( m_unique_mbox, current_state );
-				// Unique mbox is no more needed.
-				m_unique_mbox = mbox_t{};
-			}
-		} );
+	//! Rearm the timer if it fires later than \a deadline.
+	static void
+	arm_timer_if_necessary(
+		agent_t & agent,
+		impl::state_time_limits_t & limits,
+		clock::time_point deadline )
+	{
+		const auto now = clock::now();
+		if( limits.m_armed_for > now && limits.m_armed_for <= deadline )
+			// The timer will fire early enough.
+			return;
+
+		const duration_t pause = deadline > now ?
+				duration_t( deadline - now ) : duration_t::zero();
+
+		bool rescheduled = false;
+		try
+		{
+			rescheduled = limits.m_timer.reschedule( pause );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			// Timer thread can be implemented by user without support
+			// for rescheduling. A new timer will be used in that case.
+			if( rc_not_implemented != x.error_code() )
+				throw;
+		}
+
+		if( !rescheduled )
+			limits.m_timer = agent.so_environment().schedule_timer< timeout >(
+					limits.m_mbox,
+					pause,
+					duration_t::zero() );
+
+		limits.m_armed_for = deadline;
+	}
+
+	//! Rearm the timer for the nearest deadline of active states.
+	static void
+	arm_timer_for_nearest_deadline(
+		agent_t & agent,
+		impl::state_time_limits_t & limits )
+	{
+		const time_limit_t * nearest = nullptr;
+		for( auto s = &agent.so_current_state(); s; s = s->m_parent_state )
+			if( s->m_time_limit && ( !nearest ||
+					s->m_time_limit->m_deadline < nearest->m_deadline ) )
+				nearest = s->m_time_limit.get();
+
+		if( nearest )
+			arm_timer_if_necessary( agent, limits, nearest->m_deadline );
+	}
+
+	//! Check time limits of active states.
+	/*!
+	 * A switch is performed for the state with the earliest expired
+	 * deadline. The timer is rearmed for the remaining deadlines.
+	 */
+	static void
+	handle_timeout(
+		agent_t & agent,
+		impl::state_time_limits_t & limits )
+	{
+		// The timer has fired.
+		limits.m_armed_for = clock::time_point::min();
+
+		const auto now = clock::now();
+		const time_limit_t * expired = nullptr;
+		for( auto s = &agent.so_current_state(); s; s = s->m_parent_state )
+			if( s->m_time_limit && s->m_time_limit->m_deadline <= now &&
+					( !expired ||
+						s->m_time_limit->m_deadline < expired->m_deadline ) )
+				expired = s->m_time_limit.get();
+
+		if( expired )
+			agent.so_change_state( expired->m_state_to_switch );
+
+		arm_timer_for_nearest_deadline( agent, limits );
 	}
 };
 
@@ -374,7 +540,10 @@ state_t::time_limit(
 	if( is_active() )
 		so_5::details::do_with_rollback_on_exception(
 			[&] {
-				m_time_limit->set_up_limit_for_agent( *m_target_agent, *this );
+				m_time_limit->set_up_limit_for_agent(
+						*m_target_agent,
+						m_target_agent->m_state_time_limits,
+						*this );
 			},
 			[&] {
 				// Time limit must be dropped because it is not activated
@@ -390,7 +559,10 @@ state_t::drop_time_limit()
 {
 	if( m_time_limit )
 	{
-		m_time_limit->drop_limit_for_agent( *m_target_agent, *this );
+		m_time_limit->drop_subscription(
+				*m_target_agent,
+				m_target_agent->m_state_time_limits.get(),
+				*this );
 		m_time_limit.reset();
 	}
 
@@ -444,13 +616,10 @@ state_t::update_history_in_parent_states() const
 void
 state_t::handle_time_limit_on_enter() const
 {
-	m_time_limit->set_up_limit_for_agent( *m_target_agent, *this );
-}
-
-void
-state_t::handle_time_limit_on_exit() const
-{
-	m_time_limit->drop_limit_for_agent( *m_target_agent, *this );
+	m_time_limit->set_up_limit_for_agent(
+			*m_target_agent,
+			m_target_agent->m_state_time_limits,
+			*this );
 }
 
 //
@@ -482,6 +651,7 @@ agent_t::agent_t(
 				&agent_t::handler_finder_msg_tracing_disabled )
 	,	m_subscriptions(
 			ctx.options().query_subscription_storage_factory()( self_ptr() ) )
+	,	m_nested_state_handlers( new impl::nested_state_handlers_table_t() )
 	,	m_message_limits(
 			message_limit::impl::info_storage_t::create_if_necessary(
 				ctx.options().giveout_message_limits() ) )
@@ -504,7 +674,9 @@ agent_t::~agent_t()
 	// Sometimes it is possible that agent is destroyed without
 	// correct deregistration from SO Environment.
 	drop_all_delivery_filters();
+	m_nested_state_handlers->drop_content();
 	m_subscriptions.reset();
+	m_state_time_limits.reset();
 }
 
 void
@@ -698,6 +870,13 @@ agent_t::so_bind_to_dispatcher(
 							typeid(void),
 							message_ref_t(),
 							&agent_t::demand_handler_on_start ) );
+
+			// Events which were pushed before the binding must follow
+			// the starting demand.
+			// Time of waiting in the event queue starts now.
+			for( auto & d : m_deferred_demands )
+				queue.push( stamp_demand( std::move( d ) ) );
+			m_deferred_demands.clear();
 			
 			// Only then pointer to the queue could be stored.
 			m_event_queue = &queue;
@@ -717,6 +896,9 @@ agent_t::so_create_execution_hint(
 
 	if( is_message_demand || is_service_demand )
 		{
+			// The original message is necessary for the search of handler.
+			const auto enqueued_at = unstamp_demand( d );
+
 			// Try to find handler for the demand.
 			auto handler = d.m_receiver->m_handler_finder(
 					d, "create_execution_hint" );
@@ -725,12 +907,13 @@ agent_t::so_create_execution_hint(
 					if( handler )
 						return execution_hint_t(
 								d,
-								[handler](
+								[handler, enqueued_at](
 										execution_demand_t & demand,
 										current_thread_id_t thread_id ) {
 									process_message(
 											thread_id,
 											demand,
+											enqueued_at,
 											handler->m_method );
 								},
 								handler->m_thread_safety );
@@ -744,12 +927,13 @@ agent_t::so_create_execution_hint(
 				// different way than absence of event handler.
 				return execution_hint_t(
 						d,
-						[handler](
+						[handler, enqueued_at](
 								execution_demand_t & demand,
 								current_thread_id_t thread_id ) {
 							process_service_request(
 									thread_id,
 									demand,
+									enqueued_at,
 									std::make_pair( true, handler ) );
 						},
 						handler ? handler->m_thread_safety :
@@ -793,6 +977,12 @@ void
 agent_t::bind_to_coop( coop_t & coop )
 {
 	m_agent_coop = &coop;
+
+	auto stats = impl::internal_env_iface_t{ m_env }.
+			event_handler_stats_storage( *this );
+
+	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	m_event_handler_stats = std::move( stats );
 }
 
 void
@@ -850,6 +1040,7 @@ agent_t::create_event_subscription(
 
 	ensure_operation_is_on_working_thread( "create_event_subscription" );
 
+	m_nested_state_handlers->drop_content();
 	m_subscriptions->create_event_subscription(
 			mbox_ref,
 			msg_type,
@@ -891,6 +1082,7 @@ agent_t::do_drop_subscription(
 	// because this operation can be performed only on agent's
 	// working thread.
 
+	m_nested_state_handlers->drop_content();
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
 }
 
@@ -906,6 +1098,7 @@ agent_t::do_drop_subscription_for_all_states(
 	ensure_operation_is_on_working_thread(
 			"do_drop_subscription_for_all_states" );
 
+	m_nested_state_handlers->drop_content();
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
 }
 
@@ -920,13 +1113,14 @@ agent_t::push_event(
 
 	if( m_event_queue )
 		m_event_queue->push(
-				execution_demand_t(
-					this,
-					limit,
-					mbox_id,
-					msg_type,
-					message,
-					&agent_t::demand_handler_on_message ) );
+				stamp_demand(
+					execution_demand_t(
+						this,
+						limit,
+						mbox_id,
+						msg_type,
+						message,
+						&agent_t::demand_handler_on_message ) ) );
 }
 
 void
@@ -940,13 +1134,82 @@ agent_t::push_service_request(
 
 	if( m_event_queue )
 		m_event_queue->push(
-				execution_demand_t(
+				stamp_demand(
+					execution_demand_t(
 						this,
 						limit,
 						mbox_id,
 						msg_type,
 						message,
-						&agent_t::service_request_handler_on_message ) );
+						&agent_t::service_request_handler_on_message ) ) );
+}
+
+void
+agent_t::push_deferrable_event(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	std::type_index msg_type,
+	const message_ref_t & message )
+{
+	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	execution_demand_t demand(
+			this,
+			limit,
+			mbox_id,
+			msg_type,
+			message,
+			&agent_t::demand_handler_on_message );
+
+	// Deferred demands will be stamped when they are pushed
+	// to the event queue.
+	if( m_event_queue )
+		m_event_queue->push( stamp_demand( std::move( demand ) ) );
+	else
+		m_deferred_demands.push_back( std::move( demand ) );
+}
+
+execution_demand_t
+agent_t::stamp_demand( execution_demand_t demand ) const SO_5_NOEXCEPT
+{
+	if( m_event_handler_stats )
+	{
+		try
+		{
+			std::unique_ptr< stamped_message_t > stamped(
+					new stamped_message_t( std::chrono::steady_clock::now() ) );
+			stamped->m_original = std::move( demand.m_message_ref );
+			demand.m_message_ref = message_ref_t( stamped.release() );
+		}
+		catch( const std::bad_alloc & )
+		{
+			// Time of waiting in the event queue will be unknown.
+		}
+	}
+
+	return demand;
+}
+
+std::chrono::steady_clock::time_point
+agent_t::unstamp_demand( execution_demand_t & d )
+{
+	// Only demands for agents with statistics can be stamped.
+	if( d.m_receiver->m_event_handler_stats )
+	{
+		auto stamped = dynamic_cast< stamped_message_t * >(
+				d.m_message_ref.get() );
+		if( stamped )
+		{
+			const auto enqueued_at = stamped->m_enqueued_at;
+			// The wrapper is destroyed here.
+			message_ref_t original = std::move( stamped->m_original );
+			d.m_message_ref = std::move( original );
+
+			return enqueued_at;
+		}
+	}
+
+	return std::chrono::steady_clock::time_point{};
 }
 
 void
@@ -1010,6 +1273,9 @@ agent_t::demand_handler_on_finish(
 
 		// Since v.5.5.15 agent should be returned in default state.
 		d.m_receiver->return_to_default_state_if_possible();
+
+		// Timer for time limits of states is no more needed.
+		d.m_receiver->m_state_time_limits.reset();
 	}
 
 	// Cooperation should receive notification about agent deregistration.
@@ -1029,10 +1295,17 @@ agent_t::demand_handler_on_message(
 {
 	message_limit::control_block_t::decrement( d.m_limit );
 
+	const auto enqueued_at = unstamp_demand( d );
+
 	auto handler = d.m_receiver->m_handler_finder(
 			d, "demand_handler_on_message" );
 	if( handler )
-		process_message( working_thread_id, d, handler->m_method );
+		process_message( working_thread_id, d, enqueued_at, handler->m_method );
+	else if( d.m_receiver->m_state_time_limits )
+		// It can be timeout signal for time limits which is ignored
+		// because there is no active state with time limit.
+		d.m_receiver->m_state_time_limits->handle_ignored_message(
+				d.m_mbox_id );
 }
 
 demand_handler_pfn_t
@@ -1048,11 +1321,14 @@ agent_t::service_request_handler_on_message(
 {
 	message_limit::control_block_t::decrement( d.m_limit );
 
+	const auto enqueued_at = unstamp_demand( d );
+
 	static const impl::event_handler_data_t * const null_handler_data = nullptr;
 
 	process_service_request(
 			working_thread_id,
 			d,
+			enqueued_at,
 			std::make_pair( false, null_handler_data ) );
 }
 
@@ -1066,12 +1342,16 @@ void
 agent_t::process_message(
 	current_thread_id_t working_thread_id,
 	execution_demand_t & d,
+	std::chrono::steady_clock::time_point enqueued_at,
 	event_handler_method_t method )
 {
 	working_thread_id_sentinel_t sentinel(
 			d.m_receiver->m_working_thread_id,
 			working_thread_id );
 
+	event_handler_meter_t meter(
+			d.m_receiver->m_event_handler_stats.get(), d, enqueued_at );
+
 	try
 	{
 		method( invocation_type_t::event, d.m_message_ref );
@@ -1087,6 +1367,7 @@ void
 agent_t::process_service_request(
 	current_thread_id_t working_thread_id,
 	execution_demand_t & d,
+	std::chrono::steady_clock::time_point enqueued_at,
 	std::pair< bool, const impl::event_handler_data_t * > handler_data )
 {
 	msg_service_request_base_t::dispatch_wrapper(
@@ -1114,6 +1395,9 @@ agent_t::process_service_request(
 				// } );
 				auto method_to_call = handler->m_method;
 
+				event_handler_meter_t meter(
+						d.m_receiver->m_event_handler_stats.get(), d, enqueued_at );
+
 				method_to_call(
 						invocation_type_t::service_request, d.m_message_ref );
 			}
@@ -1210,21 +1494,38 @@ const impl::event_handler_data_t *
 agent_t::find_event_handler_for_current_state(
 	execution_demand_t & d )
 {
-	const impl::event_handler_data_t * search_result = nullptr;
-	const state_t * s = &d.m_receiver->so_current_state();
+	const state_t & current_state = d.m_receiver->so_current_state();
+	const auto & subscriptions = *(d.m_receiver->m_subscriptions);
 
-	do {
-		search_result = d.m_receiver->m_subscriptions->find_handler(
+	if( !current_state.parent_state() )
+		// There is no need to use flattened table for top-level state.
+		// Only one lookup in subscription storage is necessary.
+		return subscriptions.find_handler(
 				d.m_mbox_id,
 				d.m_msg_type, 
-				*s );
+				current_state );
 
-		if( !search_result )
-			s = s->parent_state();
+	return d.m_receiver->m_nested_state_handlers->find_handler(
+			d.m_mbox_id,
+			d.m_msg_type,
+			current_state,
+			[&]() -> const impl::event_handler_data_t * {
+				const impl::event_handler_data_t * search_result = nullptr;
+				const state_t * s = &current_state;
 
-	} while( search_result == nullptr && s != nullptr );
+				do {
+					search_result = subscriptions.find_handler(
+							d.m_mbox_id,
+							d.m_msg_type, 
+							*s );
 
-	return search_result;
+					if( !search_result )
+						s = s->parent_state();
+
+				} while( search_result == nullptr && s != nullptr );
+
+				return search_result;
+			} );
 }
 
 void
@@ -18,6 +18,7 @@
 #include <so_5/rt/stats/impl/h/ds_mbox_core_stats.hpp>
 #include <so_5/rt/stats/impl/h/ds_agent_core_stats.hpp>
 #include <so_5/rt/stats/impl/h/ds_timer_thread_stats.hpp>
+#include <so_5/rt/stats/impl/h/ds_event_handler_stats.hpp>
 
 #include <so_5/rt/h/env_infrastructures.hpp>
 
@@ -39,6 +40,7 @@ environment_params_t::environment_params_t()
 	,	m_error_logger( create_stderr_logger() )
 	,	m_work_thread_activity_tracking(
 			work_thread_activity_tracking_t::unspecified )
+	,	m_event_handler_stats( event_handler_stats_t::off )
 	,	m_infrastructure_factory( env_infrastructures::default_mt::factory() )
 {
 }
@@ -56,6 +58,7 @@ environment_params_t::environment_params_t(
 	,	m_message_delivery_tracer( std::move( other.m_message_delivery_tracer ) )
 	,	m_work_thread_activity_tracking(
 			work_thread_activity_tracking_t::unspecified )
+	,	m_event_handler_stats( other.m_event_handler_stats )
 	,	m_queue_locks_defaults_manager( std::move( other.m_queue_locks_defaults_manager ) )
 	,	m_infrastructure_factory( std::move(other.m_infrastructure_factory) )
 {}
@@ -90,6 +93,7 @@ environment_params_t::swap( environment_params_t & other )
 
 	std::swap( m_work_thread_activity_tracking,
 			other.m_work_thread_activity_tracking );
+	std::swap( m_event_handler_stats, other.m_event_handler_stats );
 
 	std::swap( m_queue_locks_defaults_manager, other.m_queue_locks_defaults_manager );
 
@@ -291,6 +295,17 @@ struct environment_t::internals_t
 	 */
 	work_thread_activity_tracking_t m_work_thread_activity_tracking;
 
+	/*!
+	 * \brief Data source for statistics of event handlers.
+	 *
+	 * \attention Must be declared after m_infrastructure by the same
+	 * reason as m_core_data_sources.
+	 *
+	 * \since
+	 * v.5.5.20
+	 */
+	stats::impl::ds_event_handler_stats_t m_event_handler_stats;
+
 	/*!
 	 * \brief Manager for defaults of queue locks.
 	 *
@@ -330,6 +345,9 @@ struct environment_t::internals_t
 				*m_infrastructure )
 		,	m_work_thread_activity_tracking(
 				params.work_thread_activity_tracking() )
+		,	m_event_handler_stats(
+				outliving_mutable(m_infrastructure->stats_repository()),
+				params.event_handler_stats() )
 		,	m_queue_locks_defaults_manager(
 				ensure_locks_defaults_manager_exists(
 					params.so5__giveout_queue_locks_defaults_manager() ) )
@@ -370,6 +388,25 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( std::move(nonempty_name) );
 }
 
+mbox_t
+environment_t::create_routing_mbox(
+	const routing::mbox_params_t & params )
+{
+	return m_impl->m_mbox_core->create_routing_mbox( params );
+}
+
+mbox_t
+environment_t::create_last_value_mbox()
+{
+	return m_impl->m_mbox_core->create_last_value_mbox();
+}
+
+topics::space_ref_t
+environment_t::create_topic_space()
+{
+	return m_impl->m_mbox_core->create_topic_space();
+}
+
 mchain_t
 environment_t::create_mchain(
 	const mchain_params_t & params )
@@ -590,6 +627,14 @@ environment_t::stats_repository()
 	return m_impl->m_infrastructure->stats_repository();
 }
 
+void
+environment_t::change_message_delivery_sampling(
+	so_5::msg_tracing::sampling_t rules )
+{
+	impl::internal_env_iface_t{ *this }.msg_tracer().change_sampling(
+			std::move( rules ) );
+}
+
 work_thread_activity_tracking_t
 environment_t::work_thread_activity_tracking() const
 {
@@ -753,6 +798,12 @@ internal_env_iface_t::msg_tracer() const
 	return *(m_env.m_impl->m_message_delivery_tracer);
 }
 
+std::shared_ptr< stats::impl::event_handler_stats_storage_t >
+internal_env_iface_t::event_handler_stats_storage( const agent_t & agent ) const
+{
+	return m_env.m_impl->m_event_handler_stats.storage_for( agent );
+}
+
 so_5::disp::mpsc_queue_traits::lock_factory_t
 internal_env_iface_t::default_mpsc_queue_lock_factory() const
 {
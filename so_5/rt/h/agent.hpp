@@ -34,6 +34,7 @@
 #include <so_5/rt/h/handler_makers.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <vector>
@@ -1035,6 +1036,32 @@ class SO_5_TYPE agent_t
 			agent.push_service_request( limit, mbox_id, msg_type, message );
 		}
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Push an event to the agent's event queue or store it
+		 * until the agent will be bound to the event queue.
+		 *
+		 * An ordinary event is thrown away if the agent is not bound to
+		 * the event queue yet. But an event pushed by this method is stored
+		 * and will be pushed to the event queue right after the binding.
+		 *
+		 * \note This method is intended for mboxes which deliver a message
+		 * right at the time of subscription. Subscriptions are usually
+		 * created in so_define_agent() before the binding to the event queue.
+		 */
+		static inline void
+		call_push_deferrable_event(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t & message )
+		{
+			agent.push_deferrable_event( limit, mbox_id, msg_type, message );
+		}
+
 		/*!
 		 * \since
 		 * v.5.4.0
@@ -1954,6 +1981,29 @@ class SO_5_TYPE agent_t
 		 */
 		impl::subscription_storage_unique_ptr_t m_subscriptions;
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Flattened event handlers for nested states.
+		 *
+		 * Used for searching event handlers when the current state of
+		 * agent is a nested state. Content of that table is dropped on
+		 * every change of agent's subscriptions.
+		 */
+		std::unique_ptr< impl::nested_state_handlers_table_t >
+			m_nested_state_handlers;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief A common timer for time limits of agent's states.
+		 *
+		 * Created at the first entering into a state with time limit.
+		 */
+		std::unique_ptr< impl::state_time_limits_t > m_state_time_limits;
+
 		/*!
 		 * \since
 		 * v.5.5.4
@@ -2014,6 +2064,32 @@ class SO_5_TYPE agent_t
 		 */
 		event_queue_t * m_event_queue;
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Events which were pushed by call_push_deferrable_event()
+		 * before the binding to the event queue.
+		 *
+		 * \attention Access to this container must be done only
+		 * under acquired m_event_queue_lock.
+		 */
+		std::vector< execution_demand_t > m_deferred_demands;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Storage for statistics of event handlers.
+		 *
+		 * It is nullptr if statistics of event handlers are not collected.
+		 * Receives a value during the binding to the cooperation.
+		 *
+		 * \attention Must be changed only under acquired m_event_queue_lock.
+		 */
+		std::shared_ptr< stats::impl::event_handler_stats_storage_t >
+				m_event_handler_stats;
+
 		/*!
 		 * \since
 		 * v.5.4.0
@@ -2191,6 +2267,58 @@ class SO_5_TYPE agent_t
 			std::type_index msg_type,
 			//! Event message.
 			const message_ref_t & message );
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Push event into the event queue or store it until
+		 * the binding to the event queue.
+		 */
+		void
+		push_deferrable_event(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for this event.
+			mbox_id_t mbox_id,
+			//! Message type for event.
+			std::type_index msg_type,
+			//! Event message.
+			const message_ref_t & message );
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Set time of pushing to event queue if statistics of
+		 * event handlers are collected.
+		 *
+		 * The message of the demand is replaced by a special wrapper
+		 * which holds the original message and the time. So there is no
+		 * space for the time in every demand and there is no reading of
+		 * the clock if statistics are not collected.
+		 *
+		 * \note If there is no memory for the wrapper then the demand
+		 * is returned as is and the time of waiting will be unknown.
+		 *
+		 * \attention Must be called only under acquired m_event_queue_lock.
+		 */
+		execution_demand_t
+		stamp_demand( execution_demand_t demand ) const SO_5_NOEXCEPT;
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Restore the original message of the demand
+		 * stamped by stamp_demand().
+		 *
+		 * \return time of pushing to event queue or zero value if
+		 * the demand wasn't stamped.
+		 */
+		static std::chrono::steady_clock::time_point
+		unstamp_demand( execution_demand_t & d );
+
 		/*!
 		 * \}
 		 */
@@ -2318,6 +2446,9 @@ class SO_5_TYPE agent_t
 		process_message(
 			current_thread_id_t working_thread_id,
 			execution_demand_t & d,
+			//! Time of pushing the demand to event queue.
+			//! Zero value if it is unknown.
+			std::chrono::steady_clock::time_point enqueued_at,
 			event_handler_method_t method );
 
 		/*!
@@ -2335,6 +2466,9 @@ class SO_5_TYPE agent_t
 		process_service_request(
 			current_thread_id_t working_thread_id,
 			execution_demand_t & d,
+			//! Time of pushing the demand to event queue.
+			//! Zero value if it is unknown.
+			std::chrono::steady_clock::time_point enqueued_at,
 			std::pair< bool, const impl::event_handler_data_t * > handler_data );
 
 		/*!
@@ -2410,6 +2544,10 @@ class SO_5_TYPE agent_t
 		 *
 		 * \brief Actual search for event handler with respect
 		 * to parent-child relationship between agent states.
+		 *
+		 * \note Since v.5.5.20 the search for nested states is
+		 * performed via flattened table of event handlers. Because of
+		 * that the cost of search doesn't depend on nesting depth.
 		 */
 		static const impl::event_handler_data_t *
 		find_event_handler_for_current_state(
@@ -24,6 +24,8 @@
 #include <so_5/rt/h/nonempty_name.hpp>
 #include <so_5/rt/h/mbox.hpp>
 #include <so_5/rt/h/mchain.hpp>
+#include <so_5/rt/h/routing_mbox.hpp>
+#include <so_5/rt/h/topic_mbox.hpp>
 #include <so_5/rt/h/message.hpp>
 #include <so_5/rt/h/agent_coop.hpp>
 #include <so_5/rt/h/disp.hpp>
@@ -365,6 +367,53 @@ class SO_5_TYPE environment_params_t
 						work_thread_activity_tracking_t::off );
 			}
 
+		/*!
+		 * \brief Set the mode of collecting statistics of event handlers.
+		 *
+		 * If statistics are collected then times between pushing messages
+		 * to event queues of agents and the start of their handling and
+		 * execution times of event handlers are measured. They are
+		 * distributed by run-time monitoring via
+		 * so_5::stats::messages::event_handler_times messages.
+		 *
+		 * Statistics are not collected by default.
+		 *
+		 * \note Collecting of statistics requires two calls to
+		 * std::chrono::steady_clock::now() and acquiring a spinlock for
+		 * every event. Pushing of messages to event queues requires one
+		 * more call to std::chrono::steady_clock::now().
+		 *
+		 * \par Usage example:
+			\code
+			so_5::launch( ...,
+				[]( so_5::environment_params_t & params ) {
+					params.event_handler_stats(
+							so_5::event_handler_stats_t::per_agent );
+				} );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		environment_params_t &
+		event_handler_stats( event_handler_stats_t mode )
+			{
+				m_event_handler_stats = mode;
+				return *this;
+			}
+
+		/*!
+		 * \brief Get the mode of collecting statistics of event handlers.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		event_handler_stats_t
+		event_handler_stats() const
+			{
+				return m_event_handler_stats;
+			}
+
 		//! Set manager for queue locks defaults.
 		/*!
 		 * \since
@@ -550,6 +599,14 @@ class SO_5_TYPE environment_params_t
 		 */
 		work_thread_activity_tracking_t m_work_thread_activity_tracking;
 
+		/*!
+		 * \brief Mode of collecting statistics of event handlers.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		event_handler_stats_t m_event_handler_stats;
+
 		/*!
 		 * \brief Manager for defaults of queue locks.
 		 *
@@ -729,6 +786,70 @@ class SO_5_TYPE environment_t
 			{
 				return create_mbox( std::move(mbox_name) );
 			}
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create an anonymous content-based routing mbox.
+		 *
+		 * \par Usage example:
+			\code
+			auto mbox = env.create_routing_mbox(
+				so_5::routing::mbox_params_t{}.key_extractor(
+					[]( const md_update & m ) { return m.m_instrument; } ) );
+			\endcode
+		 *
+		 * \sa so_5::routing.
+		 */
+		mbox_t
+		create_routing_mbox(
+			//! Parameters for the new mbox.
+			const routing::mbox_params_t & params );
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create an anonymous last-value-cache mbox.
+		 *
+		 * This MPMC-mbox stores the last delivered message of every type.
+		 * The stored message is delivered to a new subscriber right at
+		 * the time of subscription. It allows late-joining agents to receive
+		 * the current value of some state without explicit requests.
+		 *
+		 * \par Usage example:
+			\code
+			auto prices = env.create_last_value_mbox();
+			so_5::send< current_price >( prices, 42.0 );
+			...
+			// An agent which is subscribed later will receive
+			// current_price{42.0} right after the start.
+			so_subscribe( prices ).event( &trader::on_price );
+			\endcode
+		 *
+		 * \note Service requests are not stored.
+		 */
+		mbox_t
+		create_last_value_mbox();
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create a new topic space.
+		 *
+		 * \par Usage example:
+			\code
+			auto space = env.create_topic_space();
+			so_subscribe( space->mbox( "md.eq.*.trade" ) ).event( ... );
+			so_5::send< trade >( space->mbox( "md.eq.AAPL.trade" ), ... );
+			\endcode
+		 *
+		 * \sa so_5::topics.
+		 */
+		topics::space_ref_t
+		create_topic_space();
 		/*!
 		 * \}
 		 */
@@ -1670,6 +1791,31 @@ class SO_5_TYPE environment_t
 		stats::repository_t &
 		stats_repository();
 
+		/*!
+		 * \brief Replace rules for selection of messages for message
+		 * delivery tracing.
+		 *
+		 * \throw so_5::exception_t with rc_msg_tracing_disabled if
+		 * message delivery tracing is disabled.
+		 *
+		 * \par Usage sample:
+			\code
+			virtual void so_evt_start() override
+			{
+				// Trace only messages of this agent.
+				so_environment().change_message_delivery_sampling(
+					so_5::msg_tracing::sampling_t{}.agent( *this ) );
+				...
+			}
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		change_message_delivery_sampling(
+			so_5::msg_tracing::sampling_t rules );
+
 		/*!
 		 * \brief Helper method for simplification of cooperation creation
 		 * and registration.
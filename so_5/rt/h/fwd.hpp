@@ -27,9 +27,23 @@ class internal_env_iface_t;
 class internal_message_iface_t;
 class layer_core_t;
 class state_switch_guard_t;
+class nested_state_handlers_table_t;
+class state_time_limits_t;
 
 } /* namespace impl */
 
+namespace stats
+{
+
+namespace impl
+{
+
+class event_handler_stats_storage_t;
+
+} /* namespace impl */
+
+} /* namespace stats */
+
 class coop_dereg_reason_t;
 class state_t;
 class environment_t;
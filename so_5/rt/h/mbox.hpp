@@ -997,6 +997,32 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			const std::type_index & msg_type,
 			//! A message instance to be delivered.
 			const message_ref_t & message );
+
+		/*!
+		 * \brief Special method for delivery of several messages
+		 * from a timer thread at once.
+		 *
+		 * Timer thread can collect messages from all timers elapsed at
+		 * one wakeup and then deliver all messages for the same mbox
+		 * by one call to this method. It allows an mbox to do the delivery
+		 * more efficiently (e.g. message chain acquires its lock only once
+		 * for all messages).
+		 *
+		 * Messages must be delivered in the order of their appearance
+		 * in the array.
+		 *
+		 * Implementation of that method in abstract_message_box_t class
+		 * simply calls do_deliver_message_from_timer() for every message.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual void
+		do_deliver_messages_from_timer(
+			//! Messages to deliver.
+			const so_5::rt::impl::timer_message_t * messages,
+			//! Count of messages.
+			std::size_t count );
 };
 
 template< class MESSAGE >
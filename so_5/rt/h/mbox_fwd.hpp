@@ -46,6 +46,7 @@ using mbox_ref_t = so_5::mbox_t;
 namespace impl {
 
 class mbox_iface_for_timers_t;
+struct timer_message_t;
 
 } /* namespace impl */
 
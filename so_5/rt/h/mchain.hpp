@@ -16,11 +16,24 @@
 
 #include <so_5/rt/h/fwd.hpp>
 
+#include <so_5/h/priority.hpp>
+
 #include <so_5/details/h/invoke_noexcept_code.hpp>
 #include <so_5/details/h/remaining_time_counter.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <vector>
 
 namespace so_5 {
 
@@ -446,6 +459,456 @@ enum class close_mode_t
 		retain_content
 	};
 
+//
+// multiplicity_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief How many threads can work with one side of the chain.
+ */
+enum class multiplicity_t
+	{
+		//! Only one thread at a time.
+		single,
+		//! Several threads at the same time.
+		multiple
+	};
+
+//
+// priority_lanes_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of description of priority lanes of the chain.
+ *
+ * Every lane is identified by its priority and has its own capacity.
+ */
+using priority_lanes_t = std::map< priority_t, capacity_t >;
+
+//
+// message_priorities_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of map from message type to the priority of the message.
+ */
+using message_priorities_t = std::map< std::type_index, priority_t >;
+
+//
+// conflation_key_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief User's part of the key of a conflated message.
+ *
+ * An integral or enumeration value is stored as is. A value of any
+ * other type must be equality comparable and must have a specialization
+ * of std::hash. Such a value is stored in a dynamically allocated holder
+ * and keys are compared by hash values first and then by the values
+ * themselves.
+ *
+ * \note A default constructed key is the same for all messages.
+ */
+class conflation_key_t
+	{
+		//! Holder for a value of non-integral type.
+		struct holder_base_t
+			{
+				virtual ~holder_base_t() {}
+
+				//! Compare with a holder of the same type.
+				virtual bool
+				equals( const holder_base_t & other ) const = 0;
+			};
+
+		template< typename KEY >
+		struct holder_t final : public holder_base_t
+			{
+				const KEY m_value;
+
+				holder_t( KEY value ) : m_value( std::move(value) ) {}
+
+				virtual bool
+				equals( const holder_base_t & other ) const override
+					{
+						// Keys are compared only for messages of the same type.
+						// So the other holder has the same type.
+						return m_value ==
+								static_cast< const holder_t & >( other ).m_value;
+					}
+			};
+
+		template< typename KEY >
+		static std::uint64_t
+		make_value( const KEY & key, std::true_type /*is_integral*/ )
+			{
+				return static_cast< std::uint64_t >( key );
+			}
+
+		template< typename KEY >
+		static std::uint64_t
+		make_value( const KEY & key, std::false_type /*is_integral*/ )
+			{
+				return static_cast< std::uint64_t >( std::hash< KEY >{}( key ) );
+			}
+
+		template< typename KEY >
+		static std::shared_ptr< const holder_base_t >
+		make_holder( KEY &&, std::true_type /*is_integral*/ )
+			{
+				return std::shared_ptr< const holder_base_t >();
+			}
+
+		template< typename KEY >
+		static std::shared_ptr< const holder_base_t >
+		make_holder( KEY && key, std::false_type /*is_integral*/ )
+			{
+				using key_t = typename std::decay< KEY >::type;
+				return std::make_shared< holder_t< key_t > >(
+						std::forward< KEY >( key ) );
+			}
+
+	public :
+		conflation_key_t()
+			:	m_value( 0u )
+			{}
+
+		template< typename KEY,
+				typename = typename std::enable_if< !std::is_same<
+						conflation_key_t,
+						typename std::decay< KEY >::type >::value >::type >
+		conflation_key_t( KEY && key )
+			:	m_value( make_value( key, is_integral_key< KEY >{} ) )
+			,	m_holder( make_holder(
+						std::forward< KEY >( key ), is_integral_key< KEY >{} ) )
+			{}
+
+		//! Hash value of the key.
+		std::size_t
+		hash() const
+			{
+				return std::hash< std::uint64_t >{}( m_value );
+			}
+
+		bool
+		operator==( const conflation_key_t & o ) const
+			{
+				if( m_value != o.m_value )
+					return false;
+				if( m_holder && o.m_holder )
+					return m_holder->equals( *o.m_holder );
+
+				return !m_holder && !o.m_holder;
+			}
+
+	private :
+		//! Is KEY stored as is?
+		template< typename KEY >
+		using is_integral_key = std::integral_constant< bool,
+				std::is_integral< typename std::decay< KEY >::type >::value ||
+				std::is_enum< typename std::decay< KEY >::type >::value >;
+
+		//! The value of integral key or the hash of other key.
+		std::uint64_t m_value;
+
+		//! The value of non-integral key.
+		/*!
+		 * It is shared between copies of the key.
+		 */
+		std::shared_ptr< const holder_base_t > m_holder;
+	};
+
+//
+// conflation_key_extractor_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of functor for getting conflation key from a message.
+ */
+using conflation_key_extractor_t =
+		std::function< conflation_key_t( const message_ref_t & ) >;
+
+//
+// conflated_types_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of map from type of conflated message to key extractor.
+ *
+ * \note Empty extractor means that all messages of that type have
+ * the same key.
+ */
+using conflated_types_t =
+		std::map< std::type_index, conflation_key_extractor_t >;
+
+//
+// spill_codec_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Functions for storing messages of some type into spill file
+ * and restoring them back.
+ */
+struct spill_codec_t
+	{
+		//! Type of serializer.
+		/*!
+		 * Serializer must append binary image of the message to the buffer.
+		 */
+		using serializer_t = std::function<
+				void( const message_ref_t &, std::string & ) >;
+
+		//! Type of deserializer.
+		/*!
+		 * Deserializer must make a new message from binary image.
+		 */
+		using deserializer_t = std::function<
+				message_ref_t( const char *, std::size_t ) >;
+
+		serializer_t m_serializer;
+		deserializer_t m_deserializer;
+	};
+
+//
+// spill_codecs_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of map from type of spillable message to its codec.
+ */
+using spill_codecs_t = std::map< std::type_index, spill_codec_t >;
+
+namespace details {
+
+//
+// make_spill_codec
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Make codec for a message type from serializer and
+ * deserializer of message payload.
+ */
+template< typename MSG, typename SERIALIZER, typename DESERIALIZER >
+spill_codec_t
+make_spill_codec( SERIALIZER serializer, DESERIALIZER deserializer )
+	{
+		using payload_t = message_payload_type< MSG >;
+		using payload_type = typename payload_t::payload_type;
+
+		spill_codec_t codec;
+		codec.m_serializer =
+			[serializer]( const message_ref_t & msg, std::string & to ) {
+				serializer(
+						const_cast< const payload_type & >(
+								payload_t::payload_reference( *msg ) ),
+						to );
+			};
+		codec.m_deserializer =
+			[deserializer]( const char * data, std::size_t size ) {
+				auto msg = so_5::details::make_message_instance< MSG >(
+						deserializer( data, size ) );
+				so_5::details::mark_as_mutable_if_necessary< MSG >( *msg );
+
+				return message_ref_t{ msg.release() };
+			};
+
+		return codec;
+	}
+
+} /* namespace details */
+
+//
+// spill_params_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Parameters for spill-to-disk storage of mchain.
+ *
+ * Spill-to-disk storage is used by size-limited mchain instead of
+ * waiting or dropping when the mchain is full. Messages of spillable
+ * types are written into a memory-mapped file in \a directory. They are
+ * read back in FIFO order when there is a free place in the mchain.
+ *
+ * Messages of other types (and service requests) are stored in memory
+ * if the mchain is full. A sender is never blocked and messages are
+ * never dropped.
+ *
+ * \par Usage example:
+	\code
+	struct audit_record { std::uint64_t m_id; char m_action[ 32 ]; };
+
+	auto ch = env.create_mchain(
+		so_5::make_limited_without_waiting_mchain_params(
+				1000,
+				so_5::mchain_props::memory_usage_t::preallocated,
+				so_5::mchain_props::overflow_reaction_t::throw_exception )
+			.spill_to_disk(
+				so_5::mchain_props::spill_params_t{ "/var/tmp" }
+					.spillable< audit_record >() ) );
+	\endcode
+ */
+class spill_params_t
+	{
+	public :
+		//! Default size of one segment of spill file.
+		static const std::size_t default_segment_size = 4u * 1024u * 1024u;
+
+		//! Default constructor.
+		/*!
+		 * Spill-to-disk is disabled.
+		 */
+		spill_params_t()
+			{}
+
+		//! Initializing constructor.
+		spill_params_t(
+			//! Directory for spill file.
+			std::string directory )
+			:	m_directory( std::move(directory) )
+			{}
+
+		//! Is spill-to-disk enabled?
+		bool
+		enabled() const
+			{
+				return !m_directory.empty();
+			}
+
+		//! Directory for spill file.
+		const std::string &
+		directory() const
+			{
+				return m_directory;
+			}
+
+		//! Set size of one segment of spill file.
+		/*!
+		 * Spill file grows by segments. A segment is reused when all
+		 * messages from it are extracted, but the file is never shrunk
+		 * until the chain is destroyed. Message with binary image greater
+		 * than segment size is stored in memory.
+		 */
+		spill_params_t &
+		segment_size( std::size_t v )
+			{
+				m_segment_size = v;
+				return *this;
+			}
+
+		//! Get size of one segment of spill file.
+		std::size_t
+		segment_size() const
+			{
+				return m_segment_size;
+			}
+
+		//! Allow spilling of messages of trivially copyable type \a MSG.
+		/*!
+		 * \note \a MSG must not be derived from message_t.
+		 * Binary image of the message is just a copy of its bytes.
+		 */
+		template< typename MSG >
+		spill_params_t &
+		spillable()
+			{
+				using payload_type =
+						typename message_payload_type< MSG >::payload_type;
+
+				static_assert( !is_signal< MSG >::value,
+						"signals are never spilled" );
+				static_assert( !is_classical_message< payload_type >::value,
+						"serializer and deserializer must be specified for "
+						"types derived from message_t" );
+				static_assert( std::is_trivially_copyable< payload_type >::value,
+						"serializer and deserializer must be specified for "
+						"types which are not trivially copyable" );
+
+				return spillable< MSG >(
+						[]( const payload_type & msg, std::string & to ) {
+							to.append(
+									reinterpret_cast< const char * >( &msg ),
+									sizeof( msg ) );
+						},
+						[]( const char * data, std::size_t size ) {
+							if( sizeof( payload_type ) != size )
+								SO_5_THROW_EXCEPTION( rc_mchain_spill_failure,
+										"unexpected size of spilled message" );
+
+							typename std::aligned_storage<
+									sizeof( payload_type ),
+									alignof( payload_type ) >::type buf;
+							std::memcpy( &buf, data, size );
+							return *reinterpret_cast< const payload_type * >( &buf );
+						} );
+			}
+
+		//! Allow spilling of messages of type \a MSG with user-supplied
+		//! serializer and deserializer.
+		/*!
+		 * \a serializer is called as `serializer(const MSG &, std::string &)`
+		 * and must append binary image of the message to the string.
+		 *
+		 * \a deserializer is called as
+		 * `deserializer(const char * data, std::size_t size)` and must
+		 * return an instance of MSG.
+		 *
+		 * \attention Both functions are called when mchain's lock is acquired.
+		 */
+		template< typename MSG, typename SERIALIZER, typename DESERIALIZER >
+		spill_params_t &
+		spillable( SERIALIZER serializer, DESERIALIZER deserializer )
+			{
+				static_assert( !is_signal< MSG >::value,
+						"signals are never spilled" );
+
+				m_codecs[ message_payload_type< MSG >::subscription_type_index() ] =
+						details::make_spill_codec< MSG >(
+								std::move(serializer),
+								std::move(deserializer) );
+				return *this;
+			}
+
+		//! Get codecs for spillable messages.
+		const spill_codecs_t &
+		codecs() const
+			{
+				return m_codecs;
+			}
+
+	private :
+		//! Directory for spill file.
+		/*!
+		 * Empty value means that spill-to-disk is disabled.
+		 */
+		std::string m_directory;
+
+		//! Size of one segment of spill file.
+		std::size_t m_segment_size = { default_segment_size };
+
+		//! Codecs for spillable messages.
+		spill_codecs_t m_codecs;
+	};
+
 //
 // not_empty_notification_func_t
 //
@@ -499,6 +962,78 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Max time to wait on empty queue.
 			mchain_props::duration_t empty_queue_timeout ) = 0;
 
+		/*!
+		 * \brief Extraction of several messages under one lock.
+		 *
+		 * Waits for the first message no more than \a empty_queue_timeout.
+		 * Then extracts all available messages but no more than
+		 * \a max_count and no more than the extraction batch size
+		 * from chain's params. Extracted messages are appended to \a dest.
+		 *
+		 * \note The default implementation extracts just one message
+		 * by extract(). It is done to keep compatibility with custom
+		 * implementations of mchains from previous versions.
+		 *
+		 * \attention \a max_count must be greater than 0.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual mchain_props::extraction_status_t
+		extract_bunch(
+			//! Destination for extracted messages.
+			std::vector< mchain_props::demand_t > & dest,
+			//! Max count of messages to be extracted.
+			std::size_t max_count,
+			//! Max time to wait on empty queue.
+			mchain_props::duration_t empty_queue_timeout );
+
+		/*!
+		 * \brief Return extracted but unhandled demands to the chain.
+		 *
+		 * Is used by receive() and select() if a handler throws during
+		 * the handling of a batch of extracted messages. Demands are placed
+		 * to the front of the chain in the same order. It is done even if
+		 * the chain is full or closed. So they will be extracted by the next
+		 * receive() or select().
+		 *
+		 * \note The default implementation drops the demands. It is enough
+		 * for chains which don't override extract_bunch() because the
+		 * default implementation of extract_bunch() extracts just one message.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual void
+		return_demands(
+			//! The first demand to be returned.
+			std::vector< mchain_props::demand_t >::iterator first,
+			//! The end of the range of demands to be returned.
+			std::vector< mchain_props::demand_t >::iterator last );
+
+		/*!
+		 * \brief Store a message with the specified priority.
+		 *
+		 * Chains with priority lanes store the message into the lane
+		 * for \a priority.
+		 *
+		 * \note The default implementation ignores the priority and
+		 * delivers the message as an ordinary one.
+		 *
+		 * \see so_5::send_with_priority().
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual void
+		deliver_message_with_priority(
+			//! Priority for the message.
+			priority_t priority,
+			//! Type of the message.
+			const std::type_index & msg_type,
+			//! Message instance (empty for signals).
+			const message_ref_t & message );
+
 		//! Cast message chain to message box.
 		so_5::mbox_t
 		as_mbox();
@@ -541,6 +1076,29 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Select case to be stored for notification if mchain is empty.
 			mchain_props::select_case_t & select_case );
 
+		/*!
+		 * \brief An extraction of several messages under one lock
+		 * as a part of multi chain select.
+		 *
+		 * \note The default implementation extracts just one message
+		 * by extract(demand,select_case).
+		 *
+		 * \note This method is intended to be used by select_case_t.
+		 *
+		 * \attention \a max_count must be greater than 0.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		virtual mchain_props::extraction_status_t
+		extract_bunch(
+			//! Destination for extracted messages.
+			std::vector< mchain_props::demand_t > & dest,
+			//! Max count of messages to be extracted.
+			std::size_t max_count,
+			//! Select case to be stored for notification if mchain is empty.
+			mchain_props::select_case_t & select_case );
+
 		/*!
 		 * \brief Removement of mchain from multi chain select.
 		 *
@@ -647,6 +1205,72 @@ class mchain_params_t
 		//! Is message delivery tracing disabled explicitly?
 		bool m_msg_tracing_disabled = { false };
 
+		/*!
+		 * \brief Max count of messages to be extracted under one lock.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		std::size_t m_extraction_batch_size = { 1 };
+
+		/*!
+		 * \brief Multiplicity of message producers.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::multiplicity_t m_producers =
+				{ mchain_props::multiplicity_t::multiple };
+
+		/*!
+		 * \brief Multiplicity of message consumers.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::multiplicity_t m_consumers =
+				{ mchain_props::multiplicity_t::multiple };
+
+		/*!
+		 * \brief Priority lanes of the chain.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::priority_lanes_t m_priority_lanes;
+
+		/*!
+		 * \brief Priorities of messages of specific types.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::message_priorities_t m_message_priorities;
+
+		/*!
+		 * \brief Types of messages to be conflated.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::conflated_types_t m_conflated_types;
+
+		/*!
+		 * \brief Parameters of spill-to-disk storage.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::spill_params_t m_spill_params;
+
+		/*!
+		 * \brief Is run-time monitoring enabled for the chain?
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		bool m_stats_enabled = { false };
+
 	public :
 		//! Initializing constructor.
 		mchain_params_t(
@@ -709,6 +1333,395 @@ class mchain_params_t
 			{
 				return m_msg_tracing_disabled;
 			}
+
+		//! Set max count of messages to be extracted under one lock.
+		/*!
+		 * By default receive() and select() extract messages from
+		 * the chain one by one. It means that the chain is locked and
+		 * unlocked for every message. If batch size is greater than 1
+		 * then receive() and select() extract up to \a v messages under
+		 * one lock and then handle them without holding the lock.
+		 *
+		 * Limits like handle_n(), extract_n() are not violated by
+		 * batched extraction. Batched extraction is not used if
+		 * stop-predicate is set for receive() or select().
+		 *
+		 * If a handler throws then all remaining messages from the
+		 * extracted batch are returned to the front of the chain.
+		 *
+		 * \attention The total_time() limit is checked only between
+		 * batches.
+		 *
+		 * \note Value 0 is treated as 1.
+		 *
+		 * \par Usage example:
+			\code
+			auto ch = env.create_mchain(
+				so_5::make_unlimited_mchain_params().extraction_batch_size( 64 ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		extraction_batch_size( std::size_t v )
+			{
+				m_extraction_batch_size = v ? v : 1u;
+				return *this;
+			}
+
+		//! Get max count of messages to be extracted under one lock.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		std::size_t
+		extraction_batch_size() const
+			{
+				return m_extraction_batch_size;
+			}
+
+		//! Declare multiplicity of message producers.
+		/*!
+		 * If multiplicity_t::single is specified then only one thread
+		 * at a time can send messages to the chain (including timer thread
+		 * for delayed and periodic messages).
+		 *
+		 * \see consumers().
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		producers( mchain_props::multiplicity_t v )
+			{
+				m_producers = v;
+				return *this;
+			}
+
+		//! Get multiplicity of message producers.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::multiplicity_t
+		producers() const
+			{
+				return m_producers;
+			}
+
+		//! Declare multiplicity of message consumers.
+		/*!
+		 * If there is just one consumer of size-limited chain then
+		 * a lock-free ring buffer is used instead of mutex-protected queue.
+		 * Producers and consumer are blocked only if the ring is full or
+		 * empty. The ring is allocated at the creation of the chain
+		 * regardless of mchain_props::memory_usage_t value.
+		 *
+		 * Ring for single producer is used if producers() is
+		 * multiplicity_t::single. Otherwise ring for multiple producers
+		 * is used.
+		 *
+		 * All overflow reactions and close modes are supported by
+		 * lock-free chains.
+		 *
+		 * \note Lock-free ring is not used for size-unlimited chains
+		 * and for chains with run-time monitoring (see enable_stats()).
+		 *
+		 * \note If a lock-free chain is used then not_empty_notificator
+		 * can be called from several producers at the same time.
+		 *
+		 * \par Usage example:
+			\code
+			auto ch = env.create_mchain(
+				so_5::make_limited_without_waiting_mchain_params(
+						1024,
+						so_5::mchain_props::memory_usage_t::preallocated,
+						so_5::mchain_props::overflow_reaction_t::drop_newest )
+					.producers( so_5::mchain_props::multiplicity_t::single )
+					.consumers( so_5::mchain_props::multiplicity_t::single ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		consumers( mchain_props::multiplicity_t v )
+			{
+				m_consumers = v;
+				return *this;
+			}
+
+		//! Get multiplicity of message consumers.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_props::multiplicity_t
+		consumers() const
+			{
+				return m_consumers;
+			}
+
+		//! Define a priority lane.
+		/*!
+		 * If at least one lane is defined then the chain is created as
+		 * a chain with priority lanes. Every lane is a separate FIFO queue
+		 * with its own capacity. The capacity of the whole chain
+		 * (from capacity() method) is ignored for such chains.
+		 *
+		 * receive() and select() always extract messages from the lane
+		 * with the highest priority first.
+		 *
+		 * A new message goes to the lane with the highest priority which
+		 * is not greater than priority of the message. If there is no
+		 * such lane then the lowest lane is used. Priority of the message
+		 * is specified by so_5::send_with_priority() or by
+		 * message_priority() method. Messages of other types have
+		 * so_5::prio::default_priority.
+		 *
+		 * \note Lanes always use dynamically allocated storage.
+		 *
+		 * \note Lanes can't be used together with lock-free chains.
+		 * Values of producers() and consumers() are ignored.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::mchain_props;
+			auto ch = env.create_mchain(
+				so_5::make_unlimited_mchain_params()
+					.priority_lane( so_5::prio::p0,
+						capacity_t::make_limited_with_waiting(
+								10000, memory_usage_t::dynamic,
+								overflow_reaction_t::throw_exception,
+								std::chrono::seconds(1) ) )
+					.priority_lane( so_5::prio::p7,
+						capacity_t::make_unlimited() )
+					.message_priority< cancel >( so_5::prio::p7 )
+					.message_priority< shutdown >( so_5::prio::p7 ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		priority_lane(
+			//! Priority of the lane.
+			priority_t priority,
+			//! Capacity of the lane.
+			mchain_props::capacity_t capacity )
+			{
+				m_priority_lanes[ priority ] = capacity;
+				return *this;
+			}
+
+		//! Get priority lanes.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		const mchain_props::priority_lanes_t &
+		priority_lanes() const
+			{
+				return m_priority_lanes;
+			}
+
+		//! Set priority for messages of type \a MSG.
+		/*!
+		 * Has sence only for chains with priority lanes.
+		 *
+		 * \see priority_lane().
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		template< typename MSG >
+		mchain_params_t &
+		message_priority( priority_t priority )
+			{
+				m_message_priorities[
+						message_payload_type< MSG >::subscription_type_index() ] =
+								priority;
+				return *this;
+			}
+
+		//! Get priorities for message types.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		const mchain_props::message_priorities_t &
+		message_priorities() const
+			{
+				return m_message_priorities;
+			}
+
+		//! Enable conflation for messages of type \a MSG.
+		/*!
+		 * If a message of type \a MSG is sent to the chain and there is
+		 * a message of the same type in the chain which is not extracted
+		 * yet then the old message is replaced by the new one. The new
+		 * message takes the position of the old message in the chain.
+		 * The size of the chain isn't changed, so there is no overflow
+		 * on conflation.
+		 *
+		 * \note In a chain with priority lanes the new message takes
+		 * the position of the old message in the lane of the old message.
+		 * It is so even if the new message is sent with another priority
+		 * by so_5::send_with_priority().
+		 *
+		 * This version of method treats all messages of type \a MSG
+		 * as messages with the same key. It can be used for signals too.
+		 *
+		 * \note Service requests are never conflated.
+		 *
+		 * \note Lock-free ring (see consumers()) isn't used for chains
+		 * with conflation.
+		 *
+		 * \par Usage example:
+			\code
+			auto ch = env.create_mchain(
+				so_5::make_unlimited_mchain_params()
+					.conflate< current_status >()
+					.conflate< quote >( []( const quote & q ) { return q.m_ticker; } ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		template< typename MSG >
+		mchain_params_t &
+		conflate()
+			{
+				m_conflated_types[
+						message_payload_type< MSG >::subscription_type_index() ] =
+								mchain_props::conflation_key_extractor_t{};
+				return *this;
+			}
+
+		//! Enable conflation for messages of type \a MSG with
+		//! a key from the message.
+		/*!
+		 * Only messages with the same key are conflated. The extractor
+		 * gets a const reference to the message payload and returns the
+		 * key. The key can be a value of integral or enumeration type
+		 * (it is the cheapest variant), std::string or a value of any
+		 * other type with operator== and a specialization of std::hash
+		 * (see mchain_props::conflation_key_t).
+		 *
+		 * \attention The extractor is called for every message of type
+		 * \a MSG sent to the chain. It is called on the sender's context
+		 * without acquiring chain's lock.
+		 *
+		 * \see conflate().
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		template< typename MSG, typename KEY_EXTRACTOR >
+		mchain_params_t &
+		conflate( KEY_EXTRACTOR extractor )
+			{
+				static_assert( !is_signal< MSG >::value,
+						"key extractor can't be used for signals" );
+
+				using payload_t = message_payload_type< MSG >;
+
+				m_conflated_types[ payload_t::subscription_type_index() ] =
+						[extractor]( const message_ref_t & msg )
+								-> mchain_props::conflation_key_t {
+							return extractor(
+									const_cast< const typename payload_t::payload_type & >(
+											payload_t::payload_reference( *msg ) ) );
+						};
+				return *this;
+			}
+
+		//! Get types of conflated messages.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		const mchain_props::conflated_types_t &
+		conflated_types() const
+			{
+				return m_conflated_types;
+			}
+
+		//! Enable spill-to-disk storage for size-limited chain.
+		/*!
+		 * If chain is full then messages are written to spill file
+		 * instead of waiting or applying overflow reaction.
+		 * Overflow reaction and overflow timeout from chain's capacity
+		 * are not used.
+		 *
+		 * \note Spill-to-disk can't be used for unlimited chains, with
+		 * priority lanes or with conflation. An exception with
+		 * rc_incompatible_mchain_params is thrown by create_mchain() in
+		 * that case.
+		 *
+		 * \see mchain_props::spill_params_t.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		spill_to_disk( mchain_props::spill_params_t params )
+			{
+				m_spill_params = std::move(params);
+				return *this;
+			}
+
+		//! Get parameters of spill-to-disk storage.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		const mchain_props::spill_params_t &
+		spill_params() const
+			{
+				return m_spill_params;
+			}
+
+		//! Enable run-time monitoring for the chain.
+		/*!
+		 * If run-time monitoring is enabled then the chain is registered
+		 * as data source in stats repository of SObjectizer Environment.
+		 * The current size, high watermark of the size, count of enqueued
+		 * and dequeued messages, enqueue and dequeue rates and count of
+		 * overflows are distributed with prefix "mchain/<id>".
+		 *
+		 * \note Counters are updated under the chain's lock without
+		 * any additional synchronization. Because of that a lock-free
+		 * implementation is not used for a chain with run-time monitoring
+		 * even if single consumer is specified.
+		 *
+		 * \par Usage example:
+			\code
+			auto ch = env.create_mchain(
+				so_5::make_unlimited_mchain_params().enable_stats() );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_params_t &
+		enable_stats()
+			{
+				m_stats_enabled = true;
+				return *this;
+			}
+
+		//! Is run-time monitoring enabled for the chain?
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		bool
+		stats_enabled() const
+			{
+				return m_stats_enabled;
+			}
 	};
 
 /*!
@@ -1245,6 +2258,40 @@ namespace mchain_props {
 
 namespace details {
 
+//
+// max_bunch_size
+//
+/*!
+ * \brief Max count of messages which can be extracted from a chain
+ * at the next step of bulk processing.
+ *
+ * Count of messages is limited in a such way that handle_n() and
+ * extract_n() limits can't be violated. If stop-predicate is defined
+ * then messages must be extracted one by one.
+ *
+ * \since
+ * v.5.5.20
+ */
+template< typename PARAMS >
+std::size_t
+max_bunch_size(
+	const PARAMS & params,
+	std::size_t extracted_messages,
+	std::size_t handled_messages )
+	{
+		if( params.stop_on() )
+			return 1u;
+
+		std::size_t result = std::numeric_limits< std::size_t >::max();
+		if( params.to_handle() && params.to_handle() > handled_messages )
+			result = params.to_handle() - handled_messages;
+		if( params.to_extract() && params.to_extract() > extracted_messages )
+			result = (std::min)( result,
+					params.to_extract() - extracted_messages );
+
+		return result;
+	}
+
 //
 // receive_actions_performer_t
 //
@@ -1265,6 +2312,53 @@ class receive_actions_performer_t
 		std::size_t m_handled_messages = 0;
 		extraction_status_t m_status;
 
+		//! A buffer for batched extraction.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		std::vector< demand_t > m_extracted_demands;
+
+		void
+		handle_extracted_demand( demand_t & demand )
+			{
+				++m_extracted_messages;
+				const bool handled = m_bunch.handle(
+						demand.m_msg_type,
+						demand.m_message_ref,
+						demand.m_demand_type );
+				if( handled )
+					++m_handled_messages;
+			}
+
+		//! Handle all messages from the extracted batch.
+		/*!
+		 * If a handler throws then the rest of the batch is returned
+		 * to the chain.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		handle_extracted_demands()
+			{
+				auto it = m_extracted_demands.begin();
+				try
+					{
+						for(; it != m_extracted_demands.end(); ++it )
+							handle_extracted_demand( *it );
+					}
+				catch( ... )
+					{
+						m_params.chain()->return_demands(
+								std::next( it ), m_extracted_demands.end() );
+						m_extracted_demands.clear();
+						throw;
+					}
+
+				m_extracted_demands.clear();
+			}
+
 	public :
 		receive_actions_performer_t(
 			const mchain_receive_params_t & params,
@@ -1276,23 +2370,32 @@ class receive_actions_performer_t
 		void
 		handle_next( duration_t empty_timeout )
 			{
-				demand_t extracted_demand;
-				m_status = m_params.chain()->extract(
-						extracted_demand, empty_timeout );
+				const auto max_count = max_bunch_size(
+						m_params, m_extracted_messages, m_handled_messages );
 
-				if( extraction_status_t::msg_extracted == m_status )
+				if( 1u == max_count )
 					{
-						++m_extracted_messages;
-						const bool handled = m_bunch.handle(
-								extracted_demand.m_msg_type,
-								extracted_demand.m_message_ref,
-								extracted_demand.m_demand_type );
-						if( handled )
-							++m_handled_messages;
+						demand_t extracted_demand;
+						m_status = m_params.chain()->extract(
+								extracted_demand, empty_timeout );
+
+						if( extraction_status_t::msg_extracted == m_status )
+							handle_extracted_demand( extracted_demand );
 					}
+				else
+					{
+						// Since v.5.5.20 several messages can be extracted
+						// under one lock. They are handled without the lock.
+						m_status = m_params.chain()->extract_bunch(
+								m_extracted_demands, max_count, empty_timeout );
+
+						if( extraction_status_t::msg_extracted == m_status )
+							handle_extracted_demands();
+					}
+
 				// Since v.5.5.17 we must check presence of chain-closed handler.
 				// This handler must be used if chain is closed.
-				else if( extraction_status_t::chain_closed == m_status )
+				if( extraction_status_t::chain_closed == m_status )
 					{
 						if( const auto & handler = m_params.closed_handler() )
 							so_5::details::invoke_noexcept_code(
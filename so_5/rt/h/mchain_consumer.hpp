@@ -0,0 +1,217 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief An agent for asynchronous consumption of messages from mchain.
+ *
+ * \since
+ * v.5.5.20
+ */
+
+#pragma once
+
+#include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/mchain_select.hpp>
+
+#include <functional>
+
+#if defined( SO_5_MSVC )
+	#pragma warning(push)
+	#pragma warning(disable: 4251)
+#endif
+
+namespace so_5 {
+
+//
+// mchain_consumer_params_t
+//
+/*!
+ * \brief Parameters for mchain_consumer agent.
+ *
+ * \since
+ * v.5.5.20
+ */
+class mchain_consumer_params_t
+	{
+	public :
+		//! Type of handler for the close of mchain.
+		using close_handler_t = std::function< void( const mchain_t & ) >;
+
+	private :
+		//! Max count of messages to be handled in one event.
+		std::size_t m_batch_size = { 16 };
+
+		//! Handler to be called when mchain is closed.
+		close_handler_t m_close_handler;
+
+	public :
+		//! Set max count of messages to be handled in one event.
+		/*!
+		 * The consumer handles up to \a v messages and then returns
+		 * control to the dispatcher. The rest of messages is handled
+		 * in the next event. It allows several consumers to share
+		 * worker threads of the same dispatcher.
+		 *
+		 * \note Extraction of several messages under one mchain's lock
+		 * is controlled by mchain_params_t::extraction_batch_size().
+		 */
+		mchain_consumer_params_t &
+		batch_size( std::size_t v )
+			{
+				m_batch_size = v ? v : 1u;
+				return *this;
+			}
+
+		//! Get max count of messages to be handled in one event.
+		std::size_t
+		batch_size() const
+			{
+				return m_batch_size;
+			}
+
+		//! Set handler for the close of mchain.
+		/*!
+		 * The handler is called on the consumer's working context.
+		 * There is no more consumption of messages after the call.
+		 */
+		mchain_consumer_params_t &
+		on_close( close_handler_t handler )
+			{
+				m_close_handler = std::move(handler);
+				return *this;
+			}
+
+		//! Get handler for the close of mchain.
+		const close_handler_t &
+		close_handler() const
+			{
+				return m_close_handler;
+			}
+	};
+
+//
+// mchain_consumer_t
+//
+/*!
+ * \brief An agent which consumes messages from mchain without
+ * blocking of a working thread.
+ *
+ * There is no need to call receive() or select() for a mchain if
+ * messages from it are consumed by this agent. The agent is notified
+ * by mchain when mchain becomes non-empty. Then messages are extracted
+ * and handled on the agent's working context by batches of
+ * mchain_consumer_params_t::batch_size() messages. The agent is
+ * notified again only when the mchain becomes empty and then
+ * non-empty. Because of that there are no wakeups for every message.
+ *
+ * The agent can be bound to any dispatcher. For example, many consumers
+ * can be bound to thread_pool dispatcher with a few working threads.
+ *
+ * \note Handlers are specified the same way as for receive() and
+ * case_(). Messages without handlers are ignored.
+ *
+ * \attention Only one consumer (or receive/select) must be used for
+ * a mchain at the same time.
+ *
+ * \par Usage example:
+	\code
+	auto ch = env.create_mchain( so_5::make_unlimited_mchain_params() );
+	env.introduce_coop(
+		so_5::disp::thread_pool::create_private_disp( env, 4 )->binder(
+			so_5::disp::thread_pool::bind_params_t{} ),
+		[&]( so_5::coop_t & coop ) {
+			coop.make_agent< so_5::mchain_consumer_t >(
+				ch,
+				so_5::mchain_consumer_params_t{}
+					.batch_size( 32 )
+					.on_close( []( const so_5::mchain_t & ) { ... } ),
+				[]( const request & r ) { ... },
+				[]( so_5::mhood_t< shutdown > ) { ... } );
+		} );
+	\endcode
+ *
+ * \since
+ * v.5.5.20
+ */
+class SO_5_TYPE mchain_consumer_t : public agent_t
+	{
+	public :
+		//! Initializing constructor.
+		template< typename... HANDLERS >
+		mchain_consumer_t(
+			//! Agent's context.
+			context_t ctx,
+			//! Chain to consume messages from.
+			mchain_t chain,
+			//! Consumer's params.
+			mchain_consumer_params_t params,
+			//! Message handlers.
+			HANDLERS &&... handlers )
+			:	mchain_consumer_t(
+					std::move(ctx),
+					std::move(params),
+					case_( std::move(chain), std::forward<HANDLERS>(handlers)... ) )
+			{}
+
+		//! Initializing constructor for already created select_case.
+		mchain_consumer_t(
+			//! Agent's context.
+			context_t ctx,
+			//! Consumer's params.
+			mchain_consumer_params_t params,
+			//! Select case with mchain and message handlers.
+			mchain_props::select_case_unique_ptr_t select_case );
+
+		virtual ~mchain_consumer_t();
+
+		virtual void
+		so_define_agent() override;
+
+		virtual void
+		so_evt_start() override;
+
+		virtual void
+		so_evt_finish() override;
+
+	private :
+		//! Signal for handling the next portion of messages.
+		struct msg_consume : public signal_t {};
+
+		//! Notificator to be used by mchain.
+		/*!
+		 * Sends msg_consume to the consumer when mchain becomes
+		 * non-empty or closed.
+		 */
+		class notificator_t : public mchain_props::select_notificator_t
+			{
+			public :
+				notificator_t( mbox_t mbox );
+
+				virtual void
+				notify( mchain_props::select_case_t & what ) SO_5_NOEXCEPT override;
+
+			private :
+				const mbox_t m_mbox;
+			};
+
+		//! Consumer's params.
+		const mchain_consumer_params_t m_params;
+
+		//! Select case with mchain and message handlers.
+		const mchain_props::select_case_unique_ptr_t m_case;
+
+		//! Notificator to be used by mchain.
+		notificator_t m_notificator;
+
+		//! Handler for the next portion of messages.
+		void
+		evt_consume( mhood_t< msg_consume > );
+	};
+
+} /* namespace so_5 */
+
+#if defined( SO_5_MSVC )
+	#pragma warning(pop)
+#endif
@@ -19,6 +19,9 @@
 
 #include <iterator>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 namespace so_5 {
 
@@ -248,6 +251,14 @@ fill_select_cases_holder(
 /*!
  * \brief Actual implementation of notificator for multi chain select.
  *
+ * \note Since v.5.5.20 the list of notified select_cases is a lock-free
+ * stack. A notification from mchain is just one CAS operation if the
+ * selecting thread is not sleeping. Mutex and condition variable are
+ * used only when the selecting thread must be awakened. The fact of
+ * sleeping is stored in the head of the list (a special marker value
+ * is used). Because of that a notifier sees the sleeping state and
+ * pushes a new item by the same atomic operation.
+ *
  * \since
  * v.5.5.16
  */
@@ -258,16 +269,66 @@ class actual_select_notificator_t : public select_notificator_t
 		std::condition_variable m_condition;
 
 		//! Queue of already notified select_cases.
-		select_case_t * m_tail = nullptr;
+		/*!
+		 * Value sleeping_marker() means that the list is empty and
+		 * the selecting thread is waiting on m_condition.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		std::atomic< select_case_t * > m_tail{ nullptr };
+
+		//! A special value of m_tail for the sleeping state.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		select_case_t *
+		sleeping_marker() SO_5_NOEXCEPT
+			{
+				// The address of the notificator itself can't be
+				// the address of any select_case.
+				return reinterpret_cast< select_case_t * >( this );
+			}
 
 		/*!
-		 * \attention This method must be called only on locked object.
+		 * \note Can be called from any thread.
+		 *
+		 * \since
+		 * v.5.5.20
 		 */
 		void
 		push_to_notified_chain( select_case_t & what ) SO_5_NOEXCEPT
 			{
-				what.set_next( m_tail );
-				m_tail = &what;
+				auto old_tail = m_tail.load( std::memory_order_acquire );
+				for(;;)
+					{
+						if( sleeping_marker() == old_tail )
+							{
+								// The selecting thread can't change the sleeping
+								// state while m_lock is acquired by the notifier.
+								std::lock_guard< std::mutex > lock{ m_lock };
+
+								what.set_next( nullptr );
+								if( m_tail.compare_exchange_strong(
+										old_tail, &what,
+										std::memory_order_acq_rel,
+										std::memory_order_acquire ) )
+									{
+										m_condition.notify_one();
+										return;
+									}
+							}
+						else
+							{
+								what.set_next( old_tail );
+								if( m_tail.compare_exchange_weak(
+										old_tail, &what,
+										std::memory_order_acq_rel,
+										std::memory_order_acquire ) )
+									return;
+							}
+					}
 			}
 
 	public :
@@ -284,27 +345,21 @@ class actual_select_notificator_t : public select_notificator_t
 			{
 				// All select_cases from range [b,e) must be included in
 				// ready_cases list.
+				select_case_t * tail = nullptr;
 				while( b != e )
 					{
-						b->set_next( m_tail );
-						m_tail = &(*b);
+						b->set_next( tail );
+						tail = &(*b);
 						++b;
 					}
+
+				m_tail.store( tail, std::memory_order_release );
 			}
 
 		virtual void
 		notify( select_case_t & what ) SO_5_NOEXCEPT override
 			{
-				select_case_t * old_tail = nullptr;
-				{
-					std::lock_guard< std::mutex > lock{ m_lock };
-
-					old_tail = m_tail;
-					push_to_notified_chain( what );
-				}
-
-				if( !old_tail )
-					m_condition.notify_one();
+				push_to_notified_chain( what );
 			}
 
 		/*!
@@ -321,7 +376,6 @@ class actual_select_notificator_t : public select_notificator_t
 		void
 		return_to_ready_chain( select_case_t & what ) SO_5_NOEXCEPT
 			{
-				std::lock_guard< std::mutex > lock{ m_lock };
 				push_to_notified_chain( what );
 			}
 
@@ -338,17 +392,27 @@ class actual_select_notificator_t : public select_notificator_t
 			//! Maximum waiting time for notified select_case.
 			duration_t wait_time )
 			{
+				auto * result = m_tail.exchange( nullptr, std::memory_order_acq_rel );
+				if( result || duration_t::zero() == wait_time )
+					return result;
+
 				std::unique_lock< std::mutex > lock{ m_lock };
-				if( !m_tail )
+
+				// Sleeping state can be set only if the list is still empty.
+				if( m_tail.compare_exchange_strong(
+						result, sleeping_marker(),
+						std::memory_order_acq_rel,
+						std::memory_order_acquire ) )
 					m_condition.wait_for(
 							lock,
 							wait_time,
-							[this]{ return m_tail != nullptr; } );
-
-				auto * result = m_tail;
-				m_tail = nullptr;
+							[this] {
+								return sleeping_marker() !=
+										m_tail.load( std::memory_order_acquire );
+							} );
 
-				return result;
+				result = m_tail.exchange( nullptr, std::memory_order_acq_rel );
+				return sleeping_marker() != result ? result : nullptr;
 			}
 	};
 
@@ -435,7 +499,12 @@ class select_actions_performer_t
 						auto * current = ready_chain;
 						ready_chain = current->giveout_next();
 
-						const auto result = current->try_receive( m_notificator );
+						const auto result = current->try_receive(
+								m_notificator,
+								max_bunch_size(
+										m_params,
+										m_extracted_messages,
+										m_handled_messages ) );
 						m_status = result.status();
 
 						if( extraction_status_t::msg_extracted == m_status )
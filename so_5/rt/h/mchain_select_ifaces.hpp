@@ -15,7 +15,11 @@
 
 #include <so_5/rt/h/mchain.hpp>
 
+#include <so_5/details/h/at_scope_exit.hpp>
+
+#include <iterator>
 #include <memory>
+#include <vector>
 
 namespace so_5 {
 
@@ -88,6 +92,13 @@ class select_case_t
 		 */
 		select_case_t * m_next = nullptr;
 
+		//! A buffer for batched extraction.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		std::vector< demand_t > m_extracted_demands;
+
 	public :
 		//! Initialized constructor.
 		select_case_t(
@@ -173,15 +184,19 @@ class select_case_t
 		 *
 		 * \attention This method must not throw because it will be called from
 		 * destructor of RAII wrappers.
+		 *
+		 * \note Since v.5.5.20 mchain is accessed even if select_case is
+		 * already notified. Notification is performed by mchain under
+		 * mchain's lock and can be still in progress at this moment.
+		 * Removal from select tail waits for completion of notification.
+		 * It makes safe the destruction of select notificator which
+		 * doesn't use any locks for the notification.
 		 */
 		void
 		on_select_finish() SO_5_NOEXCEPT
 			{
-				if( m_notificator )
-					{
-						m_chain->remove_from_select( *this );
-						m_notificator = nullptr;
-					}
+				m_chain->remove_from_select( *this );
+				m_notificator = nullptr;
 			}
 
 		//! An attempt to extract and handle a message from mchain.
@@ -189,24 +204,46 @@ class select_case_t
 		 * \note This method returns immediately if mchain is empty.
 		 * In this case select_case object will stay in select_case queue
 		 * inside mchain.
+		 *
+		 * \note Since v.5.5.20 several messages can be extracted and
+		 * handled if \a max_count is greater than 1 and extraction
+		 * batch size of mchain is greater than 1.
 		 */
 		mchain_receive_result_t
-		try_receive( select_notificator_t & notificator )
+		try_receive(
+			select_notificator_t & notificator,
+			//! Max count of messages to be extracted.
+			std::size_t max_count = 1u )
 			{
 				m_notificator = &notificator;
 
-				demand_t demand;
-				const auto status = m_chain->extract( demand, *this );
-				// Notificator pointer must retain its value only if
-				// there is no messages in mchain.
-				// In other cases this pointer must be dropped.
-				if( extraction_status_t::no_messages != status )
-					m_notificator = nullptr;
+				if( 1u == max_count )
+					{
+						demand_t demand;
+						const auto status = m_chain->extract( demand, *this );
+						// Notificator pointer must retain its value only if
+						// there is no messages in mchain.
+						// In other cases this pointer must be dropped.
+						if( extraction_status_t::no_messages != status )
+							m_notificator = nullptr;
+
+						if( extraction_status_t::msg_extracted == status )
+							return try_handle_extracted_message( demand );
+
+						return mchain_receive_result_t{ 0u, 0u, status };
+					}
+				else
+					{
+						const auto status = m_chain->extract_bunch(
+								m_extracted_demands, max_count, *this );
+						if( extraction_status_t::no_messages != status )
+							m_notificator = nullptr;
 
-				if( extraction_status_t::msg_extracted == status )
-					return try_handle_extracted_message( demand );
+						if( extraction_status_t::msg_extracted == status )
+							return handle_extracted_demands();
 
-				return mchain_receive_result_t{ 0u, 0u, status };
+						return mchain_receive_result_t{ 0u, 0u, status };
+					}
 			}
 
 		//! Get the underlying mchain.
@@ -227,6 +264,40 @@ class select_case_t
 		 */
 		virtual mchain_receive_result_t
 		try_handle_extracted_message( demand_t & demand ) = 0;
+
+	private :
+		//! Handle all messages from the extracted batch.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		mchain_receive_result_t
+		handle_extracted_demands()
+			{
+				// The buffer must be cleaned up even if a handler throws.
+				auto buffer_cleaner = so_5::details::at_scope_exit(
+						[this] { m_extracted_demands.clear(); } );
+
+				std::size_t handled = 0;
+				auto it = m_extracted_demands.begin();
+				try
+					{
+						for(; it != m_extracted_demands.end(); ++it )
+							handled += try_handle_extracted_message( *it ).handled();
+					}
+				catch( ... )
+					{
+						// The rest of the batch must not be lost.
+						m_chain->return_demands(
+								std::next( it ), m_extracted_demands.end() );
+						throw;
+					}
+
+				return mchain_receive_result_t{
+						m_extracted_demands.size(),
+						handled,
+						extraction_status_t::msg_extracted };
+			}
 	};
 
 //
@@ -20,6 +20,7 @@
 #include <functional>
 #include <future>
 #include <atomic>
+#include <cstdint>
 
 namespace so_5
 {
@@ -144,6 +145,19 @@ class SO_5_TYPE message_t : public atomic_refcounted_t
 		 */
 		message_mutability_t m_mutability;
 
+		/*!
+		 * \brief Decision of message delivery tracing about this message.
+		 *
+		 * It is used only if message delivery tracing is enabled with
+		 * sampling of messages. The decision is made at the start of
+		 * every delivery of the message and then is reused at all other
+		 * points of this delivery.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		mutable std::atomic< std::uint8_t > m_tracing_mark;
+
 		/*!
 		 * \since
 		 * v.5.5.9
@@ -0,0 +1,250 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Public stuff for content-based routing mboxes.
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+#include <so_5/h/compiler_features.hpp>
+
+#include <so_5/rt/h/mbox.hpp>
+#include <so_5/rt/h/message.hpp>
+
+#include <so_5/details/h/lambda_traits.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <typeindex>
+
+namespace so_5
+{
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Stuff related to content-based routing mboxes.
+ *
+ * A routing mbox is a MPMC-mbox which knows how to extract
+ * a routing key from a message. Subscribers of routing mbox can set
+ * a key-based delivery filter (via so_5::routing::key_equal() or
+ * so_5::routing::key_range()). The routing mbox holds an index from keys to
+ * subscribers. Because of that a message is delivered only to subscribers
+ * with matching filters and delivery filters of other subscribers are
+ * not called at all.
+ *
+ * \par Usage example:
+	\code
+	struct md_update { std::int64_t m_instrument; double m_price; };
+
+	// Creation of routing mbox.
+	auto mbox = env.create_routing_mbox(
+		so_5::routing::mbox_params_t{}.key_extractor(
+			[]( const md_update & m ) { return m.m_instrument; } ) );
+
+	// Subscription to a routing mbox.
+	void subscriber::so_define_agent() {
+		so_set_delivery_filter< md_update >( mbox,
+			so_5::routing::key_equal( m_instrument ) );
+		so_subscribe( mbox ).event( &subscriber::on_update );
+	}
+	\endcode
+ *
+ * \note Ordinary delivery filters can also be used with routing mbox.
+ * But they are checked sequentially for every message like
+ * in ordinary MPMC-mboxes.
+ */
+namespace routing
+{
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of routing key.
+ */
+using key_t = std::int64_t;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of functional object for extraction of routing key from
+ * a message instance.
+ */
+using key_extractor_t = std::function< key_t( message_t & ) >;
+
+//
+// key_filter_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A delivery filter which can be indexed by routing mbox.
+ *
+ * Allows delivery of messages with routing key in the range [low, high]
+ * (both sides inclusive). The equality filter is represented as
+ * a range with low == high.
+ *
+ * \attention This filter is intended to be used only with routing mbox.
+ * It is because only routing mbox knows how to extract the key from
+ * a message. If this filter is used with ordinary mbox then it blocks
+ * all messages.
+ */
+class SO_5_TYPE key_filter_t : public delivery_filter_t
+	{
+	public :
+		key_filter_t(
+			key_t low,
+			key_t high );
+		virtual ~key_filter_t();
+
+		//! Low boundary of the range.
+		key_t
+		low() const { return m_low; }
+
+		//! High boundary of the range.
+		key_t
+		high() const { return m_high; }
+
+		//! Is key inside the range?
+		bool
+		match( key_t key ) const
+			{
+				return m_low <= key && key <= m_high;
+			}
+
+		virtual bool
+		check(
+			const agent_t & receiver,
+			message_t & msg ) const SO_5_NOEXCEPT override;
+
+	private :
+		const key_t m_low;
+		const key_t m_high;
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Create a filter which allows only messages with the specified key.
+ */
+inline delivery_filter_unique_ptr_t
+key_equal( key_t key )
+	{
+		return delivery_filter_unique_ptr_t{ new key_filter_t{ key, key } };
+	}
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Create a filter which allows only messages with key in
+ * the range [low, high].
+ *
+ * \throw so_5::exception_t if low > high.
+ */
+SO_5_FUNC delivery_filter_unique_ptr_t
+key_range( key_t low, key_t high );
+
+//
+// mbox_params_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Parameters for creation of routing mbox.
+ */
+class mbox_params_t
+	{
+	public :
+		//! Type of map of key extractors.
+		using extractors_map_t = std::map< std::type_index, key_extractor_t >;
+
+		//! Set a key extractor for a message type.
+		/*!
+		 * Message type is detected from the argument of \a lambda.
+		 * There can be only one key extractor for a message type.
+		 *
+		 * \note Key extractor must not throw.
+		 */
+		template< typename LAMBDA >
+		mbox_params_t &
+		key_extractor( LAMBDA && lambda );
+
+		//! Get all key extractors.
+		const extractors_map_t &
+		key_extractors() const { return m_extractors; }
+
+	private :
+		//! Key extractors for message types.
+		extractors_map_t m_extractors;
+	};
+
+namespace details
+{
+
+//
+// lambda_as_key_extractor_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A wrapper around user-supplied lambda which
+ * extracts a key from message payload.
+ */
+template< typename LAMBDA, typename MESSAGE >
+class lambda_as_key_extractor_t
+	{
+		LAMBDA m_extractor;
+
+	public :
+		lambda_as_key_extractor_t( LAMBDA extractor )
+			:	m_extractor( std::move(extractor) )
+			{}
+
+		key_t
+		operator()( message_t & msg ) const
+			{
+				return static_cast< key_t >( m_extractor(
+						message_payload_type< MESSAGE >::payload_reference( msg ) ) );
+			}
+	};
+
+} /* namespace details */
+
+template< typename LAMBDA >
+mbox_params_t &
+mbox_params_t::key_extractor( LAMBDA && lambda )
+	{
+		using namespace so_5::details::lambda_traits;
+
+		using argument_type = typename argument_type_if_lambda< LAMBDA >::type;
+		using lambda_type = typename std::decay< LAMBDA >::type;
+
+		ensure_not_signal< argument_type >();
+
+		m_extractors[ message_payload_type< argument_type >::subscription_type_index() ] =
+				details::lambda_as_key_extractor_t< lambda_type, argument_type >{
+						std::forward< LAMBDA >(lambda) };
+
+		return *this;
+	}
+
+} /* namespace routing */
+
+} /* namespace so_5 */
@@ -20,6 +20,7 @@
 #include <so_5/rt/h/send_functions.hpp>
 
 #include <so_5/rt/h/mchain_select.hpp>
+#include <so_5/rt/h/mchain_consumer.hpp>
 
 #include <so_5/h/chrono_helpers.hpp>
 
@@ -40,6 +40,25 @@ namespace impl
 						message_payload_type< MESSAGE >::mutability() );
 				}
 
+			template< typename... ARGS >
+			static void
+			send_with_priority(
+				const so_5::mchain_t & to,
+				priority_t priority,
+				ARGS &&... args )
+				{
+					auto msg = so_5::details::make_message_instance< MESSAGE >(
+							std::forward< ARGS >( args )...);
+					change_message_mutability(
+							*msg,
+							message_payload_type< MESSAGE >::mutability() );
+
+					to->deliver_message_with_priority(
+						priority,
+						message_payload_type< MESSAGE >::subscription_type_index(),
+						message_ref_t( msg.release() ) );
+				}
+
 			template< typename... ARGS >
 			static void
 			send_delayed(
@@ -89,6 +108,17 @@ namespace impl
 					to->deliver_signal< actual_signal_type >();
 				}
 
+			static void
+			send_with_priority(
+				const so_5::mchain_t & to,
+				priority_t priority )
+				{
+					to->deliver_message_with_priority(
+						priority,
+						message_payload_type< MESSAGE >::subscription_type_index(),
+						message_ref_t() );
+				}
+
 			static void
 			send_delayed(
 				so_5::environment_t & env,
@@ -303,6 +333,43 @@ send( TARGET && to, mhood_t< MESSAGE > /*what*/ )
 						typename message_payload_type<MESSAGE>::subscription_type >();
 	}
 
+/*!
+ * \brief A utility function for creating and delivering a message or
+ * a signal to mchain with the explicitly specified priority.
+ *
+ * The message goes to the priority lane of the chain. If the chain has
+ * no priority lanes then the message is stored as an ordinary one.
+ *
+ * Usage example:
+ * \code
+	so_5::mchain_t ch = env.create_mchain(
+		so_5::make_unlimited_mchain_params()
+			.priority_lane( so_5::prio::p0, so_5::mchain_props::capacity_t{} )
+			.priority_lane( so_5::prio::p7, so_5::mchain_props::capacity_t{} ) );
+	...
+	so_5::send< data_chunk >( ch, ... ); // Goes to lane p0.
+	so_5::send_with_priority< cancel >( ch, so_5::prio::p7, request_id );
+ * \endcode
+ *
+ * \see mchain_params_t::priority_lane().
+ *
+ * \since
+ * v.5.5.20
+ */
+template< typename MESSAGE, typename... ARGS >
+void
+send_with_priority(
+	//! Chain for the message.
+	const so_5::mchain_t & to,
+	//! Priority of the message.
+	priority_t priority,
+	//! Message constructor parameters.
+	ARGS&&... args )
+	{
+		so_5::impl::instantiator_and_sender< MESSAGE >::send_with_priority(
+				to, priority, std::forward<ARGS>(args)... );
+	}
+
 /*!
  * \since
  * v.5.5.1
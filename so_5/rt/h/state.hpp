@@ -1737,16 +1737,6 @@ class SO_5_TYPE state_t final
 		void
 		handle_time_limit_on_enter() const;
 
-		/*!
-		 * \since
-		 * v.5.5.15
-		 *
-		 * \brief A special handler of time limit to be used on exiting from state.
-		 * \attention This method must be called only if m_time_limit is not null.
-		 */
-		void
-		handle_time_limit_on_exit() const;
-
 		/*!
 		 * \since
 		 * v.5.5.15
@@ -1769,7 +1759,6 @@ class SO_5_TYPE state_t final
 		void
 		call_on_exit() const
 			{
-				if( m_time_limit ) handle_time_limit_on_exit();
 				if( m_on_exit ) m_on_exit();
 			}
 		/*!
@@ -0,0 +1,135 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Public stuff for mboxes with hierarchical topics.
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+#include <so_5/h/atomic_refcounted.hpp>
+
+#include <so_5/rt/h/mbox.hpp>
+
+#include <string>
+
+namespace so_5
+{
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Stuff related to mboxes with hierarchical topics.
+ *
+ * A topic is a string which consists of segments separated by dots.
+ * For example: "md.eq.AAPL.trade". A topic pattern is a topic which
+ * can contain wildcard segments:
+ * - "*" matches exactly one segment;
+ * - "#" matches zero or more segments. It can be used only as
+ *   the last segment of pattern.
+ *
+ * All topics and patterns live in a topic space. Topic space creates
+ * a mbox for every topic or pattern. There is only one mbox for a name
+ * in the space (mbox_t returned for the same name always refers to
+ * the same mbox id).
+ *
+ * A message sent to a topic mbox is delivered to subscribers of all
+ * mboxes whose names match the topic. Topic mbox itself is also matched.
+ * A message can't be sent to a pattern mbox, pattern mboxes are intended
+ * only for subscriptions.
+ *
+ * \par Usage example:
+	\code
+	struct trade { double m_price; unsigned int m_qty; };
+
+	// Creation of topic space.
+	auto space = env.create_topic_space();
+
+	// Subscription to trades of all equities.
+	void subscriber::so_define_agent() {
+		so_subscribe( space->mbox( "md.eq.*.trade" ) )
+			.event( &subscriber::on_trade );
+	}
+
+	// Publishing of trade for the specific instrument.
+	so_5::send< trade >( space->mbox( "md.eq.AAPL.trade" ), 120.5, 100u );
+	\endcode
+ *
+ * \note If an agent is subscribed to several patterns which match
+ * the same topic it receives a message several times: one time for every
+ * matching pattern.
+ *
+ * \attention Mboxes created by topic space are not destroyed until
+ * the topic space itself is destroyed. Because of that topic space is not
+ * intended for the very large set of short-lived topics.
+ */
+namespace topics
+{
+
+//
+// space_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An interface of topic space.
+ *
+ * \note Topic space is created by environment_t::create_topic_space().
+ * All methods of topic space are thread safe.
+ */
+class SO_5_TYPE space_t : protected atomic_refcounted_t
+	{
+		friend class intrusive_ptr_t< space_t >;
+
+		space_t( const space_t & ) = delete;
+		space_t &
+		operator=( const space_t & ) = delete;
+
+	public :
+		space_t();
+		virtual ~space_t();
+
+		//! Get mbox for a topic or topic pattern.
+		/*!
+		 * \throw so_5::exception_t if \a name is not a valid topic name.
+		 */
+		virtual mbox_t
+		mbox(
+			//! Name of topic or topic pattern.
+			const std::string & name ) = 0;
+
+		//! Count of different topics and patterns in the space.
+		virtual std::size_t
+		size() const = 0;
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Smart reference to topic space.
+ */
+using space_ref_t = intrusive_ptr_t< space_t >;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Does the name represent a topic pattern?
+ *
+ * \retval true if \a name contains wildcard segments.
+ */
+SO_5_FUNC bool
+is_pattern( const std::string & name );
+
+} /* namespace topics */
+
+} /* namespace so_5 */
@@ -76,6 +76,17 @@ class internal_env_iface_t
 		so_5::msg_tracing::tracer_t &
 		msg_tracer() const;
 
+		//! Get a storage for statistics of event handlers of the agent.
+		/*!
+		 * \return nullptr if statistics of event handlers are not
+		 * collected.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		std::shared_ptr< stats::impl::event_handler_stats_storage_t >
+		event_handler_stats_storage( const agent_t & agent ) const;
+
 		//! Get default lock_factory for MPSC queues.
 		/*!
 		 * \since
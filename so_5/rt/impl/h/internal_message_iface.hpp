@@ -45,6 +45,75 @@ class internal_message_iface_t
 			{
 				return m_msg.so5__payload_ptr();
 			}
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Values of decision of message delivery tracing.
+		 */
+		enum class tracing_mark_t : std::uint8_t
+			{
+				//! Decision is not made yet.
+				undecided,
+				//! Message is traced.
+				selected,
+				//! Message is not traced.
+				skipped
+			};
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Get decision of message delivery tracing about the message.
+		 */
+		tracing_mark_t
+		tracing_mark() const
+			{
+				return static_cast< tracing_mark_t >(
+						m_msg.m_tracing_mark.load( std::memory_order_relaxed ) );
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Store decision of message delivery tracing.
+		 *
+		 * The previous decision is replaced. It is used at the start
+		 * of a new delivery of the message.
+		 */
+		void
+		set_tracing_mark( tracing_mark_t mark ) const
+			{
+				m_msg.m_tracing_mark.store(
+						static_cast< std::uint8_t >( mark ),
+						std::memory_order_relaxed );
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Store decision of message delivery tracing if it is
+		 * not made yet.
+		 *
+		 * \return the actual decision. It can differ from \a mark if
+		 * the decision was made by another thread.
+		 */
+		tracing_mark_t
+		try_set_tracing_mark( tracing_mark_t mark ) const
+			{
+				auto expected =
+						static_cast< std::uint8_t >( tracing_mark_t::undecided );
+				if( m_msg.m_tracing_mark.compare_exchange_strong(
+						expected, static_cast< std::uint8_t >( mark ),
+						std::memory_order_relaxed ) )
+					return mark;
+
+				return static_cast< tracing_mark_t >( expected );
+			}
 	};
 
 } /* namespace impl */
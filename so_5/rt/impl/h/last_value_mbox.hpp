@@ -0,0 +1,248 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief A definition of the last-value-cache mbox.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/local_mbox.hpp>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// last_value_mbox_template
+//
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A template with implementation of MPMC-mbox which holds
+ * the last message of every type.
+ *
+ * Works just like local_mbox_template but stores the last delivered
+ * message of every type. This message is delivered to a new subscriber
+ * right at the time of subscription. It allows late-joining agents to get
+ * the current value without additional request/response interaction.
+ *
+ * The separate lock protects only the map of the last values (and
+ * the info about delivery filters). The ordinary delivery of a message is
+ * performed outside of that lock. Because of that senders are not
+ * serialized by the last-value mbox and an overlimit reaction can
+ * redirect a message to another mbox without any risk of deadlock.
+ *
+ * A new subscriber never receives the stale message after the new one.
+ * But if a subscription is made at the same time with sending of a new
+ * message the subscriber can receive that message twice: as the replayed
+ * last value and by the ordinary delivery.
+ *
+ * \note The replayed message doesn't respect subscriber's message limit.
+ * It is at most one message of every type for one subscription and it
+ * usually waits in the agent's storage of deferred demands until the
+ * agent is bound to its event queue. A slot of a message limit would be
+ * held for all that time.
+ *
+ * \note Service requests are not stored.
+ *
+ * \tparam TRACING_BASE base class with implementation of message
+ * delivery tracing methods.
+ */
+template< typename TRACING_BASE >
+class last_value_mbox_template
+	:	public local_mbox_template< TRACING_BASE >
+	{
+		using base_type = local_mbox_template< TRACING_BASE >;
+
+	public:
+		template< typename... TRACING_ARGS >
+		last_value_mbox_template(
+			//! ID of this mbox.
+			mbox_id_t id,
+			//! Optional parameters for TRACING_BASE's constructor.
+			TRACING_ARGS &&... args )
+			:	base_type{ id, args... }
+			,	m_replay_tracing{ std::forward< TRACING_ARGS >(args)... }
+			{}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & type_wrapper,
+			const so_5::message_limit::control_block_t * limit,
+			agent_t * subscriber ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_values_lock };
+
+				base_type::subscribe_event_handler( type_wrapper, limit, subscriber );
+
+				// The replay is performed under the lock. Otherwise a newer
+				// message could be delivered before the replayed one.
+				auto it = m_last_values.find( type_wrapper );
+				if( it != m_last_values.end() )
+					replay_last_value( type_wrapper, it->second, *subscriber );
+			}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mbox:type=MPMC-LVC:id=" << this->id() << ">";
+
+				return s.str();
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				// Mutable message must not be stored.
+				if( message_mutability_t::immutable_message !=
+						message_mutability( message ) )
+					SO_5_THROW_EXCEPTION(
+							so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox,
+							"an attempt to deliver mutable message via MPMC mbox"
+							", msg_type=" + std::string(msg_type.name()) );
+
+				{
+					std::lock_guard< std::mutex > lock{ m_values_lock };
+					m_last_values[ msg_type ] = message;
+				}
+
+				base_type::do_deliver_message(
+						msg_type, message, overlimit_reaction_deep );
+			}
+
+		virtual void
+		set_delivery_filter(
+			const std::type_index & msg_type,
+			const delivery_filter_t & filter,
+			agent_t & subscriber ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_values_lock };
+
+				base_type::set_delivery_filter( msg_type, filter, subscriber );
+
+				m_filters[ filter_key_t{ msg_type, &subscriber } ] = &filter;
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & msg_type,
+			agent_t & subscriber ) SO_5_NOEXCEPT override
+			{
+				std::lock_guard< std::mutex > lock{ m_values_lock };
+
+				base_type::drop_delivery_filter( msg_type, subscriber );
+
+				m_filters.erase( filter_key_t{ msg_type, &subscriber } );
+			}
+
+	private :
+		//! Type of map from message type to the last message.
+		using last_values_map_t = std::map< std::type_index, message_ref_t >;
+
+		//! Type of key for delivery filters.
+		using filter_key_t = std::pair< std::type_index, const agent_t * >;
+
+		//! Type of map of delivery filters.
+		using filters_map_t = std::map< filter_key_t, const delivery_filter_t * >;
+
+		//! Tracing stuff for replaying of the last values.
+		TRACING_BASE m_replay_tracing;
+
+		//! Lock for the last values and delivery filters.
+		mutable std::mutex m_values_lock;
+
+		//! The last messages.
+		/*!
+		 * \note Signals are stored as null references.
+		 */
+		mutable last_values_map_t m_last_values;
+
+		//! Delivery filters of subscribers.
+		/*!
+		 * \note The same filters are held by the base class. They are
+		 * duplicated here for checking of replayed messages.
+		 */
+		filters_map_t m_filters;
+
+		//! Deliver stored message to a new subscriber.
+		/*!
+		 * \note Must be called only when m_values_lock is acquired.
+		 */
+		void
+		replay_last_value(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			agent_t & subscriber )
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						m_replay_tracing,
+						*this, // as abstract_message_box_t
+						"replay_last_value",
+						msg_type, message, 1 };
+
+				// Delivery filters are not applicable to signals.
+				if( message )
+					{
+						auto it = m_filters.find( filter_key_t{ msg_type, &subscriber } );
+						if( it != m_filters.end() &&
+								!it->second->check( subscriber, *message ) )
+							{
+								tracer.message_rejected(
+										&subscriber,
+										delivery_possibility_t::disabled_by_delivery_filter );
+								return;
+							}
+					}
+
+				tracer.push_to_queue( &subscriber );
+
+				// Subscription is usually made before the binding
+				// of the subscriber to the event queue.
+				agent_t::call_push_deferrable_event(
+						subscriber,
+						so_5::message_limit::control_block_t::none(),
+						this->id(),
+						msg_type,
+						message );
+			}
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Alias for last-value-cache mbox without message delivery tracing.
+ */
+using last_value_mbox_without_tracing =
+	last_value_mbox_template< msg_tracing_helpers::tracing_disabled_base >;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Alias for last-value-cache mbox with message delivery tracing.
+ */
+using last_value_mbox_with_tracing =
+	last_value_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -0,0 +1,986 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Implementation of message chains based on lock-free ring buffer.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/mchain_details.hpp>
+
+#include <so_5/details/h/abort_on_fatal_error.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// lock_free_ring_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Bounded lock-free ring buffer for demands.
+ *
+ * It is an adaptation of well-known bounded MPMC queue by Dmitry Vyukov.
+ * Every cell has a sequence number which tells whether the cell is ready
+ * for writing or reading at the specified position.
+ *
+ * Positions are taken by CAS only if there can be several producers
+ * (\a PRODUCERS is multiplicity_t::multiple). Positions for reading are
+ * always taken by CAS because the oldest demand can be removed by
+ * a producer (overflow_reaction_t::remove_oldest) or by close() with
+ * close_mode_t::drop_content.
+ *
+ * \note This class doesn't count items. Free space must be reserved by
+ * the owner of the ring before the call to try_push().
+ */
+template< multiplicity_t PRODUCERS >
+class lock_free_ring_t
+	{
+		//! One cell of the ring.
+		struct cell_t
+			{
+				std::atomic< std::size_t > m_sequence;
+				demand_t m_demand;
+			};
+
+	public :
+		lock_free_ring_t( const lock_free_ring_t & ) = delete;
+		lock_free_ring_t &
+		operator=( const lock_free_ring_t & ) = delete;
+
+		//! Initializing constructor.
+		lock_free_ring_t( std::size_t capacity )
+			:	m_capacity( capacity )
+			,	m_cells( new cell_t[ capacity ] )
+			{
+				for( std::size_t i = 0; i != m_capacity; ++i )
+					m_cells[ i ].m_sequence.store( i, std::memory_order_relaxed );
+			}
+
+		//! An attempt to push a new demand to the end of the ring.
+		/*!
+		 * \return false if there is no free cell at the moment.
+		 */
+		bool
+		try_push( demand_t && demand )
+			{
+				std::size_t pos = m_push_pos.load( std::memory_order_relaxed );
+				cell_t * cell;
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const auto seq = cell->m_sequence.load(
+								std::memory_order_acquire );
+						const auto diff = static_cast< std::ptrdiff_t >( seq ) -
+								static_cast< std::ptrdiff_t >( pos );
+						if( 0 == diff )
+							{
+								if( take_push_pos( pos ) )
+									break;
+							}
+						else if( diff < 0 )
+							// The cell is still occupied.
+							return false;
+						else
+							pos = m_push_pos.load( std::memory_order_relaxed );
+					}
+
+				cell->m_demand = std::move(demand);
+				cell->m_sequence.store( pos + 1, std::memory_order_release );
+
+				return true;
+			}
+
+		//! An attempt to extract the oldest demand from the ring.
+		/*!
+		 * \return false if there is no ready demand at the moment.
+		 */
+		bool
+		try_pop( demand_t & dest )
+			{
+				std::size_t pos = m_pop_pos.load( std::memory_order_relaxed );
+				cell_t * cell;
+				for(;;)
+					{
+						cell = &m_cells[ pos % m_capacity ];
+						const auto seq = cell->m_sequence.load(
+								std::memory_order_acquire );
+						const auto diff = static_cast< std::ptrdiff_t >( seq ) -
+								static_cast< std::ptrdiff_t >( pos + 1 );
+						if( 0 == diff )
+							{
+								if( m_pop_pos.compare_exchange_weak(
+										pos, pos + 1, std::memory_order_relaxed ) )
+									break;
+							}
+						else if( diff < 0 )
+							// There is no ready demand.
+							return false;
+						else
+							pos = m_pop_pos.load( std::memory_order_relaxed );
+					}
+
+				dest = std::move(cell->m_demand);
+				cell->m_sequence.store(
+						pos + m_capacity, std::memory_order_release );
+
+				return true;
+			}
+
+	private :
+		//! Capacity of the ring.
+		const std::size_t m_capacity;
+
+		//! Cells of the ring.
+		std::unique_ptr< cell_t[] > m_cells;
+
+		//! Position for the next push.
+		std::atomic< std::size_t > m_push_pos{ 0 };
+
+		//! Position for the next pop.
+		std::atomic< std::size_t > m_pop_pos{ 0 };
+
+		//! Take the position for push.
+		/*!
+		 * \return false if position has been taken by another producer.
+		 * In that case \a pos receives an actual value.
+		 */
+		bool
+		take_push_pos( std::size_t & pos )
+			{
+				if( multiplicity_t::single == PRODUCERS )
+					{
+						m_push_pos.store( pos + 1, std::memory_order_relaxed );
+						return true;
+					}
+				else
+					return m_push_pos.compare_exchange_weak(
+							pos, pos + 1, std::memory_order_relaxed );
+			}
+	};
+
+} /* namespace details */
+
+//
+// lock_free_mchain_template
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Implementation of size-limited message chain for the case
+ * of single consumer.
+ *
+ * Demands are stored in a lock-free ring. The count of demands is
+ * maintained separately: a producer reserves a place in the chain by
+ * atomic increment of that count before pushing a demand to the ring.
+ *
+ * Chain's mutex is used only for sleeping on empty or full chain,
+ * for maintaining of multi chain select queue and for waking up
+ * sleeping threads. A producer acquires the mutex only if there are
+ * sleeping consumers or waiting select operations. A consumer acquires
+ * the mutex only if there are sleeping producers or the chain is empty.
+ *
+ * \tparam PRODUCERS multiplicity of producers.
+ * \tparam TRACING_BASE type with message tracing implementation details.
+ */
+template< multiplicity_t PRODUCERS, typename TRACING_BASE >
+class lock_free_mchain_template
+	:	public abstract_message_chain_t
+	,	private TRACING_BASE
+	{
+	public :
+		//! Initializing constructor.
+		template< typename... TRACING_ARGS >
+		lock_free_mchain_template(
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for TRACING_BASE's constructor.
+			TRACING_ARGS &&... tracing_args )
+			:	TRACING_BASE( std::forward<TRACING_ARGS>(tracing_args)... )
+			,	m_env( env )
+			,	m_id( id )
+			,	m_capacity( params.capacity() )
+			,	m_not_empty_notificator( params.not_empty_notificator() )
+			,	m_extraction_batch_size( params.extraction_batch_size() )
+			,	m_ring( params.capacity().max_size() )
+			{}
+
+		virtual mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			const so_5::message_limit::control_block_t * /*limit*/,
+			agent_t * /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_subscriptions,
+						"mchain doesn't suppor subscription" );
+			}
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & /*msg_type*/,
+			agent_t * /*subscriber*/ ) override
+			{}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mchain:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		virtual mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_message() lost const in v.5.6.0.
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::event,
+							false,
+							overlimit_reaction_deep );
+			}
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::service_request,
+							false,
+							overlimit_reaction_deep );
+			}
+
+		/*!
+		 * \attention Will throw an exception because delivery
+		 * filter is not applicable to MPSC-mboxes.
+		 */
+		virtual void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			agent_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_delivery_filters,
+						"set_delivery_filter is called for mchain" );
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			agent_t & /*subscriber*/ ) SO_5_NOEXCEPT override
+			{}
+
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout ) override
+			{
+				if( !try_extract( dest ) && !wait_and_extract(
+						dest, empty_queue_timeout ) )
+					return status_for_empty_queue();
+
+				on_demands_extracted( 1u );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			duration_t empty_queue_timeout ) override
+			{
+				demand_t demand;
+				if( !try_extract( demand ) && !wait_and_extract(
+						demand, empty_queue_timeout ) )
+					return status_for_empty_queue();
+
+				dest.push_back( std::move(demand) );
+				extract_rest_of_bunch( dest, max_count );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		/*!
+		 * Returned demands are kept outside of the ring because they must
+		 * be extracted before all other demands.
+		 */
+		virtual void
+		return_demands(
+			std::vector< demand_t >::iterator first,
+			std::vector< demand_t >::iterator last ) override
+			{
+				if( first == last )
+					return;
+
+				std::size_t prev_size = 0u;
+				{
+					std::lock_guard< std::mutex > lock{ m_returned_lock };
+
+					m_returned.insert(
+							m_returned.begin(),
+							std::make_move_iterator( first ),
+							std::make_move_iterator( last ) );
+
+					// Returned demands are counted before they become visible
+					// for the consumer. They are counted even if the chain is
+					// full or closed.
+					prev_size = m_size.fetch_add(
+							static_cast< std::size_t >(
+									std::distance( first, last ) ) ) & ~closed_flag();
+
+					m_has_returned.store( true, std::memory_order_release );
+				}
+
+				notify_about_new_demands( 0u == prev_size );
+			}
+
+		virtual bool
+		empty() const override
+			{
+				return 0u == size();
+			}
+
+		virtual std::size_t
+		size() const override
+			{
+				return m_size.load( std::memory_order_acquire ) & ~closed_flag();
+			}
+
+		virtual void
+		close( close_mode_t mode ) override
+			{
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+
+					// No more places can be reserved after that.
+					if( closed_flag() & m_size.fetch_or( closed_flag() ) )
+						return;
+
+					// Someone can wait on full chain for free place for new
+					// message. It must be informed that the chain is closed.
+					m_overflow_cond.notify_all();
+				}
+
+				if( close_mode_t::drop_content == mode )
+					{
+						// There can be producers which have reserved places
+						// before closing. Their messages must be dropped too.
+						demand_t demand;
+						while( size() )
+							{
+								if( try_pop_oldest( demand ) )
+									{
+										this->trace_demand_drop_on_close( *this, demand );
+										demand = demand_t{};
+										m_size.fetch_sub( 1u );
+									}
+								else
+									std::this_thread::yield();
+							}
+					}
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				// Multi chain selects must be informed about closing
+				// even if there are messages in the chain.
+				notify_multi_chain_select_ops();
+
+				// Someone can wait on empty chain for new messages.
+				// It must be informed that no new messages will be here.
+				m_underflow_cond.notify_all();
+			}
+
+		virtual environment_t &
+		environment() const override
+			{
+				return m_env;
+			}
+
+	protected :
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			select_case_t & select_case ) override
+			{
+				if( !try_extract( dest ) )
+					return add_to_select_tail_if_open( select_case );
+
+				on_demands_extracted( 1u );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			select_case_t & select_case ) override
+			{
+				demand_t demand;
+				if( !try_extract( demand ) )
+					return add_to_select_tail_if_open( select_case );
+
+				dest.push_back( std::move(demand) );
+				extract_rest_of_bunch( dest, max_count );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual void
+		remove_from_select(
+			select_case_t & select_case ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				select_case_t * c = m_select_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &select_case )
+							{
+								if( prev )
+									prev->set_next( next );
+								else
+									m_select_tail = next;
+
+								break;
+							}
+
+						prev = c;
+						c = next;
+					}
+
+				if( !m_select_tail )
+					m_has_select_cases.store( false, std::memory_order_relaxed );
+			}
+
+		virtual void
+		do_deliver_message_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t & message ) override
+			{
+				try_to_store_message_to_queue(
+						msg_type,
+						message,
+						invocation_type_t::event,
+						true,
+						1u );
+			}
+
+	private :
+		//! SObjectizer Environment for which message chain is created.
+		environment_t & m_env;
+
+		//! Mbox ID for chain.
+		const mbox_id_t m_id;
+
+		//! Chain capacity.
+		const capacity_t m_capacity;
+
+		//! Optional notificator for 'not_empty' condition.
+		const not_empty_notification_func_t m_not_empty_notificator;
+
+		//! Max count of messages to be extracted at once.
+		const std::size_t m_extraction_batch_size;
+
+		//! Chain's demands.
+		details::lock_free_ring_t< PRODUCERS > m_ring;
+
+		//! Count of demands in the chain (including reserved places)
+		//! and status of the chain.
+		/*!
+		 * The highest bit is set when the chain is closed. It allows
+		 * to check the status and to reserve a place for a new demand
+		 * by one atomic operation.
+		 */
+		std::atomic< std::size_t > m_size{ 0 };
+
+		//! Is there a consumer which is going to sleep on empty chain?
+		/*!
+		 * This flag is set by a consumer before every check of the chain
+		 * under m_lock. It is reset by a producer which wakes the consumer
+		 * up. So only the first producer after the check acquires m_lock.
+		 */
+		std::atomic< bool > m_consumers_wakeup_needed{ false };
+
+		//! Is there a producer which is going to sleep on full chain?
+		/*!
+		 * The same scheme as for m_consumers_wakeup_needed.
+		 */
+		std::atomic< bool > m_producers_wakeup_needed{ false };
+
+		//! Is there any multi chain select in m_select_tail?
+		std::atomic< bool > m_has_select_cases{ false };
+
+		//! Chain's lock.
+		/*!
+		 * Used only for sleeping and waking up.
+		 */
+		std::mutex m_lock;
+
+		//! Lock for returned demands.
+		/*!
+		 * It is a separate lock because returned demands are extracted
+		 * under m_lock too.
+		 */
+		std::mutex m_returned_lock;
+
+		//! Demands returned by return_demands().
+		/*!
+		 * \note Must be accessed only under m_returned_lock.
+		 */
+		std::deque< demand_t > m_returned;
+
+		//! Is there any returned demand?
+		std::atomic< bool > m_has_returned{ false };
+
+		//! Condition variable for waiting on empty queue.
+		std::condition_variable m_underflow_cond;
+		//! Condition variable for waiting on full queue.
+		std::condition_variable m_overflow_cond;
+
+		//! A queue of multi-chain selects in which this chain is used.
+		/*!
+		 * \note Must be accessed only under m_lock.
+		 */
+		select_case_t * m_select_tail = nullptr;
+
+		//! The bit in m_size for closed chain.
+		static std::size_t
+		closed_flag()
+			{
+				return ~( std::numeric_limits< std::size_t >::max() >> 1 );
+			}
+
+		bool
+		is_closed() const
+			{
+				return 0u != ( m_size.load() & closed_flag() );
+			}
+
+		//! Is the chain closed and there is no more demands?
+		/*!
+		 * \note There can be demands which places have been reserved before
+		 * closing of the chain. Consumers must wait for them.
+		 */
+		bool
+		is_closed_for_consumers() const
+			{
+				return closed_flag() == m_size.load();
+			}
+
+		//! An attempt to reserve a place for a new message.
+		bool
+		try_reserve_place(
+			//! Receiver for count of demands before the reservation.
+			std::size_t & prev_size )
+			{
+				const auto max_size = m_capacity.max_size();
+				prev_size = m_size.load();
+				do
+					{
+						// NOTE: this check fails for closed chain too.
+						if( prev_size >= max_size )
+							return false;
+					}
+				while( !m_size.compare_exchange_weak( prev_size, prev_size + 1 ) );
+
+				return true;
+			}
+
+		//! Actual implementation of pushing message to the ring.
+		void
+		try_to_store_message_to_queue(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			//! Is it a delivery from timer thread?
+			bool from_timer,
+			unsigned int overlimit_reaction_deep )
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type,
+						overlimit_reaction_deep };
+
+				std::size_t prev_size = 0u;
+				bool reserved = try_reserve_place( prev_size );
+
+				// Message cannot be stored to closed chain.
+				if( !reserved && is_closed() )
+					return;
+
+				// NOTE: there is no awaiting on full mchain if delivery
+				// is performed from timer thread.
+				if( !reserved && !from_timer &&
+						m_capacity.is_overflow_timeout_defined() )
+					{
+						std::unique_lock< std::mutex > lock{ m_lock };
+
+						m_overflow_cond.wait_for(
+								lock,
+								m_capacity.overflow_timeout(),
+								[this, &reserved, &prev_size] {
+									m_producers_wakeup_needed.store( true );
+									reserved = try_reserve_place( prev_size );
+									return reserved || is_closed();
+								} );
+
+						// NOTE: if place has been reserved before closing then
+						// message must be stored.
+						if( !reserved && is_closed() )
+							return;
+					}
+
+				// If chain is still full we must perform some reaction.
+				if( !reserved )
+					{
+						auto reaction = m_capacity.overflow_reaction();
+						if( from_timer &&
+								overflow_reaction_t::throw_exception == reaction )
+							reaction = overflow_reaction_t::drop_newest;
+
+						if( overflow_reaction_t::drop_newest == reaction )
+							{
+								// New message must be simply ignored.
+								tracer.overflow_drop_newest();
+								return;
+							}
+						else if( overflow_reaction_t::remove_oldest == reaction )
+							{
+								// The oldest message must be removed.
+								if( !remove_oldest_and_reserve_place(
+										tracer, prev_size ) )
+									// Chain has been closed.
+									return;
+							}
+						else if( overflow_reaction_t::throw_exception == reaction )
+							{
+								tracer.overflow_throw_exception();
+								SO_5_THROW_EXCEPTION(
+										rc_msg_chain_overflow,
+										"an attempt to push message to full mchain "
+										"with overflow_reaction_t::throw_exception policy" );
+							}
+						else
+							{
+								so_5::details::abort_on_fatal_error( [&] {
+										tracer.overflow_throw_exception();
+										SO_5_LOG_ERROR( m_env, log_stream ) {
+											log_stream << "overflow_reaction_t::abort_app "
+													"will be performed for mchain (id="
+													<< m_id << "), msg_type: "
+													<< msg_type.name()
+													<< ". Application will be aborted"
+													<< std::endl;
+										}
+									} );
+							}
+					}
+
+				complete_store_message_to_queue(
+						tracer,
+						demand_t{ msg_type, message, demand_type },
+						0u == prev_size );
+			}
+
+		//! Remove oldest demands until a place for the new one is reserved.
+		/*!
+		 * \return false if the chain has been closed.
+		 */
+		bool
+		remove_oldest_and_reserve_place(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			std::size_t & prev_size )
+			{
+				demand_t oldest;
+				do
+					{
+						if( is_closed() )
+							return false;
+
+						if( try_pop_oldest( oldest ) )
+							{
+								tracer.overflow_remove_oldest( oldest );
+								oldest = demand_t{};
+								m_size.fetch_sub( 1u );
+							}
+						else
+							// Another thread pushes or pops a message just now.
+							std::this_thread::yield();
+					}
+				while( !try_reserve_place( prev_size ) );
+
+				return true;
+			}
+
+		//! Push a demand to the ring and wake up consumers if necessary.
+		/*!
+		 * \attention Place for the demand must be reserved.
+		 */
+		void
+		complete_store_message_to_queue(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			demand_t && demand,
+			//! Was the chain empty before the reservation of place?
+			bool was_empty )
+			{
+				// Place is reserved. But the cell can still be occupied
+				// by a consumer which is extracting the oldest demand.
+				while( !m_ring.try_push( std::move(demand) ) )
+					std::this_thread::yield();
+
+				tracer.stored( *this );
+
+				notify_about_new_demands( was_empty );
+			}
+
+		//! Wake up consumers after appearance of new demands.
+		void
+		notify_about_new_demands(
+			//! Was the chain empty before the appearance of new demands?
+			bool was_empty )
+			{
+				// Producer and sleeping consumer use the same pattern:
+				// modify one variable and then read another one.
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				// If chain was empty then not_empty_notificator
+				// must be used.
+				if( was_empty && m_not_empty_notificator )
+					so_5::details::invoke_noexcept_code(
+						[this] { m_not_empty_notificator(); } );
+
+				const bool wakeup_consumers =
+						m_consumers_wakeup_needed.load( std::memory_order_relaxed ) &&
+						m_consumers_wakeup_needed.exchange( false );
+				if( wakeup_consumers ||
+						m_has_select_cases.load( std::memory_order_relaxed ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+
+						notify_multi_chain_select_ops();
+
+						if( wakeup_consumers )
+							m_underflow_cond.notify_all();
+					}
+			}
+
+		//! An attempt to extract a demand without waiting.
+		bool
+		try_extract( demand_t & dest )
+			{
+				if( try_pop_oldest( dest ) )
+					{
+						this->trace_extracted_demand( *this, dest );
+						return true;
+					}
+
+				return false;
+			}
+
+		//! An attempt to remove the oldest demand.
+		/*!
+		 * Returned demands are the oldest ones.
+		 *
+		 * \return false if there is no ready demand at the moment.
+		 */
+		bool
+		try_pop_oldest( demand_t & dest )
+			{
+				if( m_has_returned.load( std::memory_order_acquire ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_returned_lock };
+						if( !m_returned.empty() )
+							{
+								dest = std::move( m_returned.front() );
+								m_returned.pop_front();
+								if( m_returned.empty() )
+									m_has_returned.store( false, std::memory_order_release );
+
+								return true;
+							}
+					}
+
+				return m_ring.try_pop( dest );
+			}
+
+		//! Waiting on empty chain.
+		/*!
+		 * \return true if a demand has been extracted.
+		 */
+		bool
+		wait_and_extract( demand_t & dest, duration_t empty_queue_timeout )
+			{
+				// There is no need to wait if chain is closed.
+				if( is_closed_for_consumers() )
+					// But the last message could be stored before closing.
+					return try_extract( dest );
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				bool extracted = false;
+				auto predicate = [&]() -> bool {
+						// Producers must know that someone is going to sleep.
+						// The flag must be set before the check of the ring.
+						m_consumers_wakeup_needed.store( true );
+						std::atomic_thread_fence( std::memory_order_seq_cst );
+
+						extracted = try_extract( dest );
+						return extracted || is_closed_for_consumers();
+					};
+
+				if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
+					// A wait with finite timeout must be performed.
+					m_underflow_cond.wait_for(
+							lock, empty_queue_timeout, predicate );
+				else
+					// Wait until arrival of any message or closing of chain.
+					m_underflow_cond.wait( lock, predicate );
+
+				return extracted;
+			}
+
+		//! Extract the rest of batch after extraction of the first demand.
+		void
+		extract_rest_of_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count )
+			{
+				const std::size_t count =
+						(std::min)( max_count, m_extraction_batch_size );
+
+				demand_t demand;
+				std::size_t extracted = 1u;
+				while( extracted < count && try_extract( demand ) )
+					{
+						dest.push_back( std::move(demand) );
+						++extracted;
+					}
+
+				on_demands_extracted( extracted );
+			}
+
+		//! Update the count of demands and wake up sleeping producers.
+		void
+		on_demands_extracted( std::size_t count )
+			{
+				m_size.fetch_sub( count );
+
+				if( m_producers_wakeup_needed.load() &&
+						m_producers_wakeup_needed.exchange( false ) )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+						m_overflow_cond.notify_all();
+					}
+			}
+
+		extraction_status_t
+		status_for_empty_queue() const
+			{
+				return is_closed_for_consumers() ?
+						extraction_status_t::chain_closed :
+						extraction_status_t::no_messages;
+			}
+
+		//! Implementation of extract operation as a part of
+		//! multi chain select for the case when the chain is empty.
+		extraction_status_t
+		add_to_select_tail_if_open( select_case_t & select_case )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( is_closed_for_consumers() )
+					// There is no need to wait for something.
+					return extraction_status_t::chain_closed;
+
+				select_case.set_next( m_select_tail );
+				m_select_tail = &select_case;
+				m_has_select_cases.store( true );
+
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				// A message could be stored (or the chain could be closed)
+				// before the registration. Select must be informed about it
+				// because the producer hasn't seen the registration.
+				if( m_size.load( std::memory_order_relaxed ) )
+					notify_multi_chain_select_ops();
+
+				return extraction_status_t::no_messages;
+			}
+
+		/*!
+		 * \attention Must be called only under m_lock.
+		 */
+		void
+		notify_multi_chain_select_ops() SO_5_NOEXCEPT
+			{
+				if( m_select_tail )
+					{
+						auto old = m_select_tail;
+						m_select_tail = nullptr;
+						m_has_select_cases.store( false, std::memory_order_relaxed );
+						old->notify();
+					}
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
+
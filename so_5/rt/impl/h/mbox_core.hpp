@@ -22,9 +22,13 @@
 #include <so_5/rt/h/mbox.hpp>
 #include <so_5/rt/h/mchain.hpp>
 #include <so_5/rt/h/nonempty_name.hpp>
+#include <so_5/rt/h/routing_mbox.hpp>
+#include <so_5/rt/h/topic_mbox.hpp>
 
 #include <so_5/rt/h/message_limit.hpp>
 
+#include <so_5/rt/impl/h/mchain_stats.hpp>
+
 namespace so_5
 {
 
@@ -93,6 +97,24 @@ class mbox_core_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create anonymous last-value-cache mbox.
+		 */
+		mbox_t
+		create_last_value_mbox();
+
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create a new topic space.
+		 */
+		so_5::topics::space_ref_t
+		create_topic_space();
+
 		/*!
 		 * \since
 		 * v.5.4.0
@@ -109,6 +131,17 @@ class mbox_core_t
 			//! control will be created.
 			const so_5::message_limit::impl::info_storage_t * limits_storage );
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Create anonymous content-based routing mbox.
+		 */
+		mbox_t
+		create_routing_mbox(
+			//! Parameters for the new mbox.
+			const so_5::routing::mbox_params_t & params );
+
 		//! Remove a reference to the named mbox.
 		/*!
 		 * If it was a last reference to named mbox the mbox destroyed.
@@ -142,6 +175,17 @@ class mbox_core_t
 		mbox_core_stats_t
 		query_stats();
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Distribute run-time monitoring information from
+		 * message chains.
+		 */
+		void
+		distribute_mchain_stats(
+			const mbox_t & distribution_mbox );
+
 	private:
 		/*!
 		 * \since
@@ -192,6 +236,15 @@ class mbox_core_t
 		 */
 		std::atomic< mbox_id_t > m_mbox_id_counter;
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 *
+		 * \brief Registry of message chains with run-time monitoring.
+		 */
+		const mchain_props::details::mchain_stats_registry_shptr_t
+				m_mchain_stats_registry;
+
 		/*!
 		 * \since
 		 * v.5.2.0
@@ -20,6 +20,25 @@ namespace rt {
 
 namespace impl {
 
+//
+// timer_message_t
+//
+/*!
+ * \brief A message from an elapsed timer.
+ *
+ * Used for delivery of several messages from timer thread at once.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct timer_message_t
+	{
+		//! Type of the message to deliver.
+		std::type_index m_msg_type;
+		//! A message instance to be delivered.
+		message_ref_t m_message;
+	};
+
 //
 // mbox_iface_for_timers_t
 //
@@ -45,6 +64,20 @@ class mbox_iface_for_timers_t
 				m_mb.do_deliver_message_from_timer( msg_type, message );
 			}
 
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		inline void
+		deliver_messages_from_timer(
+			//! Messages to deliver.
+			const timer_message_t * messages,
+			//! Count of messages.
+			std::size_t count )
+			{
+				m_mb.do_deliver_messages_from_timer( messages, count );
+			}
+
 	private :
 		abstract_message_box_t & m_mb;
 	};
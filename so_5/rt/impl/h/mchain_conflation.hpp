@@ -0,0 +1,204 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Helpers for conflation of messages in message chains.
+ */
+
+#pragma once
+
+#include <so_5/rt/h/mchain.hpp>
+
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// typed_conflation_key_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Full key of conflated message: message type and user key.
+ */
+struct typed_conflation_key_t
+	{
+		std::type_index m_msg_type;
+		conflation_key_t m_key;
+
+		bool
+		operator==( const typed_conflation_key_t & o ) const
+			{
+				return m_msg_type == o.m_msg_type && m_key == o.m_key;
+			}
+	};
+
+//
+// conflation_key_hash_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Hash function for typed_conflation_key_t.
+ */
+struct conflation_key_hash_t
+	{
+		std::size_t
+		operator()( const typed_conflation_key_t & k ) const
+			{
+				const auto h = std::hash< std::type_index >{}( k.m_msg_type );
+				return h ^ ( k.m_key.hash() +
+						0x9e3779b9u + ( h << 6 ) + ( h >> 2 ) );
+			}
+	};
+
+//
+// conflation_index_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Index of demands which can be replaced by new messages
+ * with the same key.
+ *
+ * Index holds pointers to demands inside chain's queue. Because of that
+ * the queue must not move its items during push_back() and pop_front()
+ * operations (std::deque and ring buffer inside std::vector are suitable).
+ *
+ * The owner of the index must call remember() after storing of a new
+ * demand and forget() before the removal of a demand from the queue.
+ *
+ * \note Only ordinary messages and signals are conflated. Service
+ * requests are never replaced because the result of replaced request
+ * would be lost.
+ *
+ * \attention Methods find(), remember(), forget() and clear()
+ * must be called under the chain's lock. Method make_key() is intended
+ * to be called without the lock because it calls the user's key
+ * extractor.
+ */
+class conflation_index_t
+	{
+	public :
+		conflation_index_t( const conflated_types_t & types )
+			:	m_types( types )
+			{}
+
+		//! Is conflation used by the chain?
+		bool
+		enabled() const
+			{
+				return !m_types.empty();
+			}
+
+		//! Make the conflation key for a new message.
+		/*!
+		 * \return false if the message must not be conflated.
+		 */
+		bool
+		make_key(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			//! Receiver for user's part of the key.
+			conflation_key_t & key ) const
+			{
+				if( invocation_type_t::event != demand_type )
+					return false;
+
+				auto it = m_types.find( msg_type );
+				if( it == m_types.end() )
+					return false;
+
+				if( it->second )
+					key = it->second( message );
+
+				return true;
+			}
+
+		//! Find already stored demand with the same key.
+		/*!
+		 * \return nullptr if there is no such demand.
+		 */
+		demand_t *
+		find( const typed_conflation_key_t & key ) const
+			{
+				auto it = m_demands.find( key );
+				return it != m_demands.end() ? it->second : nullptr;
+			}
+
+		//! Remember just stored demand.
+		void
+		remember( typed_conflation_key_t key, demand_t & demand )
+			{
+				auto it = m_demands.emplace( std::move(key), &demand ).first;
+				m_keys.emplace( &demand, &(it->first) );
+			}
+
+		//! Forget a demand which is being removed from the queue.
+		void
+		forget( const demand_t & demand )
+			{
+				if( m_keys.empty() )
+					return;
+
+				auto it = m_keys.find( &demand );
+				if( it != m_keys.end() )
+					{
+						// Key must not be used as an argument for erase()
+						// because it is destroyed during erase().
+						m_demands.erase( m_demands.find( *(it->second) ) );
+						m_keys.erase( it );
+					}
+			}
+
+		//! Forget all demands.
+		void
+		clear()
+			{
+				m_demands.clear();
+				m_keys.clear();
+			}
+
+	private :
+		//! Type of map from conflation key to stored demand.
+		using demands_map_t = std::unordered_map<
+				typed_conflation_key_t, demand_t *, conflation_key_hash_t >;
+
+		//! Type of map from stored demand to its conflation key.
+		/*!
+		 * \note Pointers to keys inside demands_map_t remain valid
+		 * even after rehashing.
+		 */
+		using keys_map_t = std::unordered_map<
+				const demand_t *, const typed_conflation_key_t * >;
+
+		//! Types of conflated messages.
+		const conflated_types_t m_types;
+
+		//! Stored demands with conflated messages.
+		demands_map_t m_demands;
+
+		//! Keys for stored demands.
+		keys_map_t m_keys;
+	};
+
+} /* namespace details */
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
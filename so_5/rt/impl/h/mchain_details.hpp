@@ -16,16 +16,23 @@
 #include <so_5/rt/h/mchain_select_ifaces.hpp>
 #include <so_5/rt/h/environment.hpp>
 
+#include <so_5/rt/impl/h/mchain_conflation.hpp>
+#include <so_5/rt/impl/h/mchain_stats.hpp>
+#include <so_5/rt/impl/h/mbox_iface_for_timers.hpp>
+#include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
+
 #include <so_5/h/ret_code.hpp>
 #include <so_5/h/exception.hpp>
 #include <so_5/h/error_logger.hpp>
 
 #include <so_5/details/h/at_scope_exit.hpp>
 
+#include <algorithm>
 #include <deque>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
+#include <type_traits>
 
 namespace so_5 {
 
@@ -86,7 +93,7 @@ class unlimited_demand_queue
 		/*!
 		 * \note This constructor is necessary just for a convinience.
 		 */
-		unlimited_demand_queue( const capacity_t & ) {}
+		unlimited_demand_queue( const mchain_params_t & ) {}
 
 		//! Is queue full?
 		/*!
@@ -108,6 +115,18 @@ class unlimited_demand_queue
 				return m_queue.front();
 			}
 
+		//! Access to the last item from queue.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		demand_t &
+		back()
+			{
+				ensure_queue_not_empty( *this );
+				return m_queue.back();
+			}
+
 		//! Remove the front item from queue.
 		void
 		pop_front()
@@ -123,6 +142,17 @@ class unlimited_demand_queue
 				m_queue.push_back( std::move(demand) );
 			}
 
+		//! Return an extracted item to the front of the queue.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		push_front( demand_t && demand )
+			{
+				m_queue.push_front( std::move(demand) );
+			}
+
 		//! Size of the queue.
 		std::size_t
 		size() const { return m_queue.size(); }
@@ -147,13 +177,17 @@ class limited_dynamic_demand_queue
 	public :
 		//! Initializing constructor.
 		limited_dynamic_demand_queue(
-			const capacity_t & capacity )
-			:	m_max_size{ capacity.max_size() }
+			const mchain_params_t & params )
+			:	m_max_size{ params.capacity().max_size() }
 			{}
 
 		//! Is queue full?
+		/*!
+		 * \note Since v.5.5.20 the size of the queue can be greater than
+		 * the max size because of returned items.
+		 */
 		bool
-		is_full() const { return m_max_size == m_queue.size(); }
+		is_full() const { return m_max_size <= m_queue.size(); }
 
 		//! Is queue empty?
 		bool
@@ -167,6 +201,18 @@ class limited_dynamic_demand_queue
 				return m_queue.front();
 			}
 
+		//! Access to the last item from queue.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		demand_t &
+		back()
+			{
+				ensure_queue_not_empty( *this );
+				return m_queue.back();
+			}
+
 		//! Remove the front item from queue.
 		void
 		pop_front()
@@ -183,6 +229,19 @@ class limited_dynamic_demand_queue
 				m_queue.push_back( std::move(demand) );
 			}
 
+		//! Return an extracted item to the front of the queue.
+		/*!
+		 * \note The item is returned even if the queue is full.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		push_front( demand_t && demand )
+			{
+				m_queue.push_front( std::move(demand) );
+			}
+
 		//! Size of the queue.
 		std::size_t
 		size() const { return m_queue.size(); }
@@ -209,16 +268,20 @@ class limited_preallocated_demand_queue
 	public :
 		//! Initializing constructor.
 		limited_preallocated_demand_queue(
-			const capacity_t & capacity )
-			:	m_storage( capacity.max_size(), demand_t{} )
-			,	m_max_size{ capacity.max_size() }
+			const mchain_params_t & params )
+			:	m_storage( params.capacity().max_size(), demand_t{} )
+			,	m_max_size{ params.capacity().max_size() }
 			,	m_head{ 0 }
 			,	m_size{ 0 }
 			{}
 
 		//! Is queue full?
+		/*!
+		 * \note Since v.5.5.20 the size of the queue can be greater than
+		 * the max size because of returned items.
+		 */
 		bool
-		is_full() const { return m_max_size == m_size; }
+		is_full() const { return m_max_size <= m_size; }
 
 		//! Is queue empty?
 		bool
@@ -232,13 +295,25 @@ class limited_preallocated_demand_queue
 				return m_storage[ m_head ];
 			}
 
+		//! Access to the last item from queue.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		demand_t &
+		back()
+			{
+				ensure_queue_not_empty( *this );
+				return m_storage[ (m_head + m_size - 1) % m_storage.size() ];
+			}
+
 		//! Remove the front item from queue.
 		void
 		pop_front()
 			{
 				ensure_queue_not_empty( *this );
 				m_storage[ m_head ] = demand_t{};
-				m_head = (m_head + 1) % m_max_size;
+				m_head = (m_head + 1) % m_storage.size();
 				--m_size;
 			}
 
@@ -247,17 +322,40 @@ class limited_preallocated_demand_queue
 		push_back( demand_t && demand )
 			{
 				ensure_queue_not_full( *this );
-				auto index = (m_head + m_size) % m_max_size;
+				auto index = (m_head + m_size) % m_storage.size();
 				m_storage[ index ] = std::move(demand);
 				++m_size;
 			}
 
+		//! Return an extracted item to the front of the queue.
+		/*!
+		 * \note The item is returned even if the queue is full.
+		 * The storage is extended in that case.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		push_front( demand_t && demand )
+			{
+				if( m_storage.size() == m_size )
+					extend_storage();
+
+				m_head = (m_head + m_storage.size() - 1) % m_storage.size();
+				m_storage[ m_head ] = std::move(demand);
+				++m_size;
+			}
+
 		//! Size of the queue.
 		std::size_t
 		size() const { return m_size; }
 
 	private :
 		//! Queue's storage.
+		/*!
+		 * \note Since v.5.5.20 it can be greater than m_max_size
+		 * after returning of items to the full queue.
+		 */
 		std::vector< demand_t > m_storage;
 		//! Maximum size of the queue.
 		const std::size_t m_max_size;
@@ -266,6 +364,23 @@ class limited_preallocated_demand_queue
 		std::size_t m_head;
 		//! The current size of the queue.
 		std::size_t m_size;
+
+		//! Make place for returned items.
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		extend_storage()
+			{
+				std::vector< demand_t > storage( m_size * 2 + 1, demand_t{} );
+				for( std::size_t i = 0; i != m_size; ++i )
+					storage[ i ] = std::move(
+							m_storage[ (m_head + i) % m_storage.size() ] );
+
+				m_storage.swap( storage );
+				m_head = 0;
+			}
 	};
 
 //
@@ -285,6 +400,31 @@ enum class status
 		closed
 	};
 
+//
+// drop_queue_content
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Remove all demands from a queue.
+ *
+ * \note Is found via ADL. A queue with own way of dropping demands
+ * can have a more specialized overload.
+ */
+template< typename QUEUE, typename LAMBDA >
+void
+drop_queue_content(
+	QUEUE & queue,
+	LAMBDA on_drop )
+	{
+		while( !queue.is_empty() )
+			{
+				on_drop( queue.front() );
+				queue.pop_front();
+			}
+	}
+
 } /* namespace details */
 
 //
@@ -308,6 +448,8 @@ class mchain_template
 		//! Initializing constructor.
 		template< typename... TRACING_ARGS >
 		mchain_template(
+			//! Registry for run-time monitoring.
+			details::mchain_stats_registry_shptr_t stats_registry,
 			//! SObjectizer Environment for which message chain is created.
 			so_5::environment_t & env,
 			//! Mbox ID for this chain.
@@ -321,7 +463,11 @@ class mchain_template
 			,	m_id( id )
 			,	m_capacity( params.capacity() )
 			,	m_not_empty_notificator( params.not_empty_notificator() )
-			,	m_queue( params.capacity() )
+			,	m_extraction_batch_size( params.extraction_batch_size() )
+			,	m_queue( params )
+			,	m_conflation( params.conflated_types() )
+			,	m_stats( details::make_mchain_stats(
+						params.stats_enabled(), std::move(stats_registry), id ) )
 			{}
 
 		virtual mbox_id_t
@@ -366,7 +512,7 @@ class mchain_template
 		do_deliver_message(
 			const std::type_index & msg_type,
 			const message_ref_t & message,
-			unsigned int /*overlimit_reaction_deep*/ ) const override
+			unsigned int overlimit_reaction_deep ) const override
 			{
 				// Constness must be removed explicitly.
 				// Until do_deliver_message() lost const in v.5.6.0.
@@ -374,14 +520,15 @@ class mchain_template
 					try_to_store_message_to_queue(
 							msg_type,
 							message,
-							invocation_type_t::event );
+							invocation_type_t::event,
+							overlimit_reaction_deep );
 			}
 
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
 			const message_ref_t & message,
-			unsigned int /*overlimit_reaction_deep*/ ) const override
+			unsigned int overlimit_reaction_deep ) const override
 			{
 				// Constness must be removed explicitly.
 				// Until do_deliver_service_request() lost const in v.5.6.0.
@@ -389,7 +536,8 @@ class mchain_template
 					try_to_store_message_to_queue(
 							msg_type,
 							message,
-							invocation_type_t::service_request );
+							invocation_type_t::service_request,
+							overlimit_reaction_deep );
 			}
 
 		/*!
@@ -420,46 +568,61 @@ class mchain_template
 			{
 				std::unique_lock< std::mutex > lock{ m_lock };
 
-				// If queue is empty we must wait for some time.
-				bool queue_empty = m_queue.is_empty();
-				if( queue_empty )
-					{
-						if( details::status::closed == m_status )
-							// Waiting for new messages has no sence because
-							// chain is closed.
-							return extraction_status_t::chain_closed;
+				// If queue is still empty nothing can be extracted and
+				// we must stop operation.
+				if( !wait_for_not_empty_queue( lock, empty_queue_timeout ) )
+					return status_for_empty_queue();
 
-						auto predicate = [this, &queue_empty]() -> bool {
-								queue_empty = m_queue.is_empty();
-								return !queue_empty ||
-										details::status::closed == m_status;
-							};
+				return extract_demand_from_not_empty_queue( dest );
+			}
 
-						// Count of sleeping thread must be incremented before
-						// going to sleep and decremented right after.
-						++m_threads_to_wakeup;
-						auto decrement_threads = so_5::details::at_scope_exit(
-								[this] { --m_threads_to_wakeup; } );
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			duration_t empty_queue_timeout ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
 
-						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
-							// A wait with finite timeout must be performed.
-							m_underflow_cond.wait_for(
-									lock, empty_queue_timeout, predicate );
-						else
-							// Wait until arrival of any message or closing of chain.
-							m_underflow_cond.wait( lock, predicate );
+				if( !wait_for_not_empty_queue( lock, empty_queue_timeout ) )
+					return status_for_empty_queue();
+
+				return extract_demands_from_not_empty_queue( dest, max_count );
+			}
+
+		virtual void
+		return_demands(
+			std::vector< demand_t >::iterator first,
+			std::vector< demand_t >::iterator last ) override
+			{
+				if( first == last )
+					return;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				const bool was_empty = m_queue.is_empty();
+
+				// NOTE: returned demands are not conflated with new ones.
+				while( first != last )
+					{
+						--last;
+						m_queue.push_front( std::move(*last) );
 					}
 
-				// If queue is still empty nothing can be extracted and
-				// we must stop operation.
-				if( queue_empty )
-					return details::status::open == m_status ?
-							// The chain is still open so there must be this result
-							extraction_status_t::no_messages :
-							// The chain is closed and there must be different result
-							extraction_status_t::chain_closed;
+				if( m_stats )
+					m_stats->size_changed( m_queue.size() );
 
-				return extract_demand_from_not_empty_queue( dest );
+				if( was_empty )
+					{
+						if( m_not_empty_notificator )
+							so_5::details::invoke_noexcept_code(
+								[this] { m_not_empty_notificator(); } );
+
+						notify_multi_chain_select_ops();
+					}
+
+				if( m_threads_to_wakeup )
+					m_underflow_cond.notify_all();
 			}
 
 		virtual bool
@@ -488,12 +651,15 @@ class mchain_template
 
 				if( close_mode_t::drop_content == mode )
 					{
-						while( !m_queue.is_empty() )
-							{
-								this->trace_demand_drop_on_close(
-										*this, m_queue.front() );
-								m_queue.pop_front();
-							}
+						drop_queue_content( m_queue,
+								[this]( const demand_t & d ) {
+									this->trace_demand_drop_on_close( *this, d );
+								} );
+
+						m_conflation.clear();
+
+						if( m_stats )
+							m_stats->size_changed( 0u );
 					}
 
 				// If queue is empty now and there is any multi chain select
@@ -526,21 +692,24 @@ class mchain_template
 			{
 				std::unique_lock< std::mutex > lock{ m_lock };
 
-				const bool queue_empty = m_queue.is_empty();
-				if( queue_empty )
-					{
-						if( details::status::closed == m_status )
-							// There is no need to wait for something.
-							return extraction_status_t::chain_closed;
+				if( m_queue.is_empty() )
+					return add_to_select_tail_if_open( select_case );
+				else
+					return extract_demand_from_not_empty_queue( dest );
+			}
 
-						// In other cases select_tail must be modified.
-						select_case.set_next( m_select_tail );
-						m_select_tail = &select_case;
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			select_case_t & select_case ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
 
-						return extraction_status_t::no_messages;
-					}
+				if( m_queue.is_empty() )
+					return add_to_select_tail_if_open( select_case );
 				else
-					return extract_demand_from_not_empty_queue( dest );
+					return extract_demands_from_not_empty_queue( dest, max_count );
 			}
 
 		virtual void
@@ -580,6 +749,28 @@ class mchain_template
 						invocation_type_t::event );
 			}
 
+		virtual void
+		do_deliver_messages_from_timer(
+			const so_5::rt::impl::timer_message_t * messages,
+			std::size_t count ) override
+			{
+				try_to_store_messages_from_timer_to_queue( messages, count );
+			}
+
+		//! Access to the chain's queue for derived classes.
+		/*!
+		 * \attention Only thread-safe methods of the queue can be
+		 * called via this reference.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		const QUEUE &
+		queue() const
+			{
+				return m_queue;
+			}
+
 	private :
 		//! SObjectizer Environment for which message chain is created.
 		environment_t & m_env;
@@ -596,9 +787,35 @@ class mchain_template
 		//! Optional notificator for 'not_empty' condition.
 		const not_empty_notification_func_t m_not_empty_notificator;
 
+		/*!
+		 * \brief Max count of messages to be extracted under one lock.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		const std::size_t m_extraction_batch_size;
+
 		//! Chain's demands queue.
 		mutable QUEUE m_queue;
 
+		/*!
+		 * \brief Index of demands for conflation.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		details::conflation_index_t m_conflation;
+
+		/*!
+		 * \brief Counters for run-time monitoring.
+		 *
+		 * Null if run-time monitoring is disabled.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		const details::mchain_stats_unique_ptr_t m_stats;
+
 		//! Chain's lock.
 		mutable std::mutex m_lock;
 
@@ -637,14 +854,21 @@ class mchain_template
 		try_to_store_message_to_queue(
 			const std::type_index & msg_type,
 			const message_ref_t & message,
-			invocation_type_t demand_type )
+			invocation_type_t demand_type,
+			unsigned int overlimit_reaction_deep )
 			{
 				typename TRACING_BASE::deliver_op_tracer tracer{
 						*this, // as tracing base.
 						*this, // as chain.
 						msg_type,
 						message,
-						demand_type };
+						demand_type,
+						overlimit_reaction_deep };
+
+				// Key extractor is called outside of the lock.
+				details::typed_conflation_key_t key{ msg_type, conflation_key_t{} };
+				const bool conflated = m_conflation.enabled() &&
+						m_conflation.make_key( msg_type, message, demand_type, key.m_key );
 
 				std::unique_lock< std::mutex > lock{ m_lock };
 
@@ -652,6 +876,11 @@ class mchain_template
 				if( details::status::closed == m_status )
 					return;
 
+				// There is no need to check the size of the queue if
+				// the message replaces the old one.
+				if( conflated && try_conflate( tracer, key, message ) )
+					return;
+
 				// If queue full and waiting on full queue is enabled we
 				// must wait for some time until there will be some space in
 				// the queue.
@@ -671,6 +900,9 @@ class mchain_template
 				// If queue still full we must perform some reaction.
 				if( queue_full )
 					{
+						if( m_stats )
+							m_stats->overflow();
+
 						const auto reaction = m_capacity.overflow_reaction();
 						if( overflow_reaction_t::drop_newest == reaction )
 							{
@@ -682,6 +914,7 @@ class mchain_template
 							{
 								// The oldest message must be simply removed.
 								tracer.overflow_remove_oldest( m_queue.front() );
+								m_conflation.forget( m_queue.front() );
 								m_queue.pop_front();
 							}
 						else if( overflow_reaction_t::throw_exception == reaction )
@@ -712,7 +945,8 @@ class mchain_template
 						tracer,
 						msg_type,
 						message,
-						demand_type );
+						demand_type,
+						conflated ? &key : nullptr );
 			}
 
 		/*!
@@ -744,19 +978,117 @@ class mchain_template
 						*this, // as chain.
 						msg_type,
 						message,
-						demand_type };
+						demand_type,
+						1u };
 
-				std::unique_lock< std::mutex > lock{ m_lock };
+				// Key extractor is called outside of the lock.
+				details::typed_conflation_key_t key{ msg_type, conflation_key_t{} };
+				const bool conflated = m_conflation.enabled() &&
+						m_conflation.make_key( msg_type, message, demand_type, key.m_key );
+
+				std::lock_guard< std::mutex > lock{ m_lock };
 
 				// Message cannot be stored to closed chain.
 				if( details::status::closed == m_status )
 					return;
 
+				store_message_from_timer_under_lock(
+						tracer,
+						msg_type,
+						message,
+						demand_type,
+						conflated ? &key : nullptr );
+			}
+
+		/*!
+		 * \brief An implementation of storing several messages from
+		 * timer thread at once.
+		 *
+		 * The chain's lock is acquired only once for all messages.
+		 *
+		 * \note If conflation of messages or message delivery tracing
+		 * is used then messages are stored one by one because conflation
+		 * keys and tracing filters must be evaluated outside of the lock.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		try_to_store_messages_from_timer_to_queue(
+			const so_5::rt::impl::timer_message_t * messages,
+			std::size_t count )
+			{
+				const bool tracing_disabled = std::is_same<
+						TRACING_BASE,
+						so_5::impl::msg_tracing_helpers::mchain_tracing_disabled_base
+					>::value;
+
+				if( !tracing_disabled || m_conflation.enabled() )
+					{
+						for( std::size_t i = 0; i != count; ++i )
+							try_to_store_message_from_timer_to_queue(
+									messages[ i ].m_msg_type,
+									messages[ i ].m_message,
+									invocation_type_t::event );
+						return;
+					}
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				// Messages cannot be stored to closed chain.
+				if( details::status::closed == m_status )
+					return;
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						typename TRACING_BASE::deliver_op_tracer tracer{
+								*this, // as tracing base.
+								*this, // as chain.
+								messages[ i ].m_msg_type,
+								messages[ i ].m_message,
+								invocation_type_t::event,
+								1u };
+
+						store_message_from_timer_under_lock(
+								tracer,
+								messages[ i ].m_msg_type,
+								messages[ i ].m_message,
+								invocation_type_t::event,
+								nullptr );
+					}
+			}
+
+		/*!
+		 * \brief Store a message from timer thread to the open chain.
+		 *
+		 * \attention Must be called when chain object is locked.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		void
+		store_message_from_timer_under_lock(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			//! Conflation key for the message.
+			//! Null if message isn't conflated.
+			details::typed_conflation_key_t * conflation_key )
+			{
+				// There is no need to check the size of the queue if
+				// the message replaces the old one.
+				if( conflation_key && try_conflate( tracer, *conflation_key, message ) )
+					return;
+
 				bool queue_full = m_queue.is_full();
 				// NOTE: there is no awaiting on full mchain.
 				// If queue full we must perform some reaction.
 				if( queue_full )
 					{
+						if( m_stats )
+							m_stats->overflow();
+
 						const auto reaction = m_capacity.overflow_reaction();
 						if( overflow_reaction_t::drop_newest == reaction ||
 								overflow_reaction_t::throw_exception == reaction )
@@ -769,6 +1101,7 @@ class mchain_template
 							{
 								// The oldest message must be simply removed.
 								tracer.overflow_remove_oldest( m_queue.front() );
+								m_conflation.forget( m_queue.front() );
 								m_queue.pop_front();
 							}
 						else
@@ -791,7 +1124,98 @@ class mchain_template
 						tracer,
 						msg_type,
 						message,
-						demand_type );
+						demand_type,
+						conflation_key );
+			}
+
+		/*!
+		 * \brief Wait for a message if the queue is empty.
+		 *
+		 * \return true if the queue is not empty.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked by \a lock.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		bool
+		wait_for_not_empty_queue(
+			std::unique_lock< std::mutex > & lock,
+			duration_t empty_queue_timeout )
+			{
+				// If queue is empty we must wait for some time.
+				bool queue_empty = m_queue.is_empty();
+				if( queue_empty )
+					{
+						if( details::status::closed == m_status )
+							// Waiting for new messages has no sence because
+							// chain is closed.
+							return false;
+
+						auto predicate = [this, &queue_empty]() -> bool {
+								queue_empty = m_queue.is_empty();
+								return !queue_empty ||
+										details::status::closed == m_status;
+							};
+
+						// Count of sleeping thread must be incremented before
+						// going to sleep and decremented right after.
+						++m_threads_to_wakeup;
+						auto decrement_threads = so_5::details::at_scope_exit(
+								[this] { --m_threads_to_wakeup; } );
+
+						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
+							// A wait with finite timeout must be performed.
+							m_underflow_cond.wait_for(
+									lock, empty_queue_timeout, predicate );
+						else
+							// Wait until arrival of any message or closing of chain.
+							m_underflow_cond.wait( lock, predicate );
+					}
+
+				return !queue_empty;
+			}
+
+		/*!
+		 * \brief Result of extract operation for the case when
+		 * message queue is empty.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		extraction_status_t
+		status_for_empty_queue() const
+			{
+				return details::status::open == m_status ?
+						// The chain is still open so there must be this result
+						extraction_status_t::no_messages :
+						// The chain is closed and there must be different result
+						extraction_status_t::chain_closed;
+			}
+
+		/*!
+		 * \brief Implementation of extract operation as a part of
+		 * multi chain select for the case when message queue is empty.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		extraction_status_t
+		add_to_select_tail_if_open( select_case_t & select_case )
+			{
+				if( details::status::closed == m_status )
+					// There is no need to wait for something.
+					return extraction_status_t::chain_closed;
+
+				// In other cases select_tail must be modified.
+				select_case.set_next( m_select_tail );
+				m_select_tail = &select_case;
+
+				return extraction_status_t::no_messages;
 			}
 
 		/*!
@@ -810,11 +1234,56 @@ class mchain_template
 			{
 				// If queue was full then someone can wait on it.
 				const bool queue_was_full = m_queue.is_full();
+				m_conflation.forget( m_queue.front() );
 				dest = std::move( m_queue.front() );
 				m_queue.pop_front();
 
 				this->trace_extracted_demand( *this, dest );
 
+				if( m_stats )
+					m_stats->extracted( 1u, m_queue.size() );
+
+				if( queue_was_full )
+					m_overflow_cond.notify_all();
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		/*!
+		 * \brief Implementation of batched extract operation for the case
+		 * when message queue is not empty.
+		 *
+		 * Waiting producers are notified just once for the whole batch.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		extraction_status_t
+		extract_demands_from_not_empty_queue(
+			std::vector< demand_t > & dest,
+			std::size_t max_count )
+			{
+				// If queue was full then someone can wait on it.
+				const bool queue_was_full = m_queue.is_full();
+
+				const std::size_t count = (std::min)(
+						(std::min)( max_count, m_extraction_batch_size ),
+						m_queue.size() );
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						m_conflation.forget( m_queue.front() );
+						dest.push_back( std::move( m_queue.front() ) );
+						m_queue.pop_front();
+
+						this->trace_extracted_demand( *this, dest.back() );
+					}
+
+				if( m_stats )
+					m_stats->extracted( count, m_queue.size() );
+
 				if( queue_was_full )
 					m_overflow_cond.notify_all();
 
@@ -839,6 +1308,34 @@ class mchain_template
 					}
 			}
 
+		/*!
+		 * \brief An attempt to replace already stored message with
+		 * the same conflation key.
+		 *
+		 * \return true if message has been replaced.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		bool
+		try_conflate(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			const details::typed_conflation_key_t & key,
+			const message_ref_t & message )
+			{
+				auto d = m_conflation.find( key );
+				if( !d )
+					return false;
+
+				tracer.conflated( *d );
+				d->m_message_ref = message;
+
+				return true;
+			}
+
 		/*!
 		 * \brief A reusable method with implementation of
 		 * last part of storing a message into chain.
@@ -855,15 +1352,25 @@ class mchain_template
 			typename TRACING_BASE::deliver_op_tracer & tracer,
 			const std::type_index & msg_type,
 			const message_ref_t & message,
-			invocation_type_t demand_type )
+			invocation_type_t demand_type,
+			//! Conflation key for the message.
+			//! Null if message isn't conflated.
+			details::typed_conflation_key_t * conflation_key )
 			{
 				const bool was_empty = m_queue.is_empty();
 				
 				m_queue.push_back(
 						demand_t{ msg_type, message, demand_type } );
 
+				if( conflation_key )
+					m_conflation.remember(
+							std::move(*conflation_key), m_queue.back() );
+
 				tracer.stored( m_queue );
 
+				if( m_stats )
+					m_stats->stored( m_queue.size() );
+
 				// If chain was empty then multi-chain cases must be notified.
 				// And if not_empty_notificator is defined then it must be used too.
 				if( was_empty )
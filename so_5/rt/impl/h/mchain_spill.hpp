@@ -0,0 +1,530 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Implementation of message chains with spill-to-disk storage.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/mchain_details.hpp>
+#include <so_5/rt/impl/h/mchain_stats.hpp>
+
+#include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/std_names.hpp>
+
+#include <so_5/rt/h/send_functions.hpp>
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// spill_location_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Location of binary image of a message inside spill file.
+ */
+struct spill_location_t
+	{
+		//! Index of segment.
+		std::size_t m_segment = { 0 };
+		//! Offset inside segment.
+		std::size_t m_offset = { 0 };
+		//! Size of binary image.
+		std::size_t m_size = { 0 };
+	};
+
+//
+// spill_storage_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A memory-mapped spill file.
+ *
+ * File is created in the specified directory and is removed from
+ * the directory just after creation. So there is no need to delete it
+ * manually even if application crashes.
+ *
+ * File consists of segments of the same size. Every segment is mapped
+ * into memory separately. A segment is reused when all binary images in
+ * it are released. New segments are added only if there are no
+ * free segments.
+ *
+ * \attention This class is not thread safe. It must be used under
+ * mchain's lock.
+ *
+ * \note Only POSIX platforms are supported at the moment.
+ * An exception with rc_not_implemented is thrown by the constructor
+ * on other platforms.
+ */
+class spill_storage_t
+	{
+		spill_storage_t( const spill_storage_t & ) = delete;
+		spill_storage_t &
+		operator=( const spill_storage_t & ) = delete;
+
+	public :
+		spill_storage_t(
+			//! Directory for spill file.
+			const std::string & directory,
+			//! Size of one segment.
+			std::size_t segment_size );
+		~spill_storage_t();
+
+		//! Store binary image of a message.
+		/*!
+		 * \return false if image is too big to be stored.
+		 *
+		 * \throw so_5::exception_t with rc_mchain_spill_failure if the spill
+		 * file can't be extended.
+		 */
+		bool
+		store(
+			const std::string & image,
+			spill_location_t & location );
+
+		//! Get a pointer to stored binary image.
+		const char *
+		data( const spill_location_t & location ) const;
+
+		//! Release stored binary image.
+		void
+		release( const spill_location_t & location );
+
+	private :
+		//! Description of one segment.
+		struct segment_t
+			{
+				//! Pointer to the mapped memory.
+				char * m_data;
+				//! Count of bytes used.
+				std::size_t m_used;
+				//! Count of non-released images.
+				std::size_t m_live;
+			};
+
+		//! Special value for absence of the current segment.
+		static const std::size_t no_segment = static_cast< std::size_t >(-1);
+
+		//! File descriptor of spill file.
+		int m_fd;
+
+		//! Size of one segment.
+		const std::size_t m_segment_size;
+
+		//! All segments of the file.
+		std::vector< segment_t > m_segments;
+
+		//! Indexes of free segments.
+		std::vector< std::size_t > m_free_segments;
+
+		//! Index of segment for new images.
+		std::size_t m_current = { no_segment };
+
+		//! Select a new segment for writing.
+		void
+		switch_to_new_segment();
+	};
+
+//
+// spilling_demand_queue
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Implementation of demands queue for size-limited message chain
+ * with spill-to-disk storage.
+ *
+ * The queue consists of two parts: an in-memory ring with capacity of
+ * the chain and overflow part. If the ring is full (or the overflow part
+ * is not empty) then a new demand goes to the overflow part. Messages
+ * of spillable types are stored in spill file. Other demands are kept
+ * in memory.
+ *
+ * Overflow part is moved to the ring when the ring becomes empty.
+ * It keeps FIFO order of messages.
+ *
+ * \note This queue is never full.
+ */
+class spilling_demand_queue
+	{
+	public :
+		//! Initializing constructor.
+		spilling_demand_queue(
+			const mchain_params_t & params )
+			:	m_ring( params )
+			,	m_codecs( params.spill_params().codecs() )
+			,	m_storage(
+					params.spill_params().directory(),
+					params.spill_params().segment_size() )
+			{}
+
+		//! Is queue full?
+		/*!
+		 * \note This queue is never full.
+		 */
+		bool
+		is_full() const { return false; }
+
+		//! Is queue empty?
+		bool
+		is_empty() const { return 0 == m_size; }
+
+		//! Access to front item from queue.
+		/*!
+		 * \note If there are demands in the overflow part only they are
+		 * moved into the ring. A spilled message is dropped if its
+		 * deserializer throws and the exception is rethrown.
+		 */
+		demand_t &
+		front()
+			{
+				ensure_queue_not_empty( *this );
+				if( m_ring.is_empty() )
+					refill_ring();
+
+				return m_ring.front();
+			}
+
+		//! Access to the last item from queue.
+		/*!
+		 * \note This method is used only for conflation which is not
+		 * supported for chains with spill-to-disk storage. Because of that
+		 * there is no access to items in the overflow part.
+		 */
+		demand_t &
+		back()
+			{
+				if( !m_overflow.empty() )
+					SO_5_THROW_EXCEPTION( rc_incompatible_mchain_params,
+							"conflation can't be used for mchain with "
+							"spill-to-disk storage" );
+
+				return m_ring.back();
+			}
+
+		//! Remove the front item from queue.
+		void
+		pop_front()
+			{
+				front();
+				m_ring.pop_front();
+				--m_size;
+			}
+
+		//! Return an extracted item to the front of the queue.
+		/*!
+		 * \note The item is kept in memory even if it is spillable.
+		 */
+		void
+		push_front( demand_t && demand )
+			{
+				m_ring.push_front( std::move(demand) );
+				++m_size;
+			}
+
+		//! Remove all items from queue.
+		/*!
+		 * Spilled messages are not deserialized. The demand with
+		 * an empty message reference is passed to \a on_drop for them.
+		 *
+		 * \note This method is used for closing chain with drop_content
+		 * mode. It doesn't throw if \a on_drop doesn't throw.
+		 */
+		template< typename LAMBDA >
+		void
+		drop_all( LAMBDA on_drop )
+			{
+				while( !m_ring.is_empty() )
+					{
+						on_drop( m_ring.front() );
+						m_ring.pop_front();
+					}
+
+				while( !m_overflow.empty() )
+					{
+						auto & item = m_overflow.front();
+						on_drop( item.m_demand );
+						if( item.m_codec )
+							release_spilled( item );
+						m_overflow.pop_front();
+					}
+
+				m_size = 0;
+			}
+
+		//! Add a new item to the end of the queue.
+		void
+		push_back( demand_t && demand )
+			{
+				if( m_overflow.empty() && !m_ring.is_full() )
+					m_ring.push_back( std::move(demand) );
+				else
+					push_to_overflow( std::move(demand) );
+
+				++m_size;
+			}
+
+		//! Size of the queue.
+		std::size_t
+		size() const { return m_size; }
+
+		//! Count of messages in spill file.
+		/*!
+		 * \note This method is thread safe.
+		 */
+		std::size_t
+		spilled_count() const
+			{
+				return m_spilled_count.load( std::memory_order_relaxed );
+			}
+
+		//! Total size of messages in spill file.
+		/*!
+		 * \note This method is thread safe.
+		 */
+		std::size_t
+		spilled_bytes() const
+			{
+				return m_spilled_bytes.load( std::memory_order_relaxed );
+			}
+
+	private :
+		//! Description of one item in overflow part.
+		struct overflow_item_t
+			{
+				//! Demand.
+				/*!
+				 * Message reference is empty if the message is in spill file.
+				 */
+				demand_t m_demand;
+				//! Codec for spilled message.
+				/*!
+				 * Null if the message is not in spill file.
+				 */
+				const spill_codec_t * m_codec;
+				//! Location of spilled message.
+				spill_location_t m_location;
+			};
+
+		//! In-memory ring.
+		limited_preallocated_demand_queue m_ring;
+
+		//! Overflow part.
+		std::deque< overflow_item_t > m_overflow;
+
+		//! Codecs for spillable messages.
+		const spill_codecs_t m_codecs;
+
+		//! Spill file.
+		spill_storage_t m_storage;
+
+		//! Buffer for binary images.
+		std::string m_buffer;
+
+		//! Total count of demands.
+		std::size_t m_size = { 0 };
+
+		//! Count of messages in spill file.
+		std::atomic< std::size_t > m_spilled_count{ 0 };
+		//! Total size of messages in spill file.
+		std::atomic< std::size_t > m_spilled_bytes{ 0 };
+
+		//! Store demand into the overflow part.
+		void
+		push_to_overflow( demand_t && demand )
+			{
+				if( invocation_type_t::event == demand.m_demand_type &&
+						demand.m_message_ref )
+					{
+						auto it = m_codecs.find( demand.m_msg_type );
+						if( it != m_codecs.end() )
+							{
+								m_buffer.clear();
+								it->second.m_serializer( demand.m_message_ref, m_buffer );
+
+								spill_location_t location;
+								if( m_storage.store( m_buffer, location ) )
+									{
+										m_overflow.push_back( overflow_item_t{
+												demand_t{
+														demand.m_msg_type,
+														message_ref_t{},
+														demand.m_demand_type },
+												&(it->second),
+												location } );
+
+										m_spilled_count.fetch_add(
+												1u, std::memory_order_relaxed );
+										m_spilled_bytes.fetch_add(
+												location.m_size, std::memory_order_relaxed );
+										return;
+									}
+							}
+					}
+
+				// Demand can't be spilled and must be kept in memory.
+				m_overflow.push_back( overflow_item_t{
+						std::move(demand), nullptr, spill_location_t{} } );
+			}
+
+		//! Move demands from the overflow part to the ring.
+		void
+		refill_ring()
+			{
+				while( !m_overflow.empty() && !m_ring.is_full() )
+					{
+						auto & item = m_overflow.front();
+						if( item.m_codec )
+							{
+								message_ref_t msg;
+								try
+									{
+										msg = item.m_codec->m_deserializer(
+												m_storage.data( item.m_location ),
+												item.m_location.m_size );
+									}
+								catch( ... )
+									{
+										release_spilled( item );
+										m_overflow.pop_front();
+										--m_size;
+										throw;
+									}
+
+								release_spilled( item );
+								item.m_demand.m_message_ref = std::move(msg);
+							}
+
+						m_ring.push_back( std::move(item.m_demand) );
+						m_overflow.pop_front();
+					}
+			}
+
+		//! Release place of spilled message.
+		void
+		release_spilled( const overflow_item_t & item )
+			{
+				m_storage.release( item.m_location );
+
+				m_spilled_count.fetch_sub( 1u, std::memory_order_relaxed );
+				m_spilled_bytes.fetch_sub(
+						item.m_location.m_size, std::memory_order_relaxed );
+			}
+	};
+
+//
+// drop_queue_content
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Remove all demands from spilling queue without
+ * deserialization of spilled messages.
+ */
+template< typename LAMBDA >
+void
+drop_queue_content(
+	spilling_demand_queue & queue,
+	LAMBDA on_drop )
+	{
+		queue.drop_all( std::move(on_drop) );
+	}
+
+} /* namespace details */
+
+//
+// spilling_mchain_template
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Message chain with spill-to-disk storage.
+ *
+ * Count and size of spilled messages are distributed via stats repository
+ * with prefix "mchain/<id>".
+ *
+ * \tparam TRACING_BASE type with message tracing implementation details.
+ */
+template< typename TRACING_BASE >
+class spilling_mchain_template
+	:	public mchain_template< details::spilling_demand_queue, TRACING_BASE >
+	,	private details::mchain_stats_provider_t
+	{
+		using base_type = mchain_template<
+				details::spilling_demand_queue, TRACING_BASE >;
+
+	public :
+		//! Initializing constructor.
+		template< typename... TRACING_ARGS >
+		spilling_mchain_template(
+			//! Registry for run-time monitoring.
+			details::mchain_stats_registry_shptr_t stats_registry,
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for TRACING_BASE's constructor.
+			TRACING_ARGS &&... tracing_args )
+			:	base_type(
+					stats_registry,
+					env,
+					id,
+					params,
+					std::forward< TRACING_ARGS >(tracing_args)... )
+			,	m_stats_prefix( details::make_mchain_stats_prefix( id ) )
+			,	m_stats_registration( std::move(stats_registry), *this )
+			{}
+
+	private :
+		//! Prefix for data sources.
+		const so_5::stats::prefix_t m_stats_prefix;
+
+		//! Registration in the registry for run-time monitoring.
+		details::mchain_stats_registration_t m_stats_registration;
+
+		virtual void
+		distribute( const mbox_t & distribution_mbox ) override
+			{
+				namespace stats = so_5::stats;
+
+				send< stats::messages::quantity< std::size_t > >(
+						distribution_mbox,
+						m_stats_prefix,
+						stats::suffixes::mchain_spilled_count(),
+						this->queue().spilled_count() );
+
+				send< stats::messages::quantity< std::size_t > >(
+						distribution_mbox,
+						m_stats_prefix,
+						stats::suffixes::mchain_spilled_bytes(),
+						this->queue().spilled_bytes() );
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
@@ -0,0 +1,351 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Helpers for run-time monitoring of message chains.
+ */
+
+#pragma once
+
+#include <so_5/rt/h/mbox.hpp>
+
+#include <so_5/rt/stats/h/prefix.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+//
+// mchain_stats_provider_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An interface of object which distributes run-time monitoring
+ * information about a mchain.
+ *
+ * \note This class has no virtual destructor becase there is no
+ * intention to delete providers via pointer to this interface.
+ */
+class mchain_stats_provider_t
+	{
+	public :
+		//! Send appropriate notifications about the current values.
+		/*!
+		 * \attention This method is called when the registry is locked.
+		 * It must not acquire the mchain's lock.
+		 */
+		virtual void
+		distribute( const mbox_t & distribution_mbox ) = 0;
+	};
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+//
+// mchain_stats_registry_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A registry of mchains with run-time monitoring.
+ *
+ * There is just one data source for all mchains in the stats repository.
+ * That data source distributes information from all registered providers.
+ *
+ * \note The registry is controlled by a shared_ptr. It allows mchains
+ * to outlive the SObjectizer Environment.
+ */
+class mchain_stats_registry_t
+	{
+	public :
+		//! Registration of a new provider.
+		void
+		add( mchain_stats_provider_t & provider )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_providers.insert( &provider );
+			}
+
+		//! Deregistration of a provider.
+		/*!
+		 * \note If distribution is in progress then this method waits
+		 * for its completion.
+		 */
+		void
+		remove( mchain_stats_provider_t & provider )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_providers.erase( &provider );
+			}
+
+		//! Distribute information from all registered providers.
+		void
+		distribute( const mbox_t & distribution_mbox )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				for( auto p : m_providers )
+					p->distribute( distribution_mbox );
+			}
+
+	private :
+		std::mutex m_lock;
+		std::set< mchain_stats_provider_t * > m_providers;
+	};
+
+//
+// mchain_stats_registry_shptr_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An alias for shared_ptr to mchain_stats_registry.
+ */
+using mchain_stats_registry_shptr_t =
+		std::shared_ptr< mchain_stats_registry_t >;
+
+//
+// mchain_stats_registration_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief RAII-wrapper for registration of provider in the registry.
+ */
+class mchain_stats_registration_t
+	{
+		mchain_stats_registration_t( const mchain_stats_registration_t & ) = delete;
+		mchain_stats_registration_t &
+		operator=( const mchain_stats_registration_t & ) = delete;
+
+	public :
+		mchain_stats_registration_t(
+			mchain_stats_registry_shptr_t registry,
+			mchain_stats_provider_t & provider )
+			:	m_registry( std::move(registry) )
+			,	m_provider( provider )
+			{
+				m_registry->add( m_provider );
+			}
+
+		~mchain_stats_registration_t()
+			{
+				m_registry->remove( m_provider );
+			}
+
+	private :
+		const mchain_stats_registry_shptr_t m_registry;
+		mchain_stats_provider_t & m_provider;
+	};
+
+//
+// make_mchain_stats_prefix
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Make data source prefix for a mchain.
+ */
+inline so_5::stats::prefix_t
+make_mchain_stats_prefix( mbox_id_t id )
+	{
+		std::ostringstream ss;
+		ss << "mchain/" << id;
+
+		return so_5::stats::prefix_t{ ss.str() };
+	}
+
+//
+// mchain_stats_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Counters for run-time monitoring of a mchain.
+ *
+ * An object of that type is created by a mchain only if run-time
+ * monitoring is enabled in mchain_params_t.
+ *
+ * Counters are modified only under the chain's lock. Because of that
+ * there is no need for atomic read-modify-write operations: a simple
+ * relaxed load and store are used. Atomics are necessary only for
+ * reading of counters by stats distribution thread.
+ *
+ * \note High watermark is reset by every distribution. A concurrent
+ * update of the watermark by the chain can overwrite that reset.
+ * It is not a problem because the watermark is just an estimation.
+ */
+class mchain_stats_t final : private mchain_stats_provider_t
+	{
+		mchain_stats_t( const mchain_stats_t & ) = delete;
+		mchain_stats_t &
+		operator=( const mchain_stats_t & ) = delete;
+
+	public :
+		mchain_stats_t(
+			mchain_stats_registry_shptr_t registry,
+			mbox_id_t id )
+			:	m_prefix( make_mchain_stats_prefix( id ) )
+			,	m_last_distribution( std::chrono::steady_clock::now() )
+			,	m_registration( std::move(registry), *this )
+			{}
+
+		//! A new message has been stored into the chain.
+		/*!
+		 * \attention Must be called under the chain's lock.
+		 */
+		void
+		stored( std::size_t size )
+			{
+				increment( m_enqueued, 1u );
+				size_changed( size );
+			}
+
+		//! Messages have been extracted from the chain.
+		/*!
+		 * \attention Must be called under the chain's lock.
+		 */
+		void
+		extracted( std::size_t count, std::size_t size )
+			{
+				increment( m_dequeued, count );
+				m_size.store( size, std::memory_order_relaxed );
+			}
+
+		//! The size of the chain has been changed.
+		/*!
+		 * \attention Must be called under the chain's lock.
+		 */
+		void
+		size_changed( std::size_t size )
+			{
+				m_size.store( size, std::memory_order_relaxed );
+				if( size > m_high_watermark.load( std::memory_order_relaxed ) )
+					m_high_watermark.store( size, std::memory_order_relaxed );
+			}
+
+		//! The chain is full at the time of storing a new message.
+		/*!
+		 * \attention Must be called under the chain's lock.
+		 */
+		void
+		overflow()
+			{
+				increment( m_overflows, 1u );
+			}
+
+	private :
+		//! Prefix for data sources.
+		const so_5::stats::prefix_t m_prefix;
+
+		//! The current size of the chain.
+		std::atomic< std::size_t > m_size{ 0 };
+		//! Max size of the chain since the previous distribution.
+		std::atomic< std::size_t > m_high_watermark{ 0 };
+		//! Total count of stored messages.
+		std::atomic< std::size_t > m_enqueued{ 0 };
+		//! Total count of extracted messages.
+		std::atomic< std::size_t > m_dequeued{ 0 };
+		//! Total count of overflows.
+		std::atomic< std::size_t > m_overflows{ 0 };
+
+		/*!
+		 * \name Values from the previous distribution.
+		 * \brief Are used for calculation of rates.
+		 *
+		 * \note These values are used only by distribute() method.
+		 * \{
+		 */
+		std::chrono::steady_clock::time_point m_last_distribution;
+		std::size_t m_last_enqueued = { 0 };
+		std::size_t m_last_dequeued = { 0 };
+		/*!
+		 * \}
+		 */
+
+		//! Registration in the registry for run-time monitoring.
+		/*!
+		 * \note It must be the last member because the registration
+		 * makes the object available for stats distribution thread.
+		 */
+		mchain_stats_registration_t m_registration;
+
+		//! Increment counter modified only under the chain's lock.
+		static void
+		increment( std::atomic< std::size_t > & counter, std::size_t delta )
+			{
+				counter.store(
+						counter.load( std::memory_order_relaxed ) + delta,
+						std::memory_order_relaxed );
+			}
+
+		virtual void
+		distribute( const mbox_t & distribution_mbox ) override;
+	};
+
+//
+// mchain_stats_unique_ptr_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An alias for unique_ptr to mchain_stats.
+ */
+using mchain_stats_unique_ptr_t = std::unique_ptr< mchain_stats_t >;
+
+//
+// make_mchain_stats
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Create counters for run-time monitoring if it is enabled.
+ *
+ * \return nullptr if run-time monitoring is disabled.
+ */
+inline mchain_stats_unique_ptr_t
+make_mchain_stats(
+	bool enabled,
+	mchain_stats_registry_shptr_t registry,
+	mbox_id_t id )
+	{
+		mchain_stats_unique_ptr_t result;
+		if( enabled )
+			result.reset( new mchain_stats_t{ std::move(registry), id } );
+
+		return result;
+	}
+
+} /* namespace details */
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
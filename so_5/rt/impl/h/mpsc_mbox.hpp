@@ -219,6 +219,12 @@ class limitless_mpsc_mbox_template
 		 *
 		 * \brief Helper method to do delivery actions under locked object.
 		 *
+		 * \attention The read lock must be held during the whole delivery.
+		 * It guarantees that unsubscribe_event_handlers() waits for
+		 * the completion of deliveries which are in progress. Because of
+		 * that the consumer can't be destroyed after the removal of its
+		 * last subscription while a sender still works with it.
+		 *
 		 * \tparam L lambda with actual delivery actions.
 		 */
 		template< typename L >
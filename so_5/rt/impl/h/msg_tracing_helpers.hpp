@@ -23,10 +23,8 @@
 #include <so_5/rt/impl/h/message_limit_action_msg_tracer.hpp>
 
 #include <so_5/details/h/invoke_noexcept_code.hpp>
-#include <so_5/details/h/ios_helpers.hpp>
 
-#include <sstream>
-#include <tuple>
+#include <chrono>
 
 namespace so_5 {
 
@@ -36,7 +34,8 @@ namespace msg_tracing_helpers {
 
 namespace details {
 
-using namespace so_5::details::ios_helpers;
+using so_5::msg_tracing::action_t;
+using so_5::msg_tracing::trace_record_t;
 
 struct overlimit_deep
 	{
@@ -51,20 +50,39 @@ struct mbox_identification
 		mbox_id_t m_id;
 	};
 
-struct mchain_identification
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief The target mbox for overlimit reactions.
+ */
+struct target_mbox
 	{
 		mbox_id_t m_id;
 	};
 
-struct text_separator
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief The main message of trace record.
+ */
+struct message
 	{
-		const char * m_text;
+		const std::type_index & m_type;
+		const message_ref_t & m_message;
 	};
 
-struct composed_action_name
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief The second message of trace record.
+ */
+struct second_message
 	{
-		const char * m_1;
-		const char * m_2;
+		const std::type_index & m_type;
+		const message_ref_t & m_message;
 	};
 
 struct chain_size
@@ -72,159 +90,228 @@ struct chain_size
 		std::size_t m_size;
 	};
 
-inline void
-make_trace_to_1( std::ostream & s, mbox_identification id )
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Make description of a message for trace record.
+ */
+inline so_5::msg_tracing::message_info_t
+make_message_info(
+	const std::type_index & msg_type,
+	const message_ref_t & message )
 	{
-		s << "[mbox_id=" << id.m_id << "]";
+		so_5::msg_tracing::message_info_t result;
+		result.m_type = msg_type;
+
+		if( const message_t * envelope = message.get() )
+			{
+				// We can try cases with service requests and user-type messages.
+				const void * payload =
+						internal_message_iface_t{ *envelope }.payload_ptr();
+
+				if( payload != envelope )
+					{
+						// There are an envelope and payload inside it.
+						result.m_envelope = envelope;
+						result.m_payload = payload;
+					}
+				else
+					// There is only payload.
+					result.m_payload = envelope;
+			}
+		// Otherwise it is a signal and there is nothing.
+
+		result.m_mutable =
+				message_mutability_t::mutable_message == message_mutability(message);
+
+		return result;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, mchain_identification id )
+fill_1( trace_record_t & r, mbox_identification id )
 	{
-		s << "[mchain_id=" << id.m_id << "]";
+		r.m_mbox_id = id.m_id;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const abstract_message_box_t & mbox )
+fill_1( trace_record_t & r, const abstract_message_box_t & mbox )
 	{
-		make_trace_to_1( s, mbox_identification{ mbox.id() } );
+		r.m_mbox_id = mbox.id();
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const abstract_message_chain_t & chain )
+fill_1( trace_record_t & r, const abstract_message_chain_t & chain )
 	{
-		make_trace_to_1( s, mchain_identification{ chain.id() } );
+		r.m_mbox_id = chain.id();
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const std::type_index & msg_type )
+fill_1( trace_record_t & r, const message & msg )
 	{
-		s << "[msg_type=" << msg_type.name() << "]";
+		r.m_message = make_message_info( msg.m_type, msg.m_message );
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const agent_t * agent )
+fill_1( trace_record_t & r, const second_message & msg )
 	{
-		s << "[agent_ptr=" << pointer{agent} << "]";
+		r.m_second_message = make_message_info( msg.m_type, msg.m_message );
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const state_t * state )
+fill_1( trace_record_t & r, const agent_t * agent )
 	{
-		s << "[state=" << state->query_name() << "]";
+		r.m_agent = agent;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const event_handler_data_t * handler )
+fill_1( trace_record_t & r, const state_t * state )
 	{
-		s << "[evt_handler=";
-		if( handler )
-			s << pointer{handler};
-		else
-			s << "NONE";
-		s << "]";
+		r.m_state = state;
 	}
 
 inline void
-make_trace_to_1(
-	std::ostream & s,
-	const so_5::message_limit::control_block_t * limit )
+fill_1( trace_record_t & r, const event_handler_data_t * handler )
 	{
-		s << "[limit_ptr=" << pointer{limit} << "]";
+		r.m_event_handler = handler;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const message_ref_t & message )
+fill_1( trace_record_t & r, const overlimit_deep limit )
 	{
-		// The first pointer is a pointer to envelope.
-		// The second pointer is a pointer to payload.
-		using msg_pointers = std::tuple< const void *, const void * >;
-
-		auto detect_pointers = [&message]() -> msg_pointers {
-			if( const message_t * envelope = message.get() )
-				{
-					// We can try cases with service requests and user-type messages.
-					const void * payload =
-							internal_message_iface_t{ *envelope }.payload_ptr();
-
-					if( payload != envelope )
-						// There are an envelope and payload inside it.
-						return msg_pointers{ envelope, payload };
-					else
-						// There is only payload.
-						return msg_pointers{ nullptr, envelope };
-				}
-			else
-				// It is a signal there is nothing.
-				return msg_pointers{ nullptr, nullptr };
-		};
-
-		const void * envelope = nullptr;
-		const void * payload = nullptr;
-
-		std::tie(envelope,payload) = detect_pointers();
-
-		if( envelope )
-			s << "[envelope_ptr=" << pointer{envelope} << "]";
-		if( payload )
-			s << "[payload_ptr=" << pointer{payload} << "]";
-		else
-			s << "[signal]";
-		if( message_mutability_t::mutable_message == message_mutability(message) )
-			s << "[mutable]";
+		r.m_overlimit_deep = limit.m_deep;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const overlimit_deep limit )
+fill_1( trace_record_t & r, const target_mbox target )
 	{
-		s << "[overlimit_deep=" << limit.m_deep << "]";
+		r.m_target_mbox_id = target.m_id;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const composed_action_name name )
+fill_1( trace_record_t & r, chain_size size )
 	{
-		s << " " << name.m_1 << "." << name.m_2 << " ";
+		r.m_chain_size = size.m_size;
 	}
 
 inline void
-make_trace_to_1( std::ostream & s, const text_separator text )
+fill( trace_record_t & ) {}
+
+template< typename A, typename... OTHER >
+void
+fill( trace_record_t & r, A && a, OTHER &&... other )
 	{
-		s << " " << text.m_text << " ";
+		fill_1( r, std::forward< A >(a) );
+		fill( r, std::forward< OTHER >(other)... );
 	}
 
-inline void
-make_trace_to_1( std::ostream & s, chain_size size )
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Should records about a message be made?
+ *
+ * A new decision is made at the start of a new delivery of the message
+ * and is stored into the message instance. At other points the stored
+ * decision is reused. If there is no stored decision then it is made
+ * and stored.
+ */
+inline bool
+is_message_selected(
+	const so_5::msg_tracing::tracer_t & tracer,
+	const std::type_index & msg_type,
+	const message_ref_t & message,
+	mbox_id_t mbox_id,
+	//! Is it the start of a new delivery of the message?
+	bool new_delivery = false ) SO_5_NOEXCEPT
 	{
-		s << "[chain_size=" << size.m_size << "]";
+		if( !tracer.has_sampling() )
+			return true;
+
+		const message_t * envelope = message.get();
+		if( !envelope )
+			// Signals have no instances. Decision is made every time.
+			return tracer.select_message( msg_type, mbox_id );
+
+		using mark_t = internal_message_iface_t::tracing_mark_t;
+
+		internal_message_iface_t iface{ *envelope };
+		if( new_delivery )
+			{
+				const auto mark = tracer.select_message( msg_type, mbox_id ) ?
+						mark_t::selected : mark_t::skipped;
+				iface.set_tracing_mark( mark );
+				return mark_t::selected == mark;
+			}
+
+		auto mark = iface.tracing_mark();
+		if( mark_t::undecided == mark )
+			mark = iface.try_set_tracing_mark(
+					tracer.select_message( msg_type, mbox_id ) ?
+							mark_t::selected : mark_t::skipped );
+
+		return mark_t::selected == mark;
 	}
 
-inline void
-make_trace_to( std::ostream & ) {}
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Should a record related to an agent be made?
+ *
+ * \note Records without an agent (\a agent is nullptr) are not
+ * checked by agents.
+ */
+inline bool
+is_agent_selected(
+	const so_5::msg_tracing::tracer_t & tracer,
+	const agent_t * agent ) SO_5_NOEXCEPT
+	{
+		return !agent || !tracer.has_sampling() || tracer.select_agent( agent );
+	}
 
-template< typename A, typename... OTHER >
-void
-make_trace_to( std::ostream & s, A && a, OTHER &&... other )
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Pass the decision about the original message to the result
+ * of its transformation.
+ */
+inline void
+inherit_message_selection(
+	const so_5::msg_tracing::tracer_t & tracer,
+	bool selected,
+	const message_ref_t & transformed ) SO_5_NOEXCEPT
 	{
-		make_trace_to_1( s, std::forward< A >(a) );
-		make_trace_to( s, std::forward< OTHER >(other)... );
+		using mark_t = internal_message_iface_t::tracing_mark_t;
+
+		if( tracer.has_sampling() && transformed )
+			internal_message_iface_t{ *transformed }.set_tracing_mark(
+					selected ? mark_t::selected : mark_t::skipped );
 	}
 
 template< typename... ARGS >
 void
 make_trace(
 	so_5::msg_tracing::tracer_t & tracer,
+	action_t action,
+	const char * operation,
 	ARGS &&... args ) SO_5_NOEXCEPT
 	{
 #if !defined( SO_5_HAVE_NOEXCEPT )
 		so_5::details::invoke_noexcept_code( [&] {
 #endif
-				std::ostringstream s;
+				trace_record_t r{};
 
-				s << "[tid=" << query_current_thread_id() << "]";
+				if( tracer.needs_timestamps() )
+					r.m_timestamp = std::chrono::steady_clock::now();
+				r.m_thread_id = query_current_thread_id();
+				r.m_action = action;
+				r.m_operation = operation;
 
-				make_trace_to( s, std::forward< ARGS >(args)... );
+				fill( r, std::forward< ARGS >(args)... );
 
-				tracer.trace( s.str() );
+				tracer.trace_record( r );
 #if !defined( SO_5_HAVE_NOEXCEPT )
 			} );
 #endif
@@ -313,22 +400,26 @@ class tracing_enabled_base
 				const std::type_index & m_msg_type;
 				const message_ref_t & m_message;
 				const details::overlimit_deep m_overlimit_deep;
+				const bool m_message_selected;
 
 				template< typename... ARGS >
 				void
 				make_trace(
-					const char * action_name_suffix,
+					details::action_t action,
+					const agent_t * subscriber,
 					ARGS &&... args ) const
 					{
-						details::make_trace(
-								m_tracer,
-								m_mbox,
-								details::composed_action_name{
-										m_op_name, action_name_suffix },
-								m_msg_type,
-								m_message,
-								m_overlimit_deep,
-								std::forward< ARGS >(args)... );
+						if( m_message_selected &&
+								details::is_agent_selected( m_tracer, subscriber ) )
+							details::make_trace(
+									m_tracer,
+									action,
+									m_op_name,
+									m_mbox,
+									details::message{ m_msg_type, m_message },
+									m_overlimit_deep,
+									subscriber,
+									std::forward< ARGS >(args)... );
 					}
 
 			public :
@@ -345,19 +436,23 @@ class tracing_enabled_base
 					,	m_msg_type( msg_type )
 					,	m_message( message )
 					,	m_overlimit_deep( overlimit_reaction_deep )
+					,	m_message_selected( details::is_message_selected(
+								m_tracer, msg_type, message, mbox.id(),
+								// Redirection of a message is not a new delivery.
+								overlimit_reaction_deep <= 1u ) )
 					{
 					}
 
 				void
 				no_subscribers() const
 					{
-						make_trace( "no_subscribers" );
+						make_trace( details::action_t::no_subscribers, nullptr );
 					}
 
 				void
 				push_to_queue( const agent_t * subscriber ) const
 					{
-						make_trace( "push_to_queue", subscriber );
+						make_trace( details::action_t::push_to_queue, subscriber );
 					}
 
 				void
@@ -368,7 +463,7 @@ class tracing_enabled_base
 						if( delivery_possibility_t::disabled_by_delivery_filter
 								== status )
 							{
-								make_trace( "message_rejected", subscriber );
+								make_trace( details::action_t::message_rejected, subscriber );
 							}
 					}
 
@@ -380,14 +475,14 @@ class tracing_enabled_base
 				reaction_abort_app(
 					const agent_t * subscriber ) const SO_5_NOEXCEPT override
 					{
-						make_trace( "overlimit.abort", subscriber );
+						make_trace( details::action_t::overlimit_abort, subscriber );
 					}
 
 				virtual void
 				reaction_drop_message(
 					const agent_t * subscriber ) const SO_5_NOEXCEPT override
 					{
-						make_trace( "overlimit.drop", subscriber );
+						make_trace( details::action_t::overlimit_drop, subscriber );
 					}
 
 				virtual void
@@ -396,10 +491,9 @@ class tracing_enabled_base
 					const mbox_t & target ) const SO_5_NOEXCEPT override
 					{
 						make_trace(
-								"overlimit.redirect",
+								details::action_t::overlimit_redirect,
 								subscriber,
-								details::text_separator{ "==>" },
-								*target );
+								details::target_mbox{ target->id() } );
 					}
 
 				virtual void
@@ -409,13 +503,14 @@ class tracing_enabled_base
 					const std::type_index & msg_type,
 					const message_ref_t & transformed ) const SO_5_NOEXCEPT override
 					{
+						details::inherit_message_selection(
+								m_tracer, m_message_selected, transformed );
+
 						make_trace(
-								"overlimit.transform",
+								details::action_t::overlimit_transform,
 								subscriber,
-								details::text_separator{ "==>" },
-								*target,
-								msg_type,
-								transformed );
+								details::target_mbox{ target->id() },
+								details::second_message{ msg_type, transformed } );
 					}
 			};
 
@@ -437,15 +532,24 @@ trace_event_handler_search_result(
 	const char * context_marker,
 	const event_handler_data_t * search_result )
 	{
-		details::make_trace(
-			internal_env_iface_t{ demand.m_receiver->so_environment() }.msg_tracer(),
-			demand.m_receiver,
-			details::composed_action_name{ context_marker, "find_handler" },
-			details::mbox_identification{ demand.m_mbox_id },
-			demand.m_msg_type,
-			demand.m_message_ref,
-			&(demand.m_receiver->so_current_state()),
-			search_result );
+		auto & tracer = internal_env_iface_t{
+				demand.m_receiver->so_environment() }.msg_tracer();
+
+		if( details::is_message_selected(
+					tracer,
+					demand.m_msg_type,
+					demand.m_message_ref,
+					demand.m_mbox_id ) &&
+				details::is_agent_selected( tracer, demand.m_receiver ) )
+			details::make_trace(
+				tracer,
+				details::action_t::find_handler,
+				context_marker,
+				demand.m_receiver,
+				details::mbox_identification{ demand.m_mbox_id },
+				details::message{ demand.m_msg_type, demand.m_message_ref },
+				&(demand.m_receiver->so_current_state()),
+				search_result );
 	}
 
 /*!
@@ -464,11 +568,13 @@ safe_trace_state_leaving(
 {
 	internal_env_iface_t env{ state_owner.so_environment() };
 
-	if( env.is_msg_tracing_enabled() )
+	if( env.is_msg_tracing_enabled() &&
+			details::is_agent_selected( env.msg_tracer(), &state_owner ) )
 		details::make_trace(
 				env.msg_tracer(),
+				details::action_t::state_leaving,
+				"state",
 				&state_owner,
-				details::composed_action_name{ "state", "leaving" },
 				&state );
 }
 
@@ -488,11 +594,13 @@ safe_trace_state_entering(
 {
 	internal_env_iface_t env{ state_owner.so_environment() };
 
-	if( env.is_msg_tracing_enabled() )
+	if( env.is_msg_tracing_enabled() &&
+			details::is_agent_selected( env.msg_tracer(), &state_owner ) )
 		details::make_trace(
 				env.msg_tracer(),
+				details::action_t::state_entering,
+				"state",
 				&state_owner,
-				details::composed_action_name{ "state", "entering" },
 				&state );
 }
 
@@ -524,7 +632,8 @@ struct mchain_tracing_disabled_base
 					const abstract_message_chain_t &,
 					const std::type_index &,
 					const message_ref_t &,
-					const invocation_type_t )
+					const invocation_type_t,
+					const unsigned int )
 					{}
 
 				template< typename QUEUE >
@@ -534,6 +643,8 @@ struct mchain_tracing_disabled_base
 
 				void overflow_remove_oldest( const so_5::mchain_props::demand_t & ) {}
 
+				void conflated( const so_5::mchain_props::demand_t & ) {}
+
 				void overflow_throw_exception() {}
 
 				void overflow_abort_app() {}
@@ -574,19 +685,28 @@ class mchain_tracing_enabled_base
 				return m_tracer;
 			}
 
+		//! Should records about the demand be made?
+		bool
+		is_demand_selected(
+			const abstract_message_chain_t & chain,
+			const mchain_props::demand_t & d ) const
+			{
+				return details::is_message_selected(
+						m_tracer, d.m_msg_type, d.m_message_ref, chain.id() );
+			}
+
 		void
 		trace_extracted_demand(
 			const abstract_message_chain_t & chain,
 			const mchain_props::demand_t & d )
 			{
-				details::make_trace(
-						m_tracer,
-						chain,
-						details::composed_action_name{
-								message_or_svc_request( d.m_demand_type ),
-								"extracted" },
-						d.m_msg_type,
-						d.m_message_ref );
+				if( is_demand_selected( chain, d ) )
+					details::make_trace(
+							m_tracer,
+							details::action_t::mchain_extracted,
+							message_or_svc_request( d.m_demand_type ),
+							chain,
+							details::message{ d.m_msg_type, d.m_message_ref } );
 			}
 
 		void
@@ -594,14 +714,13 @@ class mchain_tracing_enabled_base
 			const abstract_message_chain_t & chain,
 			const mchain_props::demand_t & d )
 			{
-				details::make_trace(
-						m_tracer,
-						chain,
-						details::composed_action_name{
-								message_or_svc_request( d.m_demand_type ),
-								"dropped_on_close" },
-						d.m_msg_type,
-						d.m_message_ref );
+				if( is_demand_selected( chain, d ) )
+					details::make_trace(
+							m_tracer,
+							details::action_t::mchain_dropped_on_close,
+							message_or_svc_request( d.m_demand_type ),
+							chain,
+							details::message{ d.m_msg_type, d.m_message_ref } );
 			}
 
 		class deliver_op_tracer
@@ -612,21 +731,22 @@ class mchain_tracing_enabled_base
 				const char * m_op_name;
 				const std::type_index & m_msg_type;
 				const message_ref_t & m_message;
+				const bool m_message_selected;
 
 				template< typename... ARGS >
 				void
 				make_trace(
-					const char * action_name_suffix,
+					details::action_t action,
 					ARGS &&... args ) const
 					{
-						details::make_trace(
-								m_tracer,
-								m_chain,
-								details::composed_action_name{
-										m_op_name, action_name_suffix },
-								m_msg_type,
-								m_message,
-								std::forward< ARGS >(args)... );
+						if( m_message_selected )
+							details::make_trace(
+									m_tracer,
+									action,
+									m_op_name,
+									m_chain,
+									details::message{ m_msg_type, m_message },
+									std::forward< ARGS >(args)... );
 					}
 
 			public :
@@ -635,46 +755,62 @@ class mchain_tracing_enabled_base
 					const abstract_message_chain_t & chain,
 					const std::type_index & msg_type,
 					const message_ref_t & message,
-					const invocation_type_t invocation )
+					const invocation_type_t invocation,
+					const unsigned int overlimit_reaction_deep )
 					:	m_tracer( tracing_base.tracer() )
 					,	m_chain( chain )
 					,	m_op_name( message_or_svc_request( invocation ) )
 					,	m_msg_type( msg_type )
 					,	m_message( message )
+					,	m_message_selected(
+							details::is_message_selected(
+									m_tracer, msg_type, message, chain.id(),
+									// Redirection of a message is not a new delivery.
+									overlimit_reaction_deep <= 1u ) )
 					{}
 
 				template< typename QUEUE >
 				void
 				stored( const QUEUE & queue )
 					{
-						make_trace( "stored", details::chain_size{ queue.size() } );
+						make_trace( details::action_t::mchain_stored,
+								details::chain_size{ queue.size() } );
 					}
 
 				void
 				overflow_drop_newest()
 					{
-						make_trace( "overflow.drop_newest" );
+						make_trace( details::action_t::mchain_overflow_drop_newest );
 					}
 
 				void
 				overflow_remove_oldest( const so_5::mchain_props::demand_t & d )
 					{
-						make_trace( "overflow.remove_oldest",
-								details::text_separator{ "removed:" },
-								d.m_msg_type,
-								d.m_message_ref );
+						make_trace( details::action_t::mchain_overflow_remove_oldest,
+								details::second_message{ d.m_msg_type, d.m_message_ref } );
+					}
+
+				/*!
+				 * \since
+				 * v.5.5.20
+				 */
+				void
+				conflated( const so_5::mchain_props::demand_t & d )
+					{
+						make_trace( details::action_t::mchain_conflated,
+								details::second_message{ d.m_msg_type, d.m_message_ref } );
 					}
 
 				void
 				overflow_throw_exception()
 					{
-						make_trace( "overflow.throw_exception" );
+						make_trace( details::action_t::mchain_overflow_throw_exception );
 					}
 
 				void
 				overflow_abort_app()
 					{
-						make_trace( "overflow.abort_app" );
+						make_trace( details::action_t::mchain_overflow_abort_app );
 					}
 			};
 	};
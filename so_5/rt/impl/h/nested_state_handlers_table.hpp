@@ -0,0 +1,156 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief A table of effective event handlers for nested states.
+ */
+
+#pragma once
+
+#include <so_5/rt/h/state.hpp>
+
+#include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <unordered_map>
+
+namespace so_5 {
+
+namespace impl {
+
+//
+// nested_state_handlers_table_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A flattened table of event handlers for nested states.
+ *
+ * Search for an event handler for a nested state requires a lookup
+ * in the subscription storage for the state itself and then for
+ * every parent state until the handler is found. The cost of that
+ * search grows with the depth of the state hierarchy. It is especially
+ * noticeable when the most of events are handled in the root states.
+ *
+ * This table holds the result of such search for every
+ * (mbox, msg_type, state) triple which was looked up. The handlers
+ * inherited from parent states are flattened into the table record
+ * for the nested state. Because of that the cost of search doesn't
+ * depend on the nesting depth.
+ *
+ * Absence of a handler is also stored in the table.
+ *
+ * \attention The content of the table must be dropped on every change
+ * of agent's subscriptions. It is because the table holds pointers
+ * to event_handler_data objects inside subscription storage.
+ *
+ * \note The table is not thread safe. It is used only on agent's
+ * working context where agent's subscriptions are guaranteed
+ * to be unchanged.
+ */
+class nested_state_handlers_table_t
+	{
+		//! Type of key for the table.
+		struct key_t
+			{
+				//! Unique ID of mbox.
+				mbox_id_t m_mbox_id;
+				//! Message type.
+				std::type_index m_msg_type;
+				//! Nested state of agent.
+				const state_t * m_state;
+
+				bool
+				operator==( const key_t & o ) const
+					{
+						return m_mbox_id == o.m_mbox_id &&
+								m_msg_type == o.m_msg_type &&
+								m_state == o.m_state;
+					}
+			};
+
+		//! Hash function for the key.
+		struct hash_t
+			{
+				std::size_t
+				operator()( const key_t & k ) const
+					{
+						// The same approach as in hash_table-based
+						// subscription storage is used here.
+						const std::size_t h1 =
+							std::hash< so_5::mbox_id_t >()( k.m_mbox_id );
+						const std::size_t h2 = h1 ^
+							(std::hash< std::type_index >()( k.m_msg_type ) +
+								0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+
+						return h2 ^ (std::hash< const state_t * >()(
+									k.m_state ) +
+								0x9e3779b9 + (h2 << 6) + (h2 >> 2));
+					}
+			};
+
+		//! Type of the table.
+		using table_t = std::unordered_map<
+				key_t,
+				const event_handler_data_t *,
+				hash_t >;
+
+		//! Effective handlers for nested states.
+		table_t m_table;
+
+	public :
+		//! Find an event handler for a nested state.
+		/*!
+		 * If there is no record for (mbox_id, msg_type, state) in the table
+		 * then \a full_search is called and its result is stored
+		 * in the table.
+		 *
+		 * \tparam FULL_SEARCH type of functor for the search with respect
+		 * to parent-child relationship between states. It must have
+		 * the following format:
+		 * \code
+			const event_handler_data_t * full_search();
+		 * \endcode
+		 */
+		template< typename FULL_SEARCH >
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			const state_t & current_state,
+			FULL_SEARCH && full_search )
+			{
+				const key_t key{ mbox_id, msg_type, &current_state };
+
+				auto it = m_table.find( key );
+				if( it != m_table.end() )
+					return it->second;
+
+				const event_handler_data_t * search_result = full_search();
+
+				m_table.emplace( key, search_result );
+
+				return search_result;
+			}
+
+		//! Drop the whole content of the table.
+		/*!
+		 * Must be called before any change of agent's subscriptions.
+		 */
+		void
+		drop_content() SO_5_NOEXCEPT
+			{
+				m_table.clear();
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
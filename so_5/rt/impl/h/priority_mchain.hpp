@@ -0,0 +1,941 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Implementation of message chains with priority lanes.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/mchain_details.hpp>
+
+#include <so_5/details/h/abort_on_fatal_error.hpp>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// priority_lane_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief One lane of message chain with priorities.
+ *
+ * \note Lane always uses dynamically allocated storage. Memory usage
+ * type from lane's capacity is ignored.
+ */
+struct priority_lane_t
+	{
+		//! Initializing constructor.
+		priority_lane_t(
+			priority_t priority,
+			const capacity_t & capacity )
+			:	m_priority( priority )
+			,	m_capacity( capacity )
+			{}
+
+		//! Priority of the lane.
+		priority_t m_priority;
+
+		//! Capacity of the lane.
+		capacity_t m_capacity;
+
+		//! Demands stored in the lane.
+		std::deque< demand_t > m_queue;
+
+		//! Is lane full?
+		bool
+		is_full() const
+			{
+				// NOTE: size of lane can be greater than max size
+				// because of returned demands.
+				return !m_capacity.unlimited() &&
+						m_capacity.max_size() <= m_queue.size();
+			}
+	};
+
+} /* namespace details */
+
+//
+// priority_mchain_template
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Template-based implementation of message chain with
+ * several priority lanes.
+ *
+ * Every lane is a separate FIFO queue with its own capacity. A demand
+ * is always extracted from the highest non-empty lane. Because of that
+ * messages of higher priority are not waiting while messages of lower
+ * priority are being handled.
+ *
+ * A lane for a new message is selected by the priority of the message.
+ * The priority is specified explicitly by so_5::send_with_priority()
+ * or is taken from mchain_params_t::message_priority() for the type of
+ * the message (so_5::prio::default_priority is used for other types).
+ * The message goes to the lane with the highest priority which is not
+ * greater than the priority of message. If there is no such lane then
+ * the lowest lane is used.
+ *
+ * \tparam TRACING_BASE type with message tracing implementation details.
+ */
+template< typename TRACING_BASE >
+class priority_mchain_template
+	:	public abstract_message_chain_t
+	,	private TRACING_BASE
+	{
+	public :
+		//! Initializing constructor.
+		template< typename... TRACING_ARGS >
+		priority_mchain_template(
+			//! Registry for run-time monitoring.
+			details::mchain_stats_registry_shptr_t stats_registry,
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for TRACING_BASE's constructor.
+			TRACING_ARGS &&... tracing_args )
+			:	TRACING_BASE( std::forward<TRACING_ARGS>(tracing_args)... )
+			,	m_env( env )
+			,	m_id( id )
+			,	m_not_empty_notificator( params.not_empty_notificator() )
+			,	m_extraction_batch_size( params.extraction_batch_size() )
+			,	m_conflation( params.conflated_types() )
+			,	m_stats( details::make_mchain_stats(
+						params.stats_enabled(), std::move(stats_registry), id ) )
+			{
+				// Lanes must be ordered from the highest priority to
+				// the lowest one.
+				const auto & lanes = params.priority_lanes();
+				for( auto it = lanes.rbegin(); it != lanes.rend(); ++it )
+					m_lanes.emplace_back( it->first, it->second );
+
+				for( std::size_t p = 0; p != m_lane_indexes.size(); ++p )
+					m_lane_indexes[ p ] = find_lane_index( to_priority_t( p ) );
+
+				for( const auto & mp : params.message_priorities() )
+					m_message_lanes.emplace(
+							mp.first,
+							m_lane_indexes[ to_size_t( mp.second ) ] );
+			}
+
+		virtual mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			const so_5::message_limit::control_block_t * /*limit*/,
+			agent_t * /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_subscriptions,
+						"mchain doesn't suppor subscription" );
+			}
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & /*msg_type*/,
+			agent_t * /*subscriber*/ ) override
+			{}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mchain:type=PRIORITY:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		virtual mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_message() lost const in v.5.6.0.
+				const_cast< priority_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							lane_index_for( msg_type ),
+							msg_type,
+							message,
+							invocation_type_t::event,
+							overlimit_reaction_deep );
+			}
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_service_request() lost const in v.5.6.0.
+				const_cast< priority_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							lane_index_for( msg_type ),
+							msg_type,
+							message,
+							invocation_type_t::service_request,
+							overlimit_reaction_deep );
+			}
+
+		/*!
+		 * \attention Will throw an exception because delivery
+		 * filter is not applicable to MPSC-mboxes.
+		 */
+		virtual void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			agent_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_delivery_filters,
+						"set_delivery_filter is called for mchain" );
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			agent_t & /*subscriber*/ ) SO_5_NOEXCEPT override
+			{}
+
+		virtual void
+		deliver_message_with_priority(
+			priority_t priority,
+			const std::type_index & msg_type,
+			const message_ref_t & message ) override
+			{
+				try_to_store_message_to_queue(
+						m_lane_indexes[ to_size_t( priority ) ],
+						msg_type,
+						message,
+						invocation_type_t::event,
+						1u );
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !wait_for_not_empty_queue( lock, empty_queue_timeout ) )
+					return status_for_empty_queue();
+
+				extract_demands_from_not_empty_queue( 1u, [&dest]( demand_t & d ) {
+						dest = std::move(d);
+					} );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			duration_t empty_queue_timeout ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !wait_for_not_empty_queue( lock, empty_queue_timeout ) )
+					return status_for_empty_queue();
+
+				extract_demands_from_not_empty_queue(
+						(std::min)( max_count, m_extraction_batch_size ),
+						[&dest]( demand_t & d ) {
+							dest.push_back( std::move(d) );
+						} );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		/*!
+		 * Demands are returned to the front of the highest lane
+		 * because they must be extracted first.
+		 */
+		virtual void
+		return_demands(
+			std::vector< demand_t >::iterator first,
+			std::vector< demand_t >::iterator last ) override
+			{
+				if( first == last )
+					return;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				const bool was_empty = !m_size;
+
+				// NOTE: returned demands are not conflated with new ones.
+				auto & lane = m_lanes.front();
+				while( first != last )
+					{
+						--last;
+						lane.m_queue.push_front( std::move(*last) );
+						++m_size;
+					}
+
+				if( m_stats )
+					m_stats->size_changed( m_size );
+
+				if( was_empty )
+					{
+						if( m_not_empty_notificator )
+							so_5::details::invoke_noexcept_code(
+								[this] { m_not_empty_notificator(); } );
+
+						notify_multi_chain_select_ops();
+					}
+
+				if( m_threads_to_wakeup )
+					m_underflow_cond.notify_all();
+			}
+
+		virtual bool
+		empty() const override
+			{
+				return 0u == m_size;
+			}
+
+		virtual std::size_t
+		size() const override
+			{
+				return m_size;
+			}
+
+		virtual void
+		close( close_mode_t mode ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( details::status::closed == m_status )
+					return;
+
+				m_status = details::status::closed;
+
+				if( close_mode_t::drop_content == mode )
+					{
+						for( auto & lane : m_lanes )
+							{
+								for( const auto & d : lane.m_queue )
+									this->trace_demand_drop_on_close( *this, d );
+								lane.m_queue.clear();
+							}
+						m_size = 0u;
+
+						m_conflation.clear();
+
+						if( m_stats )
+							m_stats->size_changed( 0u );
+					}
+
+				// If queue is empty now and there is any multi chain select
+				// than select_tail must be handled.
+				if( !m_size )
+					notify_multi_chain_select_ops();
+
+				if( m_threads_to_wakeup )
+					// Someone is waiting on empty chain for new messages.
+					// It must be informed that no new messages will be here.
+					m_underflow_cond.notify_all();
+
+				// Someone can wait on full lane for free place for new message.
+				// It must be informed that the chain is closed.
+				m_overflow_cond.notify_all();
+			}
+
+		virtual environment_t &
+		environment() const override
+			{
+				return m_env;
+			}
+
+	protected :
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			select_case_t & select_case ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !m_size )
+					return add_to_select_tail_if_open( select_case );
+
+				extract_demands_from_not_empty_queue( 1u, [&dest]( demand_t & d ) {
+						dest = std::move(d);
+					} );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual extraction_status_t
+		extract_bunch(
+			std::vector< demand_t > & dest,
+			std::size_t max_count,
+			select_case_t & select_case ) override
+			{
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !m_size )
+					return add_to_select_tail_if_open( select_case );
+
+				extract_demands_from_not_empty_queue(
+						(std::min)( max_count, m_extraction_batch_size ),
+						[&dest]( demand_t & d ) {
+							dest.push_back( std::move(d) );
+						} );
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		virtual void
+		remove_from_select(
+			select_case_t & select_case ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				select_case_t * c = m_select_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &select_case )
+							{
+								if( prev )
+									prev->set_next( next );
+								else
+									m_select_tail = next;
+
+								return;
+							}
+
+						prev = c;
+						c = next;
+					}
+			}
+
+		virtual void
+		do_deliver_message_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t & message ) override
+			{
+				try_to_store_message_from_timer_to_queue(
+						lane_index_for( msg_type ),
+						msg_type,
+						message,
+						invocation_type_t::event );
+			}
+
+	private :
+		//! Type of map from message type to lane index.
+		using message_lanes_map_t = std::map< std::type_index, std::size_t >;
+
+		//! SObjectizer Environment for which message chain is created.
+		environment_t & m_env;
+
+		//! Status of the chain.
+		details::status m_status = { details::status::open };
+
+		//! Mbox ID for chain.
+		const mbox_id_t m_id;
+
+		//! Optional notificator for 'not_empty' condition.
+		const not_empty_notification_func_t m_not_empty_notificator;
+
+		//! Max count of messages to be extracted under one lock.
+		const std::size_t m_extraction_batch_size;
+
+		//! Chain's lanes.
+		/*!
+		 * The lane with the highest priority is the first.
+		 */
+		std::vector< details::priority_lane_t > m_lanes;
+
+		//! Index of lane for every priority value.
+		std::array< std::size_t, prio::total_priorities_count > m_lane_indexes;
+
+		//! Lanes for message types with priorities from mchain params.
+		/*!
+		 * \note This map isn't changed after the construction.
+		 * Because of that it can be used without acquiring the lock.
+		 */
+		message_lanes_map_t m_message_lanes;
+
+		//! Index of demands for conflation.
+		details::conflation_index_t m_conflation;
+
+		//! Total count of demands in all lanes.
+		/*!
+		 * \note It is atomic because empty() and size() are called
+		 * without acquiring the lock.
+		 */
+		std::atomic< std::size_t > m_size{ 0u };
+
+		//! Counters for run-time monitoring.
+		/*!
+		 * Null if run-time monitoring is disabled.
+		 */
+		const details::mchain_stats_unique_ptr_t m_stats;
+
+		//! Chain's lock.
+		std::mutex m_lock;
+
+		//! Condition variable for waiting on empty chain.
+		std::condition_variable m_underflow_cond;
+		//! Condition variable for waiting on full lanes.
+		std::condition_variable m_overflow_cond;
+
+		//! Count of threads sleeping on empty mchain.
+		std::size_t m_threads_to_wakeup = { 0 };
+
+		//! A queue of multi-chain selects in which this chain is used.
+		select_case_t * m_select_tail = nullptr;
+
+		//! Find the lane for the specified priority.
+		/*!
+		 * It is the lane with the highest priority which is not greater
+		 * than \a priority. Or the lowest lane if there is no such lane.
+		 */
+		std::size_t
+		find_lane_index( priority_t priority ) const
+			{
+				for( std::size_t i = 0; i != m_lanes.size(); ++i )
+					if( m_lanes[ i ].m_priority <= priority )
+						return i;
+
+				return m_lanes.size() - 1u;
+			}
+
+		//! Get the lane for a message of the specified type.
+		std::size_t
+		lane_index_for( const std::type_index & msg_type ) const
+			{
+				auto it = m_message_lanes.find( msg_type );
+				return it != m_message_lanes.end() ?
+						it->second :
+						m_lane_indexes[ to_size_t( prio::default_priority ) ];
+			}
+
+		//! Actual implementation of pushing message to a lane.
+		void
+		try_to_store_message_to_queue(
+			std::size_t lane_index,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			unsigned int overlimit_reaction_deep )
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type,
+						overlimit_reaction_deep };
+
+				auto & lane = m_lanes[ lane_index ];
+				const auto & capacity = lane.m_capacity;
+
+				// Key extractor is called outside of the lock.
+				details::typed_conflation_key_t key{ msg_type, conflation_key_t{} };
+				const bool conflated = m_conflation.enabled() &&
+						m_conflation.make_key( msg_type, message, demand_type, key.m_key );
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				// Message cannot be stored to closed chain.
+				if( details::status::closed == m_status )
+					return;
+
+				// Message replaces the old one with the same key.
+				// The old message can be in any lane.
+				if( conflated )
+					{
+						auto d = m_conflation.find( key );
+						if( d )
+							{
+								tracer.conflated( *d );
+								d->m_message_ref = message;
+								return;
+							}
+					}
+
+				// If lane is full and waiting on full lane is enabled we
+				// must wait for some time until there will be some space in
+				// the lane.
+				bool lane_full = lane.is_full();
+				if( lane_full && capacity.is_overflow_timeout_defined() )
+					{
+						m_overflow_cond.wait_for(
+								lock,
+								capacity.overflow_timeout(),
+								[this, &lane, &lane_full] {
+									lane_full = lane.is_full();
+									return !lane_full ||
+											details::status::closed == m_status;
+								} );
+
+						// Chain can be closed during the wait.
+						if( details::status::closed == m_status )
+							return;
+					}
+
+				// If lane still full we must perform some reaction.
+				if( lane_full )
+					{
+						if( m_stats )
+							m_stats->overflow();
+
+						const auto reaction = capacity.overflow_reaction();
+						if( overflow_reaction_t::drop_newest == reaction )
+							{
+								// New message must be simply ignored.
+								tracer.overflow_drop_newest();
+								return;
+							}
+						else if( overflow_reaction_t::remove_oldest == reaction )
+							{
+								// The oldest message must be simply removed.
+								tracer.overflow_remove_oldest( lane.m_queue.front() );
+								m_conflation.forget( lane.m_queue.front() );
+								lane.m_queue.pop_front();
+								--m_size;
+							}
+						else if( overflow_reaction_t::throw_exception == reaction )
+							{
+								tracer.overflow_throw_exception();
+								SO_5_THROW_EXCEPTION(
+										rc_msg_chain_overflow,
+										"an attempt to push message to full lane "
+										"of mchain with overflow_reaction_t::throw_exception "
+										"policy" );
+							}
+						else
+							abort_on_overflow( tracer, msg_type );
+					}
+
+				complete_store_message_to_queue(
+						tracer,
+						lane,
+						msg_type,
+						message,
+						demand_type,
+						conflated ? &key : nullptr );
+			}
+
+		/*!
+		 * \brief An implementation of storing another message to
+		 * chain for the case of delated/periodic messages.
+		 *
+		 * There is no waiting on full lane and
+		 * overflow_reaction_t::throw_exception is replaced by
+		 * overflow_reaction_t::drop_newest. It is the same behaviour as
+		 * for ordinary mchains.
+		 */
+		void
+		try_to_store_message_from_timer_to_queue(
+			std::size_t lane_index,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type )
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type,
+						1u };
+
+				auto & lane = m_lanes[ lane_index ];
+
+				// Key extractor is called outside of the lock.
+				details::typed_conflation_key_t key{ msg_type, conflation_key_t{} };
+				const bool conflated = m_conflation.enabled() &&
+						m_conflation.make_key( msg_type, message, demand_type, key.m_key );
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				// Message cannot be stored to closed chain.
+				if( details::status::closed == m_status )
+					return;
+
+				// Message replaces the old one with the same key.
+				// The old message can be in any lane.
+				if( conflated )
+					{
+						auto d = m_conflation.find( key );
+						if( d )
+							{
+								tracer.conflated( *d );
+								d->m_message_ref = message;
+								return;
+							}
+					}
+
+				// NOTE: there is no awaiting on full lane.
+				if( lane.is_full() )
+					{
+						if( m_stats )
+							m_stats->overflow();
+
+						const auto reaction = lane.m_capacity.overflow_reaction();
+						if( overflow_reaction_t::drop_newest == reaction ||
+								overflow_reaction_t::throw_exception == reaction )
+							{
+								// New message must be simply ignored.
+								tracer.overflow_drop_newest();
+								return;
+							}
+						else if( overflow_reaction_t::remove_oldest == reaction )
+							{
+								// The oldest message must be simply removed.
+								tracer.overflow_remove_oldest( lane.m_queue.front() );
+								m_conflation.forget( lane.m_queue.front() );
+								lane.m_queue.pop_front();
+								--m_size;
+							}
+						else
+							abort_on_overflow( tracer, msg_type );
+					}
+
+				complete_store_message_to_queue(
+						tracer,
+						lane,
+						msg_type,
+						message,
+						demand_type,
+						conflated ? &key : nullptr );
+			}
+
+		//! Reaction to overflow with overflow_reaction_t::abort_app.
+		void
+		abort_on_overflow(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			const std::type_index & msg_type )
+			{
+				so_5::details::abort_on_fatal_error( [&] {
+						tracer.overflow_throw_exception();
+						SO_5_LOG_ERROR( m_env, log_stream ) {
+							log_stream << "overflow_reaction_t::abort_app "
+									"will be performed for mchain (id="
+									<< m_id << "), msg_type: "
+									<< msg_type.name()
+									<< ". Application will be aborted"
+									<< std::endl;
+						}
+					} );
+			}
+
+		/*!
+		 * \brief Wait for a message if the chain is empty.
+		 *
+		 * \return true if the chain is not empty.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked by \a lock.
+		 */
+		bool
+		wait_for_not_empty_queue(
+			std::unique_lock< std::mutex > & lock,
+			duration_t empty_queue_timeout )
+			{
+				if( !m_size )
+					{
+						if( details::status::closed == m_status )
+							// Waiting for new messages has no sence because
+							// chain is closed.
+							return false;
+
+						auto predicate = [this]() -> bool {
+								return 0u != m_size ||
+										details::status::closed == m_status;
+							};
+
+						// Count of sleeping thread must be incremented before
+						// going to sleep and decremented right after.
+						++m_threads_to_wakeup;
+						auto decrement_threads = so_5::details::at_scope_exit(
+								[this] { --m_threads_to_wakeup; } );
+
+						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
+							m_underflow_cond.wait_for(
+									lock, empty_queue_timeout, predicate );
+						else
+							m_underflow_cond.wait( lock, predicate );
+					}
+
+				return 0u != m_size;
+			}
+
+		//! Result of extract operation for the case of empty chain.
+		extraction_status_t
+		status_for_empty_queue() const
+			{
+				return details::status::open == m_status ?
+						extraction_status_t::no_messages :
+						extraction_status_t::chain_closed;
+			}
+
+		/*!
+		 * \brief Implementation of extract operation as a part of
+		 * multi chain select for the case when chain is empty.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 */
+		extraction_status_t
+		add_to_select_tail_if_open( select_case_t & select_case )
+			{
+				if( details::status::closed == m_status )
+					// There is no need to wait for something.
+					return extraction_status_t::chain_closed;
+
+				select_case.set_next( m_select_tail );
+				m_select_tail = &select_case;
+
+				return extraction_status_t::no_messages;
+			}
+
+		/*!
+		 * \brief Extraction of up to \a max_count demands starting from
+		 * the highest non-empty lane.
+		 *
+		 * Waiting producers are notified just once.
+		 *
+		 * \attention This helper method must be called when chain object
+		 * is locked in some hi-level method.
+		 */
+		template< typename RECEIVER >
+		void
+		extract_demands_from_not_empty_queue(
+			std::size_t max_count,
+			RECEIVER && receiver )
+			{
+				bool lane_was_full = false;
+				std::size_t extracted = 0u;
+
+				for( auto & lane : m_lanes )
+					{
+						if( !max_count )
+							break;
+						if( lane.m_queue.empty() )
+							continue;
+
+						lane_was_full = lane_was_full || lane.is_full();
+
+						while( max_count && !lane.m_queue.empty() )
+							{
+								auto & d = lane.m_queue.front();
+								this->trace_extracted_demand( *this, d );
+								m_conflation.forget( d );
+								receiver( d );
+								lane.m_queue.pop_front();
+
+								--m_size;
+								--max_count;
+								++extracted;
+							}
+					}
+
+				if( m_stats )
+					m_stats->extracted( extracted, m_size );
+
+				// Someone can wait for free place in full lane.
+				if( lane_was_full )
+					m_overflow_cond.notify_all();
+			}
+
+		//! Notification for multi chain selects.
+		void
+		notify_multi_chain_select_ops() SO_5_NOEXCEPT
+			{
+				if( m_select_tail )
+					{
+						auto old = m_select_tail;
+						m_select_tail = nullptr;
+						old->notify();
+					}
+			}
+
+		//! Storing a new demand to the lane.
+		void
+		complete_store_message_to_queue(
+			typename TRACING_BASE::deliver_op_tracer & tracer,
+			details::priority_lane_t & lane,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			//! Conflation key for the message.
+			//! Null if message isn't conflated.
+			details::typed_conflation_key_t * conflation_key )
+			{
+				const bool was_empty = !m_size;
+
+				lane.m_queue.push_back(
+						demand_t{ msg_type, message, demand_type } );
+				++m_size;
+
+				if( conflation_key )
+					m_conflation.remember(
+							std::move(*conflation_key), lane.m_queue.back() );
+
+				tracer.stored( *this );
+
+				if( m_stats )
+					m_stats->stored( m_size );
+
+				// If chain was empty then multi-chain cases must be notified.
+				// And if not_empty_notificator is defined then it must be used too.
+				if( was_empty )
+					{
+						if( m_not_empty_notificator )
+							so_5::details::invoke_noexcept_code(
+								[this] { m_not_empty_notificator(); } );
+
+						notify_multi_chain_select_ops();
+					}
+
+				// Should be wake up some sleeping thread?
+				if( m_threads_to_wakeup && m_threads_to_wakeup >= m_size )
+					m_underflow_cond.notify_one();
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
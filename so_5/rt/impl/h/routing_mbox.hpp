@@ -0,0 +1,898 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Implementation of content-based routing mbox.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <limits>
+
+#include <so_5/h/types.hpp>
+#include <so_5/h/exception.hpp>
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <so_5/rt/h/mbox.hpp>
+#include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/routing_mbox.hpp>
+
+#include <so_5/rt/impl/h/agent_ptr_compare.hpp>
+#include <so_5/rt/impl/h/message_limit_internals.hpp>
+#include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
+
+#include <so_5/details/h/invoke_noexcept_code.hpp>
+#include <so_5/details/h/rollback_on_exception.hpp>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace routing_mbox_details
+{
+
+using so_5::routing::key_t;
+using so_5::routing::key_filter_t;
+using so_5::routing::key_extractor_t;
+
+//
+// subscriber_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An information about one subscriber of routing mbox.
+ */
+struct subscriber_t
+	{
+		//! Subscriber.
+		agent_t * m_agent;
+
+		//! Optional message limit for that subscriber.
+		const so_5::message_limit::control_block_t * m_limit = nullptr;
+
+		//! Does subscriber have actual subscriptions?
+		bool m_subscribed = false;
+
+		//! Ordinary delivery filter for that subscriber.
+		/*!
+		 * \note It is nullptr if there is no filter or if filter
+		 * is a key filter.
+		 */
+		const delivery_filter_t * m_filter = nullptr;
+
+		//! Key filter for that subscriber.
+		/*!
+		 * \note It is nullptr if there is no filter or if filter
+		 * is an ordinary filter.
+		 */
+		const key_filter_t * m_key_filter = nullptr;
+
+		subscriber_t( agent_t * agent )
+			:	m_agent( agent )
+			{}
+
+		bool
+		empty() const
+			{
+				return !m_subscribed && !m_filter && !m_key_filter;
+			}
+	};
+
+//
+// agent_ptr_compare_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Comparator for agent pointers with respect to agent's priorities.
+ */
+struct agent_ptr_compare_t
+	{
+		bool
+		operator()( agent_t * a, agent_t * b ) const
+			{
+				return special_agent_ptr_compare( *a, *b );
+			}
+	};
+
+//
+// subscribers_vector_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Type of vector with pointers to subscribers.
+ *
+ * \note Pointers are ordered by priorities of agents. It is the same
+ * order as in the map of all subscribers.
+ */
+using subscribers_vector_t = std::vector< const subscriber_t * >;
+
+//
+// msg_routes_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Subscribers for one message type and indexes for them.
+ *
+ * Indexes are updated incrementally on every change of a subscriber.
+ * The change is done in three steps:
+ * - reserve_for() allocates all the memory for the new state of
+ *   the subscriber. It is the only step which can throw;
+ * - remove() excludes the old state of the subscriber from indexes;
+ * - add() includes the new state of the subscriber to indexes.
+ *
+ * Because of that indexes remain correct if there is no memory for
+ * the new state.
+ */
+class msg_routes_t
+	{
+	public :
+		//! Type of map with all subscribers.
+		using subscribers_map_t = std::map<
+				agent_t *, subscriber_t, agent_ptr_compare_t >;
+
+		msg_routes_t( const key_extractor_t * extractor )
+			:	m_extractor( extractor )
+			{}
+
+		//! Key extractor for this message type.
+		/*!
+		 * \note Can be nullptr if there is no extractor for that type.
+		 */
+		const key_extractor_t *
+		extractor() const { return m_extractor; }
+
+		//! Access to subscribers.
+		subscribers_map_t &
+		subscribers() { return m_subscribers; }
+
+		bool
+		empty() const { return m_subscribers.empty(); }
+
+		//! Allocate the memory for the addition of subscriber to indexes.
+		/*!
+		 * Boundaries of the subscriber's range are added to the range
+		 * index. The new segments have the same subscribers as segments
+		 * they were split from. So the content of the index isn't changed.
+		 */
+		void
+		reserve_for( const subscriber_t & s )
+			{
+				if( !s.m_subscribed )
+					return;
+
+				if( is_range( s ) )
+					{
+						const auto first = split_segment( s.m_key_filter->low() );
+						const auto last = has_right_boundary( s ) ?
+								split_segment( s.m_key_filter->high() + 1 ) :
+								m_range_index.end();
+						for( auto it = first; it != last; ++it )
+							reserve_one_more( it->second );
+					}
+				else if( s.m_key_filter )
+					reserve_one_more( m_equal_index[ s.m_key_filter->low() ] );
+				else
+					reserve_one_more( m_plain );
+			}
+
+		//! Exclude the subscriber from indexes.
+		/*!
+		 * \attention \a s must be the object from subscribers() because
+		 * indexes hold pointers to those objects.
+		 *
+		 * \note Boundaries of the range index aren't joined here.
+		 * It is done by join_segments() when the change is finished.
+		 */
+		void
+		remove( const subscriber_t & s ) SO_5_NOEXCEPT
+			{
+				if( !s.m_subscribed )
+					return;
+
+				if( is_range( s ) )
+					for_each_segment( s, [&s]( subscribers_vector_t & v ) {
+							erase_subscriber( v, s );
+						} );
+				else if( s.m_key_filter )
+					{
+						auto it = m_equal_index.find( s.m_key_filter->low() );
+						if( it != m_equal_index.end() )
+							{
+								erase_subscriber( it->second, s );
+								if( it->second.empty() )
+									m_equal_index.erase( it );
+							}
+					}
+				else
+					erase_subscriber( m_plain, s );
+			}
+
+		//! Include the subscriber into indexes.
+		/*!
+		 * \attention reserve_for() must be called for \a s before.
+		 * \a s must be the object from subscribers().
+		 */
+		void
+		add( const subscriber_t & s ) SO_5_NOEXCEPT
+			{
+				if( !s.m_subscribed )
+					return;
+
+				if( is_range( s ) )
+					for_each_segment( s, [&s]( subscribers_vector_t & v ) {
+							insert_subscriber( v, s );
+						} );
+				else if( s.m_key_filter )
+					insert_subscriber( m_equal_index[ s.m_key_filter->low() ], s );
+				else
+					insert_subscriber( m_plain, s );
+			}
+
+		//! Remove boundaries of the range index which are not necessary.
+		/*!
+		 * A boundary is not necessary if the segment to the left of it
+		 * has the same subscribers. Only boundaries of the range
+		 * of \a s are checked. All other boundaries are not affected
+		 * by a change of \a s.
+		 *
+		 * \note An empty equal index entry for the key of \a s, which
+		 * can be left after an unsuccessful reserve_for(), is removed too.
+		 */
+		void
+		join_segments( const subscriber_t & s ) SO_5_NOEXCEPT
+			{
+				if( !s.m_key_filter )
+					return;
+
+				if( s.m_key_filter->low() == s.m_key_filter->high() )
+					{
+						auto it = m_equal_index.find( s.m_key_filter->low() );
+						if( it != m_equal_index.end() && it->second.empty() )
+							m_equal_index.erase( it );
+					}
+				else
+					{
+						join_at( s.m_key_filter->low() );
+						if( has_right_boundary( s ) )
+							join_at( s.m_key_filter->high() + 1 );
+					}
+			}
+
+		//! Enumerate all receivers of a message.
+		/*!
+		 * Receivers are enumerated with respect to priorities of agents.
+		 * It is the same order as in ordinary MPMC-mbox.
+		 *
+		 * Subscribers without filters and subscribers selected by key
+		 * indexes are passed to \a unfiltered_handler. Subscribers with
+		 * ordinary delivery filters are passed to \a filtered_handler
+		 * and filters must be checked by this handler.
+		 */
+		template< typename UNFILTERED_HANDLER, typename FILTERED_HANDLER >
+		void
+		for_each_receiver(
+			message_t * msg,
+			UNFILTERED_HANDLER && unfiltered_handler,
+			FILTERED_HANDLER && filtered_handler ) const
+			{
+				// Every source of receivers is already ordered by priorities.
+				// So the sources are merged.
+				const subscribers_vector_t * sources[ 3 ] = { &m_plain };
+				std::size_t sources_count = 1;
+
+				if( msg && m_extractor &&
+						!( m_equal_index.empty() && m_range_index.empty() ) )
+					{
+						const key_t key = (*m_extractor)( *msg );
+
+						auto it_eq = m_equal_index.find( key );
+						if( it_eq != m_equal_index.end() )
+							sources[ sources_count++ ] = &(it_eq->second);
+
+						auto it_range = m_range_index.upper_bound( key );
+						if( it_range != m_range_index.begin() )
+							sources[ sources_count++ ] = &((--it_range)->second);
+					}
+
+				subscribers_vector_t::const_iterator current[ 3 ];
+				for( std::size_t i = 0; i != sources_count; ++i )
+					current[ i ] = sources[ i ]->begin();
+
+				for(;;)
+					{
+						const subscriber_t * next = nullptr;
+						std::size_t next_source = 0;
+						for( std::size_t i = 0; i != sources_count; ++i )
+							if( current[ i ] != sources[ i ]->end() &&
+									( !next || is_before( **current[ i ], *next ) ) )
+								{
+									next = *current[ i ];
+									next_source = i;
+								}
+
+						if( !next )
+							break;
+
+						++current[ next_source ];
+
+						if( next->m_filter )
+							filtered_handler( *next );
+						else
+							unfiltered_handler( *next );
+					}
+			}
+
+	private :
+		//! Type of index for equality filters.
+		using equal_index_t = std::unordered_map< key_t, subscribers_vector_t >;
+
+		//! Type of index for range filters.
+		/*!
+		 * Key is the left boundary of a segment. The segment lasts up to
+		 * the left boundary of the next segment. Value is the list of
+		 * subscribers whose ranges cover the segment.
+		 *
+		 * There are no two adjacent segments with the same subscribers
+		 * and there is no empty first segment.
+		 */
+		using range_index_t = std::map< key_t, subscribers_vector_t >;
+
+		//! Key extractor for that message type.
+		const key_extractor_t * m_extractor;
+
+		//! All subscribers.
+		subscribers_map_t m_subscribers;
+
+		//! Subscribers without key filters.
+		/*!
+		 * Subscribers with ordinary delivery filters are stored here too.
+		 */
+		subscribers_vector_t m_plain;
+
+		//! Subscribers with key filters for a single key.
+		equal_index_t m_equal_index;
+
+		//! Subscribers with key filters for key ranges.
+		range_index_t m_range_index;
+
+		static bool
+		is_range( const subscriber_t & s )
+			{
+				return s.m_key_filter &&
+						s.m_key_filter->low() != s.m_key_filter->high();
+			}
+
+		//! Does the range of subscriber end before the max key value?
+		static bool
+		has_right_boundary( const subscriber_t & s )
+			{
+				return s.m_key_filter->high() !=
+						(std::numeric_limits< key_t >::max)();
+			}
+
+		//! Must \a a receive messages before \a b?
+		static bool
+		is_before( const subscriber_t & a, const subscriber_t & b )
+			{
+				return special_agent_ptr_compare( *(a.m_agent), *(b.m_agent) );
+			}
+
+		static void
+		reserve_one_more( subscribers_vector_t & v )
+			{
+				v.reserve( v.size() + 1 );
+			}
+
+		static void
+		insert_subscriber( subscribers_vector_t & v, const subscriber_t & s )
+			{
+				v.insert(
+						std::lower_bound( v.begin(), v.end(), &s,
+								[]( const subscriber_t * a, const subscriber_t * b ) {
+									return is_before( *a, *b );
+								} ),
+						&s );
+			}
+
+		static void
+		erase_subscriber( subscribers_vector_t & v, const subscriber_t & s )
+			{
+				auto it = std::find( v.begin(), v.end(), &s );
+				if( it != v.end() )
+					v.erase( it );
+			}
+
+		//! Ensure that there is a segment which starts from \a key.
+		range_index_t::iterator
+		split_segment( key_t key )
+			{
+				auto it = m_range_index.lower_bound( key );
+				if( it != m_range_index.end() && it->first == key )
+					return it;
+
+				subscribers_vector_t subscribers;
+				if( it != m_range_index.begin() )
+					subscribers = std::prev( it )->second;
+
+				return m_range_index.emplace_hint(
+						it, key, std::move(subscribers) );
+			}
+
+		//! Call \a action for every segment inside the range of \a s.
+		template< typename ACTION >
+		void
+		for_each_segment( const subscriber_t & s, ACTION action )
+			{
+				for( auto it = m_range_index.find( s.m_key_filter->low() );
+						it != m_range_index.end() &&
+							s.m_key_filter->match( it->first );
+						++it )
+					action( it->second );
+			}
+
+		//! Remove the boundary at \a key if it is not necessary.
+		void
+		join_at( key_t key )
+			{
+				auto it = m_range_index.find( key );
+				if( it == m_range_index.end() )
+					return;
+
+				const bool redundant = it == m_range_index.begin() ?
+						it->second.empty() :
+						std::prev( it )->second == it->second;
+				if( redundant )
+					m_range_index.erase( it );
+			}
+	};
+
+//
+// data_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A collection of data required for routing mbox implementation.
+ */
+struct data_t
+	{
+		data_t(
+			mbox_id_t id,
+			so_5::routing::mbox_params_t::extractors_map_t extractors )
+			:	m_id{ id }
+			,	m_extractors( std::move(extractors) )
+			{}
+
+		//! ID of this mbox.
+		const mbox_id_t m_id;
+
+		//! Key extractors for message types.
+		const so_5::routing::mbox_params_t::extractors_map_t m_extractors;
+
+		//! Object lock.
+		mutable default_rw_spinlock_t m_lock;
+
+		//! Type of map from message type to subscribers.
+		using messages_table_t = std::map< std::type_index, msg_routes_t >;
+
+		//! Map of subscribers to messages.
+		messages_table_t m_subscribers;
+	};
+
+} /* namespace routing_mbox_details */
+
+//
+// routing_mbox_template
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A template with implementation of content-based routing mbox.
+ *
+ * \tparam TRACING_BASE base class with implementation of message
+ * delivery tracing methods.
+ */
+template< typename TRACING_BASE >
+class routing_mbox_template
+	:	public abstract_message_box_t
+	,	private routing_mbox_details::data_t
+	,	private TRACING_BASE
+	{
+	public:
+		template< typename... TRACING_ARGS >
+		routing_mbox_template(
+			//! ID of this mbox.
+			mbox_id_t id,
+			//! Parameters for the mbox.
+			const so_5::routing::mbox_params_t & params,
+			//! Optional parameters for TRACING_BASE's constructor.
+			TRACING_ARGS &&... args )
+			:	routing_mbox_details::data_t{ id, params.key_extractors() }
+			,	TRACING_BASE{ std::forward< TRACING_ARGS >(args)... }
+			{}
+
+		virtual mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & type_wrapper,
+			const so_5::message_limit::control_block_t * limit,
+			agent_t * subscriber ) override
+			{
+				modify_subscriber(
+						type_wrapper,
+						subscriber,
+						[&]( routing_mbox_details::subscriber_t & info ) {
+							info.m_limit = limit;
+							info.m_subscribed = true;
+						} );
+			}
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & type_wrapper,
+			agent_t * subscriber ) override
+			{
+				modify_subscriber(
+						type_wrapper,
+						subscriber,
+						[]( routing_mbox_details::subscriber_t & info ) {
+							info.m_limit = nullptr;
+							info.m_subscribed = false;
+						} );
+			}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mbox:type=MPMC:routing:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		virtual mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_multi_consumer;
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						*this, // as TRACING_BASE
+						*this, // as abstract_message_box_t
+						"deliver_message",
+						msg_type, message, overlimit_reaction_deep };
+
+				ensure_immutable_message( msg_type, message );
+
+				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type );
+				if( it != m_subscribers.end() )
+					{
+						it->second.for_each_receiver(
+								message.get(),
+								[&]( const routing_mbox_details::subscriber_t & s ) {
+									do_deliver_message_to_subscriber(
+											s, tracer, msg_type, message,
+											overlimit_reaction_deep );
+								},
+								[&]( const routing_mbox_details::subscriber_t & s ) {
+									if( s.m_filter->check( *(s.m_agent), *message ) )
+										do_deliver_message_to_subscriber(
+												s, tracer, msg_type, message,
+												overlimit_reaction_deep );
+									else
+										tracer.message_rejected(
+												s.m_agent,
+												delivery_possibility_t::disabled_by_delivery_filter );
+								} );
+					}
+				else
+					tracer.no_subscribers();
+			}
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				typename TRACING_BASE::deliver_op_tracer tracer{
+						*this, // as TRACING_BASE
+						*this, // as abstract_message_box_t
+						"deliver_service_request",
+						msg_type, message, overlimit_reaction_deep };
+
+				msg_service_request_base_t::dispatch_wrapper( message,
+					[&] {
+						read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+
+						auto it = m_subscribers.find( msg_type );
+						if( it == m_subscribers.end() )
+							{
+								tracer.no_subscribers();
+
+								SO_5_THROW_EXCEPTION(
+										so_5::rc_no_svc_handlers,
+										"no service handlers (no subscribers for message)" );
+							}
+
+						auto & param =
+							dynamic_cast< msg_service_request_base_t & >( *message )
+									.query_param();
+
+						const routing_mbox_details::subscriber_t * receiver = nullptr;
+						std::size_t receivers_count = 0;
+						const auto add_receiver =
+							[&]( const routing_mbox_details::subscriber_t & s ) {
+								receiver = &s;
+								++receivers_count;
+							};
+
+						it->second.for_each_receiver(
+								&param,
+								add_receiver,
+								[&]( const routing_mbox_details::subscriber_t & s ) {
+									if( s.m_filter->check( *(s.m_agent), param ) )
+										add_receiver( s );
+									else
+										tracer.message_rejected(
+												s.m_agent,
+												delivery_possibility_t::disabled_by_delivery_filter );
+								} );
+
+						if( !receivers_count )
+							SO_5_THROW_EXCEPTION(
+									so_5::rc_no_svc_handlers,
+									"no service handlers (no subscribers for message or "
+									"subscriber is blocked by delivery filter)" );
+
+						if( 1 != receivers_count )
+							SO_5_THROW_EXCEPTION(
+									so_5::rc_more_than_one_svc_handler,
+									"more than one service handler found" );
+
+						using namespace so_5::message_limit::impl;
+
+						try_to_deliver_to_agent(
+								invocation_type_t::service_request,
+								*(receiver->m_agent),
+								receiver->m_limit,
+								msg_type,
+								message,
+								overlimit_reaction_deep,
+								tracer.overlimit_tracer(),
+								[&] {
+									tracer.push_to_queue( receiver->m_agent );
+
+									agent_t::call_push_service_request(
+											*(receiver->m_agent),
+											receiver->m_limit,
+											m_id,
+											msg_type,
+											message );
+								} );
+					} );
+			}
+
+		virtual void
+		set_delivery_filter(
+			const std::type_index & msg_type,
+			const delivery_filter_t & filter,
+			agent_t & subscriber ) override
+			{
+				const auto * key_filter =
+						dynamic_cast< const so_5::routing::key_filter_t * >( &filter );
+
+				if( key_filter &&
+						m_extractors.find( msg_type ) == m_extractors.end() )
+					SO_5_THROW_EXCEPTION(
+							so_5::rc_routing_key_extractor_not_found,
+							"an attempt to set key filter for message type without "
+							"key extractor, msg_type=" + std::string(msg_type.name()) );
+
+				modify_subscriber(
+						msg_type,
+						&subscriber,
+						[&]( routing_mbox_details::subscriber_t & info ) {
+							if( key_filter )
+								{
+									info.m_key_filter = key_filter;
+									info.m_filter = nullptr;
+								}
+							else
+								{
+									info.m_key_filter = nullptr;
+									info.m_filter = &filter;
+								}
+						} );
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & msg_type,
+			agent_t & subscriber ) SO_5_NOEXCEPT override
+			{
+				so_5::details::invoke_noexcept_code( [&] {
+					modify_subscriber(
+							msg_type,
+							&subscriber,
+							[]( routing_mbox_details::subscriber_t & info ) {
+								info.m_key_filter = nullptr;
+								info.m_filter = nullptr;
+							} );
+				} );
+			}
+
+	private :
+		/*!
+		 * \brief Modify (and create if necessary) an information about
+		 * subscriber.
+		 *
+		 * The information about subscriber will be removed if it becomes
+		 * empty. Indexes are updated only for that subscriber.
+		 */
+		template< typename INFO_CHANGER >
+		void
+		modify_subscriber(
+			const std::type_index & msg_type,
+			agent_t * subscriber,
+			INFO_CHANGER changer )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type );
+				if( it == m_subscribers.end() )
+					{
+						auto it_ex = m_extractors.find( msg_type );
+						it = m_subscribers.emplace(
+								msg_type,
+								routing_mbox_details::msg_routes_t{
+										it_ex != m_extractors.end() ?
+												&(it_ex->second) : nullptr } ).first;
+					}
+
+				auto & routes = it->second;
+				auto & subscribers = routes.subscribers();
+
+				auto pos = subscribers.find( subscriber );
+				if( pos == subscribers.end() )
+					pos = subscribers.emplace(
+							subscriber,
+							routing_mbox_details::subscriber_t{ subscriber } ).first;
+
+				const auto old_info = pos->second;
+				auto new_info = old_info;
+				changer( new_info );
+
+				// Only this step can throw. Indexes are not changed yet.
+				so_5::details::do_with_rollback_on_exception(
+						[&] { routes.reserve_for( new_info ); },
+						[&] {
+							routes.join_segments( new_info );
+							if( pos->second.empty() )
+								subscribers.erase( pos );
+							if( routes.empty() )
+								m_subscribers.erase( it );
+						} );
+
+				// Indexes hold pointers to the stored info. So the stored
+				// info must be removed before it is changed.
+				routes.remove( pos->second );
+				pos->second = new_info;
+				routes.add( pos->second );
+				routes.join_segments( old_info );
+				routes.join_segments( new_info );
+
+				if( pos->second.empty() )
+					subscribers.erase( pos );
+
+				if( routes.empty() )
+					m_subscribers.erase( it );
+			}
+
+		void
+		do_deliver_message_to_subscriber(
+			const routing_mbox_details::subscriber_t & subscriber,
+			typename TRACING_BASE::deliver_op_tracer const & tracer,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const
+			{
+				using namespace so_5::message_limit::impl;
+
+				try_to_deliver_to_agent(
+						invocation_type_t::event,
+						*(subscriber.m_agent),
+						subscriber.m_limit,
+						msg_type,
+						message,
+						overlimit_reaction_deep,
+						tracer.overlimit_tracer(),
+						[&] {
+							tracer.push_to_queue( subscriber.m_agent );
+
+							agent_t::call_push_event(
+									*(subscriber.m_agent),
+									subscriber.m_limit,
+									m_id,
+									msg_type,
+									message );
+						} );
+			}
+
+		/*!
+		 * \brief Ensures that message is an immutable message.
+		 *
+		 * Checks mutability flag and throws an exception if message is
+		 * a mutable one.
+		 */
+		void
+		ensure_immutable_message(
+			const std::type_index & msg_type,
+			const message_ref_t & what ) const
+			{
+				if( message_mutability_t::immutable_message !=
+						message_mutability( what ) )
+					SO_5_THROW_EXCEPTION(
+							so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox,
+							"an attempt to deliver mutable message via MPMC mbox"
+							", msg_type=" + std::string(msg_type.name()) );
+			}
+	};
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Alias for routing mbox without message delivery tracing.
+ */
+using routing_mbox_without_tracing =
+	routing_mbox_template< msg_tracing_helpers::tracing_disabled_base >;
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Alias for routing mbox with message delivery tracing.
+ */
+using routing_mbox_with_tracing =
+	routing_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -0,0 +1,88 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief A common timer for time limits of agent's states.
+ */
+
+#pragma once
+
+#include <so_5/rt/h/mbox.hpp>
+#include <so_5/rt/h/message.hpp>
+
+#include <so_5/h/timers.hpp>
+
+#include <chrono>
+
+namespace so_5 {
+
+namespace impl {
+
+//
+// state_time_limits_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A common timer for time limits of all agent's states.
+ *
+ * Before v.5.5.20 every entering into a state with time limit created
+ * a new mbox, a new subscription and a new timer. All of them were
+ * destroyed on exit from the state. It was too expensive for agents
+ * which switch between states with time limits very often.
+ *
+ * Since v.5.5.20 there is just one mbox and one timer per agent.
+ * The timer is armed for the nearest deadline of active states with
+ * time limits. It is rearmed only if a new deadline is earlier than the
+ * time point the timer is armed for. Exit from a state doesn't touch
+ * the timer at all: expiration of deadlines is checked lazily when
+ * the timeout signal arrives.
+ *
+ * \note This object is used only on agent's working context.
+ */
+class state_time_limits_t
+	{
+	public :
+		using clock = std::chrono::steady_clock;
+
+		//! Signal about possible expiration of time limits.
+		struct timeout : public signal_t {};
+
+		//! Unique mbox for timeout signals.
+		/*!
+		 * Created at the first entering into a state with time limit.
+		 */
+		mbox_t m_mbox;
+
+		//! Timer for the nearest deadline.
+		timer_id_t m_timer;
+
+		//! Time point for which the timer is armed.
+		/*!
+		 * Value clock::time_point::min() means that the timer is not armed.
+		 */
+		clock::time_point m_armed_for = clock::time_point::min();
+
+		//! Handle a message for which there is no event handler.
+		/*!
+		 * If it is timeout signal then the timer has fired but there is
+		 * no active state with time limit. The timer must be treated
+		 * as not armed.
+		 */
+		void
+		handle_ignored_message( mbox_id_t mbox_id )
+			{
+				if( m_mbox && m_mbox->id() == mbox_id )
+					m_armed_for = clock::time_point::min();
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
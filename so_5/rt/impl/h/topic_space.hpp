@@ -0,0 +1,271 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief An implementation of topic space and topic mboxes.
+ */
+
+#pragma once
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <so_5/rt/h/mbox.hpp>
+#include <so_5/rt/h/topic_mbox.hpp>
+
+#include <so_5/rt/impl/h/mbox_core.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace topic_space_details
+{
+
+//! Type of parsed topic name.
+using segments_t = std::vector< std::string >;
+
+/*!
+ * \brief Split topic name to segments.
+ *
+ * \throw so_5::exception_t if \a name is not a valid topic name.
+ */
+segments_t
+split_topic_name( const std::string & name );
+
+//! Type of list of actual mboxes which receive a message for a topic.
+using receivers_t = std::vector< mbox_t >;
+
+//! Type of shared pointer to cached list of receivers.
+using receivers_shptr_t = std::shared_ptr< const receivers_t >;
+
+//
+// trie_node_t
+//
+/*!
+ * \brief A node of topic trie.
+ *
+ * Wildcard segments are stored as ordinary children with
+ * names "*" and "#".
+ */
+struct trie_node_t
+	{
+		//! Children nodes.
+		std::unordered_map<
+						std::string,
+						std::unique_ptr< trie_node_t > >
+				m_children;
+
+		//! Actual mbox for name which ends at this node.
+		/*!
+		 * Null if there is no such name in the space.
+		 */
+		mbox_t m_mbox;
+	};
+
+//
+// topic_info_t
+//
+/*!
+ * \brief Information about one topic or pattern in the space.
+ */
+struct topic_info_t
+	{
+		topic_info_t(
+			segments_t segments,
+			bool is_pattern,
+			mbox_t actual_mbox )
+			:	m_segments( std::move(segments) )
+			,	m_is_pattern( is_pattern )
+			,	m_actual_mbox( std::move(actual_mbox) )
+			{}
+
+		//! Segments of the name.
+		const segments_t m_segments;
+
+		//! Is it a pattern?
+		const bool m_is_pattern;
+
+		//! Actual MPMC-mbox for subscribers of this name.
+		/*!
+		 * Topic mboxes use ID of that mbox as their own ID.
+		 */
+		const mbox_t m_actual_mbox;
+
+		//! Generation of the space for which receivers have been cached.
+		/*!
+		 * Value 0 means that receivers are not cached yet.
+		 */
+		std::uint_fast64_t m_generation = 0;
+
+		//! Cached receivers.
+		receivers_shptr_t m_receivers;
+	};
+
+} /* namespace topic_space_details */
+
+//
+// topic_space_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief An implementation of topic space.
+ *
+ * Every name in the space has its own actual local mbox. All names are
+ * indexed by a trie. A list of actual mboxes for a topic is found by
+ * walking the trie. Found lists are cached in topic_info_t and
+ * are invalidated only when a new pattern is added to the space.
+ */
+class topic_space_t : public so_5::topics::space_t
+	{
+		friend class intrusive_ptr_t< topic_space_t >;
+
+	public :
+		topic_space_t(
+			//! Owner of the space. Actual mboxes will be created by it.
+			mbox_core_t & mbox_core );
+		virtual ~topic_space_t();
+
+		virtual mbox_t
+		mbox( const std::string & name ) override;
+
+		virtual std::size_t
+		size() const override;
+
+		//! Get the list of actual mboxes which receive a message
+		//! for the topic.
+		topic_space_details::receivers_shptr_t
+		receivers( topic_space_details::topic_info_t & info );
+
+	private :
+		//! Object lock.
+		mutable default_rw_spinlock_t m_lock;
+
+		//! Owner of the space.
+		mbox_core_ref_t m_mbox_core;
+
+		//! Root of the trie.
+		topic_space_details::trie_node_t m_root;
+
+		//! All names in the space.
+		std::map< std::string, topic_space_details::topic_info_t > m_names;
+
+		//! Current generation of the space.
+		/*!
+		 * Is incremented every time a new pattern is added.
+		 */
+		std::uint_fast64_t m_generation;
+
+		//! Find all actual mboxes which match the topic.
+		void
+		collect_receivers(
+			const topic_space_details::trie_node_t & node,
+			const topic_space_details::segments_t & segments,
+			std::size_t index,
+			topic_space_details::receivers_t & receivers ) const;
+	};
+
+//
+// topic_mbox_t
+//
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief A mbox for a topic or pattern from topic space.
+ *
+ * All subscriptions and delivery filters are delegated to the actual
+ * mbox of the name. Messages are delivered to actual mboxes of all
+ * names which match the topic.
+ *
+ * \note Service requests are delivered only to the actual mbox of
+ * the topic itself.
+ */
+class topic_mbox_t : public abstract_message_box_t
+	{
+	public :
+		topic_mbox_t(
+			intrusive_ptr_t< topic_space_t > space,
+			const std::string & name,
+			topic_space_details::topic_info_t & info );
+		virtual ~topic_mbox_t();
+
+		virtual mbox_id_t
+		id() const override;
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & type_wrapper,
+			const so_5::message_limit::control_block_t * limit,
+			agent_t * subscriber ) override;
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & type_wrapper,
+			agent_t * subscriber ) override;
+
+		virtual std::string
+		query_name() const override;
+
+		virtual mbox_type_t
+		type() const override;
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override;
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override;
+
+		virtual void
+		set_delivery_filter(
+			const std::type_index & msg_type,
+			const delivery_filter_t & filter,
+			agent_t & subscriber ) override;
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & msg_type,
+			agent_t & subscriber ) SO_5_NOEXCEPT override;
+
+	private :
+		//! Space of the topic.
+		const intrusive_ptr_t< topic_space_t > m_space;
+
+		//! Name of the topic.
+		const std::string m_name;
+
+		//! Information about the topic.
+		/*!
+		 * \note This object is owned by m_space.
+		 */
+		topic_space_details::topic_info_t & m_info;
+
+		//! Throw an exception if the mbox is a pattern mbox.
+		void
+		ensure_not_pattern() const;
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -9,8 +9,14 @@
 #include <so_5/rt/impl/h/local_mbox.hpp>
 #include <so_5/rt/impl/h/named_local_mbox.hpp>
 #include <so_5/rt/impl/h/mpsc_mbox.hpp>
+#include <so_5/rt/impl/h/routing_mbox.hpp>
+#include <so_5/rt/impl/h/last_value_mbox.hpp>
+#include <so_5/rt/impl/h/topic_space.hpp>
 #include <so_5/rt/impl/h/mbox_core.hpp>
 #include <so_5/rt/impl/h/mchain_details.hpp>
+#include <so_5/rt/impl/h/lock_free_mchain.hpp>
+#include <so_5/rt/impl/h/priority_mchain.hpp>
+#include <so_5/rt/impl/h/mchain_spill.hpp>
 
 namespace so_5
 {
@@ -26,6 +32,8 @@ mbox_core_t::mbox_core_t(
 	so_5::msg_tracing::tracer_t * tracer )
 	:	m_tracer{ tracer }
 	,	m_mbox_id_counter{ 1 }
+	,	m_mchain_stats_registry{
+			std::make_shared< mchain_props::details::mchain_stats_registry_t >() }
 {
 }
 
@@ -71,6 +79,25 @@ make_actual_mbox(
 
 } /* namespace anonymous */
 
+mbox_t
+mbox_core_t::create_last_value_mbox()
+{
+	const auto id = ++m_mbox_id_counter;
+
+	return mbox_t{
+			make_actual_mbox<
+					last_value_mbox_without_tracing,
+					last_value_mbox_with_tracing >(
+				m_tracer,
+				id ).release() };
+}
+
+so_5::topics::space_ref_t
+mbox_core_t::create_topic_space()
+{
+	return so_5::topics::space_ref_t{ new topic_space_t{ *this } };
+}
+
 mbox_t
 mbox_core_t::create_mpsc_mbox(
 	agent_t * single_consumer,
@@ -104,6 +131,21 @@ mbox_core_t::create_mpsc_mbox(
 	return mbox_t{ actual_mbox.release() };
 }
 
+mbox_t
+mbox_core_t::create_routing_mbox(
+	const so_5::routing::mbox_params_t & params )
+{
+	const auto id = ++m_mbox_id_counter;
+
+	return mbox_t{
+			make_actual_mbox<
+					routing_mbox_without_tracing,
+					routing_mbox_with_tracing >(
+				m_tracer,
+				id,
+				params ).release() };
+}
+
 void
 mbox_core_t::destroy_mbox(
 	const std::string & name )
@@ -147,6 +189,94 @@ make_mchain(
 						std::forward<A>(args)..., params } };
 	}
 
+template< so_5::mchain_props::multiplicity_t PRODUCERS, typename... A >
+mchain_t
+make_lock_free_mchain(
+	so_5::msg_tracing::tracer_t * tracer,
+	const mchain_params_t & params,
+	A &&... args )
+	{
+		using namespace so_5::mchain_props;
+		using namespace so_5::impl::msg_tracing_helpers;
+		using D = mchain_tracing_disabled_base;
+		using E = mchain_tracing_enabled_base;
+
+		if( tracer && !params.msg_tracing_disabled() )
+			return mchain_t{
+					new lock_free_mchain_template< PRODUCERS, E >{
+						std::forward<A>(args)...,
+						params,
+						*tracer } };
+		else
+			return mchain_t{
+					new lock_free_mchain_template< PRODUCERS, D >{
+						std::forward<A>(args)..., params } };
+	}
+
+template< typename... A >
+mchain_t
+make_priority_mchain(
+	so_5::msg_tracing::tracer_t * tracer,
+	const mchain_params_t & params,
+	A &&... args )
+	{
+		using namespace so_5::mchain_props;
+		using namespace so_5::impl::msg_tracing_helpers;
+		using D = mchain_tracing_disabled_base;
+		using E = mchain_tracing_enabled_base;
+
+		if( tracer && !params.msg_tracing_disabled() )
+			return mchain_t{
+					new priority_mchain_template< E >{
+						std::forward<A>(args)...,
+						params,
+						*tracer } };
+		else
+			return mchain_t{
+					new priority_mchain_template< D >{
+						std::forward<A>(args)..., params } };
+	}
+
+template< typename... A >
+mchain_t
+make_spilling_mchain(
+	so_5::msg_tracing::tracer_t * tracer,
+	const mchain_params_t & params,
+	A &&... args )
+	{
+		using namespace so_5::mchain_props;
+		using namespace so_5::impl::msg_tracing_helpers;
+		using D = mchain_tracing_disabled_base;
+		using E = mchain_tracing_enabled_base;
+
+		if( tracer && !params.msg_tracing_disabled() )
+			return mchain_t{
+					new spilling_mchain_template< E >{
+						std::forward<A>(args)...,
+						params,
+						*tracer } };
+		else
+			return mchain_t{
+					new spilling_mchain_template< D >{
+						std::forward<A>(args)..., params } };
+	}
+
+//! Check compatibility of spill-to-disk with other params of mchain.
+void
+ensure_spill_can_be_used( const mchain_params_t & params )
+	{
+		const char * reason = nullptr;
+		if( params.capacity().unlimited() )
+			reason = "spill-to-disk can't be used for size-unlimited mchain";
+		else if( !params.priority_lanes().empty() )
+			reason = "spill-to-disk can't be used with priority lanes";
+		else if( !params.conflated_types().empty() )
+			reason = "spill-to-disk can't be used with conflation";
+
+		if( reason )
+			SO_5_THROW_EXCEPTION( rc_incompatible_mchain_params, reason );
+	}
+
 } /* namespace anonymous */
 
 mchain_t
@@ -157,17 +287,45 @@ mbox_core_t::create_mchain(
 	using namespace so_5::mchain_props;
 	using namespace so_5::mchain_props::details;
 
+	if( params.spill_params().enabled() )
+		ensure_spill_can_be_used( params );
+
 	auto id = ++m_mbox_id_counter;
 
-	if( params.capacity().unlimited() )
+	if( params.spill_params().enabled() )
+		return make_spilling_mchain(
+				m_tracer, params, m_mchain_stats_registry, env, id );
+	else if( !params.priority_lanes().empty() )
+		return make_priority_mchain(
+				m_tracer, params, m_mchain_stats_registry, env, id );
+	else if( params.capacity().unlimited() )
 		return make_mchain< unlimited_demand_queue >(
-				m_tracer, params, env, id );
+				m_tracer, params, m_mchain_stats_registry, env, id );
+	else if( multiplicity_t::single == params.consumers() &&
+			params.capacity().max_size() &&
+			params.conflated_types().empty() &&
+			!params.stats_enabled() )
+		{
+			if( multiplicity_t::single == params.producers() )
+				return make_lock_free_mchain< multiplicity_t::single >(
+						m_tracer, params, env, id );
+			else
+				return make_lock_free_mchain< multiplicity_t::multiple >(
+						m_tracer, params, env, id );
+		}
 	else if( memory_usage_t::dynamic == params.capacity().memory_usage() )
 		return make_mchain< limited_dynamic_demand_queue >(
-				m_tracer, params, env, id );
+				m_tracer, params, m_mchain_stats_registry, env, id );
 	else
 		return make_mchain< limited_preallocated_demand_queue >(
-				m_tracer, params, env, id );
+				m_tracer, params, m_mchain_stats_registry, env, id );
+}
+
+void
+mbox_core_t::distribute_mchain_stats(
+	const mbox_t & distribution_mbox )
+{
+	m_mchain_stats_registry->distribute( distribution_mbox );
 }
 
 mbox_core_stats_t
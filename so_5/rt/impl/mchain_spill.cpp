@@ -0,0 +1,197 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Implementation of spill file for message chains.
+ */
+
+#include <so_5/rt/impl/h/mchain_spill.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#if !defined(_WIN32)
+	#include <sys/mman.h>
+	#include <sys/types.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+namespace {
+
+//! Alignment of binary images inside a segment.
+const std::size_t image_alignment = 8u;
+
+#if !defined(_WIN32)
+
+void
+throw_spill_failure( const char * what )
+	{
+		const auto code = errno;
+		SO_5_THROW_EXCEPTION( rc_mchain_spill_failure,
+				std::string( what ) + ": " + std::strerror( code ) );
+	}
+
+std::size_t
+page_aligned_segment_size( std::size_t segment_size )
+	{
+		const auto page = static_cast< std::size_t >( ::sysconf( _SC_PAGESIZE ) );
+		if( !segment_size )
+			segment_size = page;
+
+		return ( segment_size + page - 1u ) / page * page;
+	}
+
+#endif
+
+} /* namespace anonymous */
+
+#if !defined(_WIN32)
+
+spill_storage_t::spill_storage_t(
+	const std::string & directory,
+	std::size_t segment_size )
+	:	m_fd( -1 )
+	,	m_segment_size( page_aligned_segment_size( segment_size ) )
+	{
+		std::string name = directory + "/so5_mchain_spill_XXXXXX";
+		m_fd = ::mkstemp( &name[ 0 ] );
+		if( -1 == m_fd )
+			throw_spill_failure( "unable to create spill file" );
+
+		// File isn't needed in the directory. It will be deleted
+		// automatically after close.
+		::unlink( name.c_str() );
+	}
+
+spill_storage_t::~spill_storage_t()
+	{
+		for( auto & s : m_segments )
+			::munmap( s.m_data, m_segment_size );
+
+		::close( m_fd );
+	}
+
+void
+spill_storage_t::switch_to_new_segment()
+	{
+		if( !m_free_segments.empty() )
+			{
+				m_current = m_free_segments.back();
+				m_free_segments.pop_back();
+				return;
+			}
+
+		const auto index = m_segments.size();
+		const auto new_file_size = static_cast< off_t >(
+				( index + 1u ) * m_segment_size );
+		if( 0 != ::ftruncate( m_fd, new_file_size ) )
+			throw_spill_failure( "unable to extend spill file" );
+
+		void * data = ::mmap(
+				nullptr,
+				m_segment_size,
+				PROT_READ | PROT_WRITE,
+				MAP_SHARED,
+				m_fd,
+				static_cast< off_t >( index * m_segment_size ) );
+		if( MAP_FAILED == data )
+			throw_spill_failure( "unable to map segment of spill file" );
+
+		m_segments.push_back( segment_t{ static_cast< char * >( data ), 0u, 0u } );
+		m_current = index;
+	}
+
+#else
+
+spill_storage_t::spill_storage_t(
+	const std::string & /*directory*/,
+	std::size_t segment_size )
+	:	m_fd( -1 )
+	,	m_segment_size( segment_size )
+	{
+		SO_5_THROW_EXCEPTION( rc_not_implemented,
+				"spill-to-disk mchains are not supported on this platform" );
+	}
+
+spill_storage_t::~spill_storage_t()
+	{}
+
+void
+spill_storage_t::switch_to_new_segment()
+	{}
+
+#endif
+
+bool
+spill_storage_t::store(
+	const std::string & image,
+	spill_location_t & location )
+	{
+		if( image.size() > m_segment_size )
+			return false;
+
+		// NOTE: the current segment has live images if there is no
+		// place for the image. It will be reused in release().
+		if( no_segment == m_current ||
+				m_segment_size - m_segments[ m_current ].m_used < image.size() )
+			switch_to_new_segment();
+
+		auto & s = m_segments[ m_current ];
+		std::memcpy( s.m_data + s.m_used, image.data(), image.size() );
+
+		location.m_segment = m_current;
+		location.m_offset = s.m_used;
+		location.m_size = image.size();
+
+		s.m_used += ( image.size() + image_alignment - 1u ) /
+				image_alignment * image_alignment;
+		if( s.m_used > m_segment_size )
+			s.m_used = m_segment_size;
+		++s.m_live;
+
+		return true;
+	}
+
+const char *
+spill_storage_t::data( const spill_location_t & location ) const
+	{
+		return m_segments[ location.m_segment ].m_data + location.m_offset;
+	}
+
+void
+spill_storage_t::release( const spill_location_t & location )
+	{
+		auto & s = m_segments[ location.m_segment ];
+		if( 0u == --s.m_live )
+			{
+				if( location.m_segment == m_current )
+					// The current segment can be reused from the beginning.
+					s.m_used = 0u;
+				else
+					{
+						s.m_used = 0u;
+						m_free_segments.push_back( location.m_segment );
+					}
+			}
+	}
+
+} /* namespace details */
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
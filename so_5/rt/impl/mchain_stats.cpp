@@ -0,0 +1,101 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Helpers for run-time monitoring of message chains.
+ */
+
+#include <so_5/rt/impl/h/mchain_stats.hpp>
+
+#include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/std_names.hpp>
+
+#include <so_5/rt/h/send_functions.hpp>
+
+#include <algorithm>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+namespace {
+
+//! Calculate count of events per second.
+std::size_t
+per_second(
+	std::size_t count,
+	std::chrono::steady_clock::duration period )
+	{
+		const auto ms = std::chrono::duration_cast<
+				std::chrono::milliseconds >( period ).count();
+		if( ms <= 0 )
+			return 0u;
+
+		return static_cast< std::size_t >(
+				static_cast< unsigned long long >( count ) * 1000u /
+				static_cast< unsigned long long >( ms ) );
+	}
+
+} /* namespace anonymous */
+
+void
+mchain_stats_t::distribute( const mbox_t & distribution_mbox )
+	{
+		namespace stats = so_5::stats;
+		using quantity_t = stats::messages::quantity< std::size_t >;
+
+		const auto now = std::chrono::steady_clock::now();
+		const auto period = now - m_last_distribution;
+
+		const auto size = m_size.load( std::memory_order_relaxed );
+		const auto enqueued = m_enqueued.load( std::memory_order_relaxed );
+		const auto dequeued = m_dequeued.load( std::memory_order_relaxed );
+
+		// High watermark for the next period starts from the current size.
+		const auto high_watermark = (std::max)(
+				size,
+				m_high_watermark.exchange( size, std::memory_order_relaxed ) );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_size(), size );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_size_high_watermark(),
+				high_watermark );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_enqueued_count(), enqueued );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_dequeued_count(), dequeued );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_enqueue_rate(),
+				per_second( enqueued - m_last_enqueued, period ) );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_dequeue_rate(),
+				per_second( dequeued - m_last_dequeued, period ) );
+
+		send< quantity_t >( distribution_mbox,
+				m_prefix, stats::suffixes::mchain_overflow_count(),
+				m_overflows.load( std::memory_order_relaxed ) );
+
+		m_last_distribution = now;
+		m_last_enqueued = enqueued;
+		m_last_dequeued = dequeued;
+	}
+
+} /* namespace details */
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
+
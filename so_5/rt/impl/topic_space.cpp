@@ -0,0 +1,317 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief An implementation of topic space and topic mboxes.
+ */
+
+#include <so_5/rt/impl/h/topic_space.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <mutex>
+#include <sstream>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace topic_space_details
+{
+
+namespace
+{
+
+const char * const single_segment_wildcard = "*";
+const char * const multi_segment_wildcard = "#";
+
+void
+throw_invalid_name( const std::string & name, const char * reason )
+	{
+		SO_5_THROW_EXCEPTION( rc_invalid_topic_name,
+				"invalid topic name '" + name + "': " + reason );
+	}
+
+} /* namespace anonymous */
+
+segments_t
+split_topic_name( const std::string & name )
+	{
+		if( name.empty() )
+			throw_invalid_name( name, "name is empty" );
+
+		segments_t result;
+
+		std::string::size_type from = 0;
+		while( true )
+			{
+				const auto dot = name.find( '.', from );
+				const auto end = std::string::npos == dot ? name.size() : dot;
+
+				if( from == end )
+					throw_invalid_name( name, "empty segment" );
+
+				result.emplace_back( name, from, end - from );
+
+				const auto & s = result.back();
+				if( s.size() > 1u && std::string::npos != s.find_first_of( "*#" ) )
+					throw_invalid_name( name,
+							"wildcard can't be a part of segment" );
+
+				if( std::string::npos == dot )
+					break;
+
+				if( multi_segment_wildcard == s )
+					throw_invalid_name( name,
+							"'#' can be used only as the last segment" );
+
+				from = dot + 1;
+			}
+
+		return result;
+	}
+
+} /* namespace topic_space_details */
+
+using namespace topic_space_details;
+
+//
+// topic_space_t
+//
+topic_space_t::topic_space_t(
+	mbox_core_t & mbox_core )
+	:	m_mbox_core( &mbox_core )
+	,	m_generation( 1 )
+	{}
+
+topic_space_t::~topic_space_t()
+	{}
+
+mbox_t
+topic_space_t::mbox( const std::string & name )
+	{
+		{
+			read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+			auto it = m_names.find( name );
+			if( it != m_names.end() )
+				return mbox_t{ new topic_mbox_t{ this, it->first, it->second } };
+		}
+
+		auto segments = split_topic_name( name );
+		const bool pattern = so_5::topics::is_pattern( name );
+
+		// Creation of actual mbox is performed outside of the lock.
+		// It will be thrown out if another thread adds the same name.
+		auto actual_mbox = m_mbox_core->create_mbox();
+
+		std::lock_guard< default_rw_spinlock_t > lock{ m_lock };
+
+		auto it = m_names.find( name );
+		if( it == m_names.end() )
+			{
+				it = m_names.emplace(
+						name,
+						topic_info_t{ segments, pattern, actual_mbox } ).first;
+
+				trie_node_t * node = &m_root;
+				for( const auto & s : segments )
+					{
+						auto & child = node->m_children[ s ];
+						if( !child )
+							child.reset( new trie_node_t{} );
+						node = child.get();
+					}
+				node->m_mbox = std::move(actual_mbox);
+
+				// A new topic doesn't change list of receivers
+				// of other topics. But a new pattern does.
+				if( pattern )
+					++m_generation;
+			}
+
+		return mbox_t{ new topic_mbox_t{ this, it->first, it->second } };
+	}
+
+std::size_t
+topic_space_t::size() const
+	{
+		read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+		return m_names.size();
+	}
+
+receivers_shptr_t
+topic_space_t::receivers( topic_info_t & info )
+	{
+		{
+			read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+			if( m_generation == info.m_generation )
+				return info.m_receivers;
+		}
+
+		std::lock_guard< default_rw_spinlock_t > lock{ m_lock };
+
+		// List could be updated by another thread.
+		if( m_generation != info.m_generation )
+			{
+				std::unique_ptr< receivers_t > r{ new receivers_t{} };
+				collect_receivers( m_root, info.m_segments, 0u, *r );
+
+				info.m_receivers = receivers_shptr_t{ r.release() };
+				info.m_generation = m_generation;
+			}
+
+		return info.m_receivers;
+	}
+
+void
+topic_space_t::collect_receivers(
+	const trie_node_t & node,
+	const segments_t & segments,
+	std::size_t index,
+	receivers_t & receivers ) const
+	{
+		const auto & children = node.m_children;
+		const auto not_found = children.end();
+
+		if( index == segments.size() )
+			{
+				if( node.m_mbox )
+					receivers.push_back( node.m_mbox );
+			}
+		else
+			{
+				auto it = children.find( segments[ index ] );
+				if( it != not_found )
+					collect_receivers( *(it->second), segments, index + 1, receivers );
+
+				it = children.find( single_segment_wildcard );
+				if( it != not_found )
+					collect_receivers( *(it->second), segments, index + 1, receivers );
+			}
+
+		// Multi-segment wildcard matches the rest of topic
+		// (including the empty rest).
+		auto it = children.find( multi_segment_wildcard );
+		if( it != not_found && it->second->m_mbox )
+			receivers.push_back( it->second->m_mbox );
+	}
+
+//
+// topic_mbox_t
+//
+topic_mbox_t::topic_mbox_t(
+	intrusive_ptr_t< topic_space_t > space,
+	const std::string & name,
+	topic_info_t & info )
+	:	m_space( std::move(space) )
+	,	m_name( name )
+	,	m_info( info )
+	{}
+
+topic_mbox_t::~topic_mbox_t()
+	{}
+
+mbox_id_t
+topic_mbox_t::id() const
+	{
+		return m_info.m_actual_mbox->id();
+	}
+
+void
+topic_mbox_t::subscribe_event_handler(
+	const std::type_index & type_wrapper,
+	const so_5::message_limit::control_block_t * limit,
+	agent_t * subscriber )
+	{
+		m_info.m_actual_mbox->subscribe_event_handler(
+				type_wrapper, limit, subscriber );
+	}
+
+void
+topic_mbox_t::unsubscribe_event_handlers(
+	const std::type_index & type_wrapper,
+	agent_t * subscriber )
+	{
+		m_info.m_actual_mbox->unsubscribe_event_handlers(
+				type_wrapper, subscriber );
+	}
+
+std::string
+topic_mbox_t::query_name() const
+	{
+		std::ostringstream s;
+		s << "<mbox:type=TOPIC:name=" << m_name << ":id=" << id() << ">";
+
+		return s.str();
+	}
+
+mbox_type_t
+topic_mbox_t::type() const
+	{
+		return mbox_type_t::multi_producer_multi_consumer;
+	}
+
+void
+topic_mbox_t::do_deliver_message(
+	const std::type_index & msg_type,
+	const message_ref_t & message,
+	unsigned int overlimit_reaction_deep ) const
+	{
+		ensure_not_pattern();
+
+		const auto receivers = m_space->receivers( m_info );
+		for( const auto & m : *receivers )
+			m->do_deliver_message( msg_type, message, overlimit_reaction_deep );
+	}
+
+void
+topic_mbox_t::do_deliver_service_request(
+	const std::type_index & msg_type,
+	const message_ref_t & message,
+	unsigned int overlimit_reaction_deep ) const
+	{
+		ensure_not_pattern();
+
+		m_info.m_actual_mbox->do_deliver_service_request(
+				msg_type, message, overlimit_reaction_deep );
+	}
+
+void
+topic_mbox_t::set_delivery_filter(
+	const std::type_index & msg_type,
+	const delivery_filter_t & filter,
+	agent_t & subscriber )
+	{
+		m_info.m_actual_mbox->set_delivery_filter( msg_type, filter, subscriber );
+	}
+
+void
+topic_mbox_t::drop_delivery_filter(
+	const std::type_index & msg_type,
+	agent_t & subscriber ) SO_5_NOEXCEPT
+	{
+		m_info.m_actual_mbox->drop_delivery_filter( msg_type, subscriber );
+	}
+
+void
+topic_mbox_t::ensure_not_pattern() const
+	{
+		if( m_info.m_is_pattern )
+			SO_5_THROW_EXCEPTION( rc_topic_pattern_cannot_be_published,
+					"message can't be sent to topic pattern '" + m_name + "'" );
+	}
+
+} /* namespace impl */
+
+} /* namespace so_5 */
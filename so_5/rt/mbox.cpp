@@ -4,6 +4,8 @@
 
 #include <so_5/rt/h/mbox.hpp>
 
+#include <so_5/rt/impl/h/mbox_iface_for_timers.hpp>
+
 namespace so_5
 {
 
@@ -47,5 +49,16 @@ abstract_message_box_t::do_deliver_message_from_timer(
 	this->do_deliver_message( msg_type, message, 1 );
 }
 
+void
+abstract_message_box_t::do_deliver_messages_from_timer(
+	const so_5::rt::impl::timer_message_t * messages,
+	std::size_t count )
+{
+	for( std::size_t i = 0; i != count; ++i )
+		this->do_deliver_message_from_timer(
+				messages[ i ].m_msg_type,
+				messages[ i ].m_message );
+}
+
 } /* namespace so_5 */
 
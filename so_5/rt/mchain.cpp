@@ -22,12 +22,43 @@ abstract_message_chain_t::abstract_message_chain_t()
 abstract_message_chain_t::~abstract_message_chain_t()
 	{}
 
+void
+abstract_message_chain_t::deliver_message_with_priority(
+	priority_t /*priority*/,
+	const std::type_index & msg_type,
+	const message_ref_t & message )
+	{
+		do_deliver_message( msg_type, message, 1 );
+	}
+
 mbox_t
 abstract_message_chain_t::as_mbox()
 	{
 		return mbox_t{ this };
 	}
 
+mchain_props::extraction_status_t
+abstract_message_chain_t::extract_bunch(
+	std::vector< mchain_props::demand_t > & dest,
+	std::size_t /*max_count*/,
+	mchain_props::duration_t empty_queue_timeout )
+	{
+		mchain_props::demand_t demand;
+		const auto status = extract( demand, empty_queue_timeout );
+		if( mchain_props::extraction_status_t::msg_extracted == status )
+			dest.push_back( std::move(demand) );
+
+		return status;
+	}
+
+void
+abstract_message_chain_t::return_demands(
+	std::vector< mchain_props::demand_t >::iterator /*first*/,
+	std::vector< mchain_props::demand_t >::iterator /*last*/ )
+	{
+		// Nothing to do. Demands are dropped.
+	}
+
 mchain_props::extraction_status_t
 abstract_message_chain_t::extract(
 	mchain_props::demand_t & /*dest*/,
@@ -41,6 +72,20 @@ abstract_message_chain_t::extract(
 		return mchain_props::extraction_status_t::no_messages;
 	}
 
+mchain_props::extraction_status_t
+abstract_message_chain_t::extract_bunch(
+	std::vector< mchain_props::demand_t > & dest,
+	std::size_t /*max_count*/,
+	mchain_props::select_case_t & select_case )
+	{
+		mchain_props::demand_t demand;
+		const auto status = extract( demand, select_case );
+		if( mchain_props::extraction_status_t::msg_extracted == status )
+			dest.push_back( std::move(demand) );
+
+		return status;
+	}
+
 void
 abstract_message_chain_t::remove_from_select(
 	mchain_props::select_case_t & /*select_case*/ )
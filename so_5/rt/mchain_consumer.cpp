@@ -0,0 +1,126 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief An agent for asynchronous consumption of messages from mchain.
+ *
+ * \since
+ * v.5.5.20
+ */
+
+#include <so_5/rt/h/mchain_consumer.hpp>
+
+#include <so_5/rt/h/send_functions.hpp>
+
+#include <so_5/details/h/invoke_noexcept_code.hpp>
+
+#include <algorithm>
+
+namespace so_5 {
+
+//
+// mchain_consumer_t::notificator_t
+//
+mchain_consumer_t::notificator_t::notificator_t( mbox_t mbox )
+	:	m_mbox( std::move(mbox) )
+	{}
+
+void
+mchain_consumer_t::notificator_t::notify(
+	mchain_props::select_case_t & /*what*/ ) SO_5_NOEXCEPT
+	{
+		// NOTE: this method is called under mchain's lock.
+		so_5::details::invoke_noexcept_code( [this] {
+				so_5::send< msg_consume >( m_mbox );
+			} );
+	}
+
+//
+// mchain_consumer_t
+//
+mchain_consumer_t::mchain_consumer_t(
+	context_t ctx,
+	mchain_consumer_params_t params,
+	mchain_props::select_case_unique_ptr_t select_case )
+	:	agent_t( std::move(ctx) )
+	,	m_params( std::move(params) )
+	,	m_case( std::move(select_case) )
+	,	m_notificator( so_direct_mbox() )
+	{}
+
+mchain_consumer_t::~mchain_consumer_t()
+	{}
+
+void
+mchain_consumer_t::so_define_agent()
+	{
+		so_subscribe_self().event( &mchain_consumer_t::evt_consume );
+	}
+
+void
+mchain_consumer_t::so_evt_start()
+	{
+		so_5::send< msg_consume >( *this );
+	}
+
+void
+mchain_consumer_t::so_evt_finish()
+	{
+		// mchain must not hold a pointer to select_case after
+		// the destruction of the agent.
+		m_case->on_select_finish();
+	}
+
+void
+mchain_consumer_t::evt_consume( mhood_t< msg_consume > )
+	{
+		using namespace mchain_props;
+
+		bool closed = false;
+		std::size_t remaining = m_params.batch_size();
+		try
+			{
+				while( remaining )
+					{
+						const auto r = m_case->try_receive(
+								m_notificator, remaining );
+
+						if( extraction_status_t::no_messages == r.status() )
+							// select_case is stored in mchain now.
+							// There will be a notification from mchain when
+							// a new message arrives.
+							return;
+
+						if( extraction_status_t::chain_closed == r.status() )
+							{
+								closed = true;
+								break;
+							}
+
+						remaining -= (std::min)( remaining, r.extracted() );
+					}
+			}
+		catch( ... )
+			{
+				// There is no notification from mchain for the rest of
+				// messages. So consumption must be continued in the next
+				// event if the exception will be ignored.
+				so_5::send< msg_consume >( *this );
+				throw;
+			}
+
+		if( closed )
+			{
+				if( m_params.close_handler() )
+					m_params.close_handler()( m_case->chain() );
+			}
+		else
+			// Batch size exhausted. The rest of messages will be handled
+			// in the next event. It allows other agents to be handled on
+			// the same working thread.
+			so_5::send< msg_consume >( *this );
+	}
+
+} /* namespace so_5 */
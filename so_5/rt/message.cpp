@@ -13,18 +13,21 @@ namespace so_5
 
 message_t::message_t()
 	:	m_mutability( message_mutability_t::immutable_message )
+	,	m_tracing_mark( 0 )
 {
 }
 
 message_t::message_t( const message_t & other )
 	:	atomic_refcounted_t()
 	,	m_mutability( other.m_mutability )
+	,	m_tracing_mark( 0 )
 {
 }
 
 message_t::message_t( message_t && other )
 	:	atomic_refcounted_t()
 	,	m_mutability( other.m_mutability )
+	,	m_tracing_mark( 0 )
 {
 }
 
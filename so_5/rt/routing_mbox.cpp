@@ -0,0 +1,66 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Public stuff for content-based routing mboxes.
+ */
+
+#include <so_5/rt/h/routing_mbox.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <string>
+
+namespace so_5
+{
+
+namespace routing
+{
+
+//
+// key_filter_t
+//
+key_filter_t::key_filter_t(
+	key_t low,
+	key_t high )
+	:	m_low( low )
+	,	m_high( high )
+	{}
+
+key_filter_t::~key_filter_t()
+	{}
+
+bool
+key_filter_t::check(
+	const agent_t & /*receiver*/,
+	message_t & /*msg*/ ) const SO_5_NOEXCEPT
+	{
+		// Key can't be extracted from a message without routing mbox.
+		// Routing mbox doesn't call this method.
+		return false;
+	}
+
+//
+// key_range
+//
+SO_5_FUNC delivery_filter_unique_ptr_t
+key_range( key_t low, key_t high )
+	{
+		if( low > high )
+			SO_5_THROW_EXCEPTION(
+					rc_invalid_routing_key_range,
+					"low boundary of key range is greater than high boundary: [" +
+					std::to_string( low ) + ", " + std::to_string( high ) + "]" );
+
+		return delivery_filter_unique_ptr_t{ new key_filter_t{ low, high } };
+	}
+
+} /* namespace routing */
+
+} /* namespace so_5 */
@@ -0,0 +1,180 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.5.20
+ *
+ * \brief A histogram for durations of some activity.
+ */
+
+#include <so_5/rt/stats/h/duration_histogram.hpp>
+
+#include <algorithm>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+namespace
+{
+
+//! Count of bits for the index of a bucket inside a power of two.
+const unsigned int sub_bucket_bits = 3;
+
+//! Max power of two which has own buckets.
+const unsigned int max_power = 40;
+
+static_assert( (1u << sub_bucket_bits) ==
+		duration_histogram_t::sub_bucket_count,
+		"sub_bucket_count must correspond to sub_bucket_bits" );
+
+static_assert( duration_histogram_t::sub_bucket_count *
+		(max_power - sub_bucket_bits + 2) + 1 ==
+		duration_histogram_t::bucket_count,
+		"bucket_count must correspond to max_power" );
+
+//! Index of the most significant bit of non-zero value.
+unsigned int
+most_significant_bit( std::uint64_t v )
+	{
+		unsigned int r = 0;
+		for( unsigned int step = 32; step; step >>= 1 )
+			if( v >> step )
+				{
+					v >>= step;
+					r += step;
+				}
+
+		return r;
+	}
+
+std::uint64_t
+to_ns( duration_histogram_t::duration_t value )
+	{
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				value ).count();
+		return ns > 0 ? static_cast< std::uint64_t >( ns ) : 0u;
+	}
+
+duration_histogram_t::duration_t
+from_ns( std::uint64_t value )
+	{
+		return std::chrono::duration_cast< duration_histogram_t::duration_t >(
+				std::chrono::nanoseconds(
+						static_cast< std::chrono::nanoseconds::rep >( value ) ) );
+	}
+
+} /* namespace anonymous */
+
+std::size_t
+duration_histogram_t::bucket_index( duration_t value )
+	{
+		const auto ns = to_ns( value );
+		if( ns < sub_bucket_count )
+			return static_cast< std::size_t >( ns );
+
+		const auto power = most_significant_bit( ns );
+		if( power > max_power )
+			return bucket_count - 1;
+
+		return sub_bucket_count * (power - sub_bucket_bits + 1) +
+				static_cast< std::size_t >(
+						(ns >> (power - sub_bucket_bits)) &
+								(sub_bucket_count - 1) );
+	}
+
+duration_histogram_t::duration_t
+duration_histogram_t::lower_border( std::size_t index )
+	{
+		if( index < sub_bucket_count )
+			return from_ns( static_cast< std::uint64_t >( index ) );
+		if( index >= bucket_count - 1 )
+			return from_ns( std::uint64_t{1} << (max_power + 1) );
+
+		const auto power = static_cast< unsigned int >(
+				index / sub_bucket_count + sub_bucket_bits - 1 );
+		const auto sub_bucket = index % sub_bucket_count;
+
+		return from_ns(
+				static_cast< std::uint64_t >( sub_bucket_count + sub_bucket ) <<
+						(power - sub_bucket_bits) );
+	}
+
+duration_histogram_t::duration_t
+duration_histogram_t::upper_border( std::size_t index )
+	{
+		if( index >= bucket_count - 1 )
+			return (duration_t::max)();
+
+		return lower_border( index + 1 );
+	}
+
+void
+duration_histogram_t::add( duration_t value )
+	{
+		++m_buckets[ bucket_index( value ) ];
+		m_sum += value;
+		if( m_max < value )
+			m_max = value;
+	}
+
+void
+duration_histogram_t::merge( const duration_histogram_t & other )
+	{
+		for( std::size_t i = 0; i != bucket_count; ++i )
+			m_buckets[ i ] += other.m_buckets[ i ];
+		m_sum += other.m_sum;
+		m_max = (std::max)( m_max, other.m_max );
+	}
+
+std::uint64_t
+duration_histogram_t::total() const
+	{
+		std::uint64_t result = 0;
+		for( auto c : m_buckets )
+			result += c;
+
+		return result;
+	}
+
+duration_histogram_t::duration_t
+duration_histogram_t::mean() const
+	{
+		const auto count = total();
+		if( !count )
+			return duration_t::zero();
+
+		return m_sum / static_cast< duration_t::rep >( count );
+	}
+
+duration_histogram_t::duration_t
+duration_histogram_t::percentile( double p ) const
+	{
+		const auto count = total();
+		if( !count )
+			return duration_t::zero();
+
+		// Rank of the value which must be found, in range [1, count].
+		auto rank = static_cast< std::uint64_t >(
+				static_cast< double >( count ) * p + 0.5 );
+		rank = (std::min)( (std::max)( rank, std::uint64_t{1} ), count );
+
+		std::uint64_t accumulated = 0;
+		for( std::size_t i = 0; i != bucket_count; ++i )
+			{
+				accumulated += m_buckets[ i ];
+				if( accumulated >= rank )
+					return (std::min)( upper_border( i ), m_max );
+			}
+
+		return m_max;
+	}
+
+} /* namespace stats */
+
+} /* namespace so_5 */
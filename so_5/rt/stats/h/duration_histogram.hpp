@@ -0,0 +1,120 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.5.20
+ *
+ * \brief A histogram for durations of some activity.
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+//
+// duration_histogram_t
+//
+/*!
+ * \brief A histogram of durations with logarithmic buckets.
+ *
+ * Durations are counted in nanoseconds. Values less than 8ns have own
+ * buckets. Every power of two above is split into 8 buckets of the same
+ * width. It means that the relative error of a value estimation is not
+ * greater than 12.5% in all the range. The last bucket is for values
+ * which are not less than 2^41ns (approximately 36 minutes).
+ *
+ * Adding of a value requires just a few arithmetic operations and
+ * does not allocate memory.
+ *
+ * \note A histogram must be value-initialized:
+ * \code
+	so_5::stats::duration_histogram_t h{};
+ * \endcode
+ *
+ * \since
+ * v.5.5.20
+ */
+struct SO_5_TYPE duration_histogram_t
+	{
+		//! Type of values in the histogram.
+		using duration_t = std::chrono::steady_clock::duration;
+
+		//! Count of buckets for every power of two.
+		static const std::size_t sub_bucket_count = 8;
+
+		//! Count of buckets.
+		static const std::size_t bucket_count = 313;
+
+		//! Counts of values in every bucket.
+		std::array< std::uint64_t, bucket_count > m_buckets;
+
+		//! Sum of all values.
+		duration_t m_sum;
+
+		//! Max value.
+		duration_t m_max;
+
+		//! Index of a bucket for the value.
+		/*!
+		 * \note Negative values are counted as zeros.
+		 */
+		static std::size_t
+		bucket_index( duration_t value );
+
+		//! Lower border (inclusive) of values in a bucket.
+		static duration_t
+		lower_border( std::size_t index );
+
+		//! Upper border (exclusive) of values in a bucket.
+		/*!
+		 * \note It is duration_t::max() for the last bucket.
+		 */
+		static duration_t
+		upper_border( std::size_t index );
+
+		//! Add a value to the histogram.
+		void
+		add( duration_t value );
+
+		//! Add all values from another histogram.
+		void
+		merge( const duration_histogram_t & other );
+
+		//! Total count of values in the histogram.
+		std::uint64_t
+		total() const;
+
+		//! Average value.
+		/*!
+		 * \return Zero if the histogram is empty.
+		 */
+		duration_t
+		mean() const;
+
+		//! Get an estimation for a percentile.
+		/*!
+		 * \return Upper border of the bucket in which the percentile is
+		 * but not greater than the max value. Zero if the histogram is empty.
+		 */
+		duration_t
+		percentile(
+			//! Percentile in range [0.0, 1.0].
+			double p ) const;
+	};
+
+} /* namespace stats */
+
+} /* namespace so_5 */
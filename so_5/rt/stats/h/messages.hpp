@@ -12,11 +12,15 @@
 
 #pragma once
 
+#include <string>
+
 #include <so_5/h/current_thread_id.hpp>
+#include <so_5/h/timers.hpp>
 
 #include <so_5/rt/h/message.hpp>
 
 #include <so_5/rt/stats/h/prefix.hpp>
+#include <so_5/rt/stats/h/duration_histogram.hpp>
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
 
 namespace so_5
@@ -114,6 +118,95 @@ struct work_thread_activity : public message_t
 			{}
 	};
 
+/*!
+ * \brief Information about lateness of expired timers.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct timer_lateness : public message_t
+	{
+		//! Prefix of data_source name.
+		prefix_t m_prefix;
+		//! Suffix of data_source name.
+		suffix_t m_suffix;
+
+		//! Actual value.
+		timer_lateness_histogram_t m_histogram;
+
+		timer_lateness(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			const timer_lateness_histogram_t & histogram )
+			:	m_prefix( prefix )
+			,	m_suffix( suffix )
+			,	m_histogram( histogram )
+			{}
+	};
+
+/*!
+ * \brief Information about times of event handlers for one message type.
+ *
+ * Histograms are accumulated since the start of collecting the
+ * statistics for an agent or a cooperation.
+ *
+ * \see so_5::environment_params_t::event_handler_stats().
+ *
+ * \since
+ * v.5.5.20
+ */
+struct event_handler_times : public message_t
+	{
+		//! Prefix of data_source name.
+		prefix_t m_prefix;
+		//! Suffix of data_source name.
+		suffix_t m_suffix;
+
+		//! Name of the cooperation.
+		std::string m_coop_name;
+		//! The agent.
+		/*!
+		 * It is nullptr if statistics are collected for the whole
+		 * cooperation.
+		 *
+		 * \attention The agent can be destroyed already when the
+		 * message is handled. This pointer must be used only for
+		 * identification of the agent.
+		 */
+		const agent_t * m_agent;
+
+		//! Type of the handled messages.
+		std::type_index m_msg_type;
+
+		//! Times between pushing messages to event queue and the start
+		//! of their handling.
+		/*!
+		 * \note For messages sent before the binding of the agent to
+		 * a dispatcher this time is counted from the binding.
+		 */
+		duration_histogram_t m_queue_wait;
+
+		//! Times of execution of event handlers.
+		duration_histogram_t m_handler_time;
+
+		event_handler_times(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			std::string coop_name,
+			const agent_t * agent,
+			std::type_index msg_type,
+			const duration_histogram_t & queue_wait,
+			const duration_histogram_t & handler_time )
+			:	m_prefix( prefix )
+			,	m_suffix( suffix )
+			,	m_coop_name( std::move(coop_name) )
+			,	m_agent( agent )
+			,	m_msg_type( msg_type )
+			,	m_queue_wait( queue_wait )
+			,	m_handler_time( handler_time )
+			{}
+	};
+
 } /* namespace messages */
 
 } /* namespace stats */
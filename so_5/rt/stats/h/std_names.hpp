@@ -50,6 +50,20 @@ mbox_repository();
 SO_5_FUNC prefix_t
 timer_thread();
 
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Prefix of data sources with statistics of event handlers.
+ *
+ * Names of data sources are built from this prefix and names of
+ * cooperations.
+ *
+ * \see so_5::environment_params_t::event_handler_stats().
+ */
+SO_5_FUNC prefix_t
+event_handlers();
+
 } /* namespace prefixes */
 
 namespace suffixes {
@@ -156,6 +170,104 @@ timer_single_shot_count();
 SO_5_FUNC suffix_t
 timer_periodic_count();
 
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with total count of expired timers.
+ */
+SO_5_FUNC suffix_t
+timer_expired_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with count of time steps of timer thread
+ * with at least one expired timer.
+ */
+SO_5_FUNC suffix_t
+timer_ticks_with_expired_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with max count of timers expired at one
+ * time step of timer thread.
+ */
+SO_5_FUNC suffix_t
+timer_max_expired_per_tick();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with histogram of lateness of expired timers.
+ */
+SO_5_FUNC suffix_t
+timer_lateness();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with estimation of median of lateness of
+ * expired timers (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_lateness_p50_us();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with estimation of 99th percentile of
+ * lateness of expired timers (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_lateness_p99_us();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with total time of holding the lock by
+ * timer thread (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_lock_hold_time_us();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with max time of one holding of the lock
+ * by timer thread (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_max_lock_hold_time_us();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with count of slots of timer wheel with at
+ * least one timer.
+ */
+SO_5_FUNC suffix_t
+timer_occupied_slots();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with max count of timers in one slot of
+ * timer wheel.
+ */
+SO_5_FUNC suffix_t
+timer_max_slot_occupancy();
+
 /*!
  * \since
  * v.5.5.8
@@ -167,6 +279,105 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with count of messages in spill file
+ * of a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_spilled_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with size of binary images of messages
+ * in spill file of a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_spilled_bytes();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with current count of messages in a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_size();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with max count of messages in a mchain
+ * since the previous distribution of run-time monitoring information.
+ */
+SO_5_FUNC suffix_t
+mchain_size_high_watermark();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with total count of messages stored
+ * into a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_enqueued_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with total count of messages extracted
+ * from a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_dequeued_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with count of messages stored into
+ * a mchain per second.
+ */
+SO_5_FUNC suffix_t
+mchain_enqueue_rate();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with count of messages extracted from
+ * a mchain per second.
+ */
+SO_5_FUNC suffix_t
+mchain_dequeue_rate();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with total count of overflows of
+ * a mchain.
+ */
+SO_5_FUNC suffix_t
+mchain_overflow_count();
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \brief Suffix for data source with histograms of queue waiting and
+ * execution times of event handlers.
+ */
+SO_5_FUNC suffix_t
+event_handler_times();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
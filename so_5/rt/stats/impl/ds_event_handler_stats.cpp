@@ -0,0 +1,219 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief A data source for run-time monitoring of event handlers.
+ */
+
+#include <so_5/rt/stats/impl/h/ds_event_handler_stats.hpp>
+
+#include <so_5/rt/stats/h/messages.hpp>
+#include <so_5/rt/stats/h/prefix.hpp>
+#include <so_5/rt/stats/h/std_names.hpp>
+
+#include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/send_functions.hpp>
+
+#include <so_5/details/h/ios_helpers.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace so_5 {
+
+namespace stats {
+
+namespace impl {
+
+namespace
+{
+
+namespace ios_helpers = so_5::details::ios_helpers;
+
+prefix_t
+make_prefix( const std::string & coop_name, const agent_t * agent )
+	{
+		const std::size_t max_coop_name_fragment = 16;
+
+		std::ostringstream ss;
+		ss << prefixes::event_handlers().c_str() << "/"
+			<< ios_helpers::length_limited_string{
+					coop_name, max_coop_name_fragment };
+		if( agent )
+			ss << "/" << ios_helpers::pointer{ agent };
+
+		return prefix_t{ ss.str() };
+	}
+
+void
+send_times(
+	const mbox_t & distribution_mbox,
+	const std::string & coop_name,
+	const agent_t * agent,
+	const std::vector< event_handler_stats_storage_t::times_t > & times )
+	{
+		const auto prefix = make_prefix( coop_name, agent );
+
+		for( const auto & t : times )
+			send< messages::event_handler_times >( distribution_mbox,
+					prefix,
+					suffixes::event_handler_times(),
+					coop_name,
+					agent,
+					t.m_msg_type,
+					t.m_queue_wait,
+					t.m_handler_time );
+	}
+
+} /* namespace anonymous */
+
+//
+// event_handler_stats_storage_t
+//
+event_handler_stats_storage_t::event_handler_stats_storage_t(
+	std::string coop_name,
+	const agent_t * agent )
+	:	m_coop_name( std::move(coop_name) )
+	,	m_agent( agent )
+	{}
+
+void
+event_handler_stats_storage_t::register_event(
+	const std::type_index & msg_type,
+	clock_t::time_point enqueued_at,
+	clock_t::time_point started_at,
+	clock_t::time_point finished_at ) SO_5_NOEXCEPT
+	{
+		std::lock_guard< default_spinlock_t > lock{ m_lock };
+
+		auto it = std::find_if( m_times.begin(), m_times.end(),
+				[&msg_type]( const times_t & t ) {
+					return t.m_msg_type == msg_type;
+				} );
+		if( it == m_times.end() )
+			{
+				try
+					{
+						it = m_times.insert( m_times.end(), times_t{ msg_type } );
+					}
+				catch( const std::exception & )
+					{
+						// The value is lost if there is no memory for it.
+						return;
+					}
+			}
+
+		if( clock_t::time_point{} != enqueued_at )
+			it->m_queue_wait.add( started_at - enqueued_at );
+		it->m_handler_time.add( finished_at - started_at );
+	}
+
+void
+event_handler_stats_storage_t::collect(
+	std::vector< times_t > & to ) const
+	{
+		std::lock_guard< default_spinlock_t > lock{ m_lock };
+
+		for( const auto & t : m_times )
+			{
+				auto it = std::find_if( to.begin(), to.end(),
+						[&t]( const times_t & o ) {
+							return o.m_msg_type == t.m_msg_type;
+						} );
+				if( it == to.end() )
+					to.push_back( t );
+				else
+					{
+						it->m_queue_wait.merge( t.m_queue_wait );
+						it->m_handler_time.merge( t.m_handler_time );
+					}
+			}
+	}
+
+//
+// ds_event_handler_stats_t
+//
+ds_event_handler_stats_t::ds_event_handler_stats_t(
+	outliving_reference_t< repository_t > repo,
+	event_handler_stats_t mode )
+	:	auto_registered_source_t( std::move(repo) )
+	,	m_mode( mode )
+	{}
+
+std::shared_ptr< event_handler_stats_storage_t >
+ds_event_handler_stats_t::storage_for( const agent_t & agent )
+	{
+		if( event_handler_stats_t::off == m_mode )
+			return std::shared_ptr< event_handler_stats_storage_t >();
+
+		key_t key{ agent.so_coop_name(), &agent };
+
+		std::lock_guard< std::mutex > lock{ m_lock };
+
+		auto & weak_storage = m_storages[ key ];
+		auto storage = weak_storage.lock();
+		if( !storage )
+			{
+				storage = std::make_shared< event_handler_stats_storage_t >(
+						std::move(key.first), key.second );
+				weak_storage = storage;
+			}
+
+		return storage;
+	}
+
+void
+ds_event_handler_stats_t::distribute(
+	const mbox_t & distribution_mbox )
+	{
+		std::vector< std::shared_ptr< event_handler_stats_storage_t > > storages;
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			storages.reserve( m_storages.size() );
+			for( auto it = m_storages.begin(); it != m_storages.end(); )
+				{
+					auto storage = it->second.lock();
+					if( storage )
+						{
+							storages.push_back( std::move(storage) );
+							++it;
+						}
+					else
+						it = m_storages.erase( it );
+				}
+		}
+
+		// Statistics of agents from one cooperation are merged
+		// in per_coop mode.
+		const bool per_coop = event_handler_stats_t::per_coop == m_mode;
+
+		std::vector< event_handler_stats_storage_t::times_t > times;
+		for( auto it = storages.begin(); it != storages.end(); )
+			{
+				const auto & coop_name = (*it)->coop_name();
+				const agent_t * agent = per_coop ? nullptr : (*it)->agent();
+
+				times.clear();
+				do
+					{
+						(*it)->collect( times );
+						++it;
+					}
+				while( per_coop && it != storages.end() &&
+						(*it)->coop_name() == coop_name );
+
+				send_times( distribution_mbox, coop_name, agent, times );
+			}
+	}
+
+} /* namespace impl */
+
+} /* namespace stats */
+
+} /* namespace so_5 */
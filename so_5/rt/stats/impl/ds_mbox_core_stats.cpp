@@ -43,6 +43,10 @@ ds_mbox_core_stats_t::distribute(
 				prefixes::mbox_repository(),
 				suffixes::named_mbox_count(),
 				stats.m_named_mbox_count );
+
+		// Message chains are created by mbox_core.
+		// So information about them is distributed here too.
+		m_what.distribute_mchain_stats( distribution_mbox );
 	}
 
 } /* namespace impl */
@@ -48,6 +48,49 @@ ds_timer_thread_stats_t::distribute(
 				prefixes::timer_thread(),
 				suffixes::timer_periodic_count(),
 				stats.m_periodic_count );
+
+		const auto quantity = [&distribution_mbox](
+				const suffix_t & suffix, std::uint64_t value ) {
+			send< messages::quantity< std::size_t > >( distribution_mbox,
+					prefixes::timer_thread(),
+					suffix,
+					static_cast< std::size_t >( value ) );
+		};
+
+		const auto us = []( std::chrono::steady_clock::duration d ) {
+			return static_cast< std::uint64_t >(
+					std::chrono::duration_cast< std::chrono::microseconds >(
+							d ).count() );
+		};
+
+		quantity( suffixes::timer_expired_count(), stats.m_lateness.total() );
+		quantity( suffixes::timer_ticks_with_expired_count(),
+				stats.m_ticks_with_expired_timers );
+		quantity( suffixes::timer_max_expired_per_tick(),
+				stats.m_max_expired_per_tick );
+
+		send< messages::timer_lateness >( distribution_mbox,
+				prefixes::timer_thread(),
+				suffixes::timer_lateness(),
+				stats.m_lateness );
+
+		// Percentiles are meaningless if there is no expired timers.
+		if( stats.m_lateness.total() )
+			{
+				quantity( suffixes::timer_lateness_p50_us(),
+						us( stats.m_lateness.percentile( 0.5 ) ) );
+				quantity( suffixes::timer_lateness_p99_us(),
+						us( stats.m_lateness.percentile( 0.99 ) ) );
+			}
+
+		quantity( suffixes::timer_lock_hold_time_us(),
+				us( stats.m_lock_hold_time ) );
+		quantity( suffixes::timer_max_lock_hold_time_us(),
+				us( stats.m_max_lock_hold_time ) );
+
+		quantity( suffixes::timer_occupied_slots(), stats.m_occupied_slots );
+		quantity( suffixes::timer_max_slot_occupancy(),
+				stats.m_max_slot_occupancy );
 	}
 
 } /* namespace impl */
@@ -0,0 +1,202 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief A data source for run-time monitoring of event handlers.
+ */
+
+#pragma once
+
+#include <so_5/rt/stats/h/repository.hpp>
+#include <so_5/rt/stats/h/duration_histogram.hpp>
+
+#include <so_5/h/compiler_features.hpp>
+#include <so_5/h/types.hpp>
+#include <so_5/h/spinlocks.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace so_5 {
+
+namespace stats {
+
+namespace impl {
+
+//
+// event_handler_stats_storage_t
+//
+/*!
+ * \brief A storage for statistics of event handlers of an agent.
+ *
+ * Statistics are kept for every type of handled messages separately.
+ *
+ * \note Every agent has its own storage even if statistics are
+ * collected for the whole cooperation. Storages of agents from one
+ * cooperation are merged during the distribution of statistics.
+ * Because of that there is no lock shared by agents which work on
+ * different threads.
+ *
+ * \note This class is thread safe. Statistics are distributed on
+ * the context of another thread. And thread-safe event handlers
+ * of one agent can be called on different threads at the same time.
+ *
+ * \since
+ * v.5.5.20
+ */
+class event_handler_stats_storage_t
+	{
+	public :
+		using clock_t = std::chrono::steady_clock;
+
+		//! Statistics for one type of messages.
+		struct times_t
+			{
+				std::type_index m_msg_type;
+				duration_histogram_t m_queue_wait;
+				duration_histogram_t m_handler_time;
+
+				times_t( const std::type_index & msg_type )
+					:	m_msg_type( msg_type )
+					,	m_queue_wait()
+					,	m_handler_time()
+					{}
+			};
+
+		event_handler_stats_storage_t(
+			//! Name of the cooperation.
+			std::string coop_name,
+			//! The agent.
+			const agent_t * agent );
+
+		//! Register the completion of an event handler.
+		/*!
+		 * \note The value is lost if there is no memory for statistics
+		 * of a new message type.
+		 */
+		void
+		register_event(
+			//! Type of the handled message.
+			const std::type_index & msg_type,
+			//! Time of pushing message to event queue.
+			//! Zero value means that time is unknown.
+			clock_t::time_point enqueued_at,
+			//! Time of the start of event handler.
+			clock_t::time_point started_at,
+			//! Time of the completion of event handler.
+			clock_t::time_point finished_at ) SO_5_NOEXCEPT;
+
+		//! Name of the cooperation.
+		const std::string &
+		coop_name() const { return m_coop_name; }
+
+		//! The agent.
+		const agent_t *
+		agent() const { return m_agent; }
+
+		//! Add the current statistics to \a to.
+		/*!
+		 * Statistics for the same message type are merged.
+		 */
+		void
+		collect( std::vector< times_t > & to ) const;
+
+	private :
+		const std::string m_coop_name;
+		const agent_t * const m_agent;
+
+		//! Object's lock.
+		mutable default_spinlock_t m_lock;
+
+		//! Statistics for every type of messages.
+		/*!
+		 * \note An agent usually handles a few types of messages.
+		 * Because of that a vector with linear search is used.
+		 */
+		std::vector< times_t > m_times;
+	};
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+//
+// ds_event_handler_stats_t
+//
+/*!
+ * \brief A data source for distributing statistics of event handlers.
+ *
+ * Holds storages for all agents or cooperations. A storage lives while
+ * there are agents which use it.
+ *
+ * \since
+ * v.5.5.20
+ */
+class ds_event_handler_stats_t : public auto_registered_source_t
+	{
+	public :
+		ds_event_handler_stats_t(
+			//! Repository for data source.
+			outliving_reference_t< repository_t > repo,
+			//! How statistics must be collected.
+			event_handler_stats_t mode );
+
+		//! Get a storage for statistics of the agent.
+		/*!
+		 * \note The agent must be bound to a cooperation already.
+		 *
+		 * \note A new storage is created for every agent even in
+		 * event_handler_stats_t::per_coop mode.
+		 *
+		 * \return nullptr if statistics are not collected.
+		 */
+		std::shared_ptr< event_handler_stats_storage_t >
+		storage_for( const agent_t & agent );
+
+		virtual void
+		distribute(
+			const mbox_t & distribution_mbox ) override;
+
+	private :
+		//! Key for a storage: name of cooperation and the agent.
+		/*!
+		 * \note Storages of agents from the same cooperation are
+		 * adjacent in the map because of that key.
+		 */
+		using key_t = std::pair< std::string, const agent_t * >;
+
+		const event_handler_stats_t m_mode;
+
+		//! Object's lock.
+		std::mutex m_lock;
+
+		//! All the storages.
+		/*!
+		 * Storages which are not used anymore are removed during
+		 * distribution of statistics.
+		 */
+		std::map< key_t, std::weak_ptr< event_handler_stats_storage_t > >
+				m_storages;
+	};
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+} /* namespace impl */
+
+} /* namespace stats */
+
+} /* namespace so_5 */
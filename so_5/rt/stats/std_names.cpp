@@ -36,6 +36,12 @@ timer_thread()
 		return prefix_t( "timer_thread" );
 	}
 
+SO_5_FUNC prefix_t
+event_handlers()
+	{
+		return prefix_t( "evt_handlers" );
+	}
+
 } /* namespace prefixes */
 
 namespace suffixes {
@@ -110,12 +116,132 @@ timer_periodic_count()
 		IMPL_SUFFIX( "/periodic.count" )
 	}
 
+SO_5_FUNC suffix_t
+timer_expired_count()
+	{
+		IMPL_SUFFIX( "/expired.count" )
+	}
+
+SO_5_FUNC suffix_t
+timer_ticks_with_expired_count()
+	{
+		IMPL_SUFFIX( "/ticks_with_expired.count" )
+	}
+
+SO_5_FUNC suffix_t
+timer_max_expired_per_tick()
+	{
+		IMPL_SUFFIX( "/expired_per_tick.max" )
+	}
+
+SO_5_FUNC suffix_t
+timer_lateness()
+	{
+		IMPL_SUFFIX( "/lateness" )
+	}
+
+SO_5_FUNC suffix_t
+timer_lateness_p50_us()
+	{
+		IMPL_SUFFIX( "/lateness.p50.us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_lateness_p99_us()
+	{
+		IMPL_SUFFIX( "/lateness.p99.us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_lock_hold_time_us()
+	{
+		IMPL_SUFFIX( "/lock_hold.us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_max_lock_hold_time_us()
+	{
+		IMPL_SUFFIX( "/lock_hold.max.us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_occupied_slots()
+	{
+		IMPL_SUFFIX( "/occupied_slots.count" )
+	}
+
+SO_5_FUNC suffix_t
+timer_max_slot_occupancy()
+	{
+		IMPL_SUFFIX( "/slot_occupancy.max" )
+	}
+
 SO_5_FUNC suffix_t
 demand_quote()
 	{
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+mchain_spilled_count()
+	{
+		IMPL_SUFFIX( "/spilled.count" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_spilled_bytes()
+	{
+		IMPL_SUFFIX( "/spilled.bytes" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_size()
+	{
+		IMPL_SUFFIX( "/size" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_size_high_watermark()
+	{
+		IMPL_SUFFIX( "/size.high_watermark" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_enqueued_count()
+	{
+		IMPL_SUFFIX( "/enqueued.count" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_dequeued_count()
+	{
+		IMPL_SUFFIX( "/dequeued.count" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_enqueue_rate()
+	{
+		IMPL_SUFFIX( "/enqueued.rate" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_dequeue_rate()
+	{
+		IMPL_SUFFIX( "/dequeued.rate" )
+	}
+
+SO_5_FUNC suffix_t
+mchain_overflow_count()
+	{
+		IMPL_SUFFIX( "/overflow.count" )
+	}
+
+SO_5_FUNC suffix_t
+event_handler_times()
+	{
+		IMPL_SUFFIX( "/evt_handler.times" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
@@ -0,0 +1,55 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.20
+ *
+ * \file
+ * \brief Public stuff for mboxes with hierarchical topics.
+ */
+
+#include <so_5/rt/h/topic_mbox.hpp>
+
+namespace so_5
+{
+
+namespace topics
+{
+
+//
+// space_t
+//
+space_t::space_t()
+	{}
+
+space_t::~space_t()
+	{}
+
+//
+// is_pattern
+//
+SO_5_FUNC bool
+is_pattern( const std::string & name )
+	{
+		std::string::size_type from = 0;
+		while( true )
+			{
+				const auto dot = name.find( '.', from );
+				const auto end = std::string::npos == dot ? name.size() : dot;
+
+				if( 1u == end - from &&
+						( '*' == name[ from ] || '#' == name[ from ] ) )
+					return true;
+
+				if( std::string::npos == dot )
+					return false;
+
+				from = dot + 1;
+			}
+	}
+
+} /* namespace topics */
+
+} /* namespace so_5 */
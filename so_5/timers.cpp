@@ -11,15 +11,23 @@
 */
 
 #include <so_5/details/h/abort_on_fatal_error.hpp>
+#include <so_5/details/h/at_scope_exit.hpp>
 
 #include <so_5/rt/impl/h/mbox_iface_for_timers.hpp>
 
 #include <so_5/h/stdcpp.hpp>
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
 
 #include <so_5/h/timers.hpp>
 
 #include <timertt/all.hpp>
 
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace so_5
 {
 
@@ -29,6 +37,18 @@ namespace so_5
 timer_t::~timer_t()
 	{}
 
+bool
+timer_t::reschedule(
+	std::chrono::steady_clock::duration,
+	std::chrono::steady_clock::duration )
+	{
+		SO_5_THROW_EXCEPTION( rc_not_implemented,
+				"reschedule() is not implemented for this timer" );
+
+		// Never reached. Only for compilers which require return statement.
+		return false;
+	}
+
 //
 // timer_id_t
 //
@@ -88,6 +108,54 @@ timer_id_t::release()
 			m_timer->release();
 	}
 
+bool
+timer_id_t::reschedule(
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		return m_timer && m_timer->reschedule( pause, period );
+	}
+
+//
+// timer_lateness_histogram_t
+//
+
+namespace
+{
+
+static_assert( timer_lateness_histogram_t::bucket_count ==
+		timertt::lateness_histogram::bucket_count,
+		"count of buckets must be the same as in timertt" );
+
+//! Make a copy of histogram in the form of timertt.
+timertt::lateness_histogram
+to_timertt( const timer_lateness_histogram_t & h )
+	{
+		timertt::lateness_histogram result;
+		result.m_buckets = h.m_buckets;
+		return result;
+	}
+
+} /* namespace anonymous */
+
+std::chrono::steady_clock::duration
+timer_lateness_histogram_t::upper_border( std::size_t index )
+	{
+		return timertt::lateness_histogram::upper_border( index );
+	}
+
+std::uint64_t
+timer_lateness_histogram_t::total() const
+	{
+		return to_timertt( *this ).total();
+	}
+
+std::chrono::steady_clock::duration
+timer_lateness_histogram_t::percentile( double p ) const
+	{
+		return to_timertt( *this ).percentile( p );
+	}
+
 //
 // timer_thread_t
 //
@@ -120,6 +188,211 @@ timer_manager_t::~timer_manager_t()
 namespace timers_details
 {
 
+//
+// make_stats
+//
+/*!
+ * \brief Make run-time monitoring information from timertt's data.
+ *
+ * \since
+ * v.5.5.20
+ */
+inline timer_thread_stats_t
+make_stats(
+	const timertt::timer_quantities & quantities,
+	const timertt::engine_stats & engine )
+	{
+		timer_thread_stats_t result{
+				quantities.m_single_shot_count,
+				quantities.m_periodic_count };
+
+		result.m_lateness.m_buckets = engine.m_lateness.m_buckets;
+		result.m_ticks_with_expired_timers = engine.m_ticks_with_expired_timers;
+		result.m_max_expired_per_tick = engine.m_max_expired_per_tick;
+		result.m_lock_hold_time = engine.m_lock_hold_time;
+		result.m_max_lock_hold_time = engine.m_max_lock_hold_time;
+		result.m_occupied_slots = engine.m_occupied_slots;
+		result.m_max_slot_occupancy = engine.m_max_slot_occupancy;
+
+		return result;
+	}
+
+//
+// delivery_batch_t
+//
+/*!
+ * \brief A batch of messages from timers elapsed at one wakeup of
+ * timer thread.
+ *
+ * Messages are collected by actions of timers and then are delivered
+ * by flush(). All messages for the same mbox are delivered by one call.
+ * Messages for the same mbox are delivered in the order of their
+ * appearance. Mboxes are served in the order of appearance of their
+ * first messages.
+ *
+ * \attention This object is used only on the context of timer thread.
+ * Because of that it is not thread safe.
+ *
+ * \since
+ * v.5.5.20
+ */
+class delivery_batch_t
+	{
+	public :
+		void
+		add(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg )
+			{
+				const auto group = m_groups.emplace(
+						mbox.get(), m_groups.size() ).first->second;
+
+				m_items.push_back( item_t{
+						group,
+						mbox,
+						::so_5::rt::impl::timer_message_t{ type_index, msg } } );
+			}
+
+		void
+		flush()
+			{
+				// All the data must be dropped even in the case of an exception.
+				auto cleanup = so_5::details::at_scope_exit( [this] {
+						m_items.clear();
+						m_groups.clear();
+						m_messages.clear();
+					} );
+
+				std::stable_sort( m_items.begin(), m_items.end(),
+						[]( const item_t & a, const item_t & b ) {
+							return a.m_group < b.m_group;
+						} );
+
+				for( auto it = m_items.begin(); it != m_items.end(); )
+					{
+						const auto group = it->m_group;
+						const auto & mbox = it->m_mbox;
+
+						m_messages.clear();
+						for( ; it != m_items.end() && group == it->m_group; ++it )
+							m_messages.push_back( std::move( it->m_message ) );
+
+						::so_5::rt::impl::mbox_iface_for_timers_t{ mbox }
+								.deliver_messages_from_timer(
+										m_messages.data(), m_messages.size() );
+					}
+			}
+
+	private :
+		//! Info about one message.
+		struct item_t
+			{
+				//! Index of mbox in the order of appearance.
+				std::size_t m_group;
+				mbox_t m_mbox;
+				::so_5::rt::impl::timer_message_t m_message;
+			};
+
+		//! Collected messages.
+		std::vector< item_t > m_items;
+
+		//! Indexes of mboxes in the order of appearance.
+		std::unordered_map< const abstract_message_box_t *, std::size_t >
+				m_groups;
+
+		//! Messages for one mbox.
+		/*!
+		 * \note It is a member to reuse the memory between flushes.
+		 */
+		std::vector< ::so_5::rt::impl::timer_message_t > m_messages;
+	};
+
+//
+// delivery_action_t
+//
+/*!
+ * \brief Timer action for delivery of a message to a mbox.
+ *
+ * It is a named type instead of a lambda because std::function allocates
+ * a copy of it by the new-expression (at least in libstdc++). So memory
+ * blocks of these objects are reused too.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct delivery_action_t final
+	:	public timertt::details::pooled_object< delivery_action_t >
+	{
+		std::type_index m_type_index;
+		mbox_t m_mbox;
+		message_ref_t m_msg;
+		//! A batch for the message.
+		/*!
+		 * nullptr means that message must be delivered immediately.
+		 */
+		delivery_batch_t * m_batch;
+
+		delivery_action_t(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			delivery_batch_t * batch )
+			:	m_type_index( type_index )
+			,	m_mbox( mbox )
+			,	m_msg( msg )
+			,	m_batch( batch )
+			{}
+
+		void
+		operator()() const
+			{
+				if( m_batch )
+					m_batch->add( m_type_index, m_mbox, m_msg );
+				else
+					::so_5::rt::impl::mbox_iface_for_timers_t{ m_mbox }
+							.deliver_message_from_timer( m_type_index, m_msg );
+			}
+	};
+
+//
+// collecting_action_t
+//
+/*!
+ * \brief Timer action for passing a message to the collector of
+ * elapsed timers.
+ *
+ * \note It is a named type by the same reason as delivery_action_t.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct collecting_action_t final
+	:	public timertt::details::pooled_object< collecting_action_t >
+	{
+		timer_manager_t::elapsed_timers_collector_t & m_collector;
+		std::type_index m_type_index;
+		mbox_t m_mbox;
+		message_ref_t m_msg;
+
+		collecting_action_t(
+			timer_manager_t::elapsed_timers_collector_t & collector,
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg )
+			:	m_collector( collector )
+			,	m_type_index( type_index )
+			,	m_mbox( mbox )
+			,	m_msg( msg )
+			{}
+
+		void
+		operator()() const
+			{
+				m_collector.accept( m_type_index, m_mbox, m_msg );
+			}
+	};
+
 //
 // actual_timer_t
 //
@@ -133,10 +406,15 @@ namespace timers_details
  * Since v.5.5.19 this template can be used with timer_thread and
  * with timer_manager.
  * 
+ * \note
+ * Since v.5.5.20 memory blocks of these objects are reused.
+ *
  * \tparam TIMER A type of timertt-based thread/manager which implements timers.
  */
 template< class TIMER >
-class actual_timer_t : public timer_t
+class actual_timer_t
+	:	public timer_t
+	,	public timertt::details::pooled_object< actual_timer_t< TIMER > >
 	{
 	public :
 		//! The actual type of timer holder for timertt.
@@ -145,9 +423,12 @@ class actual_timer_t : public timer_t
 
 		//! Initialized constructor.
 		actual_timer_t(
-			TIMER * thread )
+			TIMER * thread,
+			//! Is the message mutable?
+			bool mutable_msg )
 			:	m_thread( thread )
 			,	m_timer( thread->allocate() )
+			,	m_mutable_msg( mutable_msg )
 			{}
 		virtual ~actual_timer_t()
 			{
@@ -177,6 +458,23 @@ class actual_timer_t : public timer_t
 				}
 			}
 
+		virtual bool
+		reschedule(
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				if( !m_thread )
+					return false;
+
+				if( m_mutable_msg )
+					SO_5_THROW_EXCEPTION(
+							so_5::rc_mutable_msg_cannot_be_periodic,
+							"unable to reschedule timer for mutable message" );
+
+				m_timer = m_thread->reactivate( m_timer, pause, period );
+				return true;
+			}
+
 	private :
 		//! Timer thread for the timer.
 		/*!
@@ -186,6 +484,13 @@ class actual_timer_t : public timer_t
 
 		//! Underlying timer object reference.
 		timer_holder_t m_timer;
+
+		//! Is the message mutable?
+		/*!
+		 * \since
+		 * v.5.5.20
+		 */
+		const bool m_mutable_msg;
 	};
 
 //
@@ -208,9 +513,21 @@ class actual_thread_t : public timer_thread_t
 		//! Initializing constructor.
 		actual_thread_t(
 			//! Real timer thread.
-			std::unique_ptr< TIMER_THREAD > thread )
-			:	m_thread( std::move( thread ) )
-			{}
+			std::unique_ptr< TIMER_THREAD > thread,
+			//! Should messages from timers elapsed at one wakeup
+			//! be delivered together?
+			bool batch_delivery = false )
+			:	m_batch( batch_delivery ?
+					stdcpp::make_unique< delivery_batch_t >() : nullptr )
+			,	m_thread( std::move( thread ) )
+			{
+				if( m_batch )
+					{
+						auto * batch = m_batch.get();
+						m_thread->set_post_processing_action(
+								[batch] { batch->flush(); } );
+					}
+			}
 
 		virtual void
 		start() override
@@ -232,16 +549,15 @@ class actual_thread_t : public timer_thread_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = stdcpp::make_unique< timer_demand_t >( m_thread.get() );
+				auto timer = stdcpp::make_unique< timer_demand_t >(
+						m_thread.get(),
+						message_mutability_t::mutable_message ==
+								message_mutability( msg ) );
 
 				m_thread->activate( timer->timer_holder(),
 						pause,
 						period,
-						[type_index, mbox, msg]()
-						{
-							::so_5::rt::impl::mbox_iface_for_timers_t{ mbox }
-									.deliver_message_from_timer( type_index, msg );
-						} );
+						delivery_action_t{ type_index, mbox, msg, m_batch.get() } );
 
 				return timer_id_t( timer.release() );
 			}
@@ -257,25 +573,29 @@ class actual_thread_t : public timer_thread_t
 				m_thread->activate(
 						pause,
 						period,
-						[type_index, mbox, msg]()
-						{
-							::so_5::rt::impl::mbox_iface_for_timers_t{ mbox }
-									.deliver_message_from_timer( type_index, msg );
-						} );
+						delivery_action_t{ type_index, mbox, msg, m_batch.get() } );
 			}
 
 		virtual timer_thread_stats_t
 		query_stats() override
 			{
-				auto d = m_thread->get_timer_quantities();
-
-				return timer_thread_stats_t{
-						d.m_single_shot_count,
-						d.m_periodic_count
-					};
+				return make_stats(
+						m_thread->get_timer_quantities(),
+						m_thread->get_engine_stats() );
 			}
 
 	private :
+		//! A batch for messages from elapsed timers.
+		/*!
+		 * nullptr if messages are delivered immediately.
+		 *
+		 * \note It must be destroyed after the timer thread.
+		 *
+		 * \since
+		 * v.5.5.20
+		 */
+		std::unique_ptr< delivery_batch_t > m_batch;
+
 		std::unique_ptr< TIMER_THREAD > m_thread;
 	};
 
@@ -328,15 +648,16 @@ class actual_manager_t : public timer_manager_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = stdcpp::make_unique< timer_demand_t >( m_manager.get() );
+				auto timer = stdcpp::make_unique< timer_demand_t >(
+						m_manager.get(),
+						message_mutability_t::mutable_message ==
+								message_mutability( msg ) );
 
 				m_manager->activate( timer->timer_holder(),
 						pause,
 						period,
-						[this, type_index, mbox, msg]()
-						{
-							m_collector.get().accept( type_index, mbox, msg );
-						} );
+						collecting_action_t{
+								m_collector.get(), type_index, mbox, msg } );
 
 				return timer_id_t( timer.release() );
 			}
@@ -352,10 +673,8 @@ class actual_manager_t : public timer_manager_t
 				m_manager->activate(
 						pause,
 						period,
-						[this, type_index, mbox, msg]()
-						{
-							m_collector.get().accept( type_index, mbox, msg );
-						} );
+						collecting_action_t{
+								m_collector.get(), type_index, mbox, msg } );
 			}
 
 		virtual bool
@@ -367,12 +686,9 @@ class actual_manager_t : public timer_manager_t
 		virtual timer_thread_stats_t
 		query_stats() override
 			{
-				auto d = m_manager->get_timer_quantities();
-
-				return timer_thread_stats_t{
-						d.m_single_shot_count,
-						d.m_periodic_count
-					};
+				return make_stats(
+						m_manager->get_timer_quantities(),
+						m_manager->get_engine_stats() );
 			}
 
 	private :
@@ -381,6 +697,131 @@ class actual_manager_t : public timer_manager_t
 				m_collector;
 	};
 
+//
+// sharded_thread_t
+//
+/*!
+ * \brief An implementation of timer thread which distributes timers
+ * between several independent timer threads.
+ *
+ * Every shard is a full-fledged timer_thread with its own lock.
+ * A shard for a new timer is selected by hashing the ID of the
+ * caller's thread. So every worker thread always uses the same shard
+ * and different worker threads are spread between shards.
+ *
+ * The timer_id returned by a shard refers to the shard's timer directly.
+ * Because of that cancellation of the timer touches only that shard.
+ *
+ * \since
+ * v.5.5.20
+ */
+class sharded_thread_t : public timer_thread_t
+	{
+	public :
+		//! Initializing constructor.
+		sharded_thread_t(
+			//! Shards to be used.
+			std::vector< timer_thread_unique_ptr_t > shards )
+			:	m_shards( std::move( shards ) )
+			{}
+
+		virtual void
+		start() override
+			{
+				std::size_t started = 0;
+				try
+					{
+						for( ; started != m_shards.size(); ++started )
+							m_shards[ started ]->start();
+					}
+				catch( ... )
+					{
+						// Already started shards must be stopped.
+						while( started )
+							m_shards[ --started ]->finish();
+						throw;
+					}
+			}
+
+		virtual void
+		finish() override
+			{
+				for( auto & s : m_shards )
+					s->finish();
+			}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				return select_shard().schedule(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				select_shard().schedule_anonymous(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				timer_thread_stats_t result{ 0, 0 };
+				for( auto & s : m_shards )
+					{
+						const auto d = s->query_stats();
+						result.m_single_shot_count += d.m_single_shot_count;
+						result.m_periodic_count += d.m_periodic_count;
+
+						for( std::size_t i = 0;
+								i != timer_lateness_histogram_t::bucket_count; ++i )
+							result.m_lateness.m_buckets[ i ] +=
+									d.m_lateness.m_buckets[ i ];
+
+						result.m_ticks_with_expired_timers +=
+								d.m_ticks_with_expired_timers;
+						result.m_max_expired_per_tick = (std::max)(
+								result.m_max_expired_per_tick,
+								d.m_max_expired_per_tick );
+						result.m_lock_hold_time += d.m_lock_hold_time;
+						result.m_max_lock_hold_time = (std::max)(
+								result.m_max_lock_hold_time,
+								d.m_max_lock_hold_time );
+						result.m_occupied_slots += d.m_occupied_slots;
+						result.m_max_slot_occupancy = (std::max)(
+								result.m_max_slot_occupancy,
+								d.m_max_slot_occupancy );
+					}
+
+				return result;
+			}
+
+	private :
+		//! Shards.
+		const std::vector< timer_thread_unique_ptr_t > m_shards;
+
+		//! Get the shard for the current thread.
+		timer_thread_t &
+		select_shard()
+			{
+				const auto h = std::hash< std::thread::id >()(
+						std::this_thread::get_id() );
+
+				return *(m_shards[ h % m_shards.size() ]);
+			}
+	};
+
 //
 // error_logger_for_timertt_t
 //
@@ -486,6 +927,11 @@ using timer_list_thread_t = timertt::timer_list_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel thread type.
+using timer_hwheel_thread_t = timertt::timer_hwheel_thread_template<
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
+
 //! timer_wheel manager type.
 using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
 		timertt::thread_safety::unsafe,
@@ -503,10 +949,165 @@ using timer_list_manager_t = timertt::timer_list_manager_template<
 		timertt::thread_safety::unsafe,
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel manager type.
+using timer_hwheel_manager_t = timertt::timer_hwheel_manager_template<
+		timertt::thread_safety::unsafe,
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
 /*!
  * \}
  */
 
+/*!
+ * \brief Helper for wrapping tuned timertt thread into timer_thread.
+ *
+ * \since
+ * v.5.5.20
+ */
+template< class TUNER, class TIMER_THREAD >
+timer_thread_unique_ptr_t
+make_tuned_thread(
+	const TUNER & tuner,
+	std::unique_ptr< TIMER_THREAD > thread )
+	{
+		tuner( *thread );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< TIMER_THREAD >(
+						std::move( thread ),
+						TUNER::batch_delivery ) );
+	}
+
+/*!
+ * \brief Tuner which switches timer thread to lock-free inbox.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct inbox_tuner_t
+	{
+		static constexpr bool batch_delivery = false;
+
+		template< class TIMER_THREAD >
+		void
+		operator()( TIMER_THREAD & thread ) const
+			{
+				thread.set_submission_mode( timertt::submission_mode::inbox );
+			}
+	};
+
+/*!
+ * \brief Tuner which sets the slack for wakeups of timer thread.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct slack_tuner_t
+	{
+		//! Messages from timers elapsed at one wakeup are delivered together.
+		static constexpr bool batch_delivery = true;
+
+		std::chrono::steady_clock::duration m_slack;
+
+		template< class TIMER_THREAD >
+		void
+		operator()( TIMER_THREAD & thread ) const
+			{
+				thread.set_slack( m_slack );
+			}
+	};
+
+/*!
+ * \brief Tuner which does nothing.
+ *
+ * \since
+ * v.5.5.20
+ */
+struct no_tuning_t
+	{
+		static constexpr bool batch_delivery = false;
+
+		template< class TIMER_THREAD >
+		void
+		operator()( TIMER_THREAD & ) const {}
+	};
+
+/*!
+ * \brief Helper for creation of timer thread of the specified type
+ * with additional tuning.
+ *
+ * \tparam CONSUMER type of timertt consumer which defines the way
+ * of waiting for next event.
+ *
+ * \tparam TUNER type of functor with template operator() which
+ * tunes the created timertt thread before it is started.
+ *
+ * \since
+ * v.5.5.20
+ */
+template<
+	class CONSUMER = timertt::details::consumer_type::thread,
+	class TUNER >
+timer_thread_unique_ptr_t
+create_tuned_thread(
+	error_logger_shptr_t logger,
+	timer_engine_t engine,
+	TUNER tuner )
+	{
+		using wheel_thread_t = timertt::timer_wheel_thread_template<
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t,
+				CONSUMER >;
+		using list_thread_t = timertt::timer_list_thread_template<
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t,
+				CONSUMER >;
+		using heap_thread_t = timertt::timer_heap_thread_template<
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t,
+				CONSUMER >;
+		using hwheel_thread_t = timertt::timer_hwheel_thread_template<
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t,
+				CONSUMER >;
+
+		switch( engine )
+			{
+			case timer_engine_t::wheel :
+				return make_tuned_thread( tuner,
+						stdcpp::make_unique< wheel_thread_t >(
+								wheel_thread_t::default_wheel_size(),
+								wheel_thread_t::default_granularity(),
+								create_error_logger_for_timertt( logger ),
+								create_exception_handler_for_timertt_thread( logger ) ) );
+
+			case timer_engine_t::list :
+				return make_tuned_thread( tuner,
+						stdcpp::make_unique< list_thread_t >(
+								create_error_logger_for_timertt( logger ),
+								create_exception_handler_for_timertt_thread( logger ) ) );
+
+			case timer_engine_t::hwheel :
+				return make_tuned_thread( tuner,
+						stdcpp::make_unique< hwheel_thread_t >(
+								hwheel_thread_t::default_wheel_size(),
+								hwheel_thread_t::default_levels(),
+								hwheel_thread_t::default_granularity(),
+								create_error_logger_for_timertt( logger ),
+								create_exception_handler_for_timertt_thread( logger ) ) );
+
+			case timer_engine_t::heap :
+				break;
+			}
+
+		return make_tuned_thread( tuner,
+				stdcpp::make_unique< heap_thread_t >(
+						heap_thread_t::default_initial_heap_capacity(),
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+	}
+
 } /* namespace timers_details */
 
 SO_5_FUNC timer_thread_unique_ptr_t
@@ -586,6 +1187,41 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hwheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t = timers_details::timer_hwheel_thread_t;
+
+		return create_timer_hwheel_thread(
+				logger,
+				timertt_thread_t::default_wheel_size(),
+				timertt_thread_t::default_levels(),
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hwheel_thread(
+	error_logger_shptr_t logger,
+	unsigned int wheel_size,
+	unsigned int levels,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t = timers_details::timer_hwheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						wheel_size,
+						levels,
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_wheel_manager(
 	error_logger_shptr_t logger,
@@ -675,5 +1311,111 @@ create_timer_list_manager(
 				std::move( collector ) );
 	}
 
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hwheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector )
+	{
+		using timertt_manager_t = timers_details::timer_hwheel_manager_t;
+
+		return create_timer_hwheel_manager(
+				logger,
+				std::move(collector),
+				timertt_manager_t::default_wheel_size(),
+				timertt_manager_t::default_levels(),
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hwheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector,
+	unsigned int wheel_size,
+	unsigned int levels,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t = timers_details::timer_hwheel_manager_t;
+		using namespace timers_details;
+
+		auto manager = stdcpp::make_unique< timertt_manager_t >(
+				wheel_size,
+				levels,
+				granularity,
+				create_error_logger_for_timertt( logger ),
+				create_exception_handler_for_timertt_manager( logger ) );
+
+		return stdcpp::make_unique< actual_manager_t< timertt_manager_t > >(
+				std::move( manager ),
+				std::move( collector ) );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	error_logger_shptr_t logger,
+	std::size_t shards,
+	const timer_thread_factory_t & shard_factory )
+	{
+		if( !shards )
+			SO_5_THROW_EXCEPTION( rc_invalid_timer_shards_count,
+					"count of shards for timer thread must be greater than 0" );
+
+		std::vector< timer_thread_unique_ptr_t > threads;
+		threads.reserve( shards );
+		for( std::size_t i = 0; i != shards; ++i )
+			threads.push_back( shard_factory( logger ) );
+
+		return stdcpp::make_unique< timers_details::sharded_thread_t >(
+				std::move( threads ) );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_thread_with_inbox(
+	error_logger_shptr_t logger,
+	timer_engine_t engine )
+	{
+		return timers_details::create_tuned_thread(
+				std::move( logger ),
+				engine,
+				timers_details::inbox_tuner_t{} );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_coalescing_timer_thread(
+	error_logger_shptr_t logger,
+	timer_engine_t engine,
+	std::chrono::steady_clock::duration slack )
+	{
+		if( std::chrono::steady_clock::duration::zero() > slack )
+			SO_5_THROW_EXCEPTION( rc_invalid_timer_slack,
+					"timer slack can't be negative" );
+
+		return timers_details::create_tuned_thread(
+				std::move( logger ),
+				engine,
+				timers_details::slack_tuner_t{ slack } );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timerfd_timer_thread(
+	error_logger_shptr_t logger,
+	timer_engine_t engine )
+	{
+#if defined(__linux__)
+		return timers_details::create_tuned_thread<
+						timertt::details::consumer_type::timerfd_thread >(
+				std::move( logger ),
+				engine,
+				timers_details::no_tuning_t{} );
+#else
+		(void)logger;
+		(void)engine;
+		SO_5_THROW_EXCEPTION( rc_timerfd_not_supported,
+				"timerfd-based timer thread is available on Linux only" );
+		return timer_thread_unique_ptr_t();
+#endif
+	}
+
 } /* namespace so_5 */
 
@@ -1,5 +1,8 @@
 /*
  * A simple benchmark for so_change_state() performance.
+ *
+ * Since v.5.5.20 there is also a variant with time limits for
+ * all states.
  */
 
 #include <iostream>
@@ -20,9 +23,11 @@ class a_test_t
 	public :
 		a_test_t(
 			so_5::environment_t & env,
-			unsigned int iterations )
+			unsigned int iterations,
+			bool with_time_limits )
 			:	so_5::agent_t( env )
 			,	m_iterations( iterations )
+			,	m_with_time_limits( with_time_limits )
 			{
 				m_states.push_back( &st_0 );
 				m_states.push_back( &st_1 );
@@ -34,6 +39,10 @@ class a_test_t
 				m_states.push_back( &st_7 );
 				m_states.push_back( &st_8 );
 				m_states.push_back( &st_9 );
+
+				if( m_with_time_limits )
+					for( auto sp : m_states )
+						sp->time_limit( std::chrono::hours( 1 ), so_default_state() );
 			}
 
 		virtual void
@@ -68,7 +77,8 @@ class a_test_t
 							}
 					}
 
-				bench.finish_and_show_stats( changes, "changes" );
+				bench.finish_and_show_stats( changes,
+						m_with_time_limits ? "changes (with time limits)" : "changes" );
 
 				so_environment().stop();
 			}
@@ -80,20 +90,22 @@ class a_test_t
 			}
 
 	private :
-		const so_5::state_t st_0{ this, "0" };
-		const so_5::state_t st_1{ this, "1" };
-		const so_5::state_t st_2{ this, "2" };
-		const so_5::state_t st_3{ this, "3" };
-		const so_5::state_t st_4{ this, "4" };
-		const so_5::state_t st_5{ this, "5" };
-		const so_5::state_t st_6{ this, "6" };
-		const so_5::state_t st_7{ this, "7" };
-		const so_5::state_t st_8{ this, "8" };
-		const so_5::state_t st_9{ this, "9" };
+		so_5::state_t st_0{ this, "0" };
+		so_5::state_t st_1{ this, "1" };
+		so_5::state_t st_2{ this, "2" };
+		so_5::state_t st_3{ this, "3" };
+		so_5::state_t st_4{ this, "4" };
+		so_5::state_t st_5{ this, "5" };
+		so_5::state_t st_6{ this, "6" };
+		so_5::state_t st_7{ this, "7" };
+		so_5::state_t st_8{ this, "8" };
+		so_5::state_t st_9{ this, "9" };
 
 		unsigned int m_iterations;
 
-		std::vector< const so_5::state_t * > m_states;
+		const bool m_with_time_limits;
+
+		std::vector< so_5::state_t * > m_states;
 	};
 
 int
@@ -101,16 +113,17 @@ main( int argc, char ** argv )
 {
 	try
 	{
-		const unsigned int tick_count = 2 == static_cast< unsigned int >(
-				argc ? std::atoi( argv[1] ) : 1000);
-
-		so_5::launch(
-			[tick_count]( so_5::environment_t & env )
-			{
-				env.register_agent_as_coop(
-					"test",
-					new a_test_t( env, tick_count ) );
-			} );
+		const unsigned int tick_count = 2 == argc ?
+				static_cast< unsigned int >( std::atoi( argv[1] ) ) : 1000;
+
+		for( bool with_time_limits : { false, true } )
+			so_5::launch(
+				[tick_count, with_time_limits]( so_5::environment_t & env )
+				{
+					env.register_agent_as_coop(
+						"test",
+						new a_test_t( env, tick_count, with_time_limits ) );
+				} );
 	}
 	catch( const std::exception & ex )
 	{
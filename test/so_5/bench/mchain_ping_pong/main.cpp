@@ -0,0 +1,116 @@
+/*
+ * A benchmark for ping-pong and streaming between two threads via mchains.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/benchmark_helpers.hpp>
+
+const unsigned int max_iterations = 200000u;
+
+so_5::mchain_params_t
+make_params( bool lock_free )
+{
+	namespace props = so_5::mchain_props;
+
+	auto params = so_5::make_limited_with_waiting_mchain_params(
+			64,
+			props::memory_usage_t::preallocated,
+			props::overflow_reaction_t::throw_exception,
+			std::chrono::seconds( 5 ) );
+
+	if( lock_free )
+		params.producers( props::multiplicity_t::single )
+			.consumers( props::multiplicity_t::single );
+
+	return params;
+}
+
+std::string
+case_name( const char * name, bool lock_free )
+{
+	return std::string( name ) + ( lock_free ? "(lock_free)" : "(mutex)" );
+}
+
+void
+ping_pong_case( so_5::environment_t & env, bool lock_free )
+{
+	auto ping_ch = env.create_mchain( make_params( lock_free ) );
+	auto pong_ch = env.create_mchain( make_params( lock_free ) );
+
+	std::thread ponger{ [&] {
+		receive( from( ping_ch ),
+				[&pong_ch]( unsigned int v ) {
+					so_5::send< unsigned int >( pong_ch, v );
+				} );
+	} };
+
+	benchmarker_t bench;
+	bench.start();
+
+	const auto prepared = so_5::prepare_receive(
+			from( pong_ch ).handle_n( 1 ),
+			[]( unsigned int ) {} );
+
+	for( unsigned int i = 0; i != max_iterations; ++i )
+	{
+		so_5::send< unsigned int >( ping_ch, i );
+		so_5::receive( prepared );
+	}
+
+	bench.finish_and_show_stats( max_iterations,
+			case_name( "ping_pong", lock_free ) );
+
+	close_drop_content( ping_ch );
+	ponger.join();
+}
+
+void
+stream_case( so_5::environment_t & env, bool lock_free )
+{
+	auto ch = env.create_mchain(
+			make_params( lock_free ).extraction_batch_size( 64 ) );
+
+	benchmarker_t bench;
+	bench.start();
+
+	std::thread producer{ [&] {
+		for( unsigned int i = 0; i != max_iterations; ++i )
+			so_5::send< unsigned int >( ch, i );
+		close_retain_content( ch );
+	} };
+
+	unsigned long long received = 0u;
+	receive( from( ch ), [&received]( unsigned int ) { ++received; } );
+
+	bench.finish_and_show_stats( received,
+			case_name( "stream", lock_free ) );
+
+	producer.join();
+}
+
+int
+main()
+{
+	try
+	{
+		so_5::wrapped_env_t env;
+
+		for( bool lock_free : { false, true } )
+		{
+			ping_pong_case( env.environment(), lock_free );
+			stream_case( env.environment(), lock_free );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
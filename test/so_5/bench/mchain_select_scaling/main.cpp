@@ -0,0 +1,125 @@
+/*
+ * A benchmark for select() from a different count of mchains.
+ *
+ * Several producer threads send messages to N mchains in round-robin
+ * manner. Several selecting threads read them via select() from all N
+ * mchains at once.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/benchmark_helpers.hpp>
+
+const unsigned int total_messages = 64000u;
+
+//
+// Helpers for making a list of select cases at compile time.
+//
+template< std::size_t... I >
+struct indices_t {};
+
+template< std::size_t N, std::size_t... I >
+struct make_indices_t : public make_indices_t< N - 1, N - 1, I... > {};
+
+template< std::size_t... I >
+struct make_indices_t< 0, I... >
+{
+	using type = indices_t< I... >;
+};
+
+template< typename HANDLER, std::size_t... I >
+void
+select_from_all(
+	const std::vector< so_5::mchain_t > & chains,
+	HANDLER handler,
+	indices_t< I... > )
+{
+	const auto prepared = so_5::prepare_select(
+			so_5::from_all(),
+			case_( chains[ I ], handler )... );
+
+	select( prepared );
+}
+
+template< std::size_t CHAINS >
+void
+run_case(
+	so_5::environment_t & env,
+	unsigned int producers,
+	unsigned int selectors )
+{
+	std::vector< so_5::mchain_t > chains;
+	for( std::size_t i = 0; i != CHAINS; ++i )
+		chains.push_back( env.create_mchain(
+				so_5::make_limited_with_waiting_mchain_params(
+						64,
+						so_5::mchain_props::memory_usage_t::preallocated,
+						so_5::mchain_props::overflow_reaction_t::throw_exception,
+						std::chrono::seconds( 5 ) ) ) );
+
+	std::atomic< unsigned long long > received{ 0u };
+
+	benchmarker_t bench;
+	bench.start();
+
+	std::vector< std::thread > selector_threads;
+	for( unsigned int i = 0; i != selectors; ++i )
+		selector_threads.emplace_back( [&] {
+			unsigned long long counter = 0u;
+			select_from_all(
+					chains,
+					[&counter]( unsigned int ) { ++counter; },
+					typename make_indices_t< CHAINS >::type{} );
+			received += counter;
+		} );
+
+	std::vector< std::thread > producer_threads;
+	for( unsigned int p = 0; p != producers; ++p )
+		producer_threads.emplace_back( [&, p] {
+			for( unsigned int i = p; i < total_messages; i += producers )
+				so_5::send< unsigned int >( chains[ i % CHAINS ], i );
+		} );
+
+	for( auto & t : producer_threads )
+		t.join();
+
+	for( auto & ch : chains )
+		close_retain_content( ch );
+
+	for( auto & t : selector_threads )
+		t.join();
+
+	bench.finish_and_show_stats( received.load(),
+			"chains=" + std::to_string( CHAINS ) +
+			",producers=" + std::to_string( producers ) +
+			",selectors=" + std::to_string( selectors ) );
+}
+
+int
+main()
+{
+	try
+	{
+		so_5::wrapped_env_t env;
+
+		for( unsigned int selectors : { 1u, 4u } )
+		{
+			run_case< 1 >( env.environment(), 4u, selectors );
+			run_case< 16 >( env.environment(), 4u, selectors );
+			run_case< 256 >( env.environment(), 4u, selectors );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
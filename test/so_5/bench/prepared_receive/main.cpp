@@ -7,6 +7,7 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -78,6 +79,46 @@ prepared_receive_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_receive_case" );
 }
 
+void
+prepared_bunch_receive_case(
+	so_5::environment_t & env,
+	std::size_t batch_size )
+{
+	const std::size_t messages_in_chain = 999u;
+	const unsigned long long bunches = 1000u;
+
+	auto ch1 = env.create_mchain(
+			so_5::make_unlimited_mchain_params()
+				.extraction_batch_size( batch_size ) );
+
+	unsigned long long counter = 0u;
+
+	const auto prepared = so_5::prepare_receive(
+			from( ch1 ).handle_n( messages_in_chain ).no_wait_on_empty(),
+			[&counter]( one ) { ++counter; },
+			[&counter]( two ) { ++counter; },
+			[&counter]( three ) { ++counter; } );
+
+	benchmarker_t bench;
+	bench.start();
+
+	for( unsigned long long i = 0u; i < bunches; ++i )
+	{
+		for( std::size_t m = 0u; m < messages_in_chain; m += 3u )
+		{
+			so_5::send< one >( ch1 );
+			so_5::send< two >( ch1 );
+			so_5::send< three >( ch1 );
+		}
+
+		so_5::receive( prepared );
+	}
+
+	bench.finish_and_show_stats( counter,
+			"prepared_bunch_receive_case(batch_size=" +
+			std::to_string( batch_size ) + ")" );
+}
+
 int
 main()
 {
@@ -88,6 +129,8 @@ main()
 			{
 				raw_receive_case( env );
 				prepared_receive_case( env );
+				prepared_bunch_receive_case( env, 1u );
+				prepared_bunch_receive_case( env, 64u );
 			} );
 	}
 	catch( const std::exception & ex )
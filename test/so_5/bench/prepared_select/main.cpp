@@ -7,6 +7,7 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -78,6 +79,52 @@ prepared_select_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_select_case" );
 }
 
+void
+prepared_bunch_select_case(
+	so_5::environment_t & env,
+	std::size_t batch_size )
+{
+	const std::size_t messages_in_chain = 1000u;
+
+	auto make_chain = [&] {
+		return env.create_mchain(
+				so_5::make_unlimited_mchain_params()
+					.extraction_batch_size( batch_size ) );
+	};
+
+	auto ch1 = make_chain();
+	auto ch2 = make_chain();
+	auto ch3 = make_chain();
+
+	unsigned long long counter = 0u;
+	const unsigned long long max_iterations = 1000u;
+
+	auto prepared = so_5::prepare_select(
+			so_5::from_all().handle_n( 3u * messages_in_chain ),
+			case_( ch1, [&counter]( int ) { ++counter; } ),
+			case_( ch2, [&counter]( int ) { ++counter; } ),
+			case_( ch3, [&counter]( int ) { ++counter; } ) );
+
+	benchmarker_t bench;
+	bench.start();
+
+	for( unsigned long long i = 0u; i < max_iterations; ++i )
+	{
+		for( std::size_t m = 0u; m < messages_in_chain; ++m )
+		{
+			so_5::send< int >( ch1, 1 );
+			so_5::send< int >( ch2, 2 );
+			so_5::send< int >( ch3, 3 );
+		}
+
+		select( prepared );
+	}
+
+	bench.finish_and_show_stats( counter,
+			"prepared_bunch_select_case(batch_size=" +
+			std::to_string( batch_size ) + ")" );
+}
+
 int
 main()
 {
@@ -88,6 +135,8 @@ main()
 			{
 				raw_select_case( env );
 				prepared_select_case( env );
+				prepared_bunch_select_case( env, 1u );
+				prepared_bunch_select_case( env, 64u );
 			} );
 	}
 	catch( const std::exception & ex )
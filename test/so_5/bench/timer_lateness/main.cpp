@@ -0,0 +1,191 @@
+/*
+ * A benchmark for lateness of delivery of delayed messages
+ * for different timer threads.
+ *
+ * Many delayed messages with random pauses are sent to a mchain.
+ * The receiver calculates the difference between the time of receiving
+ * and the deadline of every message. Percentiles of that lateness
+ * are shown for every timer thread.
+ *
+ * Additional threads with busy loops can be started for imitation of
+ * high load. The count of them is specified by the first argument.
+ *
+ * Tail percentiles of a single run are dominated by scheduling noise.
+ * Because of that all timer threads are run in turn for several rounds
+ * (the second argument, 5 by default) and the median value of every
+ * percentile is shown together with the range of p99.
+ *
+ * Note: lateness includes the time of waking up of the receiver.
+ * It is the same for all timer threads.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+using hires_clock = std::chrono::steady_clock;
+
+const std::size_t total_timers = 2000u;
+const int max_pause_ms = 200;
+
+struct delayed
+{
+	hires_clock::time_point m_deadline;
+};
+
+const double percentiles[] = { 0.5, 0.9, 0.99, 0.999, 1.0 };
+const char * const percentile_names[] = {
+		"p50", "p90", "p99", "p99.9", "max" };
+const std::size_t percentile_count =
+		sizeof(percentiles) / sizeof(percentiles[0]);
+const std::size_t p99_index = 2u;
+
+// Values of percentiles (in microseconds) for every round.
+using round_results_t = std::vector< std::vector< long long > >;
+
+struct timer_case
+{
+	std::string m_name;
+	so_5::timer_thread_factory_t m_factory;
+	round_results_t m_results;
+};
+
+std::vector< long long >
+calculate_percentiles(
+	std::vector< hires_clock::duration > & lateness )
+{
+	std::sort( lateness.begin(), lateness.end() );
+
+	std::vector< long long > result;
+	for( const auto p : percentiles )
+	{
+		const auto index = std::min(
+				lateness.size() - 1u,
+				static_cast< std::size_t >( p * lateness.size() ) );
+		result.push_back(
+				std::chrono::duration_cast< std::chrono::microseconds >(
+						lateness[ index ] ).count() );
+	}
+
+	return result;
+}
+
+void
+show_percentiles( const timer_case & c )
+{
+	auto column = [&c]( std::size_t index ) {
+		std::vector< long long > values;
+		for( const auto & r : c.m_results )
+			values.push_back( r[ index ] );
+		std::sort( values.begin(), values.end() );
+		return values;
+	};
+
+	std::cout << std::setw( 14 ) << std::left << c.m_name << std::right;
+	for( std::size_t i = 0; i != percentile_count; ++i )
+	{
+		const auto values = column( i );
+		std::cout << " " << percentile_names[ i ] << "="
+			<< std::setw( 6 ) << values[ values.size() / 2u ];
+	}
+
+	const auto p99 = column( p99_index );
+	std::cout << " (us), p99 range: " << p99.front() << ".." << p99.back()
+		<< std::endl;
+}
+
+std::vector< long long >
+run_case( so_5::timer_thread_factory_t factory )
+{
+	so_5::wrapped_env_t env{
+		[]( so_5::environment_t & ) {},
+		[&factory]( so_5::environment_params_t & params ) {
+			params.timer_thread( factory );
+		} };
+
+	auto ch = create_mchain( env );
+
+	std::mt19937 generator{ 42u };
+	std::uniform_int_distribution< int > pauses{ 1, max_pause_ms * 1000 };
+
+	for( std::size_t i = 0; i != total_timers; ++i )
+	{
+		const auto pause = std::chrono::microseconds( pauses( generator ) );
+		so_5::send_delayed< delayed >(
+				env.environment(), ch->as_mbox(), pause,
+				delayed{ hires_clock::now() + pause } );
+	}
+
+	std::vector< hires_clock::duration > lateness;
+	lateness.reserve( total_timers );
+
+	receive( from( ch ).handle_n( total_timers ),
+			[&lateness]( const delayed & msg ) {
+				lateness.push_back( hires_clock::now() - msg.m_deadline );
+			} );
+
+	return calculate_percentiles( lateness );
+}
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const unsigned int load_threads = argc > 1 ?
+				static_cast< unsigned int >( std::atoi( argv[ 1 ] ) ) : 0u;
+		const unsigned int rounds = argc > 2 ?
+				static_cast< unsigned int >( std::max( 1, std::atoi( argv[ 2 ] ) ) ) :
+				5u;
+
+		std::atomic< bool > stop{ false };
+		std::vector< std::thread > load;
+		for( unsigned int i = 0; i != load_threads; ++i )
+			load.emplace_back( [&stop] {
+				while( !stop.load( std::memory_order_relaxed ) )
+					;
+			} );
+
+		std::cout << "timers: " << total_timers
+			<< ", load threads: " << load_threads
+			<< ", rounds: " << rounds << std::endl;
+
+		std::vector< timer_case > cases;
+		cases.push_back( { "heap", so_5::timer_heap_factory(), {} } );
+		cases.push_back( { "wheel", so_5::timer_wheel_factory(), {} } );
+#if defined(__linux__)
+		cases.push_back( { "timerfd(heap)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::heap ), {} } );
+		cases.push_back( { "timerfd(wheel)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::wheel ), {} } );
+#endif
+
+		// Cases are interleaved to spread the noise between them evenly.
+		for( unsigned int r = 0; r != rounds; ++r )
+			for( auto & c : cases )
+				c.m_results.push_back( run_case( c.m_factory ) );
+
+		for( const auto & c : cases )
+			show_percentiles( c );
+
+		stop = true;
+		for( auto & t : load )
+			t.join();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
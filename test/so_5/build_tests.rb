@@ -60,6 +60,7 @@ MxxRu::Cpp::composite_target {
 
 	required_prj "#{path}/bench/ping_pong/prj.rb" 
 	required_prj "#{path}/bench/same_msg_in_different_states/prj.rb" 
+	required_prj "#{path}/bench/same_msg_in_nested_states/prj.rb" 
 	required_prj "#{path}/bench/parallel_send_to_same_mbox/prj.rb" 
 	required_prj "#{path}/bench/change_state/prj.rb" 
 	required_prj "#{path}/bench/many_mboxes/prj.rb" 
@@ -70,6 +71,9 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/bench/skynet1m/prj.rb" 
 	required_prj "#{path}/bench/prepared_receive/prj.rb" 
 	required_prj "#{path}/bench/prepared_select/prj.rb" 
+	required_prj "#{path}/bench/mchain_ping_pong/prj.rb" 
+	required_prj "#{path}/bench/mchain_select_scaling/prj.rb" 
+	required_prj "#{path}/bench/timer_lateness/prj.rb" 
 
 	required_prj "#{path}/samples_as_unit_tests/build_tests.rb" 
 }
@@ -58,6 +58,7 @@ main()
 		timer_info_t timers[] = {
 			{ "timer_wheel", so_5::timer_wheel_manager_factory() },
 			{ "timer_heap", so_5::timer_heap_manager_factory() },
+			{ "timer_hwheel", so_5::timer_hwheel_manager_factory() },
 			{ "timer_list", so_5::timer_list_manager_factory() }
 		};
 
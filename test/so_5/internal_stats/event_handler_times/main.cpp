@@ -0,0 +1,303 @@
+/*
+ * A test for queue waiting and execution times of event handlers.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std::chrono;
+
+namespace stats = so_5::stats;
+
+struct work : public so_5::signal_t {};
+
+const std::size_t work_count = 10;
+const auto work_time = milliseconds( 2 );
+
+void
+check_histogram()
+	{
+		using histogram_t = stats::duration_histogram_t;
+
+		histogram_t h{};
+		ensure_or_die( 0u == h.total(), "histogram must be empty" );
+		ensure_or_die( steady_clock::duration::zero() == h.percentile( 0.5 ),
+				"percentile of empty histogram must be zero" );
+		ensure_or_die( steady_clock::duration::zero() == h.mean(),
+				"mean of empty histogram must be zero" );
+
+		// Small values have own buckets.
+		ensure_or_die( 5u == histogram_t::bucket_index( nanoseconds( 5 ) ),
+				"unexpected bucket for 5ns" );
+		// Every power of two is split into 8 buckets.
+		ensure_or_die( histogram_t::bucket_index( nanoseconds( 1024 ) ) ==
+				histogram_t::bucket_index( nanoseconds( 1151 ) ) &&
+				histogram_t::bucket_index( nanoseconds( 1024 ) ) + 1 ==
+				histogram_t::bucket_index( nanoseconds( 1152 ) ),
+				"unexpected buckets for [1024ns, 1152ns]" );
+		for( std::size_t i = 0; i != histogram_t::bucket_count - 1; ++i )
+			{
+				ensure_or_die( i == histogram_t::bucket_index(
+								histogram_t::lower_border( i ) ),
+						"lower border must be in the bucket " +
+						std::to_string( i ) );
+				ensure_or_die( i + 1 == histogram_t::bucket_index(
+								histogram_t::upper_border( i ) ),
+						"upper border must be out of the bucket " +
+						std::to_string( i ) );
+			}
+		ensure_or_die( steady_clock::duration::max() ==
+				histogram_t::upper_border( histogram_t::bucket_count - 1 ),
+				"last bucket must be unlimited" );
+		ensure_or_die( histogram_t::bucket_count - 1 ==
+				histogram_t::bucket_index( hours( 1 ) ),
+				"too big value must be in the last bucket" );
+
+		for( int i = 0; i != 90; ++i )
+			h.add( microseconds( 10 ) );
+		for( int i = 0; i != 10; ++i )
+			h.add( milliseconds( 1 ) );
+
+		ensure_or_die( 100u == h.total(), "unexpected total" );
+		ensure_or_die( milliseconds( 1 ) == h.m_max, "unexpected max" );
+		ensure_or_die( nanoseconds( 109000 ) == h.mean(), "unexpected mean" );
+
+		const auto p50 = h.percentile( 0.5 );
+		ensure_or_die( microseconds( 10 ) < p50 && p50 < microseconds( 12 ),
+				"unexpected p50" );
+		ensure_or_die( milliseconds( 1 ) == h.percentile( 0.99 ),
+				"p99 must be limited by max" );
+
+		histogram_t other{};
+		other.add( milliseconds( 5 ) );
+		h.merge( other );
+		ensure_or_die( 101u == h.total() && milliseconds( 5 ) == h.m_max,
+				"unexpected merge result" );
+	}
+
+class a_worker_t final : public so_5::agent_t
+	{
+	public :
+		a_worker_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{
+				so_subscribe_self().event< work >( [] {
+						std::this_thread::sleep_for( work_time );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( std::size_t i = 0; i != work_count; ++i )
+					so_5::send< work >( *this );
+			}
+	};
+
+class a_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_monitor_t(
+			context_t ctx,
+			const so_5::agent_t * worker,
+			std::size_t expected_count )
+			:	so_5::agent_t( ctx )
+			,	m_worker( worker )
+			,	m_expected_count( expected_count )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state().event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::evt_times );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 100 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		const so_5::agent_t * const m_worker;
+		const std::size_t m_expected_count;
+
+		void
+		evt_times( const stats::messages::event_handler_times & evt )
+			{
+				ensure_or_die(
+						stats::suffixes::event_handler_times() == evt.m_suffix,
+						"unexpected data source" );
+				ensure_or_die( so_coop_name() == evt.m_coop_name,
+						"unexpected coop name: " + evt.m_coop_name );
+				ensure_or_die( std::string{ evt.m_prefix.c_str() }.find(
+								stats::prefixes::event_handlers().c_str() ) == 0,
+						"unexpected prefix: " +
+						std::string{ evt.m_prefix.c_str() } );
+
+				if( std::type_index{ typeid(work) } != evt.m_msg_type )
+					return;
+
+				ensure_or_die( m_worker == evt.m_agent,
+						"unexpected agent in statistics" );
+
+				const auto count = evt.m_handler_time.total();
+				if( count < m_expected_count )
+					return;
+
+				ensure_or_die( m_expected_count == count,
+						"unexpected count of events: " + std::to_string( count ) );
+				ensure_or_die( m_expected_count == evt.m_queue_wait.total(),
+						"unexpected count of queue waits" );
+				ensure_or_die( work_time <= evt.m_handler_time.percentile( 0.5 ) &&
+						work_time <= evt.m_handler_time.mean(),
+						"handler time is too small" );
+				// All work messages are sent at once. So the last of them
+				// waits while the previous ones are handled.
+				ensure_or_die( work_time * (work_count - 1) <=
+						evt.m_queue_wait.m_max,
+						"queue waiting time is too small" );
+
+				so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+check_per_agent()
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.introduce_coop( []( so_5::coop_t & coop ) {
+						auto worker = coop.make_agent< a_worker_t >();
+						coop.make_agent< a_monitor_t >( worker, work_count );
+					} );
+			},
+			[]( so_5::environment_params_t & params ) {
+				params.event_handler_stats(
+						so_5::event_handler_stats_t::per_agent );
+			} );
+	}
+
+// Events are handled via execution hints on adv_thread_pool dispatcher.
+void
+check_per_agent_adv_thread_pool()
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.introduce_coop(
+					so_5::disp::adv_thread_pool::create_private_disp( env, 2 )->
+						binder( so_5::disp::adv_thread_pool::bind_params_t{} ),
+					[]( so_5::coop_t & coop ) {
+						auto worker = coop.make_agent< a_worker_t >();
+						coop.make_agent< a_monitor_t >( worker, work_count );
+					} );
+			},
+			[]( so_5::environment_params_t & params ) {
+				params.event_handler_stats(
+						so_5::event_handler_stats_t::per_agent );
+			} );
+	}
+
+void
+check_per_coop()
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.introduce_coop(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					[]( so_5::coop_t & coop ) {
+						coop.make_agent< a_worker_t >();
+						coop.make_agent< a_worker_t >();
+						coop.make_agent< a_monitor_t >( nullptr, work_count * 2 );
+					} );
+			},
+			[]( so_5::environment_params_t & params ) {
+				params.event_handler_stats(
+						so_5::event_handler_stats_t::per_coop );
+			} );
+	}
+
+class a_silent_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_silent_monitor_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event( so_environment().stats_controller().mbox(),
+						[]( const stats::messages::event_handler_times & ) {
+							throw std::runtime_error(
+									"event_handler_times is not expected" );
+						} )
+					.event( so_environment().stats_controller().mbox(),
+						[this]( const stats::messages::distribution_finished & ) {
+							if( 3 == ++m_distributions )
+								so_deregister_agent_coop_normally();
+						} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 50 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		int m_distributions = 0;
+	};
+
+void
+check_off()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop( []( so_5::coop_t & coop ) {
+						coop.make_agent< a_worker_t >();
+						coop.make_agent< a_silent_monitor_t >();
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_histogram();
+				check_per_agent();
+				check_per_agent_adv_thread_pool();
+				check_per_coop();
+				check_off();
+			},
+			20,
+			"times of event handlers" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
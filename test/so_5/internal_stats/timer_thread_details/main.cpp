@@ -0,0 +1,229 @@
+/*
+ * A test for lateness, ticks, lock holding and occupancy information
+ * from timer threads.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std::chrono;
+
+struct delayed : public so_5::message_t {};
+
+struct far_away : public so_5::message_t {};
+
+const std::size_t delayed_count = 50;
+const std::size_t far_away_count = 10;
+
+void
+check_histogram()
+	{
+		so_5::timer_lateness_histogram_t h{};
+		ensure_or_die( 0u == h.total(), "histogram must be empty" );
+		ensure_or_die( steady_clock::duration::zero() == h.percentile( 0.5 ),
+				"percentile of empty histogram must be zero" );
+
+		// 0us, [1us, 2us), [4ms, 8ms).
+		h.m_buckets[ 0 ] = 10;
+		h.m_buckets[ 1 ] = 10;
+		h.m_buckets[ 13 ] = 80;
+
+		ensure_or_die( 100u == h.total(), "unexpected total" );
+		ensure_or_die( microseconds( 1 ) == h.percentile( 0.05 ),
+				"unexpected p5" );
+		ensure_or_die( microseconds( 2 ) == h.percentile( 0.15 ),
+				"unexpected p15" );
+		ensure_or_die( microseconds( 8192 ) == h.percentile( 0.99 ),
+				"unexpected p99" );
+		ensure_or_die( steady_clock::duration::max() ==
+				so_5::timer_lateness_histogram_t::upper_border(
+						so_5::timer_lateness_histogram_t::bucket_count - 1 ),
+				"last bucket must be unlimited" );
+	}
+
+void
+do_test(
+	const std::string & name,
+	so_5::timer_thread_unique_ptr_t timer,
+	bool has_wheel )
+	{
+		so_5::wrapped_env_t env;
+		auto ch = create_mchain( env );
+
+		timer->start();
+
+		for( std::size_t i = 0; i != far_away_count; ++i )
+			timer->schedule_anonymous(
+					typeid( far_away ),
+					ch->as_mbox(),
+					so_5::message_ref_t( new far_away() ),
+					hours( 1 ),
+					hours::zero() );
+
+		for( std::size_t i = 0; i != delayed_count; ++i )
+			timer->schedule_anonymous(
+					typeid( delayed ),
+					ch->as_mbox(),
+					so_5::message_ref_t( new delayed() ),
+					milliseconds( 20 ),
+					milliseconds::zero() );
+
+		const auto r = receive(
+				from( ch ).handle_n( delayed_count )
+						.empty_timeout( seconds( 5 ) ),
+				[]( const delayed & ) {} );
+		ensure_or_die( delayed_count == r.handled(),
+				name + ": delayed messages are lost" );
+
+		const auto first = timer->query_stats();
+		ensure_or_die( delayed_count == first.m_lateness.total(),
+				name + ": unexpected count of expired timers: " +
+				std::to_string( first.m_lateness.total() ) );
+		ensure_or_die( 0u != first.m_ticks_with_expired_timers &&
+				first.m_ticks_with_expired_timers <= delayed_count,
+				name + ": unexpected count of ticks" );
+		ensure_or_die( 0u != first.m_max_expired_per_tick,
+				name + ": max count of expired timers per tick expected" );
+		ensure_or_die( steady_clock::duration::zero() < first.m_lock_hold_time,
+				name + ": time of lock holding expected" );
+		ensure_or_die(
+				first.m_max_lock_hold_time <= first.m_lock_hold_time,
+				name + ": max time of lock holding is too big" );
+		ensure_or_die( first.m_lateness.percentile( 0.5 ) < seconds( 1 ),
+				name + ": lateness is too big" );
+
+		if( has_wheel )
+			{
+				ensure_or_die( 0u != first.m_occupied_slots &&
+						first.m_occupied_slots <= far_away_count,
+						name + ": unexpected count of occupied slots: " +
+						std::to_string( first.m_occupied_slots ) );
+				ensure_or_die( 0u != first.m_max_slot_occupancy &&
+						first.m_max_slot_occupancy <= far_away_count,
+						name + ": unexpected max occupancy of slot: " +
+						std::to_string( first.m_max_slot_occupancy ) );
+			}
+		else
+			ensure_or_die( 0u == first.m_occupied_slots &&
+					0u == first.m_max_slot_occupancy,
+					name + ": occupancy is only for wheels" );
+
+		// Maximums are reset by the previous query. Counters are not.
+		const auto second = timer->query_stats();
+		ensure_or_die( first.m_lateness.total() == second.m_lateness.total(),
+				name + ": histogram must not be reset" );
+		ensure_or_die( first.m_ticks_with_expired_timers ==
+				second.m_ticks_with_expired_timers,
+				name + ": count of ticks must not be reset" );
+		ensure_or_die( 0u == second.m_max_expired_per_tick,
+				name + ": max count of expired timers per tick must be reset" );
+		ensure_or_die( first.m_occupied_slots == second.m_occupied_slots,
+				name + ": occupancy must be the same" );
+
+		timer->finish();
+	}
+
+class a_monitor_t final : public so_5::agent_t
+	{
+	public :
+		a_monitor_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state().event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::evt_lateness );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( std::size_t i = 0; i != delayed_count; ++i )
+					so_5::send_delayed< delayed >( *this, milliseconds( 10 ) );
+
+				so_environment().stats_controller().set_distribution_period(
+						milliseconds( 100 ) );
+				so_environment().stats_controller().turn_on();
+			}
+
+	private :
+		void
+		evt_lateness( const so_5::stats::messages::timer_lateness & evt )
+			{
+				namespace stats = so_5::stats;
+
+				ensure_or_die( stats::prefixes::timer_thread() == evt.m_prefix &&
+						stats::suffixes::timer_lateness() == evt.m_suffix,
+						"unexpected data source" );
+
+				if( delayed_count <= evt.m_histogram.total() )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+check_stats_controller()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop( []( so_5::coop_t & coop ) {
+						coop.make_agent< a_monitor_t >();
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_histogram();
+
+				do_test( "wheel",
+						so_5::create_timer_wheel_thread(
+								so_5::create_stderr_logger() ),
+						true );
+				do_test( "list",
+						so_5::create_timer_list_thread(
+								so_5::create_stderr_logger() ),
+						false );
+				do_test( "heap",
+						so_5::create_timer_heap_thread(
+								so_5::create_stderr_logger() ),
+						false );
+				do_test( "hwheel",
+						so_5::create_timer_hwheel_thread(
+								so_5::create_stderr_logger() ),
+						true );
+				do_test( "sharded",
+						so_5::create_sharded_timer_thread(
+								so_5::create_stderr_logger(), 2,
+								so_5::timer_wheel_factory() ),
+						true );
+
+				check_stats_controller();
+			},
+			60,
+			"details of timer thread monitoring" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
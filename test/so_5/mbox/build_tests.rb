@@ -15,4 +15,7 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/hanging_subscriptions/prj.ut.rb" )
 	required_prj( "#{path}/delivery_filters/build_tests.rb" )
 	required_prj( "#{path}/local_mbox_growth/prj.ut.rb" )
+	required_prj( "#{path}/routing_mbox/prj.ut.rb" )
+	required_prj( "#{path}/topic_mbox/prj.ut.rb" )
+	required_prj( "#{path}/last_value_mbox/prj.ut.rb" )
 }
@@ -0,0 +1,164 @@
+/*
+ * A simple test for last-value-cache mbox.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct data { int m_value; };
+
+struct tick : public so_5::signal_t {};
+
+struct finish : public so_5::signal_t {};
+
+struct done : public so_5::signal_t {};
+
+class a_receiver_t : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t lvc_mbox,
+		so_5::mbox_t control_mbox,
+		bool odd_only,
+		std::string expected )
+		:	so_5::agent_t( ctx )
+		,	m_lvc_mbox( std::move(lvc_mbox) )
+		,	m_control_mbox( std::move(control_mbox) )
+		,	m_odd_only( odd_only )
+		,	m_expected( std::move(expected) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		if( m_odd_only )
+			so_set_delivery_filter( m_lvc_mbox, []( const data & msg ) {
+					return 1 == msg.m_value % 2;
+				} );
+
+		so_default_state()
+			.event( m_lvc_mbox, [this]( const data & msg ) {
+				m_accumulator += "[" + std::to_string( msg.m_value ) + "]";
+			} )
+			.event< tick >( m_lvc_mbox, [this] {
+				m_accumulator += "[tick]";
+			} )
+			.event< finish >( m_control_mbox, [this] {
+				if( m_expected != m_accumulator )
+					throw std::runtime_error( "unexpected accumulator value: " +
+							m_accumulator + ", expected: " + m_expected );
+
+				so_5::send< done >( m_control_mbox );
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		m_accumulator += "[start]";
+	}
+
+private :
+	const so_5::mbox_t m_lvc_mbox;
+	const so_5::mbox_t m_control_mbox;
+	const bool m_odd_only;
+	const std::string m_expected;
+
+	std::string m_accumulator;
+};
+
+class a_controller_t : public so_5::agent_t
+{
+public :
+	a_controller_t(
+		context_t ctx,
+		so_5::mbox_t lvc_mbox,
+		so_5::mbox_t control_mbox,
+		unsigned int receivers )
+		:	so_5::agent_t( ctx )
+		,	m_lvc_mbox( std::move(lvc_mbox) )
+		,	m_control_mbox( std::move(control_mbox) )
+		,	m_receivers( receivers )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state().event< done >( m_control_mbox, [this] {
+				if( 0 == --m_receivers )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< data >( m_lvc_mbox, 3 );
+
+		// The last value must be received right after the subscription.
+		so_subscribe( m_lvc_mbox ).event( [this]( const data & msg ) {
+				ensure( 3 == msg.m_value, "value 3 is expected, got: " +
+						std::to_string( msg.m_value ) );
+
+				so_5::send< finish >( m_control_mbox );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_lvc_mbox;
+	const so_5::mbox_t m_control_mbox;
+	unsigned int m_receivers;
+};
+
+void
+init( so_5::environment_t & env )
+{
+	auto lvc_mbox = env.create_last_value_mbox();
+	auto control_mbox = env.create_mbox();
+
+	// There are no subscribers yet. But the last values must be stored.
+	so_5::send< data >( lvc_mbox, 1 );
+	so_5::send< data >( lvc_mbox, 2 );
+	so_5::send< tick >( lvc_mbox );
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+		coop.make_agent< a_controller_t >( lvc_mbox, control_mbox, 2u );
+
+		coop.make_agent< a_receiver_t >( lvc_mbox, control_mbox, false,
+				"[start][2][tick][3]" );
+
+		// Value 2 must be rejected by delivery filter.
+		coop.make_agent< a_receiver_t >( lvc_mbox, control_mbox, true,
+				"[start][tick][3]" );
+	} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"last value mbox test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
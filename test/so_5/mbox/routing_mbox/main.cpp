@@ -0,0 +1,319 @@
+/*
+ * A simple test for content-based routing mbox.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct data { int m_key; };
+
+struct finish : public so_5::signal_t {};
+
+struct done : public so_5::signal_t {};
+
+using filter_maker_t = std::function< void(so_5::agent_t &, const so_5::mbox_t &) >;
+
+class a_receiver_t : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t data_mbox,
+		so_5::mbox_t done_mbox,
+		filter_maker_t filter_maker,
+		std::string expected )
+		:	so_5::agent_t( ctx )
+		,	m_data_mbox( std::move(data_mbox) )
+		,	m_done_mbox( std::move(done_mbox) )
+		,	m_filter_maker( std::move(filter_maker) )
+		,	m_expected( std::move(expected) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		if( m_filter_maker )
+			m_filter_maker( *this, m_data_mbox );
+
+		so_default_state()
+			.event( m_data_mbox, [this]( const data & msg ) {
+				m_accumulator += std::to_string( msg.m_key );
+			} )
+			.event< finish >( m_data_mbox, [this] {
+				if( m_expected != m_accumulator )
+					throw std::runtime_error( "unexpected accumulator value: " +
+							m_accumulator + ", expected: " + m_expected );
+
+				so_5::send< done >( m_done_mbox );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_data_mbox;
+	const so_5::mbox_t m_done_mbox;
+	const filter_maker_t m_filter_maker;
+	const std::string m_expected;
+
+	std::string m_accumulator;
+};
+
+class a_sender_t : public so_5::agent_t
+{
+public :
+	a_sender_t(
+		context_t ctx,
+		so_5::mbox_t data_mbox,
+		unsigned int receivers )
+		:	so_5::agent_t( ctx )
+		,	m_data_mbox( std::move(data_mbox) )
+		,	m_receivers( receivers )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state().event< done >( [this] {
+				if( 0 == --m_receivers )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		for( int i = 0; i != 10; ++i )
+			so_5::send< data >( m_data_mbox, i );
+
+		so_5::send< finish >( m_data_mbox );
+	}
+
+private :
+	const so_5::mbox_t m_data_mbox;
+	unsigned int m_receivers;
+};
+
+void
+init( so_5::environment_t & env )
+{
+	auto mbox = env.create_routing_mbox(
+			so_5::routing::mbox_params_t{}.key_extractor(
+				[]( const data & msg ) { return msg.m_key; } ) );
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+		auto sender = coop.make_agent< a_sender_t >( mbox, 6u );
+
+		auto make_receiver = [&]( filter_maker_t maker, std::string expected ) {
+			coop.make_agent< a_receiver_t >(
+					mbox, sender->so_direct_mbox(),
+					std::move(maker), std::move(expected) );
+		};
+
+		// Without filter.
+		make_receiver( filter_maker_t{}, "0123456789" );
+
+		// Equality filters.
+		make_receiver( []( so_5::agent_t & a, const so_5::mbox_t & m ) {
+				a.so_set_delivery_filter< data >( m, so_5::routing::key_equal( 3 ) );
+			}, "3" );
+		make_receiver( []( so_5::agent_t & a, const so_5::mbox_t & m ) {
+				a.so_set_delivery_filter< data >( m, so_5::routing::key_equal( 3 ) );
+			}, "3" );
+
+		// Range filters.
+		make_receiver( []( so_5::agent_t & a, const so_5::mbox_t & m ) {
+				a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 2, 5 ) );
+			}, "2345" );
+		make_receiver( []( so_5::agent_t & a, const so_5::mbox_t & m ) {
+				a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 4, 100 ) );
+			}, "456789" );
+
+		// Ordinary filter.
+		make_receiver( []( so_5::agent_t & a, const so_5::mbox_t & m ) {
+				a.so_set_delivery_filter( m, []( const data & msg ) {
+						return 0 == msg.m_key % 2;
+					} );
+			}, "02468" );
+	} );
+}
+
+struct check : public so_5::signal_t {};
+
+class a_logger_t : public so_5::agent_t
+{
+public :
+	a_logger_t(
+		context_t ctx,
+		so_5::priority_t priority,
+		so_5::mbox_t data_mbox,
+		std::string & log,
+		std::string name,
+		filter_maker_t filter_maker )
+		:	so_5::agent_t( ctx + priority )
+		,	m_data_mbox( std::move(data_mbox) )
+		,	m_log( log )
+		,	m_name( std::move(name) )
+		,	m_filter_maker( std::move(filter_maker) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		if( m_filter_maker )
+			m_filter_maker( *this, m_data_mbox );
+
+		so_default_state().event( m_data_mbox, [this]( const data & ) {
+				m_log += m_name;
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_data_mbox;
+	std::string & m_log;
+	const std::string m_name;
+	const filter_maker_t m_filter_maker;
+};
+
+// All agents work on the same thread. So the order of events in the log
+// is the order of delivery.
+void
+check_delivery_order()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+		auto mbox = env.create_routing_mbox(
+				so_5::routing::mbox_params_t{}.key_extractor(
+					[]( const data & msg ) { return msg.m_key; } ) );
+
+		env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			auto log = std::make_shared< std::string >();
+
+			auto make_logger = [&](
+					so_5::priority_t priority,
+					std::string name,
+					filter_maker_t maker ) {
+				coop.make_agent< a_logger_t >(
+						priority, mbox, *log, std::move(name), std::move(maker) );
+			};
+
+			make_logger( so_5::prio::p1, "a", filter_maker_t{} );
+			make_logger( so_5::prio::p3, "b",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter( m, []( const data & ) {
+							return true;
+						} );
+				} );
+			make_logger( so_5::prio::p2, "c",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_equal( 5 ) );
+				} );
+			make_logger( so_5::prio::p4, "d",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 0, 9 ) );
+				} );
+			// Filters are changed and dropped after subscription.
+			make_logger( so_5::prio::p5, "e",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 0, 9 ) );
+					a.so_subscribe( m ).event( []( const data & ) {} );
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 5, 6 ) );
+					a.so_drop_subscription< data >( m );
+				} );
+			make_logger( so_5::prio::p6, "f",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_range( 0, 3 ) );
+					a.so_drop_delivery_filter< data >( m );
+				} );
+			make_logger( so_5::prio::p7, "g",
+				[]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					a.so_set_delivery_filter< data >( m, so_5::routing::key_equal( 5 ) );
+					a.so_set_delivery_filter< data >( m,
+							so_5::routing::key_range( 100, 200 ) );
+				} );
+
+			auto checker = coop.define_agent();
+			checker
+				.on_start( [mbox, checker] {
+					so_5::send< data >( mbox, 5 );
+					so_5::send< data >( mbox, 1 );
+					so_5::send< check >( checker );
+				} )
+				.event< check >( checker, [log, &env] {
+					ensure( "fedbca" "fdba" == *log,
+							"unexpected delivery order: " + *log );
+					env.stop();
+				} );
+		} );
+	} );
+}
+
+void
+check_errors()
+{
+	bool extractor_not_found = false;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		auto mbox = env.create_routing_mbox( so_5::routing::mbox_params_t{} );
+
+		env.register_agent_as_coop( so_5::autoname,
+			env.make_agent< a_receiver_t >(
+				mbox, mbox,
+				[&]( so_5::agent_t & a, const so_5::mbox_t & m ) {
+					try
+					{
+						a.so_set_delivery_filter< data >( m, so_5::routing::key_equal( 1 ) );
+					}
+					catch( const so_5::exception_t & x )
+					{
+						extractor_not_found =
+								so_5::rc_routing_key_extractor_not_found == x.error_code();
+					}
+				},
+				std::string{} ) );
+
+		env.stop();
+	} );
+
+	ensure( extractor_not_found, "rc_routing_key_extractor_not_found is expected" );
+
+	bool invalid_range = false;
+	try
+	{
+		so_5::routing::key_range( 10, 1 );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		invalid_range = so_5::rc_invalid_routing_key_range == x.error_code();
+	}
+	ensure( invalid_range, "rc_invalid_routing_key_range is expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+				check_delivery_order();
+			},
+			20,
+			"routing mbox test" );
+
+		check_errors();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * A simple test for mboxes with hierarchical topics.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+struct data { std::string m_topic; };
+
+struct finish : public so_5::signal_t {};
+
+struct done : public so_5::signal_t {};
+
+class a_receiver_t : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::topics::space_ref_t space,
+		std::string pattern,
+		so_5::mbox_t done_mbox,
+		std::string expected )
+		:	so_5::agent_t( ctx )
+		,	m_space( std::move(space) )
+		,	m_pattern( std::move(pattern) )
+		,	m_done_mbox( std::move(done_mbox) )
+		,	m_expected( std::move(expected) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state()
+			.event( m_space->mbox( m_pattern ), [this]( const data & msg ) {
+				m_accumulator += "[" + msg.m_topic + "]";
+			} )
+			.event< finish >( m_space->mbox( "control" ), [this] {
+				if( m_expected != m_accumulator )
+					throw std::runtime_error( m_pattern +
+							": unexpected accumulator value: " +
+							m_accumulator + ", expected: " + m_expected );
+
+				so_5::send< done >( m_done_mbox );
+			} );
+	}
+
+private :
+	const so_5::topics::space_ref_t m_space;
+	const std::string m_pattern;
+	const so_5::mbox_t m_done_mbox;
+	const std::string m_expected;
+
+	std::string m_accumulator;
+};
+
+class a_sender_t : public so_5::agent_t
+{
+public :
+	a_sender_t(
+		context_t ctx,
+		so_5::topics::space_ref_t space,
+		unsigned int receivers )
+		:	so_5::agent_t( ctx )
+		,	m_space( std::move(space) )
+		,	m_receivers( receivers )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state().event< done >( [this] {
+				if( 0 == --m_receivers )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		const std::vector< std::string > topics{
+			"md.eq.AAPL.trade",
+			"md.eq.AAPL.quote",
+			"md.eq.MSFT.trade",
+			"md.fx.EURUSD.trade",
+			"md",
+			"md.eq.AAPL.trade"
+		};
+
+		for( const auto & t : topics )
+			so_5::send< data >( m_space->mbox( t ), t );
+
+		so_5::send< finish >( m_space->mbox( "control" ) );
+	}
+
+private :
+	const so_5::topics::space_ref_t m_space;
+	unsigned int m_receivers;
+};
+
+void
+init( so_5::environment_t & env )
+{
+	auto space = env.create_topic_space();
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+		auto sender = coop.make_agent< a_sender_t >( space, 6u );
+
+		auto make_receiver = [&]( std::string pattern, std::string expected ) {
+			coop.make_agent< a_receiver_t >(
+					space, std::move(pattern), sender->so_direct_mbox(),
+					std::move(expected) );
+		};
+
+		make_receiver( "md.eq.AAPL.trade",
+				"[md.eq.AAPL.trade][md.eq.AAPL.trade]" );
+		make_receiver( "md.eq.*.trade",
+				"[md.eq.AAPL.trade][md.eq.MSFT.trade][md.eq.AAPL.trade]" );
+		make_receiver( "md.*.*.trade",
+				"[md.eq.AAPL.trade][md.eq.MSFT.trade][md.fx.EURUSD.trade]"
+				"[md.eq.AAPL.trade]" );
+		make_receiver( "md.eq.#",
+				"[md.eq.AAPL.trade][md.eq.AAPL.quote][md.eq.MSFT.trade]"
+				"[md.eq.AAPL.trade]" );
+		make_receiver( "md.#",
+				"[md.eq.AAPL.trade][md.eq.AAPL.quote][md.eq.MSFT.trade]"
+				"[md.fx.EURUSD.trade][md][md.eq.AAPL.trade]" );
+		make_receiver( "*.fx.#", "[md.fx.EURUSD.trade]" );
+	} );
+}
+
+void
+check_invalid_name( const std::string & name )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		auto space = env.create_topic_space();
+
+		bool thrown = false;
+		try
+		{
+			space->mbox( name );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			thrown = so_5::rc_invalid_topic_name == x.error_code();
+		}
+
+		ensure( thrown, "rc_invalid_topic_name is expected for '" + name + "'" );
+
+		env.stop();
+	} );
+}
+
+void
+check_errors()
+{
+	for( const char * name :
+			{ "", ".", "a..b", "a.", ".a", "a.b*", "a.#.b", "a.#b" } )
+		check_invalid_name( name );
+
+	so_5::launch( []( so_5::environment_t & env ) {
+		auto space = env.create_topic_space();
+
+		ensure( space->mbox( "a.b" )->id() == space->mbox( "a.b" )->id(),
+				"mboxes for the same name must have the same id" );
+		ensure( 1u == space->size(), "only one name is expected" );
+
+		bool thrown = false;
+		try
+		{
+			so_5::send< data >( space->mbox( "a.*" ), "a.*" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			thrown = so_5::rc_topic_pattern_cannot_be_published == x.error_code();
+		}
+		ensure( thrown, "rc_topic_pattern_cannot_be_published is expected" );
+
+		env.stop();
+	} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"topic mbox test" );
+
+		check_errors();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
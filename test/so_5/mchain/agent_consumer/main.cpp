@@ -0,0 +1,154 @@
+/*
+ * A test for consumption of mchains by mchain_consumer agents
+ * on a thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+struct data { int m_value; };
+
+struct reset : public so_5::signal_t {};
+
+struct consumer_stats
+{
+	atomic< int > m_sum{ 0 };
+	atomic< int > m_resets{ 0 };
+	atomic< int > m_closed{ 0 };
+};
+
+void
+check_consumption(
+	const string & case_name,
+	so_5::mchain_params_t params )
+{
+	const size_t chains_count = 100;
+	const int messages_count = 50;
+
+	consumer_stats stats;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		vector< so_5::mchain_t > chains;
+		for( size_t i = 0; i != chains_count; ++i )
+			chains.push_back( env.create_mchain( params ) );
+
+		env.introduce_coop(
+			so_5::disp::thread_pool::create_private_disp( env, 3 )->binder(
+				so_5::disp::thread_pool::bind_params_t{} ),
+			[&]( so_5::coop_t & coop ) {
+				auto coop_name = coop.query_coop_name();
+				for( const auto & ch : chains )
+					coop.make_agent< so_5::mchain_consumer_t >(
+						ch,
+						so_5::mchain_consumer_params_t{}
+							.batch_size( 4 )
+							.on_close( [&env, &stats, coop_name, chains_count](
+									const so_5::mchain_t & ) {
+								if( chains_count == static_cast< size_t >(
+										++stats.m_closed ) )
+									env.deregister_coop(
+											coop_name,
+											so_5::dereg_reason::normal );
+							} ),
+						[&stats]( const data & d ) { stats.m_sum += d.m_value; },
+						[&stats]( so_5::mhood_t< reset > ) { ++stats.m_resets; } );
+			} );
+
+		for( int i = 1; i <= messages_count; ++i )
+			for( const auto & ch : chains )
+				so_5::send< data >( ch, i );
+
+		for( const auto & ch : chains )
+		{
+			so_5::send< reset >( ch );
+			so_5::close_retain_content( ch );
+		}
+	} );
+
+	const int expected_sum = static_cast< int >( chains_count ) *
+			messages_count * ( messages_count + 1 ) / 2;
+
+	ensure_or_die( expected_sum == stats.m_sum,
+			case_name + ": unexpected sum: " + to_string( stats.m_sum ) +
+			", expected: " + to_string( expected_sum ) );
+	ensure_or_die( static_cast< int >( chains_count ) == stats.m_resets,
+			case_name + ": unexpected resets: " + to_string( stats.m_resets ) );
+}
+
+void
+check_exception()
+{
+	int handled = 0;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		auto ch = env.create_mchain( so_5::make_unlimited_mchain_params() );
+
+		env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			coop.set_exception_reaction( so_5::ignore_exception );
+
+			auto coop_name = coop.query_coop_name();
+			coop.make_agent< so_5::mchain_consumer_t >(
+				ch,
+				so_5::mchain_consumer_params_t{}
+					.on_close( [&env, coop_name]( const so_5::mchain_t & ) {
+						env.deregister_coop(
+								coop_name, so_5::dereg_reason::normal );
+					} ),
+				[&handled]( const data & d ) {
+					++handled;
+					if( 2 == d.m_value )
+						throw runtime_error( "value 2 is not allowed" );
+				} );
+		} );
+
+		for( int i = 1; i <= 5; ++i )
+			so_5::send< data >( ch, i );
+		so_5::close_retain_content( ch );
+	} );
+
+	ensure_or_die( 5 == handled,
+			"consumption must be continued after exception, handled: " +
+			to_string( handled ) );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_consumption( "unlimited",
+						so_5::make_unlimited_mchain_params() );
+				check_consumption( "unlimited(batched)",
+						so_5::make_unlimited_mchain_params()
+							.extraction_batch_size( 16 ) );
+				check_consumption( "limited",
+						so_5::make_limited_with_waiting_mchain_params(
+								10,
+								so_5::mchain_props::memory_usage_t::preallocated,
+								so_5::mchain_props::overflow_reaction_t::throw_exception,
+								chrono::seconds( 5 ) ) );
+
+				check_exception();
+			},
+			60,
+			"mchain consumption by agents" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * A test for batched extraction of messages from mchains.
+ */
+
+#include <so_5/all.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include "../mchain_params.hpp"
+
+using namespace std;
+
+void
+do_check_receive_limits(
+	const string & case_name,
+	so_5::mchain_params_t params )
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			params.extraction_batch_size( 3 ) );
+
+	for( int i = 0; i != 5; ++i )
+		so_5::send< int >( ch, i );
+
+	int expected = 0;
+	auto handler = [&]( int v ) {
+		ensure_or_die( expected == v, case_name + ": unexpected value: " +
+				to_string( v ) + ", expected: " + to_string( expected ) );
+		++expected;
+	};
+
+	auto r = receive( from( ch ).handle_n( 4 ).no_wait_on_empty(), handler );
+	ensure_or_die( 4 == r.handled(), case_name + ": 4 handled messages expected" );
+	ensure_or_die( 1 == ch->size(), case_name + ": 1 message must be in chain" );
+
+	so_5::send< int >( ch, 5 );
+	so_5::send< std::string >( ch, "six" );
+	so_5::send< int >( ch, 6 );
+
+	r = receive( from( ch ).extract_n( 2 ).no_wait_on_empty(), handler );
+	ensure_or_die( 2 == r.extracted(),
+			case_name + ": 2 extracted messages expected" );
+	ensure_or_die( 2 == ch->size(), case_name + ": 2 messages must be in chain" );
+
+	r = receive( from( ch ).handle_n( 2 ).no_wait_on_empty(), handler );
+	ensure_or_die( 2 == r.extracted() && 1 == r.handled(),
+			case_name + ": 2 extracted and 1 handled messages expected" );
+	ensure_or_die( 7 == expected, case_name + ": all values must be handled" );
+}
+
+void
+check_receive_limits()
+{
+	for( auto & p : build_mchain_params() )
+		do_check_receive_limits( p.first, p.second );
+}
+
+void
+check_select_limits()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch1 = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params().extraction_batch_size( 10 ) );
+	auto ch2 = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params().extraction_batch_size( 10 ) );
+
+	for( int i = 0; i != 5; ++i )
+	{
+		so_5::send< int >( ch1, i );
+		so_5::send< int >( ch2, i );
+	}
+
+	int handled = 0;
+	auto r = so_5::select( so_5::from_all().handle_n( 7 ).no_wait_on_empty(),
+			case_( ch1, [&handled]( int ) { ++handled; } ),
+			case_( ch2, [&handled]( int ) { ++handled; } ) );
+
+	ensure_or_die( 7 == r.handled() && 7 == handled,
+			"7 handled messages expected" );
+	ensure_or_die( 3 == ch1->size() + ch2->size(),
+			"3 messages must be left in chains" );
+}
+
+struct test_exception : public std::runtime_error
+{
+	test_exception() : std::runtime_error( "test exception" ) {}
+};
+
+// Handler for 1 fills the chain and throws.
+// The rest of the batch must be returned to the chain.
+template< typename RECEIVE >
+void
+do_check_exception_in_handler(
+	const string & case_name,
+	so_5::mchain_params_t params,
+	RECEIVE && receive_func )
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			params.extraction_batch_size( 3 ) );
+
+	for( int i = 0; i != 5; ++i )
+		so_5::send< int >( ch, i );
+
+	string result;
+	auto handler = [&]( int v ) {
+		result += "[" + to_string( v ) + "]";
+		if( 1 == v )
+		{
+			for( int i = 5; i != 8; ++i )
+				so_5::send< int >( ch, i );
+			throw test_exception{};
+		}
+	};
+
+	bool thrown = false;
+	try
+	{
+		receive_func( ch, handler );
+	}
+	catch( const test_exception & )
+	{
+		thrown = true;
+	}
+
+	ensure_or_die( thrown, case_name + ": exception expected" );
+	ensure_or_die( "[0][1]" == result,
+			case_name + ": unexpected result: " + result );
+	ensure_or_die( 6 == ch->size(), case_name + ": 6 messages must be in chain, "
+			"actual: " + to_string( ch->size() ) );
+
+	result.clear();
+	receive( from( ch ).no_wait_on_empty(),
+			[&result]( int v ) { result += "[" + to_string( v ) + "]"; } );
+	ensure_or_die( "[2][3][4][5][6][7]" == result,
+			case_name + ": unexpected result after exception: " + result );
+}
+
+void
+check_exception_in_handler()
+{
+	for( auto & p : build_mchain_params() )
+	{
+		do_check_exception_in_handler( p.first + "(receive)", p.second,
+			[]( const so_5::mchain_t & ch, std::function< void(int) > handler ) {
+				receive( from( ch ).no_wait_on_empty(), handler );
+			} );
+
+		do_check_exception_in_handler( p.first + "(select)", p.second,
+			[]( const so_5::mchain_t & ch, std::function< void(int) > handler ) {
+				so_5::select( so_5::from_all().no_wait_on_empty(),
+						case_( ch, handler ) );
+			} );
+	}
+}
+
+void
+check_producer_wakeup()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_limited_with_waiting_mchain_params(
+					4,
+					so_5::mchain_props::memory_usage_t::preallocated,
+					so_5::mchain_props::overflow_reaction_t::throw_exception,
+					chrono::seconds( 5 ) )
+				.extraction_batch_size( 4 ) );
+
+	const int total = 1000;
+
+	thread producer{ [ch] {
+			for( int i = 0; i != total; ++i )
+				so_5::send< int >( ch, i );
+		} };
+
+	int expected = 0;
+	auto r = receive( from( ch ).handle_n( total ),
+			[&expected]( int v ) {
+				ensure_or_die( expected == v, "unexpected value: " +
+						to_string( v ) + ", expected: " + to_string( expected ) );
+				++expected;
+			} );
+
+	producer.join();
+
+	ensure_or_die( total == static_cast< int >( r.handled() ),
+			"all messages must be handled" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_receive_limits();
+				check_select_limits();
+				check_exception_in_handler();
+				check_producer_wakeup();
+			},
+			20,
+			"batched extraction" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -17,6 +17,13 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/not_empty_notify/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive_close/prj.ut.rb" )
+	required_prj( "#{path}/batched_extraction/prj.ut.rb" )
+	required_prj( "#{path}/lock_free_chain/prj.ut.rb" )
+	required_prj( "#{path}/priority_lanes/prj.ut.rb" )
+	required_prj( "#{path}/conflation/prj.ut.rb" )
+	required_prj( "#{path}/agent_consumer/prj.ut.rb" )
+	required_prj( "#{path}/spill_to_disk/prj.ut.rb" )
+	required_prj( "#{path}/stats/prj.ut.rb" )
 
 	required_prj( "#{path}/select_simple/prj.ut.rb" )
 	required_prj( "#{path}/prepared_select_simple/prj.ut.rb" )
@@ -0,0 +1,281 @@
+/*
+ * A test for conflation of messages in mchains.
+ */
+
+#include <so_5/all.hpp>
+
+#include <string>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+struct quote
+{
+	string m_ticker;
+	int m_price;
+};
+
+struct data { int m_value; };
+
+struct tick : public so_5::signal_t {};
+
+struct ask : public so_5::signal_t {};
+
+struct order
+{
+	int m_id;
+	string m_state;
+};
+
+struct position
+{
+	int m_row;
+	int m_column;
+	string m_value;
+};
+
+struct cell
+{
+	int m_row;
+	int m_column;
+
+	bool
+	operator==( const cell & o ) const
+	{
+		return m_row == o.m_row && m_column == o.m_column;
+	}
+};
+
+namespace std
+{
+
+// Bad hash function: different cells in the same row have the same hash.
+template<>
+struct hash< cell >
+{
+	size_t
+	operator()( const cell & c ) const
+	{
+		return hash< int >{}( c.m_row );
+	}
+};
+
+} /* namespace std */
+
+string
+collect( const so_5::mchain_t & ch )
+{
+	string result;
+	receive( from( ch ).no_wait_on_empty(),
+			[&result]( const quote & q ) {
+				result += "[" + q.m_ticker + ":" + to_string( q.m_price ) + "]";
+			},
+			[&result]( const data & d ) {
+				result += "[" + to_string( d.m_value ) + "]";
+			},
+			[&result]( so_5::mhood_t< tick > ) {
+				result += "[tick]";
+			} );
+	return result;
+}
+
+so_5::mchain_params_t
+setup( so_5::mchain_params_t params )
+{
+	return params
+		.conflate< tick >()
+		.conflate< data >()
+		.conflate< quote >( []( const quote & q ) { return q.m_ticker; } );
+}
+
+void
+check_conflation(
+	const string & case_name,
+	so_5::mchain_params_t params )
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain( setup( params ) );
+
+	so_5::send< data >( ch, 1 );
+	so_5::send< quote >( ch, "A", 1 );
+	so_5::send< tick >( ch );
+	so_5::send< quote >( ch, "B", 1 );
+	so_5::send< data >( ch, 2 );
+	so_5::send< tick >( ch );
+	so_5::send< quote >( ch, "A", 2 );
+	so_5::send< quote >( ch, "A", 3 );
+
+	ensure_or_die( 4u == ch->size(),
+			case_name + ": 4 messages expected in chain, actual: " +
+			to_string( ch->size() ) );
+
+	auto r = collect( ch );
+	ensure_or_die( "[2][A:3][tick][B:1]" == r,
+			case_name + ": unexpected content: " + r );
+
+	// After extraction new messages must be stored as usual.
+	so_5::send< data >( ch, 3 );
+	so_5::send< data >( ch, 4 );
+	so_5::send< quote >( ch, "A", 4 );
+
+	r = collect( ch );
+	ensure_or_die( "[4][A:4]" == r,
+			case_name + ": unexpected content: " + r );
+}
+
+void
+check_full_chain()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			setup( so_5::make_limited_without_waiting_mchain_params(
+					2,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception )
+				.consumers( props::multiplicity_t::single ) ) );
+
+	so_5::send< data >( ch, 1 );
+	so_5::send< quote >( ch, "A", 1 );
+
+	// There must be no overflow because old messages are replaced.
+	so_5::send< data >( ch, 2 );
+	so_5::send< quote >( ch, "A", 2 );
+
+	bool thrown = false;
+	try
+	{
+		so_5::send< quote >( ch, "B", 1 );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_msg_chain_overflow == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_msg_chain_overflow expected" );
+
+	const auto r = collect( ch );
+	ensure_or_die( "[2][A:2]" == r, "unexpected content: " + r );
+}
+
+void
+check_remove_oldest()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			setup( so_5::make_limited_without_waiting_mchain_params(
+					2,
+					props::memory_usage_t::dynamic,
+					props::overflow_reaction_t::remove_oldest ) ) );
+
+	so_5::send< quote >( ch, "A", 1 );
+	so_5::send< quote >( ch, "B", 1 );
+	// quote A must be removed.
+	so_5::send< quote >( ch, "C", 1 );
+	// New quote A must be stored as a new message.
+	so_5::send< quote >( ch, "A", 2 );
+	so_5::send< quote >( ch, "A", 3 );
+
+	const auto r = collect( ch );
+	ensure_or_die( "[C:1][A:3]" == r, "unexpected content: " + r );
+}
+
+void
+check_svc_requests()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params().conflate< ask >() );
+
+	auto f1 = so_5::request_future< int, ask >( ch );
+	auto f2 = so_5::request_future< int, ask >( ch );
+
+	ensure_or_die( 2u == ch->size(), "service requests must not be conflated" );
+
+	int counter = 0;
+	receive( from( ch ).no_wait_on_empty(),
+			[&counter]( so_5::mhood_t< ask > ) { return ++counter; } );
+
+	ensure_or_die( 1 == f1.get(), "1 expected as the first reply" );
+	ensure_or_die( 2 == f2.get(), "2 expected as the second reply" );
+}
+
+void
+check_key_types()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params()
+				.conflate< order >( []( const order & o ) { return o.m_id; } )
+				.conflate< position >( []( const position & p ) {
+						return cell{ p.m_row, p.m_column };
+					} ) );
+
+	so_5::send< order >( ch, 1, "new" );
+	so_5::send< position >( ch, 0, 0, "a" );
+	so_5::send< order >( ch, 2, "new" );
+	so_5::send< position >( ch, 0, 1, "b" );
+	so_5::send< order >( ch, 1, "filled" );
+	so_5::send< position >( ch, 0, 0, "c" );
+
+	string r;
+	receive( from( ch ).no_wait_on_empty(),
+			[&r]( const order & o ) {
+				r += "[" + to_string( o.m_id ) + ":" + o.m_state + "]";
+			},
+			[&r]( const position & p ) {
+				r += "[" + to_string( p.m_row ) + "," + to_string( p.m_column ) +
+						":" + p.m_value + "]";
+			} );
+	ensure_or_die( "[1:filled][0,0:c][2:new][0,1:b]" == r,
+			"unexpected content: " + r );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_conflation( "unlimited",
+						so_5::make_unlimited_mchain_params() );
+				check_conflation( "limited(dynamic)",
+						so_5::make_limited_without_waiting_mchain_params(
+								10,
+								props::memory_usage_t::dynamic,
+								props::overflow_reaction_t::drop_newest ) );
+				check_conflation( "limited(preallocated)",
+						so_5::make_limited_without_waiting_mchain_params(
+								10,
+								props::memory_usage_t::preallocated,
+								props::overflow_reaction_t::drop_newest ) );
+				check_conflation( "priority",
+						so_5::make_unlimited_mchain_params()
+							.priority_lane( so_5::prio::p0, props::capacity_t{} )
+							.priority_lane( so_5::prio::p1, props::capacity_t{} ) );
+
+				check_full_chain();
+				check_remove_oldest();
+				check_svc_requests();
+				check_key_types();
+			},
+			20,
+			"mchain conflation" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * A test for mchains with lock-free ring buffer.
+ */
+
+#include <so_5/all.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+so_5::mchain_params_t
+lock_free_params(
+	props::multiplicity_t producers,
+	so_5::mchain_params_t params )
+{
+	params.producers( producers ).consumers( props::multiplicity_t::single );
+	return params;
+}
+
+void
+check_stream( props::multiplicity_t producers, unsigned int producers_count )
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain( lock_free_params( producers,
+			so_5::make_limited_with_waiting_mchain_params(
+					8,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					chrono::seconds( 5 ) ) ) );
+
+	const unsigned int values = 20000;
+
+	vector< thread > threads;
+	for( unsigned int p = 0; p != producers_count; ++p )
+		threads.emplace_back( [ch, p] {
+				for( unsigned int i = 0; i != values; ++i )
+					so_5::send< pair< unsigned int, unsigned int > >( ch, p, i );
+			} );
+
+	vector< unsigned int > expected( producers_count, 0u );
+	auto r = receive( from( ch ).handle_n( values * producers_count ),
+			[&expected]( const pair< unsigned int, unsigned int > & v ) {
+				ensure_or_die( expected[ v.first ] == v.second,
+						"unexpected value: " + to_string( v.second ) +
+						", expected: " + to_string( expected[ v.first ] ) );
+				++expected[ v.first ];
+			} );
+
+	for( auto & t : threads )
+		t.join();
+
+	ensure_or_die( values * producers_count == r.handled(),
+			"all values must be handled" );
+	ensure_or_die( ch->empty(), "chain must be empty" );
+}
+
+void
+check_overflow_reactions()
+{
+	so_5::wrapped_env_t env;
+
+	auto make_chain = [&]( props::overflow_reaction_t reaction ) {
+		return env.environment().create_mchain( lock_free_params(
+				props::multiplicity_t::single,
+				so_5::make_limited_without_waiting_mchain_params(
+						3,
+						props::memory_usage_t::preallocated,
+						reaction ) ) );
+	};
+
+	auto collect = []( const so_5::mchain_t & ch ) {
+		string result;
+		receive( from( ch ).no_wait_on_empty(),
+				[&result]( int v ) { result += to_string( v ); } );
+		return result;
+	};
+
+	auto ch = make_chain( props::overflow_reaction_t::drop_newest );
+	for( int i = 0; i != 5; ++i )
+		so_5::send< int >( ch, i );
+	ensure_or_die( "012" == collect( ch ), "drop_newest: 012 expected" );
+
+	ch = make_chain( props::overflow_reaction_t::remove_oldest );
+	for( int i = 0; i != 5; ++i )
+		so_5::send< int >( ch, i );
+	ensure_or_die( "234" == collect( ch ), "remove_oldest: 234 expected" );
+
+	ch = make_chain( props::overflow_reaction_t::throw_exception );
+	bool thrown = false;
+	try
+	{
+		for( int i = 0; i != 5; ++i )
+			so_5::send< int >( ch, i );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_msg_chain_overflow == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_msg_chain_overflow expected" );
+	ensure_or_die( "012" == collect( ch ), "throw_exception: 012 expected" );
+}
+
+void
+check_close_wakes_producer()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain( lock_free_params(
+			props::multiplicity_t::single,
+			so_5::make_limited_with_waiting_mchain_params(
+					1,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception,
+					chrono::seconds( 10 ) ) ) );
+
+	so_5::send< int >( ch, 0 );
+
+	thread producer{ [ch] { so_5::send< int >( ch, 1 ); } };
+
+	this_thread::sleep_for( chrono::milliseconds( 100 ) );
+	close_drop_content( ch );
+	producer.join();
+
+	ensure_or_die( ch->empty(), "chain must be empty after close" );
+
+	auto r = receive( ch, so_5::infinite_wait, []( int ) {} );
+	ensure_or_die( props::extraction_status_t::chain_closed == r.status(),
+			"chain_closed status expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_stream( props::multiplicity_t::single, 1 );
+				check_stream( props::multiplicity_t::multiple, 4 );
+				check_overflow_reactions();
+				check_close_wakes_producer();
+			},
+			20,
+			"lock-free chain" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
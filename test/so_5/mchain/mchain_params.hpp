@@ -39,6 +39,32 @@ build_mchain_params()
 						props::overflow_reaction_t::drop_newest,
 						chrono::milliseconds(200) ) );
 
+		params.emplace_back( "limited(lock_free,nowait)",
+				so_5::make_limited_without_waiting_mchain_params(
+						5,
+						props::memory_usage_t::preallocated,
+						props::overflow_reaction_t::drop_newest )
+					.consumers( props::multiplicity_t::single ) );
+		params.emplace_back( "limited(lock_free,wait)",
+				so_5::make_limited_with_waiting_mchain_params(
+						5,
+						props::memory_usage_t::preallocated,
+						props::overflow_reaction_t::drop_newest,
+						chrono::milliseconds(200) )
+					.consumers( props::multiplicity_t::single ) );
+
+		params.emplace_back( "priority(unlimited)",
+				so_5::make_unlimited_mchain_params()
+					.priority_lane( so_5::prio::p0, props::capacity_t{} ) );
+		params.emplace_back( "priority(limited,wait)",
+				so_5::make_unlimited_mchain_params()
+					.priority_lane( so_5::prio::p0,
+						props::capacity_t::make_limited_with_waiting(
+							5,
+							props::memory_usage_t::dynamic,
+							props::overflow_reaction_t::drop_newest,
+							chrono::milliseconds(200) ) ) );
+
 		return params;
 	}
 
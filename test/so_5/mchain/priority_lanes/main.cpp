@@ -0,0 +1,175 @@
+/*
+ * A test for mchains with priority lanes.
+ */
+
+#include <so_5/all.hpp>
+
+#include <string>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+struct data { int m_value; };
+
+struct cancel : public so_5::signal_t {};
+
+string
+collect( const so_5::mchain_t & ch )
+{
+	string result;
+	receive( from( ch ).no_wait_on_empty(),
+			[&result]( const data & d ) {
+				result += "[" + to_string( d.m_value ) + "]";
+			},
+			[&result]( so_5::mhood_t< cancel > ) {
+				result += "[cancel]";
+			} );
+	return result;
+}
+
+void
+check_order()
+{
+	so_5::wrapped_env_t env;
+
+	for( std::size_t batch : { 1u, 16u } )
+	{
+		auto ch = env.environment().create_mchain(
+				so_5::make_unlimited_mchain_params()
+					.priority_lane( so_5::prio::p0, props::capacity_t{} )
+					.priority_lane( so_5::prio::p7, props::capacity_t{} )
+					.message_priority< cancel >( so_5::prio::p7 )
+					.extraction_batch_size( batch ) );
+
+		so_5::send< data >( ch, 1 );
+		so_5::send< data >( ch, 2 );
+		so_5::send< cancel >( ch );
+		so_5::send_with_priority< data >( ch, so_5::prio::p7, 100 );
+		so_5::send< data >( ch, 3 );
+
+		ensure_or_die( 5u == ch->size(), "5 messages expected in chain" );
+
+		const auto r = collect( ch );
+		ensure_or_die( "[cancel][100][1][2][3]" == r, "unexpected order: " + r );
+	}
+}
+
+void
+check_lane_selection()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params()
+				.priority_lane( so_5::prio::p2, props::capacity_t{} )
+				.priority_lane( so_5::prio::p5, props::capacity_t{} ) );
+
+	// Goes to the lowest lane (p2).
+	so_5::send_with_priority< data >( ch, so_5::prio::p0, 0 );
+	// Goes to lane p2.
+	so_5::send_with_priority< data >( ch, so_5::prio::p4, 4 );
+	// Goes to lane p5.
+	so_5::send_with_priority< data >( ch, so_5::prio::p7, 7 );
+	// Goes to the lowest lane (p2) because of default priority.
+	so_5::send< data >( ch, 1 );
+	// Goes to lane p5.
+	so_5::send_with_priority< cancel >( ch, so_5::prio::p5 );
+
+	const auto r = collect( ch );
+	ensure_or_die( "[7][cancel][0][4][1]" == r, "unexpected order: " + r );
+}
+
+void
+check_lane_capacities()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params()
+				.priority_lane( so_5::prio::p0,
+					props::capacity_t::make_limited_without_waiting(
+						2,
+						props::memory_usage_t::dynamic,
+						props::overflow_reaction_t::drop_newest ) )
+				.priority_lane( so_5::prio::p1,
+					props::capacity_t::make_limited_without_waiting(
+						1,
+						props::memory_usage_t::dynamic,
+						props::overflow_reaction_t::throw_exception ) )
+				.message_priority< cancel >( so_5::prio::p1 ) );
+
+	for( int i = 0; i != 5; ++i )
+		so_5::send< data >( ch, i );
+
+	so_5::send< cancel >( ch );
+
+	bool thrown = false;
+	try
+	{
+		so_5::send< cancel >( ch );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_msg_chain_overflow == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_msg_chain_overflow expected" );
+
+	const auto r = collect( ch );
+	ensure_or_die( "[cancel][0][1]" == r, "unexpected content: " + r );
+}
+
+void
+check_select()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			so_5::make_unlimited_mchain_params()
+				.priority_lane( so_5::prio::p0, props::capacity_t{} )
+				.priority_lane( so_5::prio::p7, props::capacity_t{} )
+				.message_priority< cancel >( so_5::prio::p7 ) );
+
+	so_5::send< data >( ch, 1 );
+	so_5::send< cancel >( ch );
+
+	string result;
+	select( so_5::from_all().handle_n( 2 ),
+			case_( ch,
+				[&result]( const data & d ) {
+					result += "[" + to_string( d.m_value ) + "]";
+				},
+				[&result]( so_5::mhood_t< cancel > ) {
+					result += "[cancel]";
+				} ) );
+
+	ensure_or_die( "[cancel][1]" == result, "unexpected order: " + result );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_order();
+				check_lane_selection();
+				check_lane_capacities();
+				check_select();
+			},
+			20,
+			"priority lanes" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
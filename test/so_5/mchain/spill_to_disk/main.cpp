@@ -0,0 +1,261 @@
+/*
+ * A test for mchains with spill-to-disk storage.
+ */
+
+#include <so_5/all.hpp>
+
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+struct data
+{
+	int m_value;
+	char m_tag[ 16 ];
+};
+
+struct text
+{
+	string m_value;
+};
+
+struct note
+{
+	string m_value;
+};
+
+struct tick : public so_5::signal_t {};
+
+so_5::mchain_params_t
+make_params( size_t capacity, props::spill_params_t spill )
+{
+	return so_5::make_limited_without_waiting_mchain_params(
+			capacity,
+			props::memory_usage_t::preallocated,
+			props::overflow_reaction_t::throw_exception )
+		.spill_to_disk( std::move(spill) );
+}
+
+void
+check_order()
+{
+	so_5::wrapped_env_t env;
+
+	// Small segments to check switching and reusing of them.
+	auto ch = env.environment().create_mchain(
+			make_params( 5,
+				props::spill_params_t{ "." }
+					.segment_size( 1 )
+					.spillable< data >() ) );
+
+	const int total = 10000;
+	for( int i = 0; i != total; ++i )
+	{
+		data d;
+		d.m_value = i;
+		std::snprintf( d.m_tag, sizeof(d.m_tag), "%d", i );
+		so_5::send< data >( ch, d );
+	}
+
+	ensure_or_die( static_cast< size_t >( total ) == ch->size(),
+			"all messages must be in chain: " + to_string( ch->size() ) );
+
+	int expected = 0;
+	// Messages are extracted by portions. New messages are sent between
+	// portions to check FIFO order.
+	for( int portion = 0; portion != 2; ++portion )
+	{
+		receive( from( ch ).no_wait_on_empty().handle_n( total / 4 ),
+				[&expected]( const data & d ) {
+					ensure_or_die( expected == d.m_value,
+							"unexpected value: " + to_string( d.m_value ) +
+							", expected: " + to_string( expected ) );
+					ensure_or_die( to_string( expected ) == d.m_tag,
+							"unexpected tag: " + string( d.m_tag ) );
+					++expected;
+				} );
+
+		for( int i = 0; i != total / 4; ++i )
+		{
+			data d;
+			d.m_value = total + portion * ( total / 4 ) + i;
+			std::snprintf( d.m_tag, sizeof(d.m_tag), "%d", d.m_value );
+			so_5::send< data >( ch, d );
+		}
+	}
+
+	receive( from( ch ).no_wait_on_empty(),
+			[&expected]( const data & d ) {
+				ensure_or_die( expected == d.m_value,
+						"unexpected value: " + to_string( d.m_value ) +
+						", expected: " + to_string( expected ) );
+				++expected;
+			} );
+
+	ensure_or_die( total + total / 2 == expected,
+			"unexpected count of messages: " + to_string( expected ) );
+}
+
+void
+check_mixed_types()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = env.environment().create_mchain(
+			make_params( 2,
+				props::spill_params_t{ "." }
+					.spillable< data >()
+					.spillable< text >(
+						[]( const text & t, string & to ) { to += t.m_value; },
+						[]( const char * d, size_t size ) {
+							return text{ string( d, size ) };
+						} ) ) );
+
+	data d{ 0, "" };
+	for( int i = 0; i != 3; ++i )
+	{
+		d.m_value = i;
+		so_5::send< data >( ch, d );
+		so_5::send< text >( ch, "t" + to_string( i ) );
+		// Not spillable types.
+		so_5::send< note >( ch, "n" + to_string( i ) );
+		so_5::send< tick >( ch );
+	}
+
+	string result;
+	receive( from( ch ).no_wait_on_empty(),
+			[&result]( const data & m ) {
+				result += "[" + to_string( m.m_value ) + "]";
+			},
+			[&result]( const text & m ) { result += "[" + m.m_value + "]"; },
+			[&result]( const note & m ) { result += "[" + m.m_value + "]"; },
+			[&result]( so_5::mhood_t< tick > ) { result += "[tick]"; } );
+
+	const string expected =
+			"[0][t0][n0][tick][1][t1][n1][tick][2][t2][n2][tick]";
+	ensure_or_die( expected == result, "unexpected result: " + result );
+}
+
+void
+check_incompatible_params()
+{
+	so_5::wrapped_env_t env;
+
+	bool thrown = false;
+	try
+	{
+		env.environment().create_mchain(
+				make_params( 2,
+					props::spill_params_t{ "." }.spillable< data >() )
+				.conflate< data >() );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_incompatible_mchain_params == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_incompatible_mchain_params expected" );
+}
+
+void
+check_close_drop_content()
+{
+	so_5::wrapped_env_t env;
+
+	int deserialized = 0;
+	auto ch = env.environment().create_mchain(
+			make_params( 1,
+				props::spill_params_t{ "." }
+					.spillable< text >(
+						[]( const text & t, string & to ) { to += t.m_value; },
+						[&deserialized]( const char *, size_t ) -> text {
+							++deserialized;
+							throw runtime_error( "deserializer must not be called" );
+						} ) ) );
+
+	for( int i = 0; i != 3; ++i )
+		so_5::send< text >( ch, "t" + to_string( i ) );
+
+	// Spilled messages must be dropped without deserialization.
+	close_drop_content( ch );
+
+	ensure_or_die( 0 == deserialized,
+			"unexpected deserializations: " + to_string( deserialized ) );
+	ensure_or_die( 0u == ch->size(), "chain must be empty" );
+}
+
+void
+check_stats()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+		auto ch = env.create_mchain(
+				make_params( 1,
+					props::spill_params_t{ "." }.spillable< data >() ) );
+
+		data d{ 0, "" };
+		for( int i = 0; i != 3; ++i )
+			so_5::send< data >( ch, d );
+
+		const auto prefix = "mchain/" + to_string( ch->id() );
+
+		env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			auto a = coop.define_agent();
+			a.on_start( [&env] {
+					env.stats_controller().set_distribution_period(
+							chrono::milliseconds( 100 ) );
+					env.stats_controller().turn_on();
+				} )
+			.event( env.stats_controller().mbox(),
+				[&env, ch, prefix]( const so_5::stats::messages::quantity<
+						std::size_t > & evt ) {
+					namespace stats = so_5::stats;
+					if( prefix != evt.m_prefix.c_str() )
+						return;
+
+					if( stats::suffixes::mchain_spilled_count() == evt.m_suffix )
+						ensure_or_die( 2u == evt.m_value,
+								"unexpected spilled count: " +
+								to_string( evt.m_value ) );
+					else if( stats::suffixes::mchain_spilled_bytes() == evt.m_suffix )
+					{
+						ensure_or_die( 2u * sizeof( data ) == evt.m_value,
+								"unexpected spilled bytes: " +
+								to_string( evt.m_value ) );
+						env.stop();
+					}
+				} );
+		} );
+	} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_order();
+				check_mixed_types();
+				check_incompatible_params();
+				check_close_drop_content();
+				check_stats();
+			},
+			20,
+			"spill-to-disk mchains" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
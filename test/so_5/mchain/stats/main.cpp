@@ -0,0 +1,170 @@
+/*
+ * A test for run-time monitoring of mchains.
+ */
+
+#include <so_5/all.hpp>
+
+#include <map>
+#include <string>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+namespace stats = so_5::stats;
+
+struct data { int m_value; };
+
+using values_t = map< string, size_t >;
+
+string
+make_key( const so_5::mchain_t & ch, const stats::suffix_t & suffix )
+{
+	return "mchain/" + to_string( ch->id() ) + suffix.c_str();
+}
+
+void
+ensure_value(
+	const values_t & values,
+	const so_5::mchain_t & ch,
+	const stats::suffix_t & suffix,
+	size_t expected )
+{
+	const auto key = make_key( ch, suffix );
+	const auto it = values.find( key );
+	ensure_or_die( it != values.end(), "value not found: " + key );
+	ensure_or_die( expected == it->second,
+			key + ": unexpected value: " + to_string( it->second ) +
+			", expected: " + to_string( expected ) );
+}
+
+void
+check_chain(
+	const values_t & values,
+	const so_5::mchain_t & ch,
+	size_t size,
+	size_t high_watermark,
+	size_t enqueued,
+	size_t dequeued,
+	size_t overflows )
+{
+	ensure_value( values, ch, stats::suffixes::mchain_size(), size );
+	ensure_value( values, ch,
+			stats::suffixes::mchain_size_high_watermark(), high_watermark );
+	ensure_value( values, ch,
+			stats::suffixes::mchain_enqueued_count(), enqueued );
+	ensure_value( values, ch,
+			stats::suffixes::mchain_dequeued_count(), dequeued );
+	ensure_value( values, ch,
+			stats::suffixes::mchain_overflow_count(), overflows );
+
+	// Rates can't be checked because they depend on timing.
+	// But they must be distributed.
+	ensure_or_die( values.count( make_key( ch,
+				stats::suffixes::mchain_enqueue_rate() ) ),
+			"enqueue rate must be distributed" );
+	ensure_or_die( values.count( make_key( ch,
+				stats::suffixes::mchain_dequeue_rate() ) ),
+			"dequeue rate must be distributed" );
+}
+
+void
+check_stats()
+{
+	values_t values;
+
+	so_5::mchain_t unlimited;
+	so_5::mchain_t limited;
+	so_5::mchain_t prioritized;
+	so_5::mchain_t not_monitored;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		unlimited = env.create_mchain(
+				so_5::make_unlimited_mchain_params().enable_stats() );
+
+		// Lock-free chain must not be used for that chain.
+		limited = env.create_mchain(
+				so_5::make_limited_without_waiting_mchain_params(
+						2,
+						props::memory_usage_t::preallocated,
+						props::overflow_reaction_t::drop_newest )
+					.consumers( props::multiplicity_t::single )
+					.enable_stats() );
+
+		prioritized = env.create_mchain(
+				so_5::make_unlimited_mchain_params()
+					.priority_lane( so_5::prio::p0,
+						props::capacity_t::make_limited_without_waiting(
+								1,
+								props::memory_usage_t::dynamic,
+								props::overflow_reaction_t::remove_oldest ) )
+					.enable_stats() );
+
+		not_monitored = env.create_mchain(
+				so_5::make_unlimited_mchain_params() );
+
+		for( int i = 0; i != 5; ++i )
+		{
+			so_5::send< data >( unlimited, i );
+			so_5::send< data >( limited, i );
+			so_5::send< data >( prioritized, i );
+			so_5::send< data >( not_monitored, i );
+		}
+
+		receive( from( unlimited ).handle_n( 2 ).no_wait_on_empty(),
+				[]( const data & ) {} );
+		receive( from( limited ).handle_n( 1 ).no_wait_on_empty(),
+				[]( const data & ) {} );
+
+		env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			auto a = coop.define_agent();
+			a.on_start( [&env] {
+					env.stats_controller().set_distribution_period(
+							chrono::milliseconds( 100 ) );
+					env.stats_controller().turn_on();
+				} )
+			.event( env.stats_controller().mbox(),
+				[&values]( const stats::messages::quantity< size_t > & evt ) {
+					values[ string( evt.m_prefix.c_str() ) +
+							evt.m_suffix.c_str() ] = evt.m_value;
+				} )
+			.event( env.stats_controller().mbox(),
+				[&env]( const stats::messages::distribution_finished & ) {
+					env.stop();
+				} );
+		} );
+	} );
+
+	check_chain( values, unlimited, 3, 5, 5, 2, 0 );
+	check_chain( values, limited, 1, 2, 2, 1, 3 );
+	check_chain( values, prioritized, 1, 1, 5, 0, 4 );
+
+	ensure_or_die( 0 == values.count( make_key( not_monitored,
+				stats::suffixes::mchain_size() ) ),
+			"there must not be stats for chain without monitoring" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_stats();
+			},
+			20,
+			"run-time monitoring of mchains" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
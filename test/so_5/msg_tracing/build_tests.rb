@@ -10,6 +10,9 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/simple_svc_count_on_exception/prj.ut.rb"
 	required_prj "#{path}/simple_msg_count_mpsc_no_limits/prj.ut.rb"
 	required_prj "#{path}/simple_msg_count_mpsc_limits/prj.ut.rb"
+	required_prj "#{path}/filtered_records/prj.ut.rb"
+	required_prj "#{path}/flight_recorder/prj.ut.rb"
+	required_prj "#{path}/sampling/prj.ut.rb"
 
 	required_prj "#{path}/overlimit_abort_app/prj.ut.rb"
 	required_prj "#{path}/overlimit_drop/prj.ut.rb"
@@ -0,0 +1,235 @@
+/*
+ * A test for structured trace records and filtering of them.
+ */
+
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+namespace trace = so_5::msg_tracing;
+
+struct finish : public so_5::signal_t {};
+
+using records_t = std::vector< trace::trace_record_t >;
+
+const std::chrono::steady_clock::time_point zero_time{};
+
+class records_tracer_t : public trace::tracer_t
+{
+public :
+	records_tracer_t(
+		std::mutex & lock,
+		records_t & records,
+		bool needs_timestamps )
+		:	m_lock( lock )
+		,	m_records( records )
+		,	m_needs_timestamps( needs_timestamps )
+	{}
+
+	virtual void
+	trace( const std::string & ) SO_5_NOEXCEPT override
+	{
+		// Must not be called because trace_record is redefined.
+		std::abort();
+	}
+
+	virtual void
+	trace_record( const trace::trace_record_t & record ) SO_5_NOEXCEPT override
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_records.push_back( record );
+	}
+
+	virtual bool
+	needs_timestamps() const SO_5_NOEXCEPT override
+	{
+		return m_needs_timestamps;
+	}
+
+private :
+	std::mutex & m_lock;
+	records_t & m_records;
+	const bool m_needs_timestamps;
+};
+
+class a_test_t : public so_5::agent_t
+{
+	struct dummy_msg { int m_i; };
+
+public :
+	a_test_t( context_t ctx, so_5::mbox_t data_mbox )
+		:	so_5::agent_t{ ctx }
+		,	m_data_mbox{ std::move( data_mbox ) }
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_set_delivery_filter( m_data_mbox, []( const dummy_msg & msg ) {
+				return 0 == msg.m_i;
+			} );
+
+		so_subscribe( m_data_mbox ).event< finish >( &a_test_t::evt_finish );
+		so_subscribe( m_data_mbox ).event( &a_test_t::evt_dummy_msg );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< dummy_msg >( m_data_mbox, 1 );
+		so_5::send< finish >( m_data_mbox );
+	}
+
+private :
+	const so_5::mbox_t m_data_mbox;
+
+	void
+	evt_finish()
+	{
+		so_deregister_agent_coop_normally();
+	}
+
+	void
+	evt_dummy_msg( const dummy_msg & msg )
+	{
+		if( 0 != msg.m_i )
+			throw std::runtime_error( "msg.m_i != 0" );
+	}
+};
+
+void
+init( so_5::environment_t & env )
+{
+	env.introduce_coop( []( so_5::coop_t & coop ) {
+			coop.make_agent< a_test_t >( coop.environment().create_mbox() );
+		} );
+}
+
+records_t
+run_with_tracer(
+	std::function< trace::tracer_unique_ptr_t(
+			trace::tracer_unique_ptr_t ) > wrapper,
+	bool needs_timestamps = true )
+{
+	std::mutex lock;
+	records_t records;
+
+	so_5::launch( &init,
+		[&]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer( wrapper(
+					trace::tracer_unique_ptr_t{
+							new records_tracer_t{ lock, records, needs_timestamps } } ) );
+		} );
+
+	return records;
+}
+
+void
+check_all_records()
+{
+	const auto records = run_with_tracer(
+			[]( trace::tracer_unique_ptr_t t ) { return t; } );
+
+	ensure_or_die( 3u == records.size(),
+			"unexpected count of records: " + std::to_string( records.size() ) );
+
+	const auto & rejected = records[ 0 ];
+	ensure_or_die( trace::action_t::message_rejected == rejected.m_action,
+			"message_rejected expected" );
+	ensure_or_die( nullptr != rejected.m_agent, "agent expected" );
+	ensure_or_die( nullptr != rejected.m_message.m_payload,
+			"payload expected" );
+	ensure_or_die( !rejected.m_message.m_mutable, "immutable message expected" );
+
+	const auto & pushed = records[ 1 ];
+	ensure_or_die( trace::action_t::push_to_queue == pushed.m_action,
+			"push_to_queue expected" );
+	ensure_or_die( std::string{ "deliver_message" } == pushed.m_operation,
+			"unexpected operation: " + std::string{ pushed.m_operation } );
+	ensure_or_die( pushed.m_mbox_id == rejected.m_mbox_id,
+			"the same mbox expected" );
+	ensure_or_die( std::type_index{ typeid(finish) } == pushed.m_message.m_type,
+			"unexpected message type" );
+	ensure_or_die( nullptr == pushed.m_message.m_payload,
+			"signal expected" );
+	ensure_or_die( zero_time != rejected.m_timestamp,
+			"timestamp expected" );
+	ensure_or_die( pushed.m_timestamp >= rejected.m_timestamp,
+			"timestamps must not decrease" );
+	ensure_or_die( records[ 2 ].m_second_message.empty(),
+			"no second message expected" );
+
+	const auto text = trace::to_text( pushed );
+	ensure_or_die( std::string::npos != text.find( " deliver_message.push_to_queue " ),
+			"unexpected text: " + text );
+}
+
+void
+check_filtered_records()
+{
+	const auto records = run_with_tracer(
+			[]( trace::tracer_unique_ptr_t t ) {
+				return trace::make_filtered_tracer(
+						[]( const trace::trace_record_t & r ) {
+							ensure_or_die( zero_time == r.m_timestamp,
+									"filter must receive records without timestamps" );
+							return trace::action_t::find_handler == r.m_action;
+						},
+						std::move( t ) );
+			} );
+
+	ensure_or_die( 1u == records.size(),
+			"unexpected count of records: " + std::to_string( records.size() ) );
+
+	const auto & r = records[ 0 ];
+	ensure_or_die( nullptr != r.m_agent, "agent expected" );
+	ensure_or_die( nullptr != r.m_state, "state expected" );
+	ensure_or_die( nullptr != r.m_event_handler, "event handler expected" );
+	ensure_or_die( std::type_index{ typeid(finish) } == r.m_message.m_type,
+			"unexpected message type" );
+	ensure_or_die( zero_time != r.m_timestamp,
+			"timestamp expected for accepted record" );
+}
+
+void
+check_no_timestamps()
+{
+	const auto records = run_with_tracer(
+			[]( trace::tracer_unique_ptr_t t ) { return t; },
+			false );
+
+	ensure_or_die( 3u == records.size(),
+			"unexpected count of records: " + std::to_string( records.size() ) );
+	for( const auto & r : records )
+		ensure_or_die( zero_time == r.m_timestamp,
+				"timestamp is not expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_all_records();
+				check_filtered_records();
+				check_no_timestamps();
+			},
+			20,
+			"structured trace records and filtering" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * A test for flight recorder of message delivery tracing.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+namespace trace = so_5::msg_tracing;
+
+struct finish : public so_5::signal_t {};
+
+trace::trace_record_t
+make_record( std::size_t index )
+{
+	trace::trace_record_t r{};
+	r.m_timestamp = std::chrono::steady_clock::now();
+	r.m_thread_id = so_5::query_current_thread_id();
+	r.m_action = trace::action_t::mchain_stored;
+	r.m_operation = "test";
+	r.m_mbox_id = 42;
+	r.m_message.m_type = typeid(finish);
+	r.m_chain_size = index;
+
+	return r;
+}
+
+std::string
+decode( const trace::flight_recorder_t & recorder )
+{
+	std::stringstream dump;
+	recorder.dump( dump );
+
+	std::ostringstream result;
+	trace::decode_flight_recorder_dump( dump, result );
+
+	return result.str();
+}
+
+std::size_t
+count_of( const std::string & text, const std::string & what )
+{
+	std::size_t result = 0;
+	for( auto pos = text.find( what ); std::string::npos != pos;
+			pos = text.find( what, pos + 1 ) )
+		++result;
+
+	return result;
+}
+
+void
+check_ring_buffer()
+{
+	trace::flight_recorder_t recorder{ 8, 2 };
+
+	for( std::size_t i = 0; i != 20; ++i )
+		recorder.store( make_record( i ) );
+
+	const auto text = decode( recorder );
+	ensure_or_die( std::string::npos !=
+			text.find( "threads: 1, records: 8, lost: 0" ),
+			"unexpected header: " + text );
+	ensure_or_die( 8u == count_of( text, " test.stored [mbox_id=42]" ),
+			"unexpected records: " + text );
+	ensure_or_die( std::string::npos == text.find( "[chain_size=11]" ) &&
+			std::string::npos != text.find( "[chain_size=12]" ) &&
+			std::string::npos != text.find( "[chain_size=19]" ),
+			"only the last records expected: " + text );
+
+	// The second thread gets its own buffer, the third one doesn't.
+	// Both threads must live at the same time because ids of finished
+	// threads can be reused.
+	std::atomic< int > stage{ 0 };
+	std::thread second{ [&] {
+			recorder.store( make_record( 0 ) );
+			stage = 1;
+			while( 2 != stage )
+				std::this_thread::yield();
+		} };
+	while( 1 != stage )
+		std::this_thread::yield();
+	std::thread{ [&recorder] {
+			recorder.store( make_record( 0 ) );
+			recorder.store( make_record( 1 ) );
+		} }.join();
+	stage = 2;
+	second.join();
+
+	ensure_or_die( 2u == recorder.lost_records(),
+			"unexpected count of lost records: " +
+			std::to_string( recorder.lost_records() ) );
+	ensure_or_die( std::string::npos != decode( recorder ).find(
+			"threads: 2, records: 9, lost: 2" ),
+			"unexpected header: " + decode( recorder ) );
+}
+
+void
+check_finished_threads()
+{
+	trace::flight_recorder_t recorder{ 8, 2 };
+
+	// Buffers of finished threads are reused by new threads.
+	for( std::size_t i = 0; i != 5; ++i )
+		std::thread{ [&recorder, i] {
+				recorder.store( make_record( i ) );
+			} }.join();
+
+	ensure_or_die( 0u == recorder.lost_records(),
+			"unexpected count of lost records: " +
+			std::to_string( recorder.lost_records() ) );
+
+	const auto text = decode( recorder );
+	ensure_or_die( std::string::npos !=
+			text.find( "threads: 2, records: 5, lost: 0" ),
+			"unexpected header: " + text );
+}
+
+void
+check_dump_during_writing()
+{
+	trace::flight_recorder_t recorder{ 64, 1 };
+
+	std::atomic< bool > stop{ false };
+	std::thread writer{ [&] {
+			for( std::size_t i = 0; !stop.load( std::memory_order_relaxed ); ++i )
+				recorder.store( make_record( i ) );
+		} };
+
+	for( int i = 0; i != 100; ++i )
+	{
+		const auto text = decode( recorder );
+		ensure_or_die( count_of( text, " test.stored " ) <= 64u,
+				"too many records: " + text );
+		ensure_or_die( count_of( text, "[msg_type=" ) ==
+				count_of( text, " test.stored " ),
+				"broken records: " + text );
+	}
+
+	stop = true;
+	writer.join();
+}
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self().event< finish >( [this] {
+				so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< finish >( *this );
+	}
+};
+
+void
+check_tracer()
+{
+	auto recorder = std::make_shared< trace::flight_recorder_t >();
+
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			env.introduce_coop( []( so_5::coop_t & coop ) {
+					coop.make_agent< a_test_t >();
+				} );
+		},
+		[&recorder]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer(
+					trace::flight_recorder_tracer( recorder ) );
+		} );
+
+	const auto text = decode( *recorder );
+	ensure_or_die( 1u == count_of( text, " deliver_message.push_to_queue " ),
+			"push_to_queue expected: " + text );
+	ensure_or_die( 1u == count_of( text, ".find_handler " ),
+			"find_handler expected: " + text );
+	ensure_or_die( std::string::npos != text.find( typeid(finish).name() ),
+			"message type expected: " + text );
+}
+
+void
+check_invalid_dump()
+{
+	std::istringstream dump{ "it is not a dump" };
+	std::ostringstream to;
+
+	bool thrown = false;
+	try
+	{
+		trace::decode_flight_recorder_dump( dump, to );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_msg_tracing_dump_failure == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_msg_tracing_dump_failure expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_ring_buffer();
+				check_finished_threads();
+				check_dump_during_writing();
+				check_tracer();
+				check_invalid_dump();
+			},
+			20,
+			"flight recorder of message delivery tracing" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
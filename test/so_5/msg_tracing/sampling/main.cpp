@@ -0,0 +1,373 @@
+/*
+ * A test for selection of traced messages.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+namespace trace = so_5::msg_tracing;
+
+struct hello { int m_v; };
+struct bye { std::string m_v; };
+
+using records_t = std::vector< trace::trace_record_t >;
+
+class records_tracer_t : public trace::tracer_t
+{
+public :
+	records_tracer_t( std::mutex & lock, records_t & records )
+		:	m_lock( lock )
+		,	m_records( records )
+	{}
+
+	virtual void
+	trace( const std::string & ) SO_5_NOEXCEPT override
+	{}
+
+	virtual void
+	trace_record( const trace::trace_record_t & record ) SO_5_NOEXCEPT override
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_records.push_back( record );
+	}
+
+private :
+	std::mutex & m_lock;
+	records_t & m_records;
+};
+
+template< typename MSG >
+bool
+is_type( const trace::trace_record_t & r )
+{
+	return std::type_index{ typeid(MSG) } == r.m_message.m_type;
+}
+
+template< typename MSG >
+std::size_t
+count_of(
+	const records_t & records,
+	trace::action_t action )
+{
+	return static_cast< std::size_t >( std::count_if(
+			records.begin(), records.end(),
+			[action]( const trace::trace_record_t & r ) {
+				return action == r.m_action && is_type< MSG >( r );
+			} ) );
+}
+
+//
+// Selection by type and one of N messages.
+//
+
+class a_receiver_t final : public so_5::agent_t
+{
+	struct finish : public so_5::signal_t {};
+
+public :
+	a_receiver_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self()
+			.event( []( const hello & ) {} )
+			.event( []( const bye & ) {} )
+			.event< finish >( [this] { so_deregister_agent_coop_normally(); } );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		for( int i = 0; i != 10; ++i )
+		{
+			so_5::send< hello >( *this, i );
+			so_5::send< bye >( *this, std::to_string( i ) );
+		}
+		so_5::send< finish >( *this );
+	}
+};
+
+void
+check_type_and_one_of()
+{
+	std::mutex lock;
+	records_t records;
+
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			env.introduce_coop( []( so_5::coop_t & coop ) {
+					coop.make_agent< a_receiver_t >();
+				} );
+		},
+		[&]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer(
+					trace::make_sampled_tracer(
+							trace::sampling_t{}.message_type< hello >().one_of( 2 ),
+							trace::tracer_unique_ptr_t{
+									new records_tracer_t{ lock, records } } ) );
+		} );
+
+	ensure_or_die( 5u == count_of< hello >(
+				records, trace::action_t::push_to_queue ),
+			"5 pushed hello expected" );
+	ensure_or_die( 5u == count_of< hello >(
+				records, trace::action_t::find_handler ),
+			"5 handled hello expected" );
+	ensure_or_die( records.size() == 10u, "only records about hello expected" );
+
+	// Records about the same messages are expected.
+	std::set< const void * > pushed;
+	std::set< const void * > handled;
+	for( const auto & r : records )
+		( trace::action_t::push_to_queue == r.m_action ? pushed : handled )
+				.insert( r.m_message.m_payload );
+	ensure_or_die( pushed == handled, "different messages are traced" );
+}
+
+//
+// Selection by mbox is kept after transformation.
+//
+
+class a_first_t final : public so_5::agent_t
+{
+public :
+	a_first_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self().event( [this]( const bye & msg ) {
+				if( "1" == msg.m_v )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+};
+
+class a_second_t final : public so_5::agent_t
+{
+public :
+	a_second_t( context_t ctx, so_5::mbox_t target )
+		:	so_5::agent_t{ ctx
+				+ limit_then_transform( 1,
+						[this]( const hello & msg ) {
+							return make_transformed< bye >(
+								m_target,
+								std::to_string( msg.m_v ) );
+						} ) }
+		,	m_target{ std::move(target) }
+	{
+		so_subscribe_self().event( []( const hello & ) {} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_environment().change_message_delivery_sampling(
+				trace::sampling_t{}.mbox_id( so_direct_mbox()->id() ) );
+
+		so_5::send< hello >( *this, 0 );
+		so_5::send< hello >( *this, 1 );
+	}
+
+private :
+	const so_5::mbox_t m_target;
+};
+
+void
+check_transformation()
+{
+	std::mutex lock;
+	records_t records;
+	so_5::mbox_id_t target_id = 0;
+
+	so_5::launch(
+		[&target_id]( so_5::environment_t & env ) {
+			env.introduce_coop( [&target_id]( so_5::coop_t & coop ) {
+					auto first = coop.make_agent< a_first_t >();
+					target_id = first->so_direct_mbox()->id();
+					coop.make_agent< a_second_t >( first->so_direct_mbox() );
+				} );
+		},
+		[&]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer(
+					trace::tracer_unique_ptr_t{
+							new records_tracer_t{ lock, records } } );
+		} );
+
+	ensure_or_die( 1u == count_of< hello >(
+				records, trace::action_t::overlimit_transform ),
+			"transformation of hello expected" );
+	ensure_or_die( 1u == count_of< bye >(
+				records, trace::action_t::push_to_queue ),
+			"pushed bye expected" );
+	ensure_or_die( 1u == count_of< bye >(
+				records, trace::action_t::find_handler ),
+			"handled bye expected" );
+	ensure_or_die( std::any_of( records.begin(), records.end(),
+				[target_id]( const trace::trace_record_t & r ) {
+					return is_type< bye >( r ) && target_id == r.m_mbox_id;
+				} ),
+			"bye must be traced for target mbox" );
+}
+
+//
+// Decision is made for every shot of a periodic message.
+//
+
+void
+check_periodic()
+{
+	std::mutex lock;
+	records_t records;
+
+	{
+		so_5::wrapped_env_t env{
+			[]( so_5::environment_t & ) {},
+			[&]( so_5::environment_params_t & params ) {
+				params.message_delivery_tracer(
+						trace::make_sampled_tracer(
+								trace::sampling_t{}.message_type< hello >().one_of( 2 ),
+								trace::tracer_unique_ptr_t{
+										new records_tracer_t{ lock, records } } ) );
+			} };
+
+		auto ch = so_5::create_mchain( env );
+		auto timer = so_5::send_periodic< hello >(
+				env.environment(),
+				ch->as_mbox(),
+				std::chrono::milliseconds( 0 ),
+				std::chrono::milliseconds( 5 ),
+				0 );
+
+		so_5::receive( so_5::from( ch ).handle_n( 6 ),
+				[]( const hello & ) {} );
+		timer.release();
+		so_5::close_drop_content( ch );
+	}
+
+	// The same instance of the message is sent by every shot of timer.
+	// One of every two shots must be traced. There can be the 7th shot
+	// before the release of the timer.
+	const auto stored = count_of< hello >(
+			records, trace::action_t::mchain_stored );
+	ensure_or_die( 3u <= stored && stored <= 4u,
+			"3 or 4 stored hello expected, got " + std::to_string( stored ) );
+}
+
+//
+// Selection by agent.
+//
+
+class a_listener_t final : public so_5::agent_t
+{
+public :
+	a_listener_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self().event( []( const hello & ) {} );
+	}
+};
+
+class a_sender_t final : public so_5::agent_t
+{
+	struct finish : public so_5::signal_t {};
+
+public :
+	a_sender_t(
+		context_t ctx,
+		so_5::mbox_t listener,
+		so_5::mchain_t chain )
+		:	so_5::agent_t{ ctx }
+		,	m_listener{ std::move( listener ) }
+		,	m_chain{ std::move( chain ) }
+	{
+		so_subscribe_self()
+			.event( []( const hello & ) {} )
+			.event< finish >( [this] { so_deregister_agent_coop_normally(); } );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_environment().change_message_delivery_sampling(
+				trace::sampling_t{}.agent( *this ) );
+
+		so_5::send< hello >( m_listener, 0 );
+		so_5::send< hello >( *this, 1 );
+		// Records about mchain are not related to agents.
+		so_5::send< hello >( m_chain, 2 );
+		so_5::send< finish >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_listener;
+	const so_5::mchain_t m_chain;
+};
+
+void
+check_agent()
+{
+	std::mutex lock;
+	records_t records;
+	const so_5::agent_t * sender = nullptr;
+
+	so_5::launch(
+		[&sender]( so_5::environment_t & env ) {
+			env.introduce_coop( [&sender]( so_5::coop_t & coop ) {
+					auto listener = coop.make_agent< a_listener_t >();
+					sender = coop.make_agent< a_sender_t >(
+							listener->so_direct_mbox(),
+							so_5::create_mchain( coop.environment() ) );
+				} );
+		},
+		[&]( so_5::environment_params_t & params ) {
+			params.message_delivery_tracer(
+					trace::tracer_unique_ptr_t{
+							new records_tracer_t{ lock, records } } );
+		} );
+
+	ensure_or_die( 2u == count_of< hello >(
+				records, trace::action_t::push_to_queue ) +
+				count_of< hello >( records, trace::action_t::find_handler ),
+			"only records about hello for sender expected" );
+	ensure_or_die( 1u == count_of< hello >(
+				records, trace::action_t::mchain_stored ),
+			"record about hello stored to mchain expected" );
+	ensure_or_die( std::all_of( records.begin(), records.end(),
+				[sender]( const trace::trace_record_t & r ) {
+					return !is_type< hello >( r ) || !r.m_agent ||
+							sender == r.m_agent;
+				} ),
+			"records about hello for listener are not expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_type_and_one_of();
+				check_transformation();
+				check_periodic();
+				check_agent();
+			},
+			20,
+			"selection of traced messages" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * A test for lazy checking of time limits of agent states.
+ *
+ * There is just one timer for all time limits of the agent. The timer
+ * is rearmed only if a deadline becomes earlier.
+ */
+
+#include <iostream>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std::chrono;
+
+using hires_clock = steady_clock;
+
+class a_test_t final : public so_5::agent_t
+{
+	// Step 1: switches between states with time limits.
+	state_t bounce_a{ this, "bounce_a" };
+	state_t bounce_b{ this, "bounce_b" };
+	state_t bounce_expired{ this, "bounce_expired" };
+
+	// Step 2: time limits of nested states.
+	state_t parent{ this, "parent" };
+	state_t child_1{ initial_substate_of{ parent }, "child_1" };
+	state_t child_2{ substate_of{ parent }, "child_2" };
+	state_t parent_expired{ this, "parent_expired" };
+
+	// Step 3: deadline becomes earlier than the armed one.
+	state_t long_limit{ this, "long_limit" };
+	state_t short_limit{ this, "short_limit" };
+	state_t short_expired{ this, "short_expired" };
+
+	// Step 4: timer fires when there is no state with time limit.
+	state_t idle{ this, "idle" };
+	state_t again{ this, "again" };
+	state_t again_expired{ this, "again_expired" };
+
+	state_t failure{ this, "failure" };
+
+	struct bounce : public so_5::signal_t {};
+	struct next : public so_5::signal_t {};
+	struct leave : public so_5::signal_t {};
+
+	const unsigned int total_bounces = 20;
+
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		bounce_a
+			.on_enter( [this]{ m_entered_at = hires_clock::now(); } )
+			.time_limit( milliseconds{50}, bounce_expired )
+			.event< bounce >( [this]{ do_bounce( bounce_b ); } );
+
+		bounce_b
+			.on_enter( [this]{ m_entered_at = hires_clock::now(); } )
+			.time_limit( milliseconds{50}, bounce_expired )
+			.event< bounce >( [this]{ do_bounce( bounce_a ); } );
+
+		bounce_expired
+			.on_enter( [this]{
+				ensure_or_die( total_bounces == m_bounces,
+						"time limit expired during bouncing: " +
+						std::to_string( m_bounces ) );
+				ensure_elapsed( m_entered_at, milliseconds{50} );
+				so_5::send< next >( *this );
+			} )
+			.event< next >( [this]{
+				m_entered_at = hires_clock::now();
+				this >>= child_1;
+			} );
+
+		parent
+			.time_limit( milliseconds{100}, parent_expired );
+
+		child_1
+			.time_limit( milliseconds{30}, child_2 );
+
+		child_2
+			.on_enter( [this]{
+				ensure_elapsed( m_entered_at, milliseconds{30} );
+			} );
+
+		parent_expired
+			.on_enter( [this]{
+				ensure_elapsed( m_entered_at, milliseconds{100} );
+				so_5::send< next >( *this );
+			} )
+			.event< next >( [this]{
+				this >>= long_limit;
+				m_entered_at = hires_clock::now();
+				this >>= short_limit;
+			} );
+
+		long_limit
+			.time_limit( seconds{10}, failure );
+
+		short_limit
+			.time_limit( milliseconds{20}, short_expired );
+
+		short_expired
+			.on_enter( [this]{
+				ensure_elapsed( m_entered_at, milliseconds{20} );
+				ensure_or_die( hires_clock::now() - m_entered_at < seconds{5},
+						"timer wasn't rearmed for earlier deadline" );
+				so_5::send< next >( *this );
+			} )
+			.event< next >( [this]{
+				this >>= again;
+				so_5::send_delayed< leave >( *this, milliseconds{5} );
+			} );
+
+		again
+			.on_enter( [this]{ m_entered_at = hires_clock::now(); } )
+			.time_limit( milliseconds{20}, again_expired )
+			.event< leave >( [this]{
+				this >>= idle;
+				so_5::send_delayed< leave >( *this, milliseconds{60} );
+			} );
+
+		idle
+			.event< leave >( [this]{
+				m_second_attempt = true;
+				this >>= again;
+			} );
+
+		again_expired
+			.on_enter( [this]{
+				ensure_or_die( m_second_attempt,
+						"time limit must not expire on the first attempt" );
+				ensure_elapsed( m_entered_at, milliseconds{20} );
+
+				so_deregister_agent_coop_normally();
+			} );
+
+		failure
+			.on_enter( []{
+				ensure_or_die( false, "failure state must not be entered" );
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		this >>= bounce_a;
+		so_5::send_delayed< bounce >( *this, milliseconds{10} );
+	}
+
+private :
+	hires_clock::time_point m_entered_at;
+
+	unsigned int m_bounces = 0;
+
+	bool m_second_attempt = false;
+
+	void
+	do_bounce( const state_t & to )
+	{
+		if( ++m_bounces < total_bounces )
+			so_5::send_delayed< bounce >( *this, milliseconds{10} );
+
+		this >>= to;
+	}
+
+	static void
+	ensure_elapsed(
+		hires_clock::time_point from,
+		milliseconds expected )
+	{
+		const auto elapsed = hires_clock::now() - from;
+		ensure_or_die( elapsed >= expected,
+				"time limit expired too early: " +
+				std::to_string(
+						duration_cast< milliseconds >( elapsed ).count() ) +
+				"ms" );
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >();
+							} );
+					} );
+			},
+			20,
+			"lazy check of state's time_limit" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -12,4 +12,10 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/overloaded_mchain/prj.ut.rb" 
 	required_prj "#{path}/overloaded_mchain_2/prj.ut.rb" 
 	required_prj "#{path}/resend_periodic_signal_via_mhood/prj.ut.rb" 
+	required_prj "#{path}/hwheel_cascading/prj.ut.rb" 
+	required_prj "#{path}/sharded_timer_thread/prj.ut.rb" 
+	required_prj "#{path}/timer_with_inbox/prj.ut.rb" 
+	required_prj "#{path}/reschedule_timer/prj.ut.rb" 
+	required_prj "#{path}/coalescing_timer_thread/prj.ut.rb" 
+	required_prj "#{path}/timerfd_timer_thread/prj.ut.rb" 
 }
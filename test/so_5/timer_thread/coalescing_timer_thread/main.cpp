@@ -0,0 +1,199 @@
+/*
+ * A test for timer thread with coalescing of wakeups.
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+using hires_clock = steady_clock;
+
+struct delayed : public so_5::message_t
+{
+	size_t m_index;
+
+	delayed( size_t index ) : m_index( index ) {}
+};
+
+struct far_away : public so_5::message_t {};
+
+const auto slack = milliseconds( 20 );
+const size_t timers = 100;
+
+void
+do_test(
+	so_5::timer_engine_t engine,
+	// Timer wheels can fire a timer one time step earlier.
+	milliseconds tolerance )
+{
+	so_5::wrapped_env_t env;
+	auto ch = create_mchain( env );
+
+	auto timer = so_5::create_coalescing_timer_thread(
+			so_5::create_stderr_logger(), engine, slack );
+	timer->start();
+
+	// Timer thread goes to sleep for a long time.
+	auto far_id = timer->schedule(
+			typeid( far_away ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new far_away() ),
+			hours( 1 ),
+			hours::zero() );
+	this_thread::sleep_for( milliseconds( 50 ) );
+
+	// Timers with close deadlines. Every timer must be fired not
+	// earlier than its deadline (with respect to tolerance).
+	const auto started_at = hires_clock::now();
+	for( size_t i = 0; i != timers; ++i )
+		timer->schedule_anonymous(
+				typeid( delayed ),
+				ch->as_mbox(),
+				so_5::message_ref_t( new delayed( i ) ),
+				microseconds( 500 * i ),
+				milliseconds::zero() );
+
+	vector< bool > received( timers, false );
+	const auto r = receive(
+			from( ch ).handle_n( timers ).empty_timeout( seconds( 5 ) ),
+			[&]( const delayed & msg ) {
+				const auto elapsed = hires_clock::now() - started_at;
+				ensure_or_die( elapsed + tolerance >=
+							microseconds( 500 * msg.m_index ),
+						"timer is too early: " + to_string( msg.m_index ) );
+				received[ msg.m_index ] = true;
+			} );
+	ensure_or_die( timers == r.handled(),
+			"unexpected count of delayed messages: " +
+			to_string( r.handled() ) );
+	for( size_t i = 0; i != received.size(); ++i )
+		ensure_or_die( received[ i ], "message is lost: " + to_string( i ) );
+
+	// Periodic timer works with slack too.
+	auto periodic_id = timer->schedule(
+			typeid( delayed ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new delayed( 0 ) ),
+			milliseconds( 5 ),
+			milliseconds( 5 ) );
+	const auto p = receive(
+			from( ch ).handle_n( 5 ).empty_timeout( seconds( 5 ) ),
+			[]( const delayed & ) {} );
+	ensure_or_die( 5u == p.handled(), "periodic messages are lost" );
+	periodic_id.release();
+
+	far_id.release();
+
+	// Timers are removed after delivery of their messages.
+	for( int i = 0; i != 100; ++i )
+	{
+		const auto stats = timer->query_stats();
+		if( !stats.m_single_shot_count && !stats.m_periodic_count )
+			break;
+		this_thread::sleep_for( milliseconds( 10 ) );
+	}
+
+	const auto stats = timer->query_stats();
+	ensure_or_die( 0 == stats.m_single_shot_count &&
+			0 == stats.m_periodic_count,
+			"all timers must be removed" );
+
+	timer->finish();
+}
+
+// Messages from timers elapsed at one wakeup are delivered together.
+// But the order of messages for every mbox must be kept.
+void
+check_batch_delivery( so_5::timer_engine_t engine )
+{
+	so_5::wrapped_env_t env;
+	so_5::mchain_t chains[] = { create_mchain( env ), create_mchain( env ) };
+
+	auto timer = so_5::create_coalescing_timer_thread(
+			so_5::create_stderr_logger(), engine, slack );
+	timer->start();
+
+	// Deadlines are different but are very close. So all timers
+	// should be processed at the same wakeup.
+	for( size_t i = 0; i != timers; ++i )
+		timer->schedule_anonymous(
+				typeid( delayed ),
+				chains[ i % 2 ]->as_mbox(),
+				so_5::message_ref_t( new delayed( i ) ),
+				milliseconds( 5 ) + microseconds( 10 * i ),
+				milliseconds::zero() );
+
+	for( size_t c = 0; c != 2; ++c )
+	{
+		size_t expected = c;
+		const auto r = receive(
+				from( chains[ c ] ).handle_n( timers / 2 )
+					.empty_timeout( seconds( 5 ) ),
+				[&]( const delayed & msg ) {
+					ensure_or_die( expected == msg.m_index,
+							"unexpected message: " + to_string( msg.m_index ) +
+							", expected: " + to_string( expected ) );
+					expected += 2;
+				} );
+		ensure_or_die( timers / 2 == r.handled(),
+				"unexpected count of delayed messages: " +
+				to_string( r.handled() ) );
+	}
+
+	timer->finish();
+}
+
+void
+check_negative_slack()
+{
+	bool thrown = false;
+	try
+	{
+		so_5::create_coalescing_timer_thread(
+				so_5::create_stderr_logger(),
+				so_5::timer_engine_t::heap,
+				-milliseconds( 1 ) );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_invalid_timer_slack == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_invalid_timer_slack expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				do_test( so_5::timer_engine_t::wheel, milliseconds( 10 ) );
+				do_test( so_5::timer_engine_t::list, milliseconds::zero() );
+				do_test( so_5::timer_engine_t::heap, milliseconds::zero() );
+				do_test( so_5::timer_engine_t::hwheel, milliseconds( 10 ) );
+				check_batch_delivery( so_5::timer_engine_t::list );
+				check_batch_delivery( so_5::timer_engine_t::heap );
+				check_negative_slack();
+			},
+			60,
+			"timer thread with coalescing of wakeups" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * A test for cascading of timers between levels of hierarchical timer wheel.
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+using hires_clock = steady_clock;
+
+struct delayed { unsigned int m_delay; };
+
+struct periodic : public so_5::signal_t {};
+
+struct canceled : public so_5::signal_t {};
+
+struct finish : public so_5::signal_t {};
+
+// Small wheel for testing: 4 slots at every level, 3 levels, 1ms step.
+// Level 0 holds timers for 4ms, level 1 for 16ms, level 2 for 64ms.
+// Timers with bigger delays are cascaded several times from level 2.
+const unsigned int wheel_size = 4;
+const unsigned int levels = 3;
+
+class a_test_t : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::on_delayed )
+			.event< periodic >( &a_test_t::on_periodic )
+			.event< canceled >( &a_test_t::on_canceled )
+			.event< finish >( &a_test_t::on_finish );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		m_started_at = hires_clock::now();
+
+		for( auto d : m_delays )
+			so_5::send_delayed< delayed >( *this, milliseconds( d ), d );
+
+		m_periodic = so_5::send_periodic< periodic >( *this,
+				milliseconds( 5 ), milliseconds( 5 ) );
+
+		m_canceled = so_5::send_periodic< canceled >( *this,
+				milliseconds( 40 ), milliseconds::zero() );
+
+		so_5::send_delayed< finish >( *this, milliseconds( 300 ) );
+
+		// Must be removed from the wheel before its time.
+		m_canceled.release();
+	}
+
+private :
+	const vector< unsigned int > m_delays{
+			1, 3, 5, 7, 15, 17, 40, 63, 65, 100, 150, 250 };
+
+	hires_clock::time_point m_started_at;
+
+	vector< unsigned int > m_received;
+
+	unsigned int m_periodic_count = 0;
+
+	so_5::timer_id_t m_periodic;
+	so_5::timer_id_t m_canceled;
+
+	void
+	on_delayed( const delayed & msg )
+	{
+		const auto elapsed = duration_cast< milliseconds >(
+				hires_clock::now() - m_started_at ).count();
+
+		// Timer can't be processed earlier than one time step before
+		// its deadline.
+		ensure_or_die( elapsed + 1 >= msg.m_delay,
+				"timer is too early: delay=" + to_string( msg.m_delay ) +
+				", elapsed=" + to_string( elapsed ) );
+
+		m_received.push_back( msg.m_delay );
+	}
+
+	void
+	on_periodic()
+	{
+		++m_periodic_count;
+	}
+
+	void
+	on_canceled()
+	{
+		ensure_or_die( false, "canceled timer must not be fired" );
+	}
+
+	void
+	on_finish()
+	{
+		m_periodic.release();
+
+		ensure_or_die( m_delays == m_received,
+				"unexpected order or count of delayed messages: " +
+				to_string( m_received.size() ) );
+
+		ensure_or_die( m_periodic_count >= 20,
+				"too few periodic messages: " +
+				to_string( m_periodic_count ) );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env )
+				{
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >();
+					} );
+				},
+				[]( so_5::environment_params_t & params )
+				{
+					params.timer_thread(
+							so_5::timer_hwheel_factory(
+									wheel_size,
+									levels,
+									milliseconds( 1 ) ) );
+				} );
+		},
+		20,
+		"hierarchical timer wheel" );
+
+	return 0;
+}
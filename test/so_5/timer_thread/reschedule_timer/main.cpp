@@ -0,0 +1,124 @@
+/*
+ * A test for rescheduling of timers via timer_id_t::reschedule().
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+struct retransmit
+{
+	int m_attempt;
+};
+
+void
+receive_one( const so_5::mchain_t & ch, int expected_attempt )
+{
+	const auto r = receive(
+			from( ch ).handle_n( 1 ).empty_timeout( seconds( 5 ) ),
+			[expected_attempt]( const retransmit & msg ) {
+				ensure_or_die( expected_attempt == msg.m_attempt,
+						"unexpected message: " + to_string( msg.m_attempt ) );
+			} );
+	ensure_or_die( 1u == r.handled(), "message is not received" );
+}
+
+void
+do_test( so_5::timer_thread_factory_t factory )
+{
+	so_5::wrapped_env_t env{
+		[]( so_5::environment_t & ) {},
+		[&factory]( so_5::environment_params_t & params ) {
+			params.timer_thread( factory );
+		} };
+
+	auto ch = create_mchain( env );
+
+	// Timer is active. It must be canceled and scheduled again.
+	auto id = so_5::send_periodic< retransmit >(
+			env.environment(), ch->as_mbox(),
+			hours( 1 ), milliseconds::zero(), 0 );
+
+	ensure_or_die( id.reschedule( milliseconds( 20 ) ),
+			"active timer must be rescheduled" );
+	receive_one( ch, 0 );
+
+	// Timer is elapsed. The same message must be delivered again.
+	ensure_or_die( id.reschedule( milliseconds( 10 ) ),
+			"elapsed timer must be rescheduled" );
+	receive_one( ch, 0 );
+
+	// Timer becomes periodic.
+	id.reschedule( milliseconds( 5 ), milliseconds( 5 ) );
+	for( int i = 0; i != 3; ++i )
+		receive_one( ch, 0 );
+
+	// Periodic timer becomes single-shot.
+	id.reschedule( milliseconds( 5 ) );
+	this_thread::sleep_for( milliseconds( 100 ) );
+	// Messages from the periodic timer could be sent before reschedule.
+	receive( from( ch ).no_wait_on_empty(), []( const retransmit & ) {} );
+	this_thread::sleep_for( milliseconds( 50 ) );
+	ensure_or_die( 0u == ch->size(), "timer must be single-shot now" );
+
+	// Released timer can't be rescheduled.
+	id.release();
+	ensure_or_die( !id.reschedule( milliseconds( 5 ) ),
+			"released timer must not be rescheduled" );
+
+	// Empty timer_id can't be rescheduled.
+	so_5::timer_id_t empty;
+	ensure_or_die( !empty.reschedule( milliseconds( 5 ) ),
+			"empty timer_id must not be rescheduled" );
+
+	// Mutable message can't be delivered several times.
+	auto mutable_id = so_5::send_periodic< so_5::mutable_msg< retransmit > >(
+			env.environment(), ch->as_mbox(),
+			hours( 1 ), milliseconds::zero(), 0 );
+	bool thrown = false;
+	try
+	{
+		mutable_id.reschedule( milliseconds( 5 ) );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_mutable_msg_cannot_be_periodic == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_mutable_msg_cannot_be_periodic expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				do_test( so_5::timer_wheel_factory(
+						64, milliseconds( 1 ) ) );
+				do_test( so_5::timer_list_factory() );
+				do_test( so_5::timer_heap_factory() );
+				do_test( so_5::timer_hwheel_factory(
+						16, 3, milliseconds( 1 ) ) );
+				do_test( so_5::timer_with_inbox_factory() );
+				do_test( so_5::sharded_timer_factory( 2 ) );
+			},
+			60,
+			"rescheduling of timers" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * A test for sharded timer thread.
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+struct delayed : public so_5::message_t {};
+
+struct periodic : public so_5::message_t {};
+
+const size_t workers = 8;
+const size_t timers_per_worker = 100;
+
+void
+ensure_stats(
+	so_5::timer_thread_t & timer,
+	size_t single_shot,
+	size_t periodic )
+{
+	const auto stats = timer.query_stats();
+	ensure_or_die( single_shot == stats.m_single_shot_count,
+			"unexpected single-shot count: " +
+			to_string( stats.m_single_shot_count ) );
+	ensure_or_die( periodic == stats.m_periodic_count,
+			"unexpected periodic count: " +
+			to_string( stats.m_periodic_count ) );
+}
+
+void
+check_many_workers()
+{
+	so_5::wrapped_env_t env;
+	auto ch = create_mchain( env );
+
+	auto timer = so_5::create_sharded_timer_thread(
+			so_5::create_stderr_logger(), 4, so_5::timer_heap_factory() );
+	timer->start();
+
+	vector< vector< so_5::timer_id_t > > ids( workers );
+	vector< thread > threads;
+	for( size_t w = 0; w != workers; ++w )
+		threads.emplace_back( [&, w] {
+			for( size_t i = 0; i != timers_per_worker; ++i )
+			{
+				ids[ w ].push_back( timer->schedule(
+						typeid( periodic ),
+						ch->as_mbox(),
+						so_5::message_ref_t( new periodic() ),
+						hours( 1 ),
+						hours( 1 ) ) );
+
+				timer->schedule_anonymous(
+						typeid( delayed ),
+						ch->as_mbox(),
+						so_5::message_ref_t( new delayed() ),
+						milliseconds( 10 ),
+						milliseconds::zero() );
+			}
+		} );
+
+	for( auto & t : threads )
+		t.join();
+
+	// All delayed messages must be delivered.
+	const auto r = receive(
+			from( ch ).handle_n( workers * timers_per_worker )
+				.empty_timeout( seconds( 5 ) ),
+			[]( const delayed & ) {} );
+	ensure_or_die( workers * timers_per_worker == r.handled(),
+			"unexpected count of delayed messages: " +
+			to_string( r.handled() ) );
+
+	// Single-shot timers are removed after delivery of their messages.
+	for( int i = 0; i != 100 && timer->query_stats().m_single_shot_count; ++i )
+		this_thread::sleep_for( milliseconds( 10 ) );
+
+	ensure_stats( *timer, 0, workers * timers_per_worker );
+
+	// Timers are released from a thread other than the creator.
+	thread( [&] {
+		for( size_t w = 0; w != workers; w += 2 )
+			for( auto & id : ids[ w ] )
+				id.release();
+	} ).join();
+
+	ensure_stats( *timer, 0, workers * timers_per_worker / 2 );
+
+	ids.clear();
+	ensure_stats( *timer, 0, 0 );
+
+	timer->finish();
+}
+
+void
+check_zero_shards()
+{
+	bool thrown = false;
+	try
+	{
+		so_5::create_sharded_timer_thread(
+				so_5::create_stderr_logger(), 0, so_5::timer_heap_factory() );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_invalid_timer_shards_count == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_invalid_timer_shards_count expected" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_many_workers();
+				check_zero_shards();
+			},
+			20,
+			"sharded timer thread" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
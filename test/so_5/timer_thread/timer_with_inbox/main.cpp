@@ -0,0 +1,137 @@
+/*
+ * A test for timer thread with lock-free inbox.
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+struct delayed : public so_5::message_t
+{
+	size_t m_index;
+
+	delayed( size_t index ) : m_index( index ) {}
+};
+
+struct far_away : public so_5::message_t {};
+
+const size_t workers = 8;
+const size_t timers_per_worker = 100;
+
+void
+do_test( so_5::timer_engine_t engine )
+{
+	so_5::wrapped_env_t env;
+	auto ch = create_mchain( env );
+
+	auto timer = so_5::create_timer_thread_with_inbox(
+			so_5::create_stderr_logger(), engine );
+	timer->start();
+
+	// Timer thread goes to sleep for a long time.
+	auto far_id = timer->schedule(
+			typeid( far_away ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new far_away() ),
+			hours( 1 ),
+			hours::zero() );
+	this_thread::sleep_for( milliseconds( 50 ) );
+
+	// Timer thread must be woken up for the earlier timer.
+	const auto started_at = steady_clock::now();
+	timer->schedule_anonymous(
+			typeid( delayed ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new delayed( 0 ) ),
+			milliseconds( 20 ),
+			milliseconds::zero() );
+	receive( from( ch ).handle_n( 1 ).empty_timeout( seconds( 5 ) ),
+			[]( const delayed & ) {} );
+	ensure_or_die( steady_clock::now() - started_at < seconds( 2 ),
+			"timer thread wasn't woken up for earlier timer" );
+
+	// Many workers schedule timers at the same time.
+	vector< thread > threads;
+	for( size_t w = 0; w != workers; ++w )
+		threads.emplace_back( [&, w] {
+			for( size_t i = 0; i != timers_per_worker; ++i )
+				timer->schedule_anonymous(
+						typeid( delayed ),
+						ch->as_mbox(),
+						so_5::message_ref_t(
+								new delayed( w * timers_per_worker + i ) ),
+						milliseconds( i % 20 ),
+						milliseconds::zero() );
+		} );
+
+	for( auto & t : threads )
+		t.join();
+
+	vector< bool > received( workers * timers_per_worker, false );
+	const auto r = receive(
+			from( ch ).handle_n( workers * timers_per_worker )
+				.empty_timeout( seconds( 5 ) ),
+			[&received]( const delayed & msg ) {
+				received[ msg.m_index ] = true;
+			} );
+	ensure_or_die( workers * timers_per_worker == r.handled(),
+			"unexpected count of delayed messages: " +
+			to_string( r.handled() ) );
+	for( size_t i = 0; i != received.size(); ++i )
+		ensure_or_die( received[ i ], "message is lost: " + to_string( i ) );
+
+	// Cancellation of the timer which is still in the inbox.
+	auto id = timer->schedule(
+			typeid( delayed ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new delayed( 0 ) ),
+			milliseconds( 10 ),
+			milliseconds::zero() );
+	id.release();
+
+	far_id.release();
+
+	this_thread::sleep_for( milliseconds( 100 ) );
+	ensure_or_die( 0 == ch->size(), "canceled timer must not be fired" );
+
+	const auto stats = timer->query_stats();
+	ensure_or_die( 0 == stats.m_single_shot_count &&
+			0 == stats.m_periodic_count,
+			"all timers must be removed" );
+
+	timer->finish();
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				do_test( so_5::timer_engine_t::wheel );
+				do_test( so_5::timer_engine_t::list );
+				do_test( so_5::timer_engine_t::heap );
+				do_test( so_5::timer_engine_t::hwheel );
+			},
+			60,
+			"timer thread with lock-free inbox" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
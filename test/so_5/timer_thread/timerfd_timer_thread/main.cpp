@@ -0,0 +1,162 @@
+/*
+ * A test for timer thread which waits on Linux timerfd.
+ */
+
+#include <so_5/all.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+using hires_clock = steady_clock;
+
+struct delayed : public so_5::message_t {};
+
+struct periodic : public so_5::message_t {};
+
+struct far_away : public so_5::message_t {};
+
+#if defined(__linux__)
+
+void
+do_test( so_5::timer_engine_t engine )
+{
+	so_5::wrapped_env_t env;
+	auto ch = create_mchain( env );
+
+	auto timer = so_5::create_timerfd_timer_thread(
+			so_5::create_stderr_logger(), engine );
+	timer->start();
+
+	// Timer thread goes to sleep for a long time.
+	auto far_id = timer->schedule(
+			typeid( far_away ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new far_away() ),
+			hours( 1 ),
+			hours::zero() );
+	this_thread::sleep_for( milliseconds( 50 ) );
+
+	// Timer thread must be woken up for the earlier timer.
+	const auto started_at = hires_clock::now();
+	timer->schedule_anonymous(
+			typeid( delayed ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new delayed() ),
+			milliseconds( 20 ),
+			milliseconds::zero() );
+	const auto r = receive(
+			from( ch ).handle_n( 1 ).empty_timeout( seconds( 5 ) ),
+			[]( const delayed & ) {} );
+	ensure_or_die( 1u == r.handled(), "delayed message is not received" );
+	ensure_or_die( hires_clock::now() - started_at < seconds( 2 ),
+			"timer thread wasn't woken up for earlier timer" );
+
+	// Periodic timer.
+	auto periodic_id = timer->schedule(
+			typeid( periodic ),
+			ch->as_mbox(),
+			so_5::message_ref_t( new periodic() ),
+			milliseconds( 5 ),
+			milliseconds( 5 ) );
+	const auto p = receive(
+			from( ch ).handle_n( 5 ).empty_timeout( seconds( 5 ) ),
+			[]( const periodic & ) {} );
+	ensure_or_die( 5u == p.handled(), "periodic messages are lost" );
+	periodic_id.release();
+
+	far_id.release();
+
+	// Timers are removed after delivery of their messages.
+	for( int i = 0; i != 100; ++i )
+	{
+		const auto stats = timer->query_stats();
+		if( !stats.m_single_shot_count && !stats.m_periodic_count )
+			break;
+		this_thread::sleep_for( milliseconds( 10 ) );
+	}
+
+	const auto stats = timer->query_stats();
+	ensure_or_die( 0 == stats.m_single_shot_count &&
+			0 == stats.m_periodic_count,
+			"all timers must be removed" );
+
+	timer->finish();
+}
+
+void
+check_timer_factory()
+{
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			auto ch = create_mchain( env );
+			so_5::send_delayed< delayed >( env, ch->as_mbox(),
+					milliseconds( 10 ) );
+			const auto r = receive(
+					from( ch ).handle_n( 1 ).empty_timeout( seconds( 5 ) ),
+					[]( const delayed & ) {} );
+			ensure_or_die( 1u == r.handled(), "delayed message is not received" );
+			env.stop();
+		},
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timerfd_timer_factory() );
+		} );
+}
+
+void
+run_tests()
+{
+	do_test( so_5::timer_engine_t::wheel );
+	do_test( so_5::timer_engine_t::list );
+	do_test( so_5::timer_engine_t::heap );
+	do_test( so_5::timer_engine_t::hwheel );
+	check_timer_factory();
+}
+
+#else
+
+void
+run_tests()
+{
+	bool thrown = false;
+	try
+	{
+		so_5::create_timerfd_timer_thread(
+				so_5::create_stderr_logger(), so_5::timer_engine_t::heap );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		thrown = so_5::rc_timerfd_not_supported == x.error_code();
+	}
+	ensure_or_die( thrown, "rc_timerfd_not_supported expected" );
+}
+
+#endif
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				run_tests();
+			},
+			60,
+			"timer thread with timerfd" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
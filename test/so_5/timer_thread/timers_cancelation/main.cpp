@@ -127,6 +127,39 @@ main()
 		check_factory( "timer_heap_factory", so_5::timer_heap_factory() );
 		check_factory( "timer_heap_factory(2048)",
 				so_5::timer_heap_factory( 2048 ) );
+		check_factory( "timer_hwheel_factory", so_5::timer_hwheel_factory() );
+		check_factory( "timer_hwheel_factory(16,3,1ms)",
+				so_5::timer_hwheel_factory(
+						16, 3, std::chrono::milliseconds(1) ) );
+		check_factory( "timer_with_inbox_factory(wheel)",
+				so_5::timer_with_inbox_factory( so_5::timer_engine_t::wheel ) );
+		check_factory( "timer_with_inbox_factory(list)",
+				so_5::timer_with_inbox_factory( so_5::timer_engine_t::list ) );
+		check_factory( "timer_with_inbox_factory(heap)",
+				so_5::timer_with_inbox_factory( so_5::timer_engine_t::heap ) );
+		check_factory( "timer_with_inbox_factory(hwheel)",
+				so_5::timer_with_inbox_factory( so_5::timer_engine_t::hwheel ) );
+		check_factory( "coalescing_timer_factory(1ms)",
+				so_5::coalescing_timer_factory(
+						std::chrono::milliseconds(1) ) );
+		check_factory( "coalescing_timer_factory(10ms,wheel)",
+				so_5::coalescing_timer_factory(
+						std::chrono::milliseconds(10),
+						so_5::timer_engine_t::wheel ) );
+#if defined(__linux__)
+		check_factory( "timerfd_timer_factory(wheel)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::wheel ) );
+		check_factory( "timerfd_timer_factory(list)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::list ) );
+		check_factory( "timerfd_timer_factory(heap)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::heap ) );
+		check_factory( "timerfd_timer_factory(hwheel)",
+				so_5::timerfd_timer_factory( so_5::timer_engine_t::hwheel ) );
+#endif
+		check_factory( "sharded_timer_factory(4)",
+				so_5::sharded_timer_factory( 4 ) );
+		check_factory( "sharded_timer_factory(3,timer_wheel_factory)",
+				so_5::sharded_timer_factory( 3, so_5::timer_wheel_factory() ) );
 
 		return 0;
 	}
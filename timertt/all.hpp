@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -17,6 +18,7 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -25,9 +27,20 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <utility>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__linux__)
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+	#include <sys/timerfd.h>
+	#include <unistd.h>
+
+	#include <cerrno>
+	#include <cstring>
+#endif
+
 /*!
  * \brief Top-level project's namespace.
  */
@@ -377,6 +390,242 @@ struct default_actor_exception_handler
 	}
 };
 
+namespace details
+{
+
+//
+// pooled_object
+//
+/*!
+ * \brief A base class which recycles memory blocks of destroyed objects.
+ *
+ * Memory blocks of destroyed objects of type \a T are not returned to
+ * the heap. They are kept in free lists and reused for new objects of
+ * that type. It means that the steady-state creation and destruction of
+ * timer objects doesn't touch the heap.
+ *
+ * Every thread has its own free list for every type \a T. Because of that
+ * there is no synchronization in the usual case. But a timer object is
+ * often created on one thread and destroyed on another (e.g. on the timer
+ * thread). So free blocks are moved between threads via a shared depot.
+ * A thread gives a batch of batch_size blocks to the depot when its own
+ * list becomes too long and takes a batch from the depot when its own list
+ * is empty. So the depot's spinlock is acquired only once per batch_size
+ * allocations or deallocations.
+ *
+ * Free blocks of a thread are given to the depot (or returned to the heap)
+ * when the thread finishes.
+ *
+ * \tparam T type of object derived from this class.
+ *
+ * \since
+ * v.1.2.0
+ */
+template< typename T >
+class pooled_object
+{
+	//! Type of item in the free lists.
+	struct free_block
+	{
+		//! Next block in the list.
+		free_block * m_next;
+		//! Next batch in the depot.
+		/*!
+		 * Is used only by the first block of a batch in the depot.
+		 */
+		free_block * m_next_batch;
+	};
+
+	//! Free list of the current thread.
+	struct thread_cache
+	{
+		//! Head of the list.
+		free_block * m_head = nullptr;
+		//! Count of blocks in the list.
+		std::size_t m_size = 0;
+		//! Is the cache destroyed already?
+		/*!
+		 * Objects can be destroyed during the destruction of other
+		 * thread local variables.
+		 */
+		bool m_destroyed = false;
+
+		~thread_cache()
+		{
+			while( m_size >= batch_size )
+				give_batch();
+
+			free_list( m_head );
+			m_head = nullptr;
+			m_size = 0;
+			m_destroyed = true;
+		}
+
+		//! Give the first batch_size blocks to the depot.
+		void
+		give_batch()
+		{
+			free_block * first = m_head;
+			free_block * last = first;
+			for( std::size_t i = 1; i != batch_size; ++i )
+				last = last->m_next;
+
+			m_head = last->m_next;
+			m_size -= batch_size;
+			last->m_next = nullptr;
+
+			lock();
+			if( s_depot_batches < max_depot_batches )
+			{
+				first->m_next_batch = s_depot_head;
+				s_depot_head = first;
+				++s_depot_batches;
+				first = nullptr;
+			}
+			unlock();
+
+			// The batch is returned to the heap if the depot is full.
+			free_list( first );
+		}
+
+		//! Take a batch from the depot.
+		void
+		take_batch()
+		{
+			lock();
+			free_block * first = s_depot_head;
+			if( first )
+			{
+				s_depot_head = first->m_next_batch;
+				--s_depot_batches;
+			}
+			unlock();
+
+			if( first )
+			{
+				m_head = first;
+				m_size = batch_size;
+			}
+		}
+	};
+
+	//! Spinlock for the depot.
+	static std::atomic_flag s_lock;
+	//! Head of the list of batches in the depot.
+	static free_block * s_depot_head;
+	//! Count of batches in the depot.
+	static std::size_t s_depot_batches;
+
+	static void
+	lock()
+	{
+		while( s_lock.test_and_set( std::memory_order_acquire ) )
+			std::this_thread::yield();
+	}
+
+	static void
+	unlock()
+	{
+		s_lock.clear( std::memory_order_release );
+	}
+
+	static thread_cache &
+	cache()
+	{
+		static thread_local thread_cache instance;
+		return instance;
+	}
+
+	static void
+	free_list( free_block * b )
+	{
+		while( b )
+		{
+			free_block * next = b->m_next;
+			::operator delete( b );
+			b = next;
+		}
+	}
+
+public :
+	//! Count of blocks which are moved between a thread and the depot
+	//! at once.
+	static const std::size_t batch_size = 64;
+
+	//! Max count of free blocks to be kept by one thread.
+	static const std::size_t max_thread_blocks = 2 * batch_size;
+
+	//! Max count of batches to be kept in the depot.
+	static const std::size_t max_depot_batches = 64;
+
+	static void *
+	operator new( std::size_t size )
+	{
+		// Objects of derived types can't be placed into blocks of T.
+		if( sizeof( T ) == size )
+		{
+			thread_cache & c = cache();
+			if( !c.m_head && !c.m_destroyed )
+				c.take_batch();
+
+			if( free_block * b = c.m_head )
+			{
+				c.m_head = b->m_next;
+				--c.m_size;
+				return b;
+			}
+		}
+
+		return ::operator new( size );
+	}
+
+	static void
+	operator delete( void * p, std::size_t size )
+	{
+		static_assert( sizeof( T ) >= sizeof( free_block ),
+				"T is too small to be pooled" );
+
+		if( sizeof( T ) == size )
+		{
+			thread_cache & c = cache();
+			if( !c.m_destroyed )
+			{
+				if( max_thread_blocks == c.m_size )
+					c.give_batch();
+
+				auto b = static_cast< free_block * >( p );
+				b->m_next = c.m_head;
+				c.m_head = b;
+				++c.m_size;
+				return;
+			}
+		}
+
+		::operator delete( p );
+	}
+};
+
+template< typename T >
+std::atomic_flag pooled_object< T >::s_lock = ATOMIC_FLAG_INIT;
+
+template< typename T >
+typename pooled_object< T >::free_block *
+pooled_object< T >::s_depot_head = nullptr;
+
+template< typename T >
+std::size_t pooled_object< T >::s_depot_batches = 0;
+
+template< typename T >
+const std::size_t pooled_object< T >::batch_size;
+
+template< typename T >
+const std::size_t pooled_object< T >::max_thread_blocks;
+
+template< typename T >
+const std::size_t pooled_object< T >::max_depot_batches;
+
+} /* namespace details */
+
 //
 // timer_action
 //
@@ -421,6 +670,177 @@ struct timer_quantities
 	std::size_t m_periodic_count = { 0 };
 };
 
+//
+// lateness_histogram
+//
+/*!
+ * \brief Histogram of lateness of expired timers.
+ *
+ * Lateness is the difference between the time when a timer is detected
+ * as expired and the time when it had to expire. Negative values (a timer
+ * of timer_wheel can be detected as expired a bit earlier because of
+ * rounding to time steps) are counted as zero.
+ *
+ * Buckets have exponential widths: bucket 0 is for lateness less than
+ * 1us, bucket N is for lateness in [2^(N-1)us, 2^N us). The last bucket
+ * is for all greater values (approximately 4s and more).
+ *
+ * \since
+ * v.1.2.0
+ */
+struct lateness_histogram
+{
+	//! Count of buckets.
+	static const std::size_t bucket_count = 24;
+
+	//! Counts of values in every bucket.
+	std::array< std::uint64_t, bucket_count > m_buckets = {{}};
+
+	//! Index of bucket for a value.
+	static std::size_t
+	bucket_index( monotonic_clock::duration lateness )
+	{
+		const auto us = std::chrono::duration_cast<
+				std::chrono::microseconds >( lateness ).count();
+
+		std::size_t index = 0;
+		for( auto v = us; v > 0 && index + 1 < bucket_count; v >>= 1 )
+			++index;
+
+		return index;
+	}
+
+	//! Upper border (exclusive) of values in a bucket.
+	/*!
+	 * \note It is monotonic_clock::duration::max() for the last bucket.
+	 */
+	static monotonic_clock::duration
+	upper_border( std::size_t index )
+	{
+		if( index + 1 >= bucket_count )
+			return monotonic_clock::duration::max();
+
+		return std::chrono::duration_cast< monotonic_clock::duration >(
+				std::chrono::microseconds( std::int64_t{1} << index ) );
+	}
+
+	//! Add a value to the histogram.
+	void
+	add(
+		//! Value to be added.
+		monotonic_clock::duration lateness,
+		//! How many times the value must be added.
+		std::uint64_t count = 1 )
+	{
+		m_buckets[ bucket_index( lateness ) ] += count;
+	}
+
+	//! Total count of values in the histogram.
+	std::uint64_t
+	total() const
+	{
+		std::uint64_t r = 0;
+		for( auto c : m_buckets )
+			r += c;
+		return r;
+	}
+
+	//! Get an estimation for a percentile.
+	/*!
+	 * \return Upper border of the bucket in which the percentile is.
+	 * Zero if the histogram is empty.
+	 */
+	monotonic_clock::duration
+	percentile(
+		//! Percentile in range [0.0, 1.0].
+		double p ) const
+	{
+		const auto t = total();
+		if( !t )
+			return monotonic_clock::duration::zero();
+
+		const auto rank = static_cast< std::uint64_t >( p * t );
+		std::uint64_t seen = 0;
+		for( std::size_t i = 0; i != bucket_count; ++i )
+		{
+			seen += m_buckets[ i ];
+			if( seen > rank )
+				return upper_border( i );
+		}
+
+		return upper_border( bucket_count - 1 );
+	}
+};
+
+//
+// engine_stats
+//
+/*!
+ * \brief Statistics about work of timer engine.
+ *
+ * Values of histogram and counters are accumulated since the creation
+ * of the engine. Maximums are accumulated since the previous query of
+ * statistics. Occupancy of slots is calculated at the moment of query
+ * and it is collected only by timer_wheel and timer_hwheel engines.
+ *
+ * \since
+ * v.1.2.0
+ */
+struct engine_stats
+{
+	//! Lateness of expired timers.
+	lateness_histogram m_lateness;
+
+	//! Count of time steps (or processing rounds for timer_list and
+	//! timer_heap) with at least one expired timer.
+	std::uint64_t m_ticks_with_expired_timers = { 0 };
+
+	//! Max count of timers expired at one time step.
+	std::size_t m_max_expired_per_tick = { 0 };
+
+	//! Total time of holding the lock by timer thread.
+	monotonic_clock::duration m_lock_hold_time =
+			monotonic_clock::duration::zero();
+
+	//! Max time of one holding of the lock by timer thread.
+	monotonic_clock::duration m_max_lock_hold_time =
+			monotonic_clock::duration::zero();
+
+	//! Count of slots of the wheel with at least one timer.
+	std::size_t m_occupied_slots = { 0 };
+
+	//! Max count of timers in one slot of the wheel.
+	std::size_t m_max_slot_occupancy = { 0 };
+};
+
+//
+// submission_mode
+//
+/*!
+ * \brief A way of passing activation/deactivation requests to timer thread.
+ *
+ * \since
+ * v.1.2.0
+ */
+enum class submission_mode
+{
+	//! Requests are handled on the caller's context under timer thread's lock.
+	locked,
+	//! Activation requests are pushed into lock-free inbox and handled
+	//! by timer thread.
+	/*!
+	 * Timer thread handles the content of inbox before processing of
+	 * expired timers. The lock is acquired by the caller only if
+	 * timer thread must be woken up earlier.
+	 *
+	 * Deactivation is still performed under the lock.
+	 *
+	 * Errors detected during handling of requests (like an attempt
+	 * to activate already active timer) are reported via error logger.
+	 */
+	inbox
+};
+
 /*!
  * \brief An internal namespace with implementation details.
  */
@@ -500,88 +920,247 @@ public :
 		return this->m_timer_quantities;
 	}
 
-protected :
-	//! Error logger.
-	ERROR_LOGGER m_error_logger;
+	/*!
+	 * \brief Get the statistics and reset maximums.
+	 *
+	 * \note Occupancy of slots is not filled here. It is done by
+	 * fill_occupancy().
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	engine_stats
+	take_engine_stats()
+	{
+		engine_stats result = this->m_engine_stats;
 
-	//! Exception handler.
-	ACTOR_EXCEPTION_HANDLER m_exception_handler;
+		this->m_engine_stats.m_max_expired_per_tick = 0;
+		this->m_engine_stats.m_max_lock_hold_time =
+				monotonic_clock::duration::zero();
+
+		return result;
+	}
 
 	/*!
-	 * \brief Quantities of timers of various types.
+	 * \brief Fill up occupancy of slots in \a stats.
+	 *
+	 * Does nothing here. Engines with wheels define their own versions.
 	 *
 	 * \since
-	 * v.1.1.1
+	 * v.1.2.0
 	 */
-	timer_quantities m_timer_quantities;
+	void
+	fill_occupancy( engine_stats & /*stats*/ ) const
+	{}
 
 	/*!
-	 * \brief Helper method for increment the count of timers of
-	 * the specific type.
+	 * \brief Account one holding of the lock by timer thread.
+	 *
+	 * \attention Must be called under the lock.
 	 *
 	 * \since
-	 * v.1.1.1
+	 * v.1.2.0
 	 */
 	void
-	inc_timer_count( timer_kind kind )
+	register_lock_hold( monotonic_clock::duration hold_time )
 	{
-		if( timer_kind::single_shot == kind )
-			++m_timer_quantities.m_single_shot_count;
-		else
-			++m_timer_quantities.m_periodic_count;
+		this->m_engine_stats.m_lock_hold_time += hold_time;
+		if( this->m_engine_stats.m_max_lock_hold_time < hold_time )
+			this->m_engine_stats.m_max_lock_hold_time = hold_time;
 	}
 
 	/*!
-	 * \brief Helper method for decrement the count of timers of
-	 * the specific type.
+	 * \brief Log an error via error logger.
 	 *
 	 * \since
-	 * v.1.1.1
+	 * v.1.2.0
 	 */
 	void
-	dec_timer_count( timer_kind kind )
+	log_error( const std::string & what )
 	{
-		if( timer_kind::single_shot == kind )
-			--m_timer_quantities.m_single_shot_count;
-		else
-			--m_timer_quantities.m_periodic_count;
+		this->m_error_logger( what );
 	}
 
 	/*!
-	 * \brief Helper method for reseting quantities of timers to zero.
+	 * \brief Turn on/off compensation of time steps which are already
+	 * passed but not processed yet.
+	 *
+	 * Such compensation is necessary only if timer thread can wake up
+	 * later than the next time step (e.g. when there is a slack for
+	 * wakeups of timer thread). It requires an additional reading of
+	 * the clock for every activation of a timer. Because of that it is
+	 * turned off by default.
+	 *
+	 * \attention Must be called before the start of timer thread.
 	 *
 	 * \since
-	 * v.1.1.1
+	 * v.1.2.0
 	 */
 	void
-	reset_timer_count()
+	set_missed_ticks_compensation( bool enabled )
 	{
-		m_timer_quantities = timer_quantities{};
+		this->m_compensate_missed_ticks = enabled;
 	}
-};
-
-//
-// timer_wheel_engine_defaults
-//
-/*!
- * \brief Container for static method with default values for
- * timer_wheel engine.
- *
- * \since
- * v.1.1.0
- */
-struct timer_wheel_engine_defaults
-{
-	//! Default wheel size.
-	inline static unsigned int
-	default_wheel_size() { return 1000; }
 
-	//! Default tick duration.
-	inline static monotonic_clock::duration
-	default_granularity() { return std::chrono::milliseconds( 10 ); }
-};
+	/*!
+	 * \brief Execute an action with the same handling of exceptions
+	 * as for actions of timers.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	void
+	safe_execute( const timer_action & action )
+	{
+		try
+		{
+			action();
+		}
+		catch( const std::exception & x )
+		{
+			this->m_exception_handler( x );
+		}
+		catch( ... )
+		{
+			std::ostringstream ss;
+			ss << __FILE__ << "(" << __LINE__ 
+				<< "): an unknown exception from timer action";
+			this->m_error_logger( ss.str() );
+			std::abort();
+		}
+	}
 
-//
+protected :
+	//! Error logger.
+	ERROR_LOGGER m_error_logger;
+
+	//! Exception handler.
+	ACTOR_EXCEPTION_HANDLER m_exception_handler;
+
+	/*!
+	 * \brief Quantities of timers of various types.
+	 *
+	 * \since
+	 * v.1.1.1
+	 */
+	timer_quantities m_timer_quantities;
+
+	/*!
+	 * \brief Statistics about work of the engine.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	engine_stats m_engine_stats;
+
+	/*!
+	 * \brief Should missed time steps be added to the pause of
+	 * a new timer?
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	bool m_compensate_missed_ticks = false;
+
+	/*!
+	 * \brief Helper method for accounting lateness of expired timers.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	void
+	register_lateness(
+		monotonic_clock::duration lateness,
+		std::uint64_t count = 1 )
+	{
+		this->m_engine_stats.m_lateness.add( lateness, count );
+	}
+
+	/*!
+	 * \brief Helper method for accounting count of timers expired
+	 * at one time step.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	void
+	register_tick( std::size_t expired )
+	{
+		if( expired )
+		{
+			++this->m_engine_stats.m_ticks_with_expired_timers;
+			if( this->m_engine_stats.m_max_expired_per_tick < expired )
+				this->m_engine_stats.m_max_expired_per_tick = expired;
+		}
+	}
+
+	/*!
+	 * \brief Helper method for increment the count of timers of
+	 * the specific type.
+	 *
+	 * \since
+	 * v.1.1.1
+	 */
+	void
+	inc_timer_count( timer_kind kind )
+	{
+		if( timer_kind::single_shot == kind )
+			++m_timer_quantities.m_single_shot_count;
+		else
+			++m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Helper method for decrement the count of timers of
+	 * the specific type.
+	 *
+	 * \since
+	 * v.1.1.1
+	 */
+	void
+	dec_timer_count( timer_kind kind )
+	{
+		if( timer_kind::single_shot == kind )
+			--m_timer_quantities.m_single_shot_count;
+		else
+			--m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Helper method for reseting quantities of timers to zero.
+	 *
+	 * \since
+	 * v.1.1.1
+	 */
+	void
+	reset_timer_count()
+	{
+		m_timer_quantities = timer_quantities{};
+	}
+};
+
+//
+// timer_wheel_engine_defaults
+//
+/*!
+ * \brief Container for static method with default values for
+ * timer_wheel engine.
+ *
+ * \since
+ * v.1.1.0
+ */
+struct timer_wheel_engine_defaults
+{
+	//! Default wheel size.
+	inline static unsigned int
+	default_wheel_size() { return 1000; }
+
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
+};
+
+//
 // timer_wheel_engine
 //
 
@@ -708,7 +1287,7 @@ public :
 		// Calculate the demand position in the wheel.
 		set_position_in_the_wheel(
 				wheel_timer,
-				duration_to_ticks( pause ) );
+				duration_to_ticks( pause ) + missed_ticks() );
 
 		// Special calculations for the periodic demand.
 		if( monotonic_clock::duration::zero() != period )
@@ -727,6 +1306,60 @@ public :
 				this->m_timer_quantities.m_periodic_count;
 	}
 
+	//! Activate timer again with the same action.
+	/*!
+	 * The timer is deactivated first if it is active. Then it is activated
+	 * with new pause and period and with the action from the previous
+	 * activation. There is no need to allocate a new timer object.
+	 *
+	 * The only exception is the case when the action of the timer is
+	 * being executed right now. The timer can't be reused in that case.
+	 * It is deactivated and a new timer object is activated instead.
+	 *
+	 * \return A timer object which is active now (\a timer or a new one)
+	 * and the value which activate() returns for it.
+	 *
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	std::pair< timer_object_holder< THREAD_SAFETY >, bool >
+	reactivate(
+		//! Timer to be activated again.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		DURATION_2 period )
+	{
+		auto * t = timer.template cast_to< timer_type >();
+		if( !t->m_action )
+			throw std::runtime_error( "timer has no action to be reactivated" );
+
+		if( timer_status::active == t->m_status )
+			deactivate( timer );
+
+		if( timer_status::deactivated == t->m_status )
+		{
+			timer_action action = std::move( t->m_action );
+			const bool r = activate( timer, pause, period, std::move( action ) );
+			return std::make_pair( std::move( timer ), r );
+		}
+
+		// The timer is in the execution list.
+		auto fresh = allocate();
+		timer_action action = t->m_action;
+		deactivate( timer );
+
+		const bool r = activate( fresh, pause, period, std::move( action ) );
+		return std::make_pair( std::move( fresh ), r );
+	}
+
 	//! Deactivate timer and remove it from the wheel.
 	void
 	deactivate( timer_object_holder< THREAD_SAFETY > timer )
@@ -775,7 +1408,10 @@ public :
 		{
 			if( !m_current_tick_processed )
 			{
-				process_current_wheel_position( lock );
+				// The current time step had to be started at
+				// the previous border.
+				process_current_wheel_position( lock,
+						now - ( m_current_tick_border - m_granularity ) );
 
 				// After processing all current demands and rescheduling
 				// all periodic demands the current_position must be
@@ -849,9 +1485,29 @@ public :
 		this->m_current_position = 0;
 	}
 
+	/*!
+	 * \brief Fill up occupancy of slots of the wheel.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	void
+	fill_occupancy( engine_stats & stats ) const
+	{
+		for( const auto & item : m_wheel )
+			if( item.m_count )
+			{
+				++stats.m_occupied_slots;
+				if( stats.m_max_slot_occupancy < item.m_count )
+					stats.m_max_slot_occupancy = item.m_count;
+			}
+	}
+
 private :
 	//! Type of wheel timer.
-	struct timer_type : public timer_object< THREAD_SAFETY >
+	struct timer_type
+		:	public timer_object< THREAD_SAFETY >
+		,	public pooled_object< timer_type >
 	{
 		//! Status of the timer.
 		typename threading_traits< THREAD_SAFETY >::status_holder_type m_status;
@@ -900,6 +1556,14 @@ private :
 		timer_type * m_head = nullptr;
 		//! Tail of the demand's list.
 		timer_type * m_tail = nullptr;
+
+		/*!
+		 * \brief Count of timers in the list.
+		 *
+		 * \since
+		 * v.1.2.0
+		 */
+		std::size_t m_count = 0;
 	};
 
 	/*!
@@ -979,6 +1643,38 @@ private :
 		return r;
 	}
 
+	/*!
+	 * \brief Count of time steps which are already passed but not
+	 * processed yet.
+	 *
+	 * These time steps will be processed at the next call to
+	 * process_expired_timers() without any waiting. It is possible if
+	 * process_expired_timers() is called less often than once per time
+	 * step (e.g. when there is a slack for wakeups of timer thread).
+	 * Such time steps must be added to the pause of a new timer.
+	 * Otherwise the timer will be processed too early.
+	 *
+	 * \note Always returns 0 if compensation of missed time steps is
+	 * not turned on (see engine_common::set_missed_ticks_compensation()).
+	 * It allows to avoid reading of the clock for every activation.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	unsigned int
+	missed_ticks() const
+	{
+		if( !this->m_compensate_missed_ticks )
+			return 0;
+
+		const auto now = monotonic_clock::now();
+		if( now < m_current_tick_border )
+			return 0;
+
+		return static_cast< unsigned int >(
+				( now - m_current_tick_border ) / m_granularity ) + 1;
+	}
+
 	/*!
 	 * \brief Calculate and fill up wheel position for the timer.
 	 *
@@ -1007,6 +1703,7 @@ private :
 	insert_demand_to_wheel( timer_type * wheel_timer )
 	{
 		wheel_item & item = m_wheel[ wheel_timer->m_position ];
+		++item.m_count;
 		if( item.m_head )
 		{
 			// There is a list of demands for the wheel position.
@@ -1032,6 +1729,8 @@ private :
 	void
 	remove_timer_from_wheel( timer_type * wheel_timer )
 	{
+		--m_wheel[ wheel_timer->m_position ].m_count;
+
 		if( wheel_timer->m_prev )
 			wheel_timer->m_prev->m_next = wheel_timer->m_next;
 		else
@@ -1052,9 +1751,16 @@ private :
 	template< class UNIQUE_LOCK >
 	void
 	process_current_wheel_position(
-		UNIQUE_LOCK & lock )
+		UNIQUE_LOCK & lock,
+		//! Lateness of processing of the current time step.
+		monotonic_clock::duration lateness )
 	{
-		timer_type * exec_list_head = make_exec_list();
+		std::size_t expired = 0;
+		timer_type * exec_list_head = make_exec_list( expired );
+
+		this->register_tick( expired );
+		if( expired )
+			this->register_lateness( lateness, expired );
 
 		if( exec_list_head )
 		{
@@ -1068,7 +1774,9 @@ private :
 	 * \brief Make list of elapsed timers to be executed.
 	 */
 	timer_type *
-	make_exec_list()
+	make_exec_list(
+		//! Receiver for count of timers in the list.
+		std::size_t & count )
 	{
 		timer_type * head = nullptr;
 		timer_type * tail = nullptr;
@@ -1088,6 +1796,7 @@ private :
 
 				remove_timer_from_wheel( t );
 				t->m_status = timer_status::wait_for_execution;
+				++count;
 
 				if( head )
 				{
@@ -1344,6 +2053,60 @@ public :
 		return list_timer == m_head;
 	}
 
+	//! Activate timer again with the same action.
+	/*!
+	 * The timer is deactivated first if it is active. Then it is activated
+	 * with new pause and period and with the action from the previous
+	 * activation. There is no need to allocate a new timer object.
+	 *
+	 * The only exception is the case when the action of the timer is
+	 * being executed right now. The timer can't be reused in that case.
+	 * It is deactivated and a new timer object is activated instead.
+	 *
+	 * \return A timer object which is active now (\a timer or a new one)
+	 * and the value which activate() returns for it.
+	 *
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	std::pair< timer_object_holder< THREAD_SAFETY >, bool >
+	reactivate(
+		//! Timer to be activated again.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		DURATION_2 period )
+	{
+		auto * t = timer.template cast_to< timer_type >();
+		if( !t->m_action )
+			throw std::runtime_error( "timer has no action to be reactivated" );
+
+		if( timer_status::active == t->m_status )
+			deactivate( timer );
+
+		if( timer_status::deactivated == t->m_status )
+		{
+			timer_action action = std::move( t->m_action );
+			const bool r = activate( timer, pause, period, std::move( action ) );
+			return std::make_pair( std::move( timer ), r );
+		}
+
+		// The timer is in the execution list.
+		auto fresh = allocate();
+		timer_action action = t->m_action;
+		deactivate( timer );
+
+		const bool r = activate( fresh, pause, period, std::move( action ) );
+		return std::make_pair( std::move( fresh ), r );
+	}
+
 	//! Deactivate timer and remove it from the list.
 	void
 	deactivate(
@@ -1439,7 +2202,9 @@ public :
 
 private :
 	//! Type of list timer.
-	struct timer_type : public timer_object< THREAD_SAFETY >
+	struct timer_type
+		:	public timer_object< THREAD_SAFETY >
+		,	public pooled_object< timer_type >
 	{
 		//! Status of the timer.
 		typename threading_traits< THREAD_SAFETY >::status_holder_type m_status;
@@ -1593,12 +2358,17 @@ private :
 		const auto now = monotonic_clock::now();
 
 		// Search the first not-elapsed-yet timer.
+		std::size_t expired = 0;
 		while( tail && now >= tail->m_when )
 		{
 			tail->m_status = timer_status::wait_for_execution;
+			this->register_lateness( now - tail->m_when );
+			++expired;
 			tail = tail->m_next;
 		}
 
+		this->register_tick( expired );
+
 		if( tail == m_head )
 			// There is no elapsed timers.
 			return nullptr;
@@ -1847,6 +2617,59 @@ public :
 		return heap_timer == heap_head();
 	}
 
+	//! Activate timer again with the same action.
+	/*!
+	 * The timer is deactivated first if it is active. Then it is activated
+	 * with new pause and period and with the action from the previous
+	 * activation. There is no need to allocate a new timer object.
+	 *
+	 * The only exception is the case when the action of the timer is
+	 * being executed right now. The timer can't be reused in that case.
+	 * It is deactivated and a new timer object is activated instead.
+	 *
+	 * \return A timer object which is active now (\a timer or a new one)
+	 * and the value which activate() returns for it.
+	 *
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	std::pair< timer_object_holder< THREAD_SAFETY >, bool >
+	reactivate(
+		//! Timer to be activated again.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		DURATION_2 period )
+	{
+		auto * t = timer.template cast_to< timer_type >();
+		if( !t->m_action )
+			throw std::runtime_error( "timer has no action to be reactivated" );
+
+		if( t != m_timer_in_processing )
+		{
+			deactivate( timer );
+
+			timer_action action = std::move( t->m_action );
+			const bool r = activate( timer, pause, period, std::move( action ) );
+			return std::make_pair( std::move( timer ), r );
+		}
+
+		// The action of the timer is being executed right now.
+		auto fresh = allocate();
+		timer_action action = t->m_action;
+		deactivate( timer );
+
+		const bool r = activate( fresh, pause, period, std::move( action ) );
+		return std::make_pair( std::move( fresh ), r );
+	}
+
 	//! Deactivate timer and remove it from the list.
 	void
 	deactivate(
@@ -1899,11 +2722,15 @@ public :
 	{
 		// Process timers in loop until there are elapsed timers.
 		const auto now = monotonic_clock::now();
+		std::size_t expired = 0;
 		while( !heap_empty() && now > heap_head()->m_when )
 		{
 			m_timer_in_processing = heap_head();
 			heap_remove( m_timer_in_processing );
 
+			this->register_lateness( now - m_timer_in_processing->m_when );
+			++expired;
+
 			execute_timer_in_processing( lock );
 
 			// If timer has become deactive it must be removed even
@@ -1928,6 +2755,8 @@ public :
 
 			m_timer_in_processing = nullptr;
 		}
+
+		this->register_tick( expired );
 	}
 
 	/*!
@@ -1968,7 +2797,9 @@ public :
 
 private :
 	//! Type of heap timer.
-	struct timer_type : public timer_object< THREAD_SAFETY >
+	struct timer_type
+		:	public timer_object< THREAD_SAFETY >
+		,	public pooled_object< timer_type >
 	{
 		//! A special value which means that timer is deactivated.
 		/*!
@@ -2191,279 +3022,1936 @@ private :
 };
 
 //
-// thread_unsafe_manager_mixin
+// timer_hwheel_engine_defaults
 //
-
 /*!
- * \brief A mixin which must be used as base class for not-thread-safe
- * timer managers.
+ * \brief Container for static method with default values for
+ * hierarchical timer_wheel engine.
  *
  * \since
- * v.1.1.0
+ * v.1.2.0
  */
-struct thread_unsafe_manager_mixin
+struct timer_hwheel_engine_defaults
 {
-	//! A empty class for an object's lock emulation.
-	/*!
-	 * Instance of that class will be used in not-thread-safe
-	 * code in places where object's lock is necessary.
-	 *
-	 * Because this class is empty its usage will be removed by
-	 * optimized compiler.
-	 */
-	class lock_guard
-	{
-	public :
-		lock_guard( thread_unsafe_manager_mixin & ) {}
-
-		void lock() {}
-		void unlock() {}
-	};
+	//! Default size of a wheel at every level.
+	inline static unsigned int
+	default_wheel_size() { return 256; }
 
-	void
-	ensure_started() {}
+	//! Default count of levels.
+	inline static unsigned int
+	default_levels() { return 4; }
 
-	void
-	notify() {}
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
 };
 
 //
-// thread_safe_manager_mixin
+// timer_hwheel_engine
 //
+
 /*!
- * \brief A mixin which must be used as base class for thread-safe
- * timer managers.
+ * \brief A engine for hierarchical timer wheel mechanism.
  *
- * \since
+ * This class uses hierarchical timer wheel mechanism. There are several
+ * wheels (levels) of the same size. A slot at the level 0 corresponds to
+ * one time step. A slot at the level N corresponds to
+ * <tt>wheel_size^N</tt> time steps.
+ *
+ * A timer is placed to the lowest level which can hold it. When
+ * a slot of the level N is reached all timers from it are moved
+ * (cascaded) to the lower levels. It means that a long-living timer
+ * is moved only several times (no more than count of levels) instead of
+ * being revisited at every revolution of a single-level wheel.
+ *
+ * For example, with the default parameters (4 levels of 256 slots,
+ * 10ms granularity) the level 0 holds timers for 2.56s, the level 1
+ * holds timers for 655s and so on.
+ *
+ * If a timer is too far for the highest level it is placed to the highest
+ * level and it is revisited at every revolution of the highest level.
+ *
+ * Like timer_wheel_engine this engine requires that timer thread is working
+ * always when there are some timers. But the engine doesn't try to process
+ * all missed time steps after a period without timers.
+ *
+ * \tparam THREAD_SAFETY Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.0
+ */
+template<
+	typename THREAD_SAFETY,
+	typename ERROR_LOGGER,
+	typename ACTOR_EXCEPTION_HANDLER >
+class timer_hwheel_engine
+	:	public engine_common<
+			THREAD_SAFETY, ERROR_LOGGER, ACTOR_EXCEPTION_HANDLER >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			THREAD_SAFETY, ERROR_LOGGER, ACTOR_EXCEPTION_HANDLER >;
+
+	//! Type for absolute number of time step.
+	using tick_type = std::uint_least64_t;
+
+public :
+	//! Type with default parameters for this engine.
+	typedef timer_hwheel_engine_defaults defaults_type;
+
+	//! Constructor with all parameters.
+	/*!
+	 * \throw std::exception if \a wheel_size is less than 2 or
+	 * \a levels is zero.
+	 */
+	timer_hwheel_engine(
+		//! Size of the wheel at every level.
+		unsigned int wheel_size,
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of time step for the timer_wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_wheel_size( wheel_size )
+		,	m_granularity( granularity )
+	{
+		if( wheel_size < 2 )
+			throw std::invalid_argument( "wheel_size must be greater than 1" );
+		if( !levels )
+			throw std::invalid_argument( "levels must be greater than 0" );
+
+		// Spans of levels are calculated with respect to overflow.
+		// Levels with overflowed spans are useless.
+		tick_type span = 1;
+		for( unsigned int l = 0; l != levels; ++l )
+		{
+			m_levels.emplace_back( wheel_size, span );
+
+			if( span > std::numeric_limits< tick_type >::max() / wheel_size )
+				break;
+			span *= wheel_size;
+		}
+
+		m_current_tick_border = monotonic_clock::now() + m_granularity;
+	}
+
+	//! Destructor.
+	~timer_hwheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< THREAD_SAFETY >
+	allocate()
+	{
+		return timer_object_holder< THREAD_SAFETY >( new timer_type() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned only when the first timer is added to
+	 * the empty wheel.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		// There is no need to process time steps missed during a period
+		// without timers. The current time step is started from now.
+		if( empty() )
+		{
+			m_current_tick_border = monotonic_clock::now() + m_granularity;
+			m_current_tick_processed = false;
+		}
+
+		wheel_timer->m_action = std::move(action);
+
+		// Timer must be taken under control.
+		timer_object< THREAD_SAFETY >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		wheel_timer->m_expiration = m_current_tick +
+				duration_to_ticks( pause ) + missed_ticks();
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		insert_timer_to_wheel( wheel_timer );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+
+		// If wheel was empty and this is the first timer added
+		// the value of timer_count must be exactly 1.
+		return 1 == this->m_timer_quantities.m_single_shot_count +
+				this->m_timer_quantities.m_periodic_count;
+	}
+
+	//! Activate timer again with the same action.
+	/*!
+	 * The timer is deactivated first if it is active. Then it is activated
+	 * with new pause and period and with the action from the previous
+	 * activation. There is no need to allocate a new timer object.
+	 *
+	 * The only exception is the case when the action of the timer is
+	 * being executed right now. The timer can't be reused in that case.
+	 * It is deactivated and a new timer object is activated instead.
+	 *
+	 * \return A timer object which is active now (\a timer or a new one)
+	 * and the value which activate() returns for it.
+	 *
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	std::pair< timer_object_holder< THREAD_SAFETY >, bool >
+	reactivate(
+		//! Timer to be activated again.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		DURATION_2 period )
+	{
+		auto * t = timer.template cast_to< timer_type >();
+		if( !t->m_action )
+			throw std::runtime_error( "timer has no action to be reactivated" );
+
+		if( timer_status::active == t->m_status )
+			deactivate( timer );
+
+		if( timer_status::deactivated == t->m_status )
+		{
+			timer_action action = std::move( t->m_action );
+			const bool r = activate( timer, pause, period, std::move( action ) );
+			return std::make_pair( std::move( timer ), r );
+		}
+
+		// The timer is in the execution list.
+		auto fresh = allocate();
+		timer_action action = t->m_action;
+		deactivate( timer );
+
+		const bool r = activate( fresh, pause, period, std::move( action ) );
+		return std::make_pair( std::move( fresh ), r );
+	}
+
+	//! Deactivate timer and remove it from the wheel.
+	void
+	deactivate( timer_object_holder< THREAD_SAFETY > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_wheel( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< THREAD_SAFETY >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Build sublist of elapsed timers and process them all.
+	 */
+	template< typename UNIQUE_LOCK >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		UNIQUE_LOCK & lock )
+	{
+		// NOTE: several time steps can be processed at once.
+		// See timer_wheel_engine::process_expired_timers() for details.
+		const auto now = monotonic_clock::now();
+		for(;;)
+		{
+			if( !m_current_tick_processed )
+			{
+				// The current time step had to be started at
+				// the previous border.
+				process_current_tick( lock,
+						now - ( m_current_tick_border - m_granularity ) );
+
+				m_current_tick += 1;
+				m_current_tick_processed = true;
+			}
+
+			if( now >= m_current_tick_border )
+			{
+				// A switch to next tick is necessary.
+				m_current_tick_border += m_granularity;
+				m_current_tick_processed = false;
+			}
+			else
+				break;
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next timer.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		if( !m_current_tick_processed )
+			return monotonic_clock::now();
+		else
+			return m_current_tick_border;
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & level : m_levels )
+			for( auto & item : level.m_slots )
+			{
+				timer_type * timer = item.m_head;
+				item = wheel_item();
+
+				while( timer )
+				{
+					timer_type * t = timer;
+					timer = timer->m_next;
+
+					t->m_status = timer_status::deactivated;
+					timer_object< THREAD_SAFETY >::decrement_references( t );
+				}
+			}
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_current_tick_border = monotonic_clock::now() + m_granularity;
+		this->m_current_tick = 0;
+		this->m_current_tick_processed = false;
+	}
+
+	/*!
+	 * \brief Fill up occupancy of slots of all levels of the wheel.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	void
+	fill_occupancy( engine_stats & stats ) const
+	{
+		for( const auto & level : m_levels )
+			for( const auto & item : level.m_slots )
+				if( item.m_count )
+				{
+					++stats.m_occupied_slots;
+					if( stats.m_max_slot_occupancy < item.m_count )
+						stats.m_max_slot_occupancy = item.m_count;
+				}
+	}
+
+private :
+	//! Type of wheel timer.
+	struct timer_type
+		:	public timer_object< THREAD_SAFETY >
+		,	public pooled_object< timer_type >
+	{
+		//! Status of the timer.
+		typename threading_traits< THREAD_SAFETY >::status_holder_type m_status;
+
+		//! Number of time step at which timer must be executed.
+		tick_type m_expiration = 0;
+
+		//! Level of the wheel in which the timer is stored.
+		unsigned int m_level = 0;
+		//! Slot of the wheel in which the timer is stored.
+		unsigned int m_slot = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		tick_type m_period = 0;
+
+		//! Timer action.
+		timer_action m_action;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		/*!
+		 * \brief Detect type of the timer (single-shot or periodic).
+		 */
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's item.
+	struct wheel_item
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+
+		/*!
+		 * \brief Count of timers in the list.
+		 *
+		 * \since
+		 * v.1.2.0
+		 */
+		std::size_t m_count = 0;
+	};
+
+	//! Type of one level of the wheel.
+	struct level_type
+	{
+		//! Count of time steps for one slot.
+		tick_type m_span;
+
+		//! Slots of the level.
+		std::vector< wheel_item > m_slots;
+
+		level_type( unsigned int wheel_size, tick_type span )
+			:	m_span( span )
+			,	m_slots( wheel_size )
+		{}
+	};
+
+	//! List of timers.
+	/*!
+	 * Is used for timers to be executed or to be cascaded.
+	 */
+	struct timer_list
+	{
+		timer_type * m_head = nullptr;
+		timer_type * m_tail = nullptr;
+
+		/*!
+		 * \brief Count of timers in the list.
+		 *
+		 * \since
+		 * v.1.2.0
+		 */
+		std::size_t m_size = 0;
+
+		void
+		push_back( timer_type * t )
+		{
+			++m_size;
+			t->m_next = nullptr;
+			t->m_prev = m_tail;
+			if( m_tail )
+				m_tail->m_next = t;
+			else
+				m_head = t;
+			m_tail = t;
+		}
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Size of the wheel at every level.
+	const unsigned int m_wheel_size;
+
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! Levels of the wheel.
+	/*!
+	 * The level 0 is the first.
+	 */
+	std::vector< level_type > m_levels;
+
+	//! Number of the current time step.
+	tick_type m_current_tick = 0;
+
+	//! Right border of the current tick.
+	/*!
+	 * This is the time point at which new tick must be started.
+	 */
+	monotonic_clock::time_point m_current_tick_border;
+
+	//! Has the current tick been processed?
+	bool m_current_tick_processed = false;
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note Rounding is performed the same way as in timer_wheel_engine.
+	 * Never return 0.
+	 *
+	 * \tparam DURATION actual type for duration representation.
+	 */
+	template< class DURATION >
+	tick_type
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		DURATION d ) const
+	{
+		auto d_units =
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		tick_type r = d_units > 0 ?
+				static_cast< tick_type >( (d_units + g_units/2) / g_units ) : 0;
+		if( !r )
+			r = 1;
+		return r;
+	}
+
+	/*!
+	 * \brief Count of time steps which are already passed but not
+	 * processed yet.
+	 *
+	 * \note See timer_wheel_engine::missed_ticks() for the details.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	tick_type
+	missed_ticks() const
+	{
+		if( !this->m_compensate_missed_ticks )
+			return 0;
+
+		const auto now = monotonic_clock::now();
+		if( now < m_current_tick_border )
+			return 0;
+
+		return static_cast< tick_type >(
+				( now - m_current_tick_border ) / m_granularity ) + 1;
+	}
+
+	/*!
+	 * \brief Insert timer to the appropriate level of the wheel.
+	 *
+	 * \note Timer must be expired later than the current tick.
+	 */
+	void
+	insert_timer_to_wheel( timer_type * wheel_timer )
+	{
+		const tick_type delta = wheel_timer->m_expiration - m_current_tick;
+
+		// The lowest level which can hold the timer. The highest level
+		// is used if timer is too far.
+		unsigned int level = 0;
+		while( level + 1 < m_levels.size() &&
+				delta >= m_levels[ level + 1 ].m_span )
+			++level;
+
+		const auto & l = m_levels[ level ];
+		wheel_timer->m_level = level;
+		wheel_timer->m_slot = static_cast< unsigned int >(
+				( wheel_timer->m_expiration / l.m_span ) % m_wheel_size );
+
+		wheel_item & item = m_levels[ level ].m_slots[ wheel_timer->m_slot ];
+		++item.m_count;
+		wheel_timer->m_prev = item.m_tail;
+		wheel_timer->m_next = nullptr;
+		if( item.m_tail )
+			item.m_tail->m_next = wheel_timer;
+		else
+			item.m_head = wheel_timer;
+		item.m_tail = wheel_timer;
+	}
+
+	/*!
+	 * \brief Remove timer from the wheel.
+	 */
+	void
+	remove_timer_from_wheel( timer_type * wheel_timer )
+	{
+		wheel_item & item =
+				m_levels[ wheel_timer->m_level ].m_slots[ wheel_timer->m_slot ];
+		--item.m_count;
+
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			item.m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			item.m_tail = wheel_timer->m_prev;
+	}
+
+	/*!
+	 * \brief Cascade timers from higher levels and process elapsed timers
+	 * for the current time step.
+	 *
+	 * Object \a lock will be unlocked and then locked back.
+	 */
+	template< class UNIQUE_LOCK >
+	void
+	process_current_tick(
+		UNIQUE_LOCK & lock,
+		//! Lateness of processing of the current time step.
+		monotonic_clock::duration lateness )
+	{
+		timer_list exec_list;
+
+		// Higher levels must be cascaded first because their timers
+		// can go to lower levels which must be cascaded at this tick too.
+		for( auto l = m_levels.size() - 1; l > 0; --l )
+		{
+			const auto & level = m_levels[ l ];
+			if( 0 == m_current_tick % level.m_span )
+				cascade( l, exec_list );
+		}
+
+		take_slot_content(
+				m_levels[ 0 ].m_slots[ m_current_tick % m_wheel_size ],
+				exec_list,
+				[]( timer_type * t, timer_list & to ) {
+					to.push_back( t );
+					t->m_status = timer_status::wait_for_execution;
+				} );
+
+		this->register_tick( exec_list.m_size );
+		if( exec_list.m_size )
+			this->register_lateness( lateness, exec_list.m_size );
+
+		if( exec_list.m_head )
+		{
+			exec_actions( lock, exec_list.m_head );
+
+			utilize_exec_list( exec_list.m_head );
+		}
+	}
+
+	/*!
+	 * \brief Move timers from the current slot of a level to lower levels.
+	 *
+	 * Timers for the current tick are added to the execution list.
+	 */
+	void
+	cascade(
+		std::size_t level,
+		timer_list & exec_list )
+	{
+		const auto & l = m_levels[ level ];
+		const auto slot = ( m_current_tick / l.m_span ) % m_wheel_size;
+
+		take_slot_content(
+				m_levels[ level ].m_slots[ slot ],
+				exec_list,
+				[this]( timer_type * t, timer_list & to ) {
+					if( t->m_expiration <= m_current_tick )
+					{
+						to.push_back( t );
+						t->m_status = timer_status::wait_for_execution;
+					}
+					else
+						insert_timer_to_wheel( t );
+				} );
+	}
+
+	/*!
+	 * \brief Detach all timers from a slot and handle every of them
+	 * by \a handler.
+	 */
+	template< typename HANDLER >
+	static void
+	take_slot_content(
+		wheel_item & item,
+		timer_list & exec_list,
+		HANDLER handler )
+	{
+		timer_type * timer = item.m_head;
+		item = wheel_item();
+
+		while( timer )
+		{
+			timer_type * t = timer;
+			timer = timer->m_next;
+
+			handler( t, exec_list );
+		}
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class UNIQUE_LOCK >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		UNIQUE_LOCK & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head )
+	{
+		lock.unlock();
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+					head->m_action();
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				t->m_expiration = m_current_tick + t->m_period;
+
+				insert_timer_to_wheel( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< THREAD_SAFETY >::decrement_references( t );
+			}
+		}
+	}
+};
+
+//
+// thread_unsafe_manager_mixin
+//
+
+/*!
+ * \brief A mixin which must be used as base class for not-thread-safe
+ * timer managers.
+ *
+ * \since
+ * v.1.1.0
+ */
+struct thread_unsafe_manager_mixin
+{
+	//! A empty class for an object's lock emulation.
+	/*!
+	 * Instance of that class will be used in not-thread-safe
+	 * code in places where object's lock is necessary.
+	 *
+	 * Because this class is empty its usage will be removed by
+	 * optimized compiler.
+	 */
+	class lock_guard
+	{
+	public :
+		lock_guard( thread_unsafe_manager_mixin & ) {}
+
+		void lock() {}
+		void unlock() {}
+	};
+
+	void
+	ensure_started() {}
+
+	void
+	notify() {}
+};
+
+//
+// thread_safe_manager_mixin
+//
+/*!
+ * \brief A mixin which must be used as base class for thread-safe
+ * timer managers.
+ *
+ * \since
+ * v.1.1.0
+ */
+struct thread_safe_manager_mixin
+{
+	//! Timer manager's lock.
+	std::mutex m_lock;
+
+	//! A special wrapper around actual std::unique_lock.
+	class lock_guard
+	{
+		std::unique_lock< std::mutex > m_lock;
+
+	public :
+		lock_guard( thread_safe_manager_mixin & self )
+			: m_lock( self.m_lock )
+		{}
+
+		void lock() { m_lock.lock(); }
+		void unlock() { m_lock.unlock(); }
+	};
+
+	void
+	ensure_started() {}
+
+	void
+	notify() {}
+};
+
+//
+// thread_mixin_base
+//
+
+/*!
+ * \brief A common part of mixins for timer threads.
+ *
+ * \since
+ * v.1.2.0
+ */
+struct thread_mixin_base
+{
+	//! Timer thread's lock.
+	std::mutex m_lock;
+
+	//! Underlying thread object.
+	/*!
+	 * \note Will be created during timer thread start and
+	 * destroyed after timer thread shutdown.
+	 */
+	std::shared_ptr< std::thread > m_thread;
+
+	//! A special wrapper around actual std::unique_lock.
+	class lock_guard
+	{
+		std::unique_lock< std::mutex > m_lock;
+
+	public :
+		lock_guard( thread_mixin_base & self )
+			: m_lock( self.m_lock )
+		{}
+
+		void lock() { m_lock.lock(); }
+		void unlock() { m_lock.unlock(); }
+
+		//! Accessor for actual std::unique_lock object.
+		std::unique_lock< std::mutex > &
+		actual_lock() { return m_lock; }
+	};
+
+	//! Checks that timer thread is really started.
+	/*!
+	 * \throw std::exception if thread is not started.
+	 */
+	void
+	ensure_started()
+	{
+		if( !m_thread )
+			throw std::runtime_error( "timer thread is not started" );
+	}
+};
+
+//
+// thread_mixin
+//
+
+/*!
+ * \brief A mixin which must be used as base class for timer threads.
+ *
+ * \note Since v.1.2.0 the common part of timer threads is moved
+ * to thread_mixin_base.
+ *
+ * \since
  * v.1.1.0
  */
-struct thread_safe_manager_mixin
+struct thread_mixin : public thread_mixin_base
+{
+	//! Condition variable for waiting for next event.
+	std::condition_variable m_condition;
+
+	//! Sends notification to timer thread.
+	void
+	notify()
+	{
+		m_condition.notify_one();
+	}
+
+	/*!
+	 * \brief Wait for notification or for the specified time point.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< typename ERROR_HANDLER >
+	void
+	wait_until(
+		//! Object's lock. Released during waiting.
+		lock_guard & lock,
+		//! Time point for the end of waiting.
+		monotonic_clock::time_point time_point,
+		//! Handler for errors. It is not used by this mixin.
+		ERROR_HANDLER && )
+	{
+		m_condition.wait_until( lock.actual_lock(), time_point );
+	}
+
+	/*!
+	 * \brief Wait for notification.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< typename ERROR_HANDLER >
+	void
+	wait(
+		//! Object's lock. Released during waiting.
+		lock_guard & lock,
+		//! Handler for errors. It is not used by this mixin.
+		ERROR_HANDLER && )
+	{
+		m_condition.wait( lock.actual_lock() );
+	}
+};
+
+#if defined(__linux__)
+
+//
+// timerfd_thread_mixin
+//
+
+/*!
+ * \brief A mixin for timer threads which wait on Linux timerfd.
+ *
+ * Timer thread sleeps in epoll_wait() on two descriptors: timerfd which
+ * is armed with absolute CLOCK_MONOTONIC deadline of the nearest timer
+ * and eventfd which is used by notify() for waking up timer thread
+ * earlier.
+ *
+ * Wakeups of timerfd are more precise than wakeups of
+ * std::condition_variable::wait_until() under high load.
+ *
+ * \note It is supposed that monotonic_clock uses CLOCK_MONOTONIC.
+ * It is true for std::chrono::steady_clock on Linux.
+ *
+ * \since
+ * v.1.2.0
+ */
+struct timerfd_thread_mixin : public thread_mixin_base
 {
-	//! Timer manager's lock.
-	std::mutex m_lock;
+	//! Initializing constructor.
+	/*!
+	 * \throw std::runtime_error if descriptors can't be created.
+	 */
+	timerfd_thread_mixin()
+	{
+		try
+		{
+			m_timerfd = ::timerfd_create(
+					CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+			if( -1 == m_timerfd )
+				throw_system_error( "timerfd_create" );
 
-	//! A special wrapper around actual std::unique_lock.
-	class lock_guard
+			m_eventfd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+			if( -1 == m_eventfd )
+				throw_system_error( "eventfd" );
+
+			m_epollfd = ::epoll_create1( EPOLL_CLOEXEC );
+			if( -1 == m_epollfd )
+				throw_system_error( "epoll_create1" );
+
+			add_to_epoll( m_timerfd );
+			add_to_epoll( m_eventfd );
+		}
+		catch( ... )
+		{
+			close_descriptors();
+			throw;
+		}
+	}
+
+	//! Destructor.
+	~timerfd_thread_mixin()
 	{
-		std::unique_lock< std::mutex > m_lock;
+		close_descriptors();
+	}
 
-	public :
-		lock_guard( thread_safe_manager_mixin & self )
-			: m_lock( self.m_lock )
-		{}
+	//! Sends notification to timer thread.
+	void
+	notify()
+	{
+		const std::uint64_t value = 1;
+		// An error can be ignored here: eventfd is already signaled
+		// if its counter can't be incremented.
+		const auto r = ::write( m_eventfd, &value, sizeof( value ) );
+		(void)r;
+	}
+
+	//! Wait for notification or for the specified time point.
+	/*!
+	 * If timerfd can't be armed then the error is passed to
+	 * \a error_handler and epoll_wait() with timeout is used instead.
+	 * Precision of that timeout is one millisecond.
+	 */
+	template< typename ERROR_HANDLER >
+	void
+	wait_until(
+		//! Object's lock. Released during waiting.
+		lock_guard & lock,
+		//! Time point for the end of waiting.
+		monotonic_clock::time_point time_point,
+		//! Handler for errors. Receives a description of an error.
+		ERROR_HANDLER && error_handler )
+	{
+		auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				time_point.time_since_epoch() ).count();
+		// Zero value disarms the timer. The minimal positive value
+		// means that time point is already passed.
+		if( ns <= 0 )
+			ns = 1;
+
+		::itimerspec spec{};
+		spec.it_value.tv_sec = static_cast< std::time_t >( ns / 1000000000 );
+		spec.it_value.tv_nsec = static_cast< long >( ns % 1000000000 );
+
+		// Timer is not rearmed if it is already armed for the same
+		// time point. It saves a system call on every wakeup by
+		// notification.
+		if( ns == m_armed_ns )
+			wait_for_event( lock, -1 );
+		else if( -1 == ::timerfd_settime(
+				m_timerfd, TFD_TIMER_ABSTIME, &spec, nullptr ) )
+		{
+			m_armed_ns = 0;
+			error_handler( system_error_description( "timerfd_settime" ) );
+
+			wait_for_event( lock, timeout_ms( time_point ) );
+		}
+		else
+		{
+			m_armed_ns = ns;
+			wait_for_event( lock, -1 );
+		}
+	}
+
+	//! Wait for notification.
+	template< typename ERROR_HANDLER >
+	void
+	wait(
+		//! Object's lock. Released during waiting.
+		lock_guard & lock,
+		//! Handler for errors. Receives a description of an error.
+		ERROR_HANDLER && error_handler )
+	{
+		if( m_armed_ns )
+		{
+			const ::itimerspec spec{};
+			// If the timer can't be disarmed then there can be a spurious
+			// wakeup. It is not a problem.
+			if( -1 == ::timerfd_settime( m_timerfd, 0, &spec, nullptr ) )
+				error_handler( system_error_description( "timerfd_settime" ) );
+			else
+				m_armed_ns = 0;
+		}
+
+		wait_for_event( lock, -1 );
+	}
+
+private :
+	//! Timer descriptor for waiting for the nearest timer.
+	int m_timerfd = -1;
+	//! Event descriptor for notifications.
+	int m_eventfd = -1;
+	//! Epoll descriptor for waiting on both descriptors.
+	int m_epollfd = -1;
+
+	//! Time point for which timerfd is armed (in nanoseconds).
+	/*!
+	 * Zero if timerfd is not armed or it has expired already.
+	 */
+	std::chrono::nanoseconds::rep m_armed_ns = 0;
+
+	//! Description of the last error of a system call.
+	static std::string
+	system_error_description( const char * what )
+	{
+		const auto code = errno;
+		return std::string( what ) + " failed: " + std::strerror( code );
+	}
+
+	[[noreturn]] static void
+	throw_system_error( const char * what )
+	{
+		throw std::runtime_error( system_error_description( what ) );
+	}
+
+	//! Timeout for epoll_wait() in milliseconds.
+	/*!
+	 * It is rounded up for not waking up before \a time_point.
+	 */
+	static int
+	timeout_ms( monotonic_clock::time_point time_point )
+	{
+		const auto now = monotonic_clock::now();
+		if( time_point <= now )
+			return 0;
+
+		const auto us = std::chrono::duration_cast< std::chrono::microseconds >(
+				time_point - now ).count();
+		const auto ms = us / 1000 + ( us % 1000 ? 1 : 0 );
+
+		return ms < std::numeric_limits< int >::max() ?
+				static_cast< int >( ms ) : std::numeric_limits< int >::max();
+	}
+
+	void
+	add_to_epoll( int fd )
+	{
+		::epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.fd = fd;
+		if( -1 == ::epoll_ctl( m_epollfd, EPOLL_CTL_ADD, fd, &ev ) )
+			throw_system_error( "epoll_ctl" );
+	}
+
+	void
+	close_descriptors()
+	{
+		for( int * fd : { &m_epollfd, &m_eventfd, &m_timerfd } )
+			if( -1 != *fd )
+			{
+				::close( *fd );
+				*fd = -1;
+			}
+	}
+
+	//! Wait on epoll without holding the object's lock.
+	/*!
+	 * Notifications sent while the lock is released are not lost
+	 * because eventfd stays signaled until it is read.
+	 */
+	void
+	wait_for_event(
+		lock_guard & lock,
+		//! Timeout for epoll_wait() in milliseconds. -1 means no timeout.
+		int timeout )
+	{
+		lock.unlock();
+
+		::epoll_event events[ 2 ];
+		int r = 0;
+		do
+			r = ::epoll_wait( m_epollfd, events, 2, timeout );
+		while( -1 == r && EINTR == errno );
+
+		lock.lock();
+
+		// Only signaled descriptors are read. Expired timerfd must be
+		// read because it stays signaled until it is read or rearmed.
+		for( int i = 0; i < r; ++i )
+		{
+			std::uint64_t value;
+			const auto rd = ::read( events[ i ].data.fd, &value, sizeof( value ) );
+			(void)rd;
+
+			if( m_timerfd == events[ i ].data.fd )
+				m_armed_ns = 0;
+		}
+	}
+};
+
+#endif
+
+/*!
+ * \brief A type-container for types of engine-consumers.
+ *
+ * \since
+ * v.1.1.0
+ */
+struct consumer_type
+{
+	/*!
+	 * \brief Indicator that an engine will be owned by timer manager.
+	 *
+	 * \since
+	 * v.1.1.0
+	 */
+	struct manager {};
+	/*!
+	 * \brief Indicator that an engine will be owned by timer thread.
+	 *
+	 * \since
+	 * v.1.1.0
+	 */
+	struct thread {};
+#if defined(__linux__)
+	/*!
+	 * \brief Indicator that an engine will be owned by timer thread
+	 * which waits on timerfd.
+	 *
+	 * \note Available on Linux only.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	struct timerfd_thread {};
+#endif
+};
+
+/*!
+ * \brief A selector of actual mixin type for timer manager or timer thread.
+ *
+ * \attention This type is empty because all actual content will be
+ * defined in specializations.
+ *
+ * \since
+ * v.1.1.0
+ */
+template< typename THREAD_SAFETY, typename CONSUMER >
+struct mixin_selector
+{
+};
+
+/*!
+ * \brief A selector of actual mixin type for not-thread-safe timer manager.
+ *
+ * \since
+ * v.1.1.0
+ */
+template<>
+struct mixin_selector< thread_safety::unsafe, consumer_type::manager >
+{
+	//! Actual type of the mixin.
+	using type = thread_unsafe_manager_mixin;
+};
+
+/*!
+ * \brief A selector of actual mixin type for thread-safe timer manager.
+ *
+ * \since
+ * v.1.1.0
+ */
+template<>
+struct mixin_selector< thread_safety::safe, consumer_type::manager >
+{
+	//! Actual type of the mixin.
+	using type = thread_safe_manager_mixin;
+};
+
+/*!
+ * \brief A selector of actual mixin type for timer thread.
+ *
+ * \since
+ * v.1.1.0
+ */
+template<>
+struct mixin_selector< thread_safety::safe, consumer_type::thread >
+{
+	//! Actual type of the mixin.
+	using type = thread_mixin;
+};
+
+#if defined(__linux__)
+/*!
+ * \brief A selector of actual mixin type for timer thread which
+ * waits on timerfd.
+ *
+ * \since
+ * v.1.2.0
+ */
+template<>
+struct mixin_selector< thread_safety::safe, consumer_type::timerfd_thread >
+{
+	//! Actual type of the mixin.
+	using type = timerfd_thread_mixin;
+};
+#endif
+
+//
+// basic_methods_impl_mixin
+//
+
+/*!
+ * \brief A implementation of basic methods for timer managers and
+ * timer threads.
+ *
+ * \tparam ENGINE actual type of engine to be used.
+ * \tparam CONSUMER type of engine consumer (e.g. consumer_type::manager or
+ * consumer_type::thread).
+ *
+ * \since
+ * v.1.1.0
+ */
+template<
+	typename ENGINE,
+	typename CONSUMER >
+class basic_methods_impl_mixin
+	:	protected mixin_selector< typename ENGINE::thread_safety, CONSUMER >::type
+	,	public ENGINE::defaults_type
+{
+	//! Shorthand for actual mixin type.
+	using mixin_type = typename mixin_selector<
+			typename ENGINE::thread_safety, CONSUMER >::type;
+
+	//! Shorthand for timer objects' smart pointer.
+	using timer_holder = timer_object_holder< typename ENGINE::thread_safety >;
+
+public :
+	/*!
+	 * \brief A typedef for thread safety type from ENGINE.
+	 *
+	 * \since
+	 * v.1.1.2
+	 */
+	using thread_safety = typename ENGINE::thread_safety;
+
+	//! Constructor with all parameters.
+	template< typename... ARGS >
+	basic_methods_impl_mixin(
+		ARGS && ... args )
+		:	m_engine( std::forward< ARGS >(args)... )
+	{
+	}
 
-		void lock() { m_lock.lock(); }
-		void unlock() { m_lock.unlock(); }
-	};
+	/*!
+	 * \brief Allocate of new timer object.
+	 *
+	 * \note This object must be activated by activate() methods.
+	 */
+	timer_holder
+	allocate()
+	{
+		return m_engine.allocate();
+	}
 
+	//! Activate timer and schedule it for execution.
+	/*!
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 */
+	template< class DURATION_1 >
 	void
-	ensure_started() {}
+	activate(
+		//! Timer to be activated.
+		timer_holder timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Action for the timer.
+		timer_action action )
+	{
+		activate(
+				std::move( timer ),
+				pause,
+				monotonic_clock::duration::zero(),
+				std::move( action ) );
+	}
 
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * There is no need to preallocate timer object. It will
+	 * be allocated automatically, but not be shown to user.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 */
+	template< class DURATION_1 >
 	void
-	notify() {}
-};
+	activate(
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Action for the timer.
+		timer_action action )
+	{
+		activate(
+				allocate(),
+				pause,
+				monotonic_clock::duration::zero(),
+				std::move( action ) );
+	}
 
-//
-// thread_mixin
-//
+	//! Activate timer and schedule it for execution.
+	/*!
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	void
+	activate(
+		//! Timer to be activated.
+		timer_holder timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		typename mixin_type::lock_guard locker{ *this };
 
-/*!
- * \brief A mixin which must be used as base class for timer threads.
- *
- * \since
- * v.1.1.0
- */
-struct thread_mixin
-{
-	//! Timer thread's lock.
-	std::mutex m_lock;
+		this->ensure_started();
 
-	//! Condition variable for waiting for next event.
-	std::condition_variable m_condition;
+		if( m_engine.activate(
+				std::move( timer ), pause, period, std::move( action ) ) )
+			this->notify();
+	}
 
-	//! Underlying thread object.
+	//! Activate timer and schedule it for execution.
 	/*!
-	 * \note Will be created during timer thread start and
-	 * destroyed after timer thread shutdown.
+	 * There is no need to preallocate timer object. It will
+	 * be allocated automatically, but not be shown to user.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
 	 */
-	std::shared_ptr< std::thread > m_thread;
+	template< class DURATION_1, class DURATION_2 >
+	void
+	activate(
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		activate( allocate(), pause, period, std::move( action ) );
+	}
 
-	//! A special wrapper around actual std::unique_lock.
-	class lock_guard
+	//! Activate timer again with the same action.
+	/*!
+	 * \return Timer object to be used for the timer from now on.
+	 * It is \a timer or a new timer object if \a timer is being
+	 * executed right now.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	timer_holder
+	reactivate(
+		//! Timer to be activated again.
+		timer_holder timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period )
 	{
-		std::unique_lock< std::mutex > m_lock;
+		typename mixin_type::lock_guard locker{ *this };
 
-	public :
-		lock_guard( thread_mixin & self )
-			: m_lock( self.m_lock )
-		{}
+		this->ensure_started();
 
-		void lock() { m_lock.lock(); }
-		void unlock() { m_lock.unlock(); }
+		auto r = m_engine.reactivate( std::move( timer ), pause, period );
+		if( r.second )
+			this->notify();
 
-		//! Accessor for actual std::unique_lock object.
-		std::unique_lock< std::mutex > &
-		actual_lock() { return m_lock; }
-	};
+		return std::move( r.first );
+	}
 
-	//! Checks that timer thread is really started.
-	/*!
-	 * \throw std::exception if thread is not started.
-	 */
+	//! Deactivate timer and remove it from the list.
 	void
-	ensure_started()
+	deactivate(
+		//! Timer to be deactivated.
+		timer_holder timer )
 	{
-		if( !m_thread )
-			throw std::runtime_error( "timer thread is not started" );
+		typename mixin_type::lock_guard locker{ *this };
+
+		m_engine.deactivate( timer );
 	}
 
-	//! Sends notification to timer thread.
-	void
-	notify()
+	/*!
+	 * \brief Count of timers of various types.
+	 *
+	 * \note This are quantities of all timers known to manager/thread.
+	 * Some of them can be already deactivated but not removed yet.
+	 *
+	 * \since
+	 * v.1.1.1
+	 */
+	timer_quantities
+	get_timer_quantities()
 	{
-		m_condition.notify_one();
+		typename mixin_type::lock_guard locker{ *this };
+
+		return m_engine.get_timer_quantities();
 	}
-};
 
-/*!
- * \brief A type-container for types of engine-consumers.
- *
- * \since
- * v.1.1.0
- */
-struct consumer_type
-{
 	/*!
-	 * \brief Indicator that an engine will be owned by timer manager.
+	 * \brief Statistics about work of the engine.
+	 *
+	 * \note Maximums in the statistics are reset by this call.
 	 *
 	 * \since
-	 * v.1.1.0
+	 * v.1.2.0
 	 */
-	struct manager {};
+	engine_stats
+	get_engine_stats()
+	{
+		typename mixin_type::lock_guard locker{ *this };
+
+		auto result = m_engine.take_engine_stats();
+		m_engine.fill_occupancy( result );
+
+		return result;
+	}
+
 	/*!
-	 * \brief Indicator that an engine will be owned by timer thread.
+	 * \brief Check for emptiness.
 	 *
 	 * \since
-	 * v.1.1.0
+	 * v.1.1.3
 	 */
-	struct thread {};
-};
+	bool
+	empty()
+	{
+		typename mixin_type::lock_guard locker{ *this };
 
-/*!
- * \brief A selector of actual mixin type for timer manager or timer thread.
- *
- * \attention This type is empty because all actual content will be
- * defined in specializations.
- *
- * \since
- * v.1.1.0
- */
-template< typename THREAD_SAFETY, typename CONSUMER >
-struct mixin_selector
-{
-};
+		return m_engine.empty();
+	}
 
-/*!
- * \brief A selector of actual mixin type for not-thread-safe timer manager.
- *
- * \since
- * v.1.1.0
- */
-template<>
-struct mixin_selector< thread_safety::unsafe, consumer_type::manager >
-{
-	//! Actual type of the mixin.
-	using type = thread_unsafe_manager_mixin;
+protected :
+	//! Actual timer engine instance.
+	ENGINE m_engine;
 };
 
-/*!
- * \brief A selector of actual mixin type for thread-safe timer manager.
- *
- * \since
- * v.1.1.0
- */
-template<>
-struct mixin_selector< thread_safety::safe, consumer_type::manager >
-{
-	//! Actual type of the mixin.
-	using type = thread_safe_manager_mixin;
-};
+//
+// manager_impl_template
+//
 
 /*!
- * \brief A selector of actual mixin type for timer thread.
+ * \brief Template-based implementation of timer manager.
+ *
+ * \tparam ENGINE actual type of engine to be used.
  *
  * \since
  * v.1.1.0
  */
-template<>
-struct mixin_selector< thread_safety::safe, consumer_type::thread >
+template< typename ENGINE >
+class manager_impl_template
+	:	public basic_methods_impl_mixin< ENGINE, consumer_type::manager > 
 {
-	//! Actual type of the mixin.
-	using type = thread_mixin;
+	//! Shorthand for base type.
+	using base_type = basic_methods_impl_mixin<
+			ENGINE,
+			consumer_type::manager >;
+
+public :
+	//! Constructor with all parameters.
+	template< typename... ARGS >
+	manager_impl_template(
+		ARGS && ... args )
+		:	base_type( std::forward< ARGS >(args)... )
+	{
+	}
+
+	//! Reset all timers and return manager to the initial state.
+	void
+	reset()
+	{
+		typename manager_impl_template::lock_guard locker{ *this };
+		this->m_engine.clear_all();
+	}
+
+	//! Perform processing of expired timers.
+	void
+	process_expired_timers()
+	{
+		typename manager_impl_template::lock_guard locker{ *this };
+
+		this->m_engine.process_expired_timers( locker );
+	}
+
+	//! Get the time for next process_expired_timers invocation.
+	/*!
+	 * \return tuple<true,timepoint> if there is a timer to process. Or
+	 * tuple<false,undefined> if there is no timers to be processed.
+	 */
+	std::tuple< bool, monotonic_clock::time_point >
+	nearest_time_point()
+	{
+		typename manager_impl_template::lock_guard locker{ *this };
+		auto e = this->m_engine.empty();
+		if( !e )
+			return std::make_tuple( true, this->m_engine.nearest_time_point() );
+		else
+			return std::make_tuple( false, monotonic_clock::time_point() );
+	}
+
+	//! Get the sleeping time before the earlist timer expiration.
+	/*!
+	 * \return actual sleeping time if there is at least one timer.
+	 * Or \a default_timeout if there is no any timers.
+	 *
+	 * \tparam DURATION type for \a default_timeout
+	 */
+	template< typename DURATION >
+	monotonic_clock::duration
+	timeout_before_nearest_timer(
+		//! Default timeout value which will be used if there is no any timers.
+		DURATION default_timeout )
+	{
+		auto r = this->nearest_time_point();
+		if( std::get<0>( r ) )
+		{
+			auto now = monotonic_clock::now();
+			const auto & f = std::get<1>( r );
+			if( now > f )
+				return monotonic_clock::duration( 0 );
+			else
+				return (f - now);
+		}
+		else
+			return default_timeout;
+	}
 };
 
 //
-// basic_methods_impl_mixin
+// thread_impl_template
 //
 
 /*!
- * \brief A implementation of basic methods for timer managers and
- * timer threads.
+ * \brief Template-based implementation of timer thread.
  *
  * \tparam ENGINE actual type of engine to be used.
- * \tparam CONSUMER type of engine consumer (e.g. consumer_type::manager or
- * consumer_type::thread).
+ *
+ * \tparam CONSUMER type of consumer which defines the way of waiting
+ * for next event. It is consumer_type::thread for waiting on
+ * std::condition_variable or consumer_type::timerfd_thread
+ * for waiting on Linux timerfd (since v.1.2.0).
  *
  * \since
  * v.1.1.0
  */
 template<
 	typename ENGINE,
-	typename CONSUMER >
-class basic_methods_impl_mixin
-	:	protected mixin_selector< typename ENGINE::thread_safety, CONSUMER >::type
-	,	public ENGINE::defaults_type
+	typename CONSUMER = consumer_type::thread >
+class thread_impl_template
+	:	public basic_methods_impl_mixin< ENGINE, CONSUMER > 
 {
-	//! Shorthand for actual mixin type.
-	using mixin_type = typename mixin_selector<
-			typename ENGINE::thread_safety, CONSUMER >::type;
+	//! Shorthand for base type.
+	using base_type = basic_methods_impl_mixin< ENGINE, CONSUMER >;
 
 	//! Shorthand for timer objects' smart pointer.
 	using timer_holder = timer_object_holder< typename ENGINE::thread_safety >;
 
+	//! Type for representation of time point in atomic variable.
+	using time_point_rep = monotonic_clock::duration::rep;
+
 public :
+	//! Constructor with all parameters.
+	template< typename... ARGS >
+	thread_impl_template(
+		ARGS && ... args )
+		:	base_type( std::forward< ARGS >(args)... )
+	{
+	}
+
+	//! Destructor.
 	/*!
-	 * \brief A typedef for thread safety type from ENGINE.
+	 * Calls shutdown_and_join()
+	 */
+	~thread_impl_template()
+	{
+		shutdown_and_join();
+
+		destroy_inbox_content( m_inbox.exchange( nullptr ) );
+	}
+
+	/*!
+	 * \brief Set the way of handling activation/deactivation requests.
+	 *
+	 * \throw std::runtime_error if thread is already started.
 	 *
 	 * \since
-	 * v.1.1.2
+	 * v.1.2.0
 	 */
-	using thread_safety = typename ENGINE::thread_safety;
+	void
+	set_submission_mode( submission_mode mode )
+	{
+		typename base_type::lock_guard locker{ *this };
 
-	//! Constructor with all parameters.
-	template< typename... ARGS >
-	basic_methods_impl_mixin(
-		ARGS && ... args )
-		:	m_engine( std::forward< ARGS >(args)... )
+		if( this->m_thread )
+			throw std::runtime_error( "timer thread is already started" );
+
+		m_submission_mode = mode;
+	}
+
+	/*!
+	 * \brief Set the slack for wakeups of timer thread.
+	 *
+	 * If slack is not zero then timer thread wakes up only at time points
+	 * which are multiples of \a slack. All timers with deadlines between
+	 * two such points are processed together at one wakeup. Timer can be
+	 * processed later than its deadline, but not more than \a slack.
+	 *
+	 * It reduces the count of wakeups (and context switches) if there
+	 * are many timers with close but different deadlines.
+	 *
+	 * \throw std::runtime_error if thread is already started.
+	 *
+	 * \tparam DURATION actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION >
+	void
+	set_slack( DURATION slack )
 	{
+		typename base_type::lock_guard locker{ *this };
+
+		if( this->m_thread )
+			throw std::runtime_error( "timer thread is already started" );
+
+		m_slack = std::chrono::duration_cast< monotonic_clock::duration >(
+				slack );
+		// Timer thread can wake up later than the next time step.
+		// Such missed steps must be taken into account for new timers.
+		this->m_engine.set_missed_ticks_compensation(
+				monotonic_clock::duration::zero() < m_slack );
 	}
 
 	/*!
-	 * \brief Allocate of new timer object.
+	 * \brief Set an action to be called after processing of all
+	 * elapsed timers at one wakeup of timer thread.
 	 *
-	 * \note This object must be activated by activate() methods.
+	 * This action is called on the context of timer thread without
+	 * holding the thread's lock. It allows actions of timers to collect
+	 * some work and then to perform it at once (e.g. to deliver several
+	 * messages to the same destination with one operation).
+	 *
+	 * Exceptions from the action are handled the same way as
+	 * exceptions from actions of timers.
+	 *
+	 * \throw std::runtime_error if thread is already started.
+	 *
+	 * \since
+	 * v.1.2.0
 	 */
-	timer_holder
-	allocate()
+	void
+	set_post_processing_action( timer_action action )
 	{
-		return m_engine.allocate();
+		typename base_type::lock_guard locker{ *this };
+
+		if( this->m_thread )
+			throw std::runtime_error( "timer thread is already started" );
+
+		m_post_processing_action = std::move( action );
+	}
+
+	//! Start timer thread.
+	/*!
+	 * \throw std::runtime_error if thread is already started.
+	 */
+	void
+	start()
+	{
+		typename base_type::lock_guard locker{ *this };
+
+		if( this->m_thread )
+			throw std::runtime_error( "timer thread is already started" );
+		else
+			this->m_shutdown = false;
+
+		this->m_thread = std::make_shared< std::thread >(
+				std::bind( &thread_impl_template::body, this ) );
+
+		m_accepts_requests = true;
+	}
+
+	//! Initiate shutdown for the timer thread without waiting for completion.
+	void
+	shutdown()
+	{
+		typename base_type::lock_guard locker{ *this };
+
+		if( this->m_thread && !this->m_shutdown )
+		{
+			m_accepts_requests = false;
+
+			this->m_shutdown = true;
+			this->notify();
+		}
+	}
+
+	//! Wait for completion of timer thread.
+	/*!
+	 * Method shutdown() must be called somewhere else.
+	 */
+	void
+	join()
+	{
+		std::shared_ptr< std::thread > t;
+		{
+			typename base_type::lock_guard locker{ *this };
+			t = this->m_thread;
+		}
+		if( t )
+		{
+			t->join();
+
+			typename base_type::lock_guard locker{ *this };
+			this->m_thread.reset();
+		}
 	}
 
+	//! Initiate shutdown and wait for completion.
+	void
+	shutdown_and_join()
+	{
+		shutdown();
+		join();
+	}
+
+	/*!
+	 * \name Methods which take submission mode into account.
+	 * \{
+	 */
 	//! Activate timer and schedule it for execution.
 	/*!
-	 *
 	 * \throw std::exception If timer thread is not started.
-	 * \throw std::exception If \a timer is already activated.
+	 * \throw std::exception If \a timer is already activated
+	 * (only for submission_mode::locked).
 	 *
 	 * \tparam DURATION_1 actual type which represents time duration.
 	 */
@@ -2502,7 +4990,7 @@ public :
 		timer_action action )
 	{
 		activate(
-				allocate(),
+				this->allocate(),
 				pause,
 				monotonic_clock::duration::zero(),
 				std::move( action ) );
@@ -2510,9 +4998,9 @@ public :
 
 	//! Activate timer and schedule it for execution.
 	/*!
-	 *
 	 * \throw std::exception If timer thread is not started.
-	 * \throw std::exception If \a timer is already activated.
+	 * \throw std::exception If \a timer is already activated
+	 * (only for submission_mode::locked).
 	 *
 	 * \tparam DURATION_1 actual type which represents time duration.
 	 * \tparam DURATION_2 actual type which represents time duration.
@@ -2531,13 +5019,24 @@ public :
 		//! Action for the timer.
 		timer_action action )
 	{
-		typename mixin_type::lock_guard locker{ *this };
+		if( submission_mode::inbox == m_submission_mode )
+			submit_activation(
+					std::move( timer ),
+					std::chrono::duration_cast< monotonic_clock::duration >(
+							pause ),
+					std::chrono::duration_cast< monotonic_clock::duration >(
+							period ),
+					std::move( action ) );
+		else
+		{
+			typename base_type::lock_guard locker{ *this };
 
-		this->ensure_started();
+			this->ensure_started();
 
-		if( m_engine.activate(
-				std::move( timer ), pause, period, std::move( action ) ) )
-			this->notify();
+			if( this->m_engine.activate(
+					std::move( timer ), pause, period, std::move( action ) ) )
+				wakeup_if_necessary();
+		}
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -2562,294 +5061,462 @@ public :
 		//! Action for the timer.
 		timer_action action )
 	{
-		activate( allocate(), pause, period, std::move( action ) );
+		activate( this->allocate(), pause, period, std::move( action ) );
+	}
+
+	//! Activate timer again with the same action.
+	/*!
+	 * \note For submission_mode::inbox the content of the inbox is
+	 * handled first because the activation of \a timer can be still there.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer was never activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	timer_holder
+	reactivate(
+		//! Timer to be activated again.
+		timer_holder timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period )
+	{
+		typename base_type::lock_guard locker{ *this };
+
+		this->ensure_started();
+
+		if( submission_mode::inbox == m_submission_mode )
+			handle_inbox_content();
+
+		auto r = this->m_engine.reactivate( std::move( timer ), pause, period );
+		if( r.second )
+			wakeup_if_necessary();
+
+		return std::move( r.first );
 	}
 
 	//! Deactivate timer and remove it from the list.
+	/*!
+	 * \note Deactivation is always performed under the object's lock.
+	 * It guarantees that the timer's action is released on return.
+	 * For submission_mode::inbox the content of the inbox is handled
+	 * first because the activation of \a timer can be still there.
+	 */
 	void
 	deactivate(
 		//! Timer to be deactivated.
 		timer_holder timer )
 	{
-		typename mixin_type::lock_guard locker{ *this };
+		if( submission_mode::inbox == m_submission_mode )
+		{
+			typename base_type::lock_guard locker{ *this };
 
-		m_engine.deactivate( timer );
+			handle_inbox_content();
+			this->m_engine.deactivate( std::move( timer ) );
+		}
+		else
+			base_type::deactivate( std::move( timer ) );
 	}
-
 	/*!
-	 * \brief Count of timers of various types.
-	 *
-	 * \note This are quantities of all timers known to manager/thread.
-	 * Some of them can be already deactivated but not removed yet.
-	 *
-	 * \since
-	 * v.1.1.1
+	 * \}
 	 */
-	timer_quantities
-	get_timer_quantities()
-	{
-		typename mixin_type::lock_guard locker{ *this };
 
-		return m_engine.get_timer_quantities();
-	}
+protected :
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Shutdown flag.
+	bool m_shutdown = false;
+	/*!
+	 * \}
+	 */
 
 	/*!
-	 * \brief Check for emptiness.
+	 * \brief A wrapper around object's lock which measures the time
+	 * of holding of the lock by timer thread.
+	 *
+	 * Every holding is accounted by engine's register_lock_hold().
+	 * The lock is released by engines during execution of timer actions,
+	 * so actions don't affect the measured time.
 	 *
 	 * \since
-	 * v.1.1.3
+	 * v.1.2.0
 	 */
-	bool
-	empty()
+	class lock_hold_meter
 	{
-		typename mixin_type::lock_guard locker{ *this };
+		//! Actual lock.
+		typename base_type::lock_guard & m_lock;
 
-		return m_engine.empty();
-	}
+		//! Engine for accounting the time of holding.
+		ENGINE & m_engine;
 
-protected :
-	//! Actual timer engine instance.
-	ENGINE m_engine;
-};
+		//! Time point of the last acquisition of the lock.
+		monotonic_clock::time_point m_acquired_at;
 
-//
-// manager_impl_template
-//
+	public :
+		//! Initializing constructor.
+		/*!
+		 * \attention \a lock must be already acquired.
+		 */
+		lock_hold_meter(
+			typename base_type::lock_guard & lock,
+			ENGINE & engine )
+			:	m_lock( lock )
+			,	m_engine( engine )
+			,	m_acquired_at( monotonic_clock::now() )
+		{}
 
-/*!
- * \brief Template-based implementation of timer manager.
- *
- * \tparam ENGINE actual type of engine to be used.
- *
- * \since
- * v.1.1.0
- */
-template< typename ENGINE >
-class manager_impl_template
-	:	public basic_methods_impl_mixin< ENGINE, consumer_type::manager > 
-{
-	//! Shorthand for base type.
-	using base_type = basic_methods_impl_mixin<
-			ENGINE,
-			consumer_type::manager >;
+		void
+		lock()
+		{
+			m_lock.lock();
+			acquired();
+		}
 
-public :
-	//! Constructor with all parameters.
-	template< typename... ARGS >
-	manager_impl_template(
-		ARGS && ... args )
-		:	base_type( std::forward< ARGS >(args)... )
-	{
-	}
+		void
+		unlock()
+		{
+			released();
+			m_lock.unlock();
+		}
 
-	//! Reset all timers and return manager to the initial state.
+		//! Actual lock for waiting on it.
+		typename base_type::lock_guard &
+		actual_lock() { return m_lock; }
+
+		//! The lock is going to be released by someone else.
+		void
+		released()
+		{
+			m_engine.register_lock_hold(
+					monotonic_clock::now() - m_acquired_at );
+		}
+
+		//! The lock is acquired back by someone else.
+		void
+		acquired()
+		{
+			m_acquired_at = monotonic_clock::now();
+		}
+	};
+
+	//! Thread body.
 	void
-	reset()
+	body()
 	{
-		typename manager_impl_template::lock_guard locker{ *this };
+		typename base_type::lock_guard locker{ *this };
+		lock_hold_meter meter{ locker, this->m_engine };
+
+		while( !this->m_shutdown )
+		{
+			handle_inbox_content();
+
+			this->m_engine.process_expired_timers( meter );
+
+			if( m_post_processing_action )
+			{
+				meter.unlock();
+				this->m_engine.safe_execute( m_post_processing_action );
+				meter.lock();
+			}
+
+			sleep_for_next_event( meter );
+		}
+
 		this->m_engine.clear_all();
+
+		// Requests which were not handled are simply dropped.
+		destroy_inbox_content( m_inbox.exchange( nullptr ) );
 	}
 
-	//! Perform processing of expired timers.
+	/*!
+	 * \brief Waiting for next event to process.
+	 *
+	 * If the list is not emply the thread will sleep until
+	 * time point of the first timer in the list.
+	 */
 	void
-	process_expired_timers()
+	sleep_for_next_event(
+		//! Object's lock.
+		//! The lock is necessary for waiting on condition variable.
+		lock_hold_meter & lock )
 	{
-		typename manager_impl_template::lock_guard locker{ *this };
+		if( !this->m_shutdown )
+		{
+			// Errors of waiting are not fatal. They are only logged.
+			auto error_handler = [this]( const std::string & what ) {
+				this->m_engine.log_error( what );
+			};
 
-		this->m_engine.process_expired_timers( locker );
+			if( !this->m_engine.empty() )
+			{
+				auto time_point = apply_slack(
+						this->m_engine.nearest_time_point() );
+
+				if( announce_sleeping(
+						time_point.time_since_epoch().count() ) )
+				{
+					lock.released();
+					this->wait_until(
+							lock.actual_lock(), time_point, error_handler );
+					lock.acquired();
+				}
+			}
+			else if( announce_sleeping(
+						std::numeric_limits< time_point_rep >::max() ) )
+			{
+				lock.released();
+				this->wait( lock.actual_lock(), error_handler );
+				lock.acquired();
+			}
+
+			m_sleep_until = std::numeric_limits< time_point_rep >::min();
+		}
 	}
 
-	//! Get the time for next process_expired_timers invocation.
+private :
+	//! Type of activation request in the inbox.
 	/*!
-	 * \return tuple<true,timepoint> if there is a timer to process. Or
-	 * tuple<false,undefined> if there is no timers to be processed.
+	 * \since
+	 * v.1.2.0
 	 */
-	std::tuple< bool, monotonic_clock::time_point >
-	nearest_time_point()
+	struct inbox_item
 	{
-		typename manager_impl_template::lock_guard locker{ *this };
-		auto e = this->m_engine.empty();
-		if( !e )
-			return std::make_tuple( true, this->m_engine.nearest_time_point() );
-		else
-			return std::make_tuple( false, monotonic_clock::time_point() );
-	}
+		//! Next item in the inbox.
+		inbox_item * m_next = nullptr;
 
-	//! Get the sleeping time before the earlist timer expiration.
+		//! Timer to be activated.
+		timer_holder m_timer;
+
+		//! Time point for the first execution of timer.
+		monotonic_clock::time_point m_deadline;
+
+		//! Repetition period.
+		monotonic_clock::duration m_period;
+
+		//! Action for the timer.
+		timer_action m_action;
+
+		//! Initializing constructor.
+		inbox_item(
+			timer_holder timer,
+			monotonic_clock::time_point deadline,
+			monotonic_clock::duration period,
+			timer_action action )
+			:	m_timer( std::move( timer ) )
+			,	m_deadline( deadline )
+			,	m_period( period )
+			,	m_action( std::move( action ) )
+		{}
+	};
+
+	//! Slack for wakeups of timer thread.
 	/*!
-	 * \return actual sleeping time if there is at least one timer.
-	 * Or \a default_timeout if there is no any timers.
+	 * Zero means that timer thread wakes up exactly at the deadline
+	 * of the nearest timer.
 	 *
-	 * \tparam DURATION type for \a default_timeout
+	 * \since
+	 * v.1.2.0
 	 */
-	template< typename DURATION >
-	monotonic_clock::duration
-	timeout_before_nearest_timer(
-		//! Default timeout value which will be used if there is no any timers.
-		DURATION default_timeout )
-	{
-		auto r = this->nearest_time_point();
-		if( std::get<0>( r ) )
-		{
-			auto now = monotonic_clock::now();
-			const auto & f = std::get<1>( r );
-			if( now > f )
-				return monotonic_clock::duration( 0 );
-			else
-				return (f - now);
-		}
-		else
-			return default_timeout;
-	}
-};
+	monotonic_clock::duration m_slack = monotonic_clock::duration::zero();
 
-//
-// thread_impl_template
-//
+	/*!
+	 * \brief An action to be called after processing of elapsed timers.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
+	timer_action m_post_processing_action;
 
-/*!
- * \brief Template-based implementation of timer thread.
- *
- * \tparam ENGINE actual type of engine to be used.
- *
- * \since
- * v.1.1.0
- */
-template< typename ENGINE >
-class thread_impl_template
-	:	public basic_methods_impl_mixin< ENGINE, consumer_type::thread > 
-{
-	//! Shorthand for base type.
-	using base_type = basic_methods_impl_mixin<
-			ENGINE,
-			consumer_type::thread >;
+	/*!
+	 * \name Attributes for submission_mode::inbox.
+	 * \{
+	 */
+	//! The way of handling activation/deactivation requests.
+	submission_mode m_submission_mode = submission_mode::locked;
 
-public :
-	//! Constructor with all parameters.
-	template< typename... ARGS >
-	thread_impl_template(
-		ARGS && ... args )
-		:	base_type( std::forward< ARGS >(args)... )
-	{
-	}
+	//! Can new requests be accepted?
+	std::atomic< bool > m_accepts_requests = { false };
 
-	//! Destructor.
+	//! Top of the lock-free stack of requests.
 	/*!
-	 * Calls shutdown_and_join()
+	 * New items are pushed to the top. Because of that the order of
+	 * items must be reversed before handling.
 	 */
-	~thread_impl_template()
-	{
-		shutdown_and_join();
-	}
+	std::atomic< inbox_item * > m_inbox = { nullptr };
 
-	//! Start timer thread.
+	//! Time point up to which timer thread is sleeping.
 	/*!
-	 * \throw std::runtime_error if thread is already started.
+	 * Holds the minimal value if timer thread is not sleeping now.
+	 * It means that there is no need to wake it up.
+	 *
+	 * \note It is also used for submission_mode::locked. But in that
+	 * case it is read and modified only under the object's lock.
+	 */
+	std::atomic< time_point_rep > m_sleep_until = {
+			std::numeric_limits< time_point_rep >::min() };
+	/*!
+	 * \}
 	 */
+
+	//! Push activation request into the inbox and wake up timer thread
+	//! if necessary.
 	void
-	start()
+	submit_activation(
+		timer_holder timer,
+		monotonic_clock::duration pause,
+		monotonic_clock::duration period,
+		timer_action action )
 	{
-		typename base_type::lock_guard locker{ *this };
-
-		if( this->m_thread )
-			throw std::runtime_error( "timer thread is already started" );
-		else
-			this->m_shutdown = false;
+		if( !m_accepts_requests )
+			throw std::runtime_error( "timer thread is not started" );
 
-		this->m_thread = std::make_shared< std::thread >(
-				std::bind( &thread_impl_template::body, this ) );
-	}
+		const auto deadline = monotonic_clock::now() + pause;
 
-	//! Initiate shutdown for the timer thread without waiting for completion.
-	void
-	shutdown()
-	{
-		typename base_type::lock_guard locker{ *this };
+		push_to_inbox( new inbox_item(
+				std::move( timer ), deadline, period, std::move( action ) ) );
 
-		if( this->m_thread && !this->m_shutdown )
+		// Timer thread must be woken up only if it sleeps longer than
+		// necessary for the new timer.
+		if( apply_slack( deadline ).time_since_epoch().count() <
+				m_sleep_until )
 		{
-			this->m_shutdown = true;
+			typename base_type::lock_guard locker{ *this };
 			this->notify();
 		}
 	}
 
-	//! Wait for completion of timer thread.
+	//! Round time point up to the nearest multiple of the slack.
 	/*!
-	 * Method shutdown() must be called somewhere else.
+	 * \since
+	 * v.1.2.0
 	 */
-	void
-	join()
+	monotonic_clock::time_point
+	apply_slack( monotonic_clock::time_point time_point ) const
 	{
-		std::shared_ptr< std::thread > t;
-		{
-			typename base_type::lock_guard locker{ *this };
-			t = this->m_thread;
-		}
-		if( t )
+		if( monotonic_clock::duration::zero() < m_slack )
 		{
-			t->join();
+			auto remainder = time_point.time_since_epoch() % m_slack;
+			if( remainder < monotonic_clock::duration::zero() )
+				remainder += m_slack;
 
-			typename base_type::lock_guard locker{ *this };
-			this->m_thread.reset();
+			if( monotonic_clock::duration::zero() != remainder )
+				time_point += m_slack - remainder;
 		}
+
+		return time_point;
 	}
 
-	//! Initiate shutdown and wait for completion.
+	//! Wake up timer thread if it sleeps longer than necessary
+	//! for the nearest timer.
+	/*!
+	 * \note Must be called under the object's lock and only if
+	 * the engine is not empty.
+	 *
+	 * \since
+	 * v.1.2.0
+	 */
 	void
-	shutdown_and_join()
+	wakeup_if_necessary()
 	{
-		shutdown();
-		join();
+		if( apply_slack( this->m_engine.nearest_time_point() )
+				.time_since_epoch().count() < m_sleep_until )
+			this->notify();
+	}
+
+	//! Push a request into the lock-free inbox.
+	void
+	push_to_inbox( inbox_item * item )
+	{
+		item->m_next = m_inbox.load( std::memory_order_relaxed );
+		while( !m_inbox.compare_exchange_weak( item->m_next, item ) )
+			;
 	}
 
-protected :
 	/*!
-	 * \name Object's attributes.
-	 * \{
+	 * \brief Store the time of wakeup and check that there is no
+	 * new requests in the inbox.
+	 *
+	 * \note Must be called under the object's lock.
+	 *
+	 * \retval true if timer thread can go to sleep.
 	 */
-	//! Shutdown flag.
-	bool m_shutdown = false;
+	bool
+	announce_sleeping( time_point_rep until )
+	{
+		m_sleep_until = until;
+
+		// If a request was pushed before the store above it must be
+		// handled right now. Otherwise the sender sees the new value
+		// of m_sleep_until and wakes timer thread up if necessary.
+		return nullptr == m_inbox.load();
+	}
+
+	//! Handle all requests from the inbox.
 	/*!
-	 * \}
+	 * \note Must be called under the object's lock.
 	 */
-
-	//! Thread body.
 	void
-	body()
+	handle_inbox_content()
 	{
-		typename base_type::lock_guard locker{ *this };
+		inbox_item * head = m_inbox.exchange( nullptr );
+		if( !head )
+			return;
 
-		while( !this->m_shutdown )
+		// Restore the order of requests.
+		inbox_item * reversed = nullptr;
+		while( head )
 		{
-			this->m_engine.process_expired_timers( locker );
-
-			sleep_for_next_event( locker );
+			auto * next = head->m_next;
+			head->m_next = reversed;
+			reversed = head;
+			head = next;
 		}
 
-		this->m_engine.clear_all();
+		const auto now = monotonic_clock::now();
+		while( reversed )
+		{
+			std::unique_ptr< inbox_item > item{ reversed };
+			reversed = reversed->m_next;
+
+			try
+			{
+				this->m_engine.activate(
+						std::move( item->m_timer ),
+						item->m_deadline > now ?
+								item->m_deadline - now :
+								monotonic_clock::duration::zero(),
+						item->m_period,
+						std::move( item->m_action ) );
+			}
+			catch( const std::exception & x )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__
+					<< "): unable to handle request from inbox: " << x.what();
+				this->m_engine.log_error( ss.str() );
+			}
+		}
 	}
 
-	/*!
-	 * \brief Waiting for next event to process.
-	 *
-	 * If the list is not emply the thread will sleep until
-	 * time point of the first timer in the list.
-	 */
-	void
-	sleep_for_next_event(
-		//! Object's lock.
-		//! The lock is necessary for waiting on condition variable.
-		typename base_type::lock_guard & lock )
+	//! Destroy all requests without handling them.
+	static void
+	destroy_inbox_content( inbox_item * head )
 	{
-		if( !this->m_shutdown )
+		while( head )
 		{
-			if( !this->m_engine.empty() )
-			{
-				auto time_point = this->m_engine.nearest_time_point();
-				this->m_condition.wait_until( lock.actual_lock(), time_point );
-			}
-			else
-				this->m_condition.wait( lock.actual_lock() );
+			std::unique_ptr< inbox_item > item{ head };
+			head = head->m_next;
 		}
 	}
 };
@@ -2873,24 +5540,31 @@ protected :
  * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
  * exceptions thrown from timer actors. Interface for exception handler
  * is defined by default_actor_exception_handler.
+ *
+ * \tparam CONSUMER type of consumer which defines the way of waiting
+ * for next event. Since v.1.2.0 it can be
+ * details::consumer_type::timerfd_thread on Linux.
  */
 template<
 	typename ERROR_LOGGER,
-	typename ACTOR_EXCEPTION_HANDLER >
+	typename ACTOR_EXCEPTION_HANDLER,
+	typename CONSUMER = details::consumer_type::thread >
 class timer_wheel_thread_template
 	: public
 		details::thread_impl_template<
 				details::timer_wheel_engine<
 						::timertt::thread_safety::safe,
 						ERROR_LOGGER,
-						ACTOR_EXCEPTION_HANDLER > > 
+						ACTOR_EXCEPTION_HANDLER >,
+				CONSUMER > 
 {
 	using base_type =
 			details::thread_impl_template<
 					details::timer_wheel_engine<
 							::timertt::thread_safety::safe,
 							ERROR_LOGGER,
-							ACTOR_EXCEPTION_HANDLER > >;
+							ACTOR_EXCEPTION_HANDLER >,
+					CONSUMER >;
 
 public :
 	//! Default constructor.
@@ -3046,24 +5720,31 @@ public :
  * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
  * exceptions thrown from timer actors. Interface for exception handler
  * is defined by default_actor_exception_handler.
+ *
+ * \tparam CONSUMER type of consumer which defines the way of waiting
+ * for next event. Since v.1.2.0 it can be
+ * details::consumer_type::timerfd_thread on Linux.
  */
 template<
 	typename ERROR_LOGGER,
-	typename ACTOR_EXCEPTION_HANDLER >
+	typename ACTOR_EXCEPTION_HANDLER,
+	typename CONSUMER = details::consumer_type::thread >
 class timer_list_thread_template
 	: public
 		details::thread_impl_template<
 				details::timer_list_engine<
 						::timertt::thread_safety::safe,
 						ERROR_LOGGER,
-						ACTOR_EXCEPTION_HANDLER > > 
+						ACTOR_EXCEPTION_HANDLER >,
+				CONSUMER > 
 {
 	using base_type =
 			details::thread_impl_template<
 					details::timer_list_engine<
 							::timertt::thread_safety::safe,
 							ERROR_LOGGER,
-							ACTOR_EXCEPTION_HANDLER > >;
+							ACTOR_EXCEPTION_HANDLER >,
+					CONSUMER >;
 
 public :
 	//! Default constructor.
@@ -3164,17 +5845,23 @@ public :
  * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
  * exceptions thrown from timer actors. Interface for exception handler
  * is defined by default_actor_exception_handler.
+ *
+ * \tparam CONSUMER type of consumer which defines the way of waiting
+ * for next event. Since v.1.2.0 it can be
+ * details::consumer_type::timerfd_thread on Linux.
  */
 template<
 	typename ERROR_LOGGER,
-	typename ACTOR_EXCEPTION_HANDLER >
+	typename ACTOR_EXCEPTION_HANDLER,
+	typename CONSUMER = details::consumer_type::thread >
 class timer_heap_thread_template
 	: public
 		details::thread_impl_template<
 				details::timer_heap_engine<
 						::timertt::thread_safety::safe,
 						ERROR_LOGGER,
-						ACTOR_EXCEPTION_HANDLER > > 
+						ACTOR_EXCEPTION_HANDLER >,
+				CONSUMER > 
 {
 	//! Shorthand for base type.
 	using base_type =
@@ -3182,7 +5869,8 @@ class timer_heap_thread_template
 					details::timer_heap_engine<
 							::timertt::thread_safety::safe,
 							ERROR_LOGGER,
-							ACTOR_EXCEPTION_HANDLER > >;
+							ACTOR_EXCEPTION_HANDLER >,
+					CONSUMER >;
 
 public :
 	//! Default constructor.
@@ -3312,5 +6000,191 @@ public :
 	{}
 };
 
+//
+// timer_hwheel_thread_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * \note Please see description of details::timer_hwheel_engine for the
+ * details of this timer mechanism.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \tparam CONSUMER type of consumer which defines the way of waiting
+ * for next event. It can be details::consumer_type::timerfd_thread
+ * on Linux.
+ *
+ * \since
+ * v.1.2.0
+ */
+template<
+	typename ERROR_LOGGER,
+	typename ACTOR_EXCEPTION_HANDLER,
+	typename CONSUMER = details::consumer_type::thread >
+class timer_hwheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::timer_hwheel_engine<
+						::timertt::thread_safety::safe,
+						ERROR_LOGGER,
+						ACTOR_EXCEPTION_HANDLER >,
+				CONSUMER > 
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::thread_impl_template<
+					details::timer_hwheel_engine<
+							::timertt::thread_safety::safe,
+							ERROR_LOGGER,
+							ACTOR_EXCEPTION_HANDLER >,
+					CONSUMER >;
+
+public :
+	//! Default constructor.
+	timer_hwheel_thread_template()
+		:	timer_hwheel_thread_template(
+				base_type::default_wheel_size(),
+				base_type::default_levels(),
+				base_type::default_granularity(),
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with wheel size, levels and granularity parameters.
+	timer_hwheel_thread_template(
+		//! Size of the wheel at every level.
+		unsigned int wheel_size,
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of time step for the timer_wheel.
+		monotonic_clock::duration granularity )
+		:	timer_hwheel_thread_template(
+				wheel_size,
+				levels,
+				granularity,
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hwheel_thread_template(
+		//! Size of the wheel at every level.
+		unsigned int wheel_size,
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of time step for the timer_wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type(
+				wheel_size,
+				levels,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// timer_hwheel_manager_template
+//
+/*!
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::timer_hwheel_engine for the
+ * details of this timer mechanism.
+ *
+ * \tparam THREAD_SAFETY Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.0
+ */
+template<
+	typename THREAD_SAFETY,
+	typename ERROR_LOGGER = default_error_logger,
+	typename ACTOR_EXCEPTION_HANDLER = default_actor_exception_handler >
+class timer_hwheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::timer_hwheel_engine<
+						THREAD_SAFETY,
+						ERROR_LOGGER,
+						ACTOR_EXCEPTION_HANDLER > > 
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::manager_impl_template<
+					details::timer_hwheel_engine<
+							THREAD_SAFETY,
+							ERROR_LOGGER,
+							ACTOR_EXCEPTION_HANDLER > >;
+
+public :
+	//! Default constructor.
+	timer_hwheel_manager_template()
+		:	timer_hwheel_manager_template(
+				base_type::default_wheel_size(),
+				base_type::default_levels(),
+				base_type::default_granularity(),
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with wheel size, levels and granularity parameters.
+	timer_hwheel_manager_template(
+		//! Size of the wheel at every level.
+		unsigned int wheel_size,
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of time step for the timer_wheel.
+		monotonic_clock::duration granularity )
+		:	timer_hwheel_manager_template(
+				wheel_size,
+				levels,
+				granularity,
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hwheel_manager_template(
+		//! Size of the wheel at every level.
+		unsigned int wheel_size,
+		//! Count of levels.
+		unsigned int levels,
+		//! Size of time step for the timer_wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type(
+				wheel_size,
+				levels,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
 } /* namespace timertt */
 